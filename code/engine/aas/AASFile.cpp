@@ -1315,9 +1315,6 @@ idAASFileLocal::Load
 bool idAASFileLocal::Load( const idStr& fileName, unsigned int mapFileCRC )
 {
 	idLexer src( LEXFL_NOFATALERRORS | LEXFL_NOSTRINGESCAPECHARS | LEXFL_NOSTRINGCONCAT | LEXFL_ALLOWPATHNAMES );
-	idToken token;
-	int depth;
-	unsigned int c;
 
 	name = fileName;
 	crc = mapFileCRC;
@@ -1330,6 +1327,43 @@ bool idAASFileLocal::Load( const idStr& fileName, unsigned int mapFileCRC )
 		return false;
 	}
 
+	return Parse( src, mapFileCRC );
+}
+
+/*
+================
+idAASFileLocal::LoadMemory
+================
+*/
+bool idAASFileLocal::LoadMemory( const idStr& fileName, const char* buffer, int length, unsigned int mapFileCRC )
+{
+	idLexer src( LEXFL_NOFATALERRORS | LEXFL_NOSTRINGESCAPECHARS | LEXFL_NOSTRINGCONCAT | LEXFL_ALLOWPATHNAMES );
+
+	name = fileName;
+	crc = mapFileCRC;
+
+	common->Printf( "[Load AAS]\n" );
+	common->Printf( "parsing %s\n", name.c_str() );
+
+	if( !src.LoadMemory( buffer, length, name ) )
+	{
+		return false;
+	}
+
+	return Parse( src, mapFileCRC );
+}
+
+/*
+================
+idAASFileLocal::Parse
+================
+*/
+bool idAASFileLocal::Parse( idLexer& src, unsigned int mapFileCRC )
+{
+	idToken token;
+	int depth;
+	unsigned int c;
+
 	if( !src.ExpectTokenString( AAS_FILEID ) )
 	{
 		common->Warning( "Not an AAS file: '%s'", name.c_str() );
@@ -1366,6 +1400,8 @@ bool idAASFileLocal::Load( const idStr& fileName, unsigned int mapFileCRC )
 		common->Warning( "AAS file '%s' is out of date", name.c_str() );
 		return false;
 	}
+	// keep the CRC of the file so a file parsed without a map CRC can be checked later
+	crc = c;
 
 	// clear the file in memory
 	Clear();
@@ -1477,7 +1513,11 @@ bool idAASFileLocal::Load( const idStr& fileName, unsigned int mapFileCRC )
 		src.Error( "idAASFileLocal::Load: tree depth = %d", depth );
 	}
 
-	common->UpdateLevelLoadPacifier();
+	// files are parsed on a job thread during level load
+	if( idLib::IsMainThread() )
+	{
+		common->UpdateLevelLoadPacifier();
+	}
 
 	common->Printf( "done.\n" );
 
@@ -40,13 +40,32 @@ If you have questions concerning this license or the applicable additional terms
 ===============================================================================
 */
 
+struct aasPreload_t
+{
+	idStr					fileName;
+	idFile* 				file;			// read on the main thread
+	idAASFileLocal* 		aas;			// parsed on a job thread, NULL if the parse failed
+};
+
 class idAASFileManagerLocal : public idAASFileManager
 {
 public:
+	idAASFileManagerLocal() : preloadsParsed( true )
+	{
+		preloadsParsed.Raise();
+	}
 	virtual						~idAASFileManagerLocal() {}
 
 	virtual idAASFile* 			LoadAAS( const char* fileName, unsigned int mapFileCRC );
 	virtual void				FreeAAS( idAASFile* file );
+
+	virtual void				PreloadAAS( const char* fileName );
+	virtual void				ParsePreloads();
+	virtual void				FreePreloads();
+
+private:
+	idList< aasPreload_t, TAG_AAS >	preloads;
+	idSysSignal					preloadsParsed;		// raised when nothing is waiting for ParsePreloads
 };
 
 idAASFileManagerLocal			AASFileManagerLocal;
@@ -60,6 +79,28 @@ idAASFileManagerLocal::LoadAAS
 */
 idAASFile* idAASFileManagerLocal::LoadAAS( const char* fileName, unsigned int mapFileCRC )
 {
+	for( int i = 0; i < preloads.Num(); i++ )
+	{
+		if( preloads[ i ].fileName.Icmp( fileName ) != 0 )
+		{
+			continue;
+		}
+
+		preloadsParsed.Wait();
+
+		idAASFileLocal* preloaded = preloads[ i ].aas;
+		preloads.RemoveIndexFast( i );
+
+		if( preloaded != NULL && ( mapFileCRC == 0 || preloaded->GetCRC() == mapFileCRC ) )
+		{
+			return preloaded;
+		}
+
+		// load it again so the warnings are printed on the main thread
+		delete preloaded;
+		break;
+	}
+
 	idAASFileLocal* file = new( TAG_AAS ) idAASFileLocal();
 	if( !file->Load( fileName, mapFileCRC ) )
 	{
@@ -78,3 +119,82 @@ void idAASFileManagerLocal::FreeAAS( idAASFile* file )
 {
 	delete file;
 }
+
+/*
+================
+idAASFileManagerLocal::PreloadAAS
+================
+*/
+void idAASFileManagerLocal::PreloadAAS( const char* fileName )
+{
+	assert( idLib::IsMainThread() );
+
+	idFile* file = fileSystem->OpenFileReadMemory( fileName );
+	if( file == NULL )
+	{
+		return;
+	}
+
+	preloadsParsed.Clear();
+
+	aasPreload_t& preload = preloads.Alloc();
+	preload.fileName = fileName;
+	preload.file = file;
+	preload.aas = NULL;
+}
+
+/*
+================
+idAASFileManagerLocal::ParsePreloads
+
+Only touches the preloads, so it can run on a job thread while the main thread keeps loading.
+================
+*/
+void idAASFileManagerLocal::ParsePreloads()
+{
+	for( int i = 0; i < preloads.Num(); i++ )
+	{
+		aasPreload_t& preload = preloads[ i ];
+		if( preload.file == NULL )
+		{
+			continue;
+		}
+
+		// the lexer wants a null terminated buffer
+		const int length = preload.file->Length();
+		char* buffer = ( char* )Mem_Alloc( length + 1, TAG_AAS );
+		preload.file->Read( buffer, length );
+		buffer[ length ] = '\0';
+
+		delete preload.file;
+		preload.file = NULL;
+
+		preload.aas = new( TAG_AAS ) idAASFileLocal();
+		if( !preload.aas->LoadMemory( preload.fileName, buffer, length, 0 ) )
+		{
+			delete preload.aas;
+			preload.aas = NULL;
+		}
+
+		Mem_Free( buffer );
+	}
+
+	preloadsParsed.Raise();
+}
+
+/*
+================
+idAASFileManagerLocal::FreePreloads
+================
+*/
+void idAASFileManagerLocal::FreePreloads()
+{
+	preloadsParsed.Wait();
+
+	for( int i = 0; i < preloads.Num(); i++ )
+	{
+		delete preloads[ i ].file;
+		delete preloads[ i ].aas;
+	}
+	preloads.Clear();
+}
@@ -44,6 +44,13 @@ public:
 
 	virtual idAASFile* 			LoadAAS( const char* fileName, unsigned int mapFileCRC ) = 0;
 	virtual void				FreeAAS( idAASFile* file ) = 0;
+
+	// level load: reads the file now so ParsePreloads can parse it on a job thread,
+	// LoadAAS then hands out the parsed file instead of loading it again
+	virtual void				PreloadAAS( const char* fileName ) = 0;
+	virtual void				ParsePreloads() = 0;
+	// frees the preloaded files LoadAAS never asked for
+	virtual void				FreePreloads() = 0;
 };
 
 extern idAASFileManager* 		AASFileManager;
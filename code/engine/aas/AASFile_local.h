@@ -70,6 +70,8 @@ public:
 // jmarshall end
 public:
 	bool						Load( const idStr& fileName, unsigned int mapFileCRC );
+	// parses a file already read into memory, the buffer has to be null terminated
+	bool						LoadMemory( const idStr& fileName, const char* buffer, int length, unsigned int mapFileCRC );
 	bool						Write( const idStr& fileName, unsigned int mapFileCRC );
 
 	int							MemorySize() const;
@@ -83,6 +85,7 @@ public:
 	void						DeleteClusters();
 
 private:
+	bool						Parse( idLexer& src, unsigned int mapFileCRC );
 	bool						ParseIndex( idLexer& src, idList<aasIndex_t>& indexes );
 	bool						ParsePlanes( idLexer& src );
 	bool						ParseVertices( idLexer& src );
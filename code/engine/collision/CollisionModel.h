@@ -141,6 +141,11 @@ public:
 									  const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
 									  cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis ) = 0;
 
+	// Traces a batch of points through the model and reports the first collision of each,
+	// the same as calling Translation without a trace model for every point.
+	virtual void			TracePoints( trace_t* results, const idVec3* starts, const idVec3* ends, const int numPoints, int contentMask,
+										 cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis ) = 0;
+
 	// Stores all contact points of the trace model with the model, returns the number of contacts.
 	virtual int				Contacts( contactInfo_t* contacts, const int maxContacts, const idVec3& start, const idVec6& dir, const float depth,
 									  const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
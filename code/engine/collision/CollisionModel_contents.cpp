@@ -60,11 +60,11 @@ bool idCollisionModelManagerLocal::TestTrmVertsInBrush( cm_traceWork_t* tw, cm_b
 	float d, bestd;
 	idVec3* p;
 
-	if( b->checkcount == idCollisionModelManagerLocal::checkCount )
+	if( tw->brushChecks[b->checkNum] == tw->checkCount )
 	{
 		return false;
 	}
-	b->checkcount = idCollisionModelManagerLocal::checkCount;
+	tw->brushChecks[b->checkNum] = tw->checkCount;
 
 	if( !( b->contents & tw->contents ) )
 	{
@@ -142,10 +142,10 @@ CM_SetTrmEdgeSidedness
 CM_SetTrmPolygonSidedness
 ================
 */
-#define CM_SetTrmPolygonSidedness( v, plane, bitNum ) {						\
+#define CM_SetTrmPolygonSidedness( v, p, plane, bitNum ) {					\
 	const int mask = 1 << bitNum;											\
 	if ( ( (v)->sideSet & mask ) == 0 ) {									\
-		const float fl = plane.Distance( (v)->p );							\
+		const float fl = plane.Distance( p );								\
 		(v)->side = ( (v)->side & ~mask ) | ( ( fl < 0.0f ) ? mask : 0 );		\
 		(v)->sideSet |= mask;												\
 	}																		\
@@ -165,14 +165,15 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t* tw, cm_poly
 	float d, bestd;
 	cm_trmEdge_t* trmEdge;
 	cm_edge_t* edge;
-	cm_vertex_t* v, *v1, *v2;
+	cm_vertex_t* v;
+	cm_sideCheck_t* edgeCheck, *v1, *v2;
 
 	// if already checked this polygon
-	if( p->checkcount == idCollisionModelManagerLocal::checkCount )
+	if( tw->polygonChecks[p->checkNum] == tw->checkCount )
 	{
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
+	tw->polygonChecks[p->checkNum] = tw->checkCount;
 
 	// if this polygon does not have the right contents behind it
 	if( !( p->contents & tw->contents ) )
@@ -210,7 +211,7 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t* tw, cm_poly
 			edgeNum = p->edges[i];
 			edge = tw->model->edges + abs( edgeNum );
 			// if this edge is already tested
-			if( edge->checkcount == idCollisionModelManagerLocal::checkCount )
+			if( tw->edgeChecks[abs( edgeNum )].checkcount == tw->checkCount )
 			{
 				continue;
 			}
@@ -219,7 +220,7 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t* tw, cm_poly
 			{
 				v = &tw->model->vertices[edge->vertexNum[j]];
 				// if this vertex is already tested
-				if( v->checkcount == idCollisionModelManagerLocal::checkCount )
+				if( tw->vertexChecks[edge->vertexNum[j]].checkcount == tw->checkCount )
 				{
 					continue;
 				}
@@ -260,21 +261,22 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t* tw, cm_poly
 	{
 		edgeNum = p->edges[i];
 		edge = tw->model->edges + abs( edgeNum );
+		edgeCheck = tw->edgeChecks + abs( edgeNum );
 		// reset sidedness cache if this is the first time we encounter this edge
-		if( edge->checkcount != idCollisionModelManagerLocal::checkCount )
+		if( edgeCheck->checkcount != tw->checkCount )
 		{
-			edge->sideSet = 0;
+			edgeCheck->sideSet = 0;
 		}
 		// pluecker coordinate for edge
 		tw->polygonEdgePlueckerCache[i].FromLine( tw->model->vertices[edge->vertexNum[0]].p,
 				tw->model->vertices[edge->vertexNum[1]].p );
-		v = &tw->model->vertices[edge->vertexNum[INT32_SIGNBITSET( edgeNum )]];
+		v1 = tw->vertexChecks + edge->vertexNum[INT32_SIGNBITSET( edgeNum )];
 		// reset sidedness cache if this is the first time we encounter this vertex
-		if( v->checkcount != idCollisionModelManagerLocal::checkCount )
+		if( v1->checkcount != tw->checkCount )
 		{
-			v->sideSet = 0;
+			v1->sideSet = 0;
 		}
-		v->checkcount = idCollisionModelManagerLocal::checkCount;
+		v1->checkcount = tw->checkCount;
 	}
 
 	// get side of polygon for each trm vertex
@@ -298,10 +300,10 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t* tw, cm_poly
 		for( j = 0; j < p->numEdges; j++ )
 		{
 			edgeNum = p->edges[j];
-			edge = tw->model->edges + abs( edgeNum );
+			edgeCheck = tw->edgeChecks + abs( edgeNum );
 #if 1
-			CM_SetTrmEdgeSidedness( edge, tw->edges[i].pl, tw->polygonEdgePlueckerCache[j], i );
-			if( INT32_SIGNBITSET( edgeNum ) ^ ( ( edge->side >> i ) & 1 ) ^ flip )
+			CM_SetTrmEdgeSidedness( edgeCheck, tw->edges[i].pl, tw->polygonEdgePlueckerCache[j], i );
+			if( INT32_SIGNBITSET( edgeNum ) ^ ( ( edgeCheck->side >> i ) & 1 ) ^ flip )
 			{
 				break;
 			}
@@ -347,19 +349,20 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t* tw, cm_poly
 	{
 		edgeNum = p->edges[i];
 		edge = tw->model->edges + abs( edgeNum );
-		if( edge->checkcount == idCollisionModelManagerLocal::checkCount )
+		edgeCheck = tw->edgeChecks + abs( edgeNum );
+		if( edgeCheck->checkcount == tw->checkCount )
 		{
 			continue;
 		}
-		edge->checkcount = idCollisionModelManagerLocal::checkCount;
+		edgeCheck->checkcount = tw->checkCount;
 
 		for( j = 0; j < tw->numPolys; j++ )
 		{
 #if 1
-			v1 = tw->model->vertices + edge->vertexNum[0];
-			CM_SetTrmPolygonSidedness( v1, tw->polys[j].plane, j );
-			v2 = tw->model->vertices + edge->vertexNum[1];
-			CM_SetTrmPolygonSidedness( v2, tw->polys[j].plane, j );
+			v1 = tw->vertexChecks + edge->vertexNum[0];
+			CM_SetTrmPolygonSidedness( v1, tw->model->vertices[edge->vertexNum[0]].p, tw->polys[j].plane, j );
+			v2 = tw->vertexChecks + edge->vertexNum[1];
+			CM_SetTrmPolygonSidedness( v2, tw->model->vertices[edge->vertexNum[1]].p, tw->polys[j].plane, j );
 			// if the polygon edge does not cross the trm polygon plane
 			if( !( ( ( v1->side ^ v2->side ) >> j ) & 1 ) )
 			{
@@ -391,8 +394,8 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t* tw, cm_poly
 				trmEdge = tw->edges + abs( trmEdgeNum );
 #if 1
 				bitNum = abs( trmEdgeNum );
-				CM_SetTrmEdgeSidedness( edge, trmEdge->pl, tw->polygonEdgePlueckerCache[i], bitNum );
-				if( INT32_SIGNBITSET( trmEdgeNum ) ^ ( ( edge->side >> bitNum ) & 1 ) ^ flip )
+				CM_SetTrmEdgeSidedness( edgeCheck, trmEdge->pl, tw->polygonEdgePlueckerCache[i], bitNum );
+				if( INT32_SIGNBITSET( trmEdgeNum ) ^ ( ( edgeCheck->side >> bitNum ) & 1 ) ^ flip )
 				{
 					break;
 				}
@@ -562,8 +565,6 @@ int idCollisionModelManagerLocal::ContentsTrm( trace_t* results, const idVec3& s
 		return results->c.contents;
 	}
 
-	idCollisionModelManagerLocal::checkCount++;
-
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
 	tw.trace.c.type = CONTACT_NONE;
@@ -575,8 +576,10 @@ int idCollisionModelManagerLocal::ContentsTrm( trace_t* results, const idVec3& s
 	tw.positionTest = true;
 	tw.pointTrace = false;
 	tw.quickExit = false;
+	tw.getContacts = false;
 	tw.numContacts = 0;
 	tw.model = idCollisionModelManagerLocal::models[model];
+	idCollisionModelManagerLocal::SetupQueryChecks( &tw, idCollisionModelManagerLocal::GetQueryContext() );
 	tw.start = start - modelOrigin;
 	tw.end = tw.start;
 
@@ -583,3 +583,290 @@ void idCollisionModelManagerLocal::DebugOutput( const idVec3& origin )
 	Mem_Free( testend );
 	testend = NULL;
 }
+
+/*
+===============================================================================
+
+Threaded collision test
+
+===============================================================================
+*/
+
+#define CM_TEST_QUERIES_PER_JOB		1024
+
+typedef enum
+{
+	CM_TEST_TRANSLATION,
+	CM_TEST_POINT,
+	CM_TEST_ROTATION,
+	CM_TEST_CONTENTS,
+	CM_TEST_NUM_TYPES
+} cm_testType_t;
+
+typedef struct cm_testQuery_s
+{
+	cm_testType_t			type;
+	idVec3					start;
+	idVec3					end;
+	idRotation				rotation;
+	trace_t					serial;				// result of the single threaded run
+	trace_t					parallel;			// result of the job run
+} cm_testQuery_t;
+
+typedef struct cm_testJob_s
+{
+	const idTraceModel* 	trm;
+	cm_testQuery_t* 		queries;
+	int						numQueries;
+} cm_testJob_t;
+
+/*
+================
+CM_RunTestQuery
+================
+*/
+static void CM_RunTestQuery( const idTraceModel* trm, cm_testQuery_t* query, trace_t* results )
+{
+	const int contentMask = CONTENTS_SOLID | CONTENTS_PLAYERCLIP;
+
+	switch( query->type )
+	{
+		case CM_TEST_TRANSLATION:
+			collisionModelManager->Translation( results, query->start, query->end, trm, mat3_identity, contentMask, 0, vec3_origin, mat3_identity );
+			break;
+		case CM_TEST_POINT:
+			collisionModelManager->Translation( results, query->start, query->end, NULL, mat3_identity, contentMask, 0, vec3_origin, mat3_identity );
+			break;
+		case CM_TEST_ROTATION:
+			collisionModelManager->Rotation( results, query->start, query->rotation, trm, mat3_identity, contentMask, 0, vec3_origin, mat3_identity );
+			break;
+		default:
+			memset( results, 0, sizeof( *results ) );
+			results->c.contents = collisionModelManager->Contents( query->start, trm, mat3_identity, contentMask, 0, vec3_origin, mat3_identity );
+			break;
+	}
+}
+
+/*
+================
+CM_TestQueryJob
+================
+*/
+static void CM_TestQueryJob( cm_testJob_t* job )
+{
+	for( int i = 0; i < job->numQueries; i++ )
+	{
+		CM_RunTestQuery( job->trm, &job->queries[i], &job->queries[i].parallel );
+	}
+}
+
+REGISTER_PARALLEL_JOB( CM_TestQueryJob, "CM_TestQueryJob" );
+
+/*
+================
+CM_SameTrace
+================
+*/
+static bool CM_SameTrace( const trace_t& a, const trace_t& b )
+{
+	return a.fraction == b.fraction && a.endpos == b.endpos && a.c.contents == b.c.contents &&
+		   a.c.normal == b.c.normal && a.c.type == b.c.type && a.c.material == b.c.material;
+}
+
+/*
+================
+testCollisionThreads
+
+  traces random queries through the world model on all job threads and compares
+  the results with the same queries traced on the calling thread
+================
+*/
+CONSOLE_COMMAND( testCollisionThreads, "traces [numQueries] random queries through the world on the job threads and compares them with a serial run", NULL )
+{
+	static const char* typeNames[CM_TEST_NUM_TYPES] = { "translation", "point", "rotation", "contents" };
+	const int batchSize = 64 * CM_TEST_QUERIES_PER_JOB;
+
+	idBounds worldBounds;
+	if( !collisionModelManager->GetModelBounds( 0, worldBounds ) )
+	{
+		common->Printf( "no collision map loaded\n" );
+		return;
+	}
+
+	const int numQueries = ( args.Argc() > 1 ) ? Max( atoi( args.Argv( 1 ) ), 1 ) : 1000000;
+
+	cm_testQuery_t* queries = ( cm_testQuery_t* ) Mem_Alloc( batchSize * sizeof( cm_testQuery_t ), TAG_COLLISION );
+	cm_testJob_t* jobs = ( cm_testJob_t* ) Mem_Alloc( ( batchSize / CM_TEST_QUERIES_PER_JOB ) * sizeof( cm_testJob_t ), TAG_COLLISION );
+	idParallelJobList* jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, batchSize / CM_TEST_QUERIES_PER_JOB, 0, NULL );
+
+	const idTraceModel trm( idBounds( idVec3( -16, -16, 0 ), idVec3( 16, 16, 64 ) ) );
+	idRandom random( 0 );
+	idTimer serialTimer, parallelTimer;
+	int numHits[CM_TEST_NUM_TYPES] = {};
+	int numMismatches[CM_TEST_NUM_TYPES] = {};
+
+	for( int first = 0; first < numQueries; first += batchSize )
+	{
+		const int num = Min( batchSize, numQueries - first );
+		const int numJobs = ( num + CM_TEST_QUERIES_PER_JOB - 1 ) / CM_TEST_QUERIES_PER_JOB;
+
+		for( int i = 0; i < num; i++ )
+		{
+			cm_testQuery_t& query = queries[i];
+			query.type = ( cm_testType_t )( ( first + i ) % CM_TEST_NUM_TYPES );
+			for( int j = 0; j < 3; j++ )
+			{
+				query.start[j] = worldBounds[0][j] + random.RandomFloat() * ( worldBounds[1][j] - worldBounds[0][j] );
+				query.end[j] = query.start[j] + random.CRandomFloat() * cm_testLength.GetFloat();
+			}
+			idVec3 axis( random.CRandomFloat(), random.CRandomFloat(), random.RandomFloat() + 0.1f );
+			axis.Normalize();
+			query.rotation.Set( query.end, axis, random.CRandomFloat() * cm_testAngle.GetFloat() );
+		}
+
+		serialTimer.Start();
+		for( int i = 0; i < num; i++ )
+		{
+			CM_RunTestQuery( &trm, &queries[i], &queries[i].serial );
+		}
+		serialTimer.Stop();
+
+		for( int i = 0; i < numJobs; i++ )
+		{
+			jobs[i].trm = &trm;
+			jobs[i].queries = queries + i * CM_TEST_QUERIES_PER_JOB;
+			jobs[i].numQueries = Min( CM_TEST_QUERIES_PER_JOB, num - i * CM_TEST_QUERIES_PER_JOB );
+			jobList->AddJob( ( jobRun_t )CM_TestQueryJob, &jobs[i] );
+		}
+
+		parallelTimer.Start();
+		jobList->Submit( NULL, JOBLIST_PARALLELISM_MAX_CORES );
+		jobList->Wait();
+		parallelTimer.Stop();
+
+		for( int i = 0; i < num; i++ )
+		{
+			const cm_testQuery_t& query = queries[i];
+			if( query.serial.fraction < 1.0f || query.serial.c.contents != 0 )
+			{
+				numHits[query.type]++;
+			}
+			if( !CM_SameTrace( query.serial, query.parallel ) )
+			{
+				if( numMismatches[query.type] == 0 )
+				{
+					common->Warning( "%s query %d differs: fraction %f / %f, contents %d / %d", typeNames[query.type], first + i,
+									 query.serial.fraction, query.parallel.fraction, query.serial.c.contents, query.parallel.c.contents );
+				}
+				numMismatches[query.type]++;
+			}
+		}
+	}
+
+	parallelJobManager->FreeJobList( jobList );
+	Mem_Free( jobs );
+	Mem_Free( queries );
+
+	int totalMismatches = 0;
+	for( int i = 0; i < CM_TEST_NUM_TYPES; i++ )
+	{
+		common->Printf( "%-12s %7d hits, %d mismatches\n", typeNames[i], numHits[i], numMismatches[i] );
+		totalMismatches += numMismatches[i];
+	}
+	common->Printf( "%d queries: serial %1.0f ms, jobs %1.0f ms, %s\n", numQueries, serialTimer.Milliseconds(), parallelTimer.Milliseconds(),
+					totalMismatches ? "FAILED" : "all results match" );
+}
+
+/*
+================
+testRayPackets
+
+  traces random line of sight rays through the world model one by one and in
+  packets and compares the results and the number of rays per second
+================
+*/
+CONSOLE_COMMAND( testRayPackets, "traces [numRays] random rays through the world one by one and in packets and compares them", NULL )
+{
+	const int raysPerEye = 16;
+
+	idBounds worldBounds;
+	if( !collisionModelManager->GetModelBounds( 0, worldBounds ) )
+	{
+		common->Printf( "no collision map loaded\n" );
+		return;
+	}
+
+	const int numRays = ( args.Argc() > 1 ) ? Max( atoi( args.Argv( 1 ) ), 1 ) : 1000000;
+	const int contentMask = CONTENTS_SOLID | CONTENTS_OPAQUE;
+
+	idVec3* starts = ( idVec3* ) Mem_Alloc( numRays * sizeof( idVec3 ), TAG_COLLISION );
+	idVec3* ends = ( idVec3* ) Mem_Alloc( numRays * sizeof( idVec3 ), TAG_COLLISION );
+	trace_t* single = ( trace_t* ) Mem_Alloc( numRays * sizeof( trace_t ), TAG_COLLISION );
+	trace_t* packets = ( trace_t* ) Mem_Alloc( numRays * sizeof( trace_t ), TAG_COLLISION );
+
+	// rays from the same eye towards targets close to each other like a line of sight sweep
+	idRandom random( 0 );
+	idVec3 eye, target;
+	for( int i = 0; i < numRays; i++ )
+	{
+		if( ( i % raysPerEye ) == 0 )
+		{
+			idVec3 dir( random.CRandomFloat(), random.CRandomFloat(), random.CRandomFloat() );
+			dir.Normalize();
+			for( int j = 0; j < 3; j++ )
+			{
+				eye[j] = worldBounds[0][j] + random.RandomFloat() * ( worldBounds[1][j] - worldBounds[0][j] );
+			}
+			target = eye + dir * cm_testLength.GetFloat();
+		}
+		starts[i] = eye;
+		for( int j = 0; j < 3; j++ )
+		{
+			ends[i][j] = target[j] + random.CRandomFloat() * cm_testRadius.GetFloat();
+		}
+	}
+
+	idTimer singleTimer, packetTimer;
+
+	singleTimer.Start();
+	for( int i = 0; i < numRays; i++ )
+	{
+		collisionModelManager->Translation( &single[i], starts[i], ends[i], NULL, mat3_identity, contentMask, 0, vec3_origin, mat3_identity );
+	}
+	singleTimer.Stop();
+
+	packetTimer.Start();
+	collisionModelManager->TracePoints( packets, starts, ends, numRays, contentMask, 0, vec3_origin, mat3_identity );
+	packetTimer.Stop();
+
+	int numHits = 0;
+	int numMismatches = 0;
+	for( int i = 0; i < numRays; i++ )
+	{
+		if( single[i].fraction < 1.0f )
+		{
+			numHits++;
+		}
+		if( !CM_SameTrace( single[i], packets[i] ) )
+		{
+			if( numMismatches == 0 )
+			{
+				common->Warning( "ray %d differs: fraction %f / %f, contents %d / %d", i,
+								 single[i].fraction, packets[i].fraction, single[i].c.contents, packets[i].c.contents );
+			}
+			numMismatches++;
+		}
+	}
+
+	Mem_Free( packets );
+	Mem_Free( single );
+	Mem_Free( ends );
+	Mem_Free( starts );
+
+	const double singleMsec = Max( singleTimer.Milliseconds(), 0.001 );
+	const double packetMsec = Max( packetTimer.Milliseconds(), 0.001 );
+
+	common->Printf( "%d rays, %d hits, %d mismatches\n", numRays, numHits, numMismatches );
+	common->Printf( "single: %1.0f ms, %1.2f Mrays/s\n", singleMsec, numRays / ( singleMsec * 1000.0 ) );
+	common->Printf( "packets: %1.0f ms, %1.2f Mrays/s\n", packetMsec, numRays / ( packetMsec * 1000.0 ) );
+}
@@ -205,10 +205,6 @@ void idCollisionModelManagerLocal::Clear()
 	trmMaterial = NULL;
 	numProcNodes = 0;
 	procNodes = NULL;
-	getContacts = false;
-	contacts = NULL;
-	maxContacts = 0;
-	numContacts = 0;
 }
 
 /*
@@ -478,6 +474,8 @@ void idCollisionModelManagerLocal::FreeMap()
 
 	Mem_Free( models );
 
+	ClearQueryContexts();
+
 	Clear();
 
 	ShutdownHash();
@@ -621,6 +619,8 @@ cm_model_t* idCollisionModelManagerLocal::AllocModel()
 	model->maxEdges = 0;
 	model->numEdges = 0;
 	model->edges = NULL;
+	model->numPolygonChecks = 0;
+	model->numBrushChecks = 0;
 	model->node = NULL;
 	model->nodeBlocks = NULL;
 	model->polygonRefBlocks = NULL;
@@ -757,6 +757,7 @@ cm_polygon_t* idCollisionModelManagerLocal::AllocPolygon( cm_model_t* model, int
 	{
 		poly = ( cm_polygon_t* ) Mem_ClearedAlloc( size, TAG_COLLISION );
 	}
+	poly->checkNum = model->numPolygonChecks++;
 	return poly;
 }
 
@@ -783,6 +784,7 @@ cm_brush_t* idCollisionModelManagerLocal::AllocBrush( cm_model_t* model, int num
 	{
 		brush = ( cm_brush_t* ) Mem_ClearedAlloc( size, TAG_COLLISION );
 	}
+	brush->checkNum = model->numBrushChecks++;
 	return brush;
 }
 
@@ -3489,7 +3491,7 @@ void idCollisionModelManagerLocal::FinishModel( cm_model_t* model )
 						model->numBrushRefs * sizeof( cm_brushRef_t );
 }
 
-static const byte BCM_VERSION = 100;
+static const byte BCM_VERSION = 101;
 static const unsigned int BCM_MAGIC = ( 'B' << 24 ) | ( 'C' << 16 ) | ( 'M' << 16 ) | BCM_VERSION;
 
 /*
@@ -4271,6 +4273,15 @@ void idCollisionModelManagerLocal::BuildModels( const idMapFile* mapFile, bool i
 
 	if( ignoreOldCollisionFile || !LoadCollisionModelFile( mapFile->GetName(), mapFile->GetGeometryCRC() ) )
 	{
+		// the game may have loaded only the entities from the binary entity cache,
+		// the brushes and patches are needed after all
+		idMapFile fullMapFile;
+		if( !mapFile->HasPrimitiveData() && fullMapFile.Parse( mapFile->GetName() ) )
+		{
+			common->Printf( "collision map out of date, parsing %s\n", mapFile->GetName() );
+			mapFile = &fullMapFile;
+		}
+
 		if( !mapFile->GetNumEntities() )
 		{
 			return;
@@ -41,6 +41,7 @@ If you have questions concerning this license or the applicable additional terms
 #define MAX_NODE_POLYGONS					128
 #define CM_MAX_POLYGON_EDGES				64
 #define CIRCLE_APPROXIMATION_LENGTH			64.0f
+#define CM_RAY_PACKET_SIZE					4		// point traces traced together through the axial BSP tree
 
 #define	MAX_SUBMODELS						2048
 #define	TRACE_MODEL_HANDLE					MAX_SUBMODELS
@@ -113,6 +114,7 @@ typedef struct cm_polygon_s
 {
 	idBounds				bounds;				// polygon bounds
 	int						checkcount;			// for multi-check avoidance
+	int						checkNum;			// index into the query check tables
 	int						contents;			// contents behind polygon
 	const idMaterial* 		material;			// material
 	idPlane					plane;				// polygon plane
@@ -143,12 +145,14 @@ typedef struct cm_brush_s
 	cm_brush_s()
 	{
 		checkcount = 0;
+		checkNum = 0;
 		contents = 0;
 		material = NULL;
 		primitiveNum = 0;
 		numPlanes = 0;
 	}
 	int						checkcount;			// for multi-check avoidance
+	int						checkNum;			// index into the query check tables
 	idBounds				bounds;				// brush bounds
 	int						contents;			// contents of brush
 	const idMaterial* 		material;			// material
@@ -198,6 +202,8 @@ typedef struct cm_model_s
 	int						maxEdges;			// size of edge array
 	int						numEdges;			// number of edges
 	cm_edge_t* 				edges;				// array with all edges used by the model
+	int						numPolygonChecks;	// polygon check numbers handed out
+	int						numBrushChecks;		// brush check numbers handed out
 	cm_node_t* 				node;				// first node of spatial subdivision
 	// blocks with allocated memory
 	cm_nodeBlock_t* 		nodeBlocks;			// list with blocks of nodes
@@ -228,6 +234,16 @@ Data used during collision detection calculations
 ===============================================================================
 */
 
+// the collision models are not written during a query, every thread keeps the
+// multi-check avoidance and sidedness caches in its own tables instead,
+// indexed by vertex, edge, polygon and brush check number of the traced model
+typedef struct cm_sideCheck_s
+{
+	int						checkcount;			// for multi-check avoidance
+	unsigned int			side;				// sidedness bits, see cm_vertex_t and cm_edge_t
+	unsigned int			sideSet;			// each bit tells if the sidedness has been calculated yet
+} cm_sideCheck_t;
+
 typedef struct cm_trmVertex_s
 {
 	int used;										// true if this vertex is used for collision detection
@@ -306,8 +322,39 @@ typedef struct cm_traceWork_s
 	idPluecker polygonEdgePlueckerCache[CM_MAX_POLYGON_EDGES];
 	idPluecker polygonVertexPlueckerCache[CM_MAX_POLYGON_EDGES];
 	idVec3 polygonRotationOriginCache[CM_MAX_POLYGON_EDGES];
+
+	int checkCount;									// check count of this query
+	cm_sideCheck_t* vertexChecks;					// check tables of the query context
+	cm_sideCheck_t* edgeChecks;
+	int* polygonChecks;
+	int* brushChecks;
 } cm_traceWork_t;
 
+// segments of the point traces in a packet at the current node, one lane per ray
+typedef struct cm_rayPacket_s
+{
+	ALIGN16( float p1[3][CM_RAY_PACKET_SIZE] );		// start of the segment for each axis
+	ALIGN16( float p2[3][CM_RAY_PACKET_SIZE] );		// end of the segment for each axis
+	ALIGN16( float p1f[CM_RAY_PACKET_SIZE] );		// trace fraction at the start of the segment
+	ALIGN16( float p2f[CM_RAY_PACKET_SIZE] );		// trace fraction at the end of the segment
+} cm_rayPacket_t;
+
+typedef struct cm_queryContext_s
+{
+	int						checkCount;			// increased for every query
+	idList<cm_sideCheck_t, TAG_COLLISION> vertexChecks;
+	idList<cm_sideCheck_t, TAG_COLLISION> edgeChecks;
+	idList<int, TAG_COLLISION> polygonChecks;
+	idList<int, TAG_COLLISION> brushChecks;
+	// for retrieving contact points
+	bool					getContacts;
+	contactInfo_t* 			contacts;
+	int						maxContacts;
+	int						numContacts;
+	// trace work for the rays of a point trace packet
+	cm_traceWork_t* 		packetWork;
+} cm_queryContext_t;
+
 /*
 ===============================================================================
 
@@ -365,6 +412,9 @@ public:
 	int				Contents( const idVec3& start,
 							  const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
 							  cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis );
+	// traces a batch of points in packets and reports the first collision of each
+	void			TracePoints( trace_t* results, const idVec3* starts, const idVec3* ends, const int numPoints, int contentMask,
+								 cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis );
 	// stores all contact points of the trm with the model, returns the number of contacts
 	int				Contacts( contactInfo_t* contacts, const int maxContacts, const idVec3& start, const idVec6& dir, const float depth,
 							  const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
@@ -429,11 +479,19 @@ private:			// CollisionMap_contents.cpp
 								 cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis );
 
 private:			// CollisionMap_trace.cpp
+	cm_queryContext_t* GetQueryContext();
+	void			SetupQueryChecks( cm_traceWork_t* tw, cm_queryContext_t* context );
+	void			ClearQueryContexts();
 	void			TraceTrmThroughNode( cm_traceWork_t* tw, cm_node_t* node );
 	void			TraceThroughAxialBSPTree_r( cm_traceWork_t* tw, cm_node_t* node, float p1f, float p2f, idVec3& p1, idVec3& p2 );
 	void			TraceThroughModel( cm_traceWork_t* tw );
 	void			RecurseProcBSP_r( trace_t* results, int parentNodeNum, int nodeNum, float p1f, float p2f, const idVec3& p1, const idVec3& p2 );
 
+private:			// CollisionMap_packet.cpp
+	void			SetupPointTrace( cm_traceWork_t* tw, const idVec3& start, const idVec3& end, int contentMask,
+									 cm_model_t* model, const idVec3& modelOrigin, const idMat3& modelAxis, bool modelRotated );
+	void			TracePacketThroughAxialBSPTree_r( cm_traceWork_t* packetWork, int activeMask, cm_node_t* node, const cm_rayPacket_t& packet );
+
 private:			// CollisionMap_load.cpp
 	void			Clear();
 	void			FreeTrmModelStructure();
@@ -545,8 +603,12 @@ private:			// collision map data
 	idStr			mapName;
 	ID_TIME_T			mapFileTime;
 	int				loaded;
-	// for multi-check avoidance
+	// for multi-check avoidance while building, writing and drawing models,
+	// queries use the check tables of their query context
 	int				checkCount;
+	// query contexts of all threads that ran a query
+	idList<cm_queryContext_t*, TAG_COLLISION> queryContexts;
+	idSysMutex		queryContextMutex;
 	// models
 	int				maxModels;
 	int				numModels;
@@ -558,11 +620,6 @@ private:			// collision map data
 	// for data pruning
 	int				numProcNodes;
 	cm_procNode_t* 	procNodes;
-	// for retrieving contact points
-	bool			getContacts;
-	contactInfo_t* 	contacts;
-	int				maxContacts;
-	int				numContacts;
 };
 
 // for debugging
@@ -0,0 +1,491 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+/*
+===============================================================================
+
+	Trace model vs. polygonal model collision detection.
+
+	Batched point traces. Point traces are grouped in packets that walk the
+	axial BSP tree together, the node tests are done for all rays at once.
+
+===============================================================================
+*/
+
+#include "precompiled.h"
+#pragma hdrstop
+
+#include "CollisionModel_local.h"
+
+// the rows of a packet are stored back to back so a packet can be blended row by row
+#define CM_RAY_PACKET_ROWS		8
+compile_time_assert( sizeof( cm_rayPacket_t ) == CM_RAY_PACKET_ROWS* CM_RAY_PACKET_SIZE* sizeof( float ) );
+
+/*
+================
+CM_SelectPacket
+
+  takes the rays in mask from a and all other rays from b
+================
+*/
+static void CM_SelectPacket( cm_rayPacket_t& out, const int mask, const cm_rayPacket_t& a, const cm_rayPacket_t& b )
+{
+	float* dst = out.p1[0];
+	const float* srcA = a.p1[0];
+	const float* srcB = b.p1[0];
+
+#if defined(USE_INTRINSICS_SSE)
+
+	const __m128i vector_int_bits = _mm_set_epi32( 1 << 3, 1 << 2, 1 << 1, 1 << 0 );
+	const __m128 vector_mask = __m128c( _mm_cmpeq_epi32( _mm_and_si128( _mm_set1_epi32( mask ), vector_int_bits ), vector_int_bits ) );
+
+	for( int i = 0; i < CM_RAY_PACKET_ROWS; i++ )
+	{
+		const __m128 va = _mm_load_ps( srcA + i * CM_RAY_PACKET_SIZE );
+		const __m128 vb = _mm_load_ps( srcB + i * CM_RAY_PACKET_SIZE );
+		_mm_store_ps( dst + i * CM_RAY_PACKET_SIZE, _mm_sel_ps( vb, va, vector_mask ) );
+	}
+
+#else
+
+	for( int i = 0; i < CM_RAY_PACKET_ROWS; i++ )
+	{
+		for( int j = 0; j < CM_RAY_PACKET_SIZE; j++ )
+		{
+			const int k = i * CM_RAY_PACKET_SIZE + j;
+			dst[k] = ( mask & ( 1 << j ) ) ? srcA[k] : srcB[k];
+		}
+	}
+
+#endif
+}
+
+/*
+================
+CM_SplitPacket
+
+  classifies the rays against an axial plane and calculates for every ray the
+  segment up to the plane and the segment past the plane, the same way
+  TraceThroughAxialBSPTree_r does for a single trace
+================
+*/
+static void CM_SplitPacket( const cm_rayPacket_t& packet, const int planeType, const float planeDist, const float offset,
+							int& frontMask, int& backMask, int& side1Mask, cm_rayPacket_t& nearPacket, cm_rayPacket_t& farPacket )
+{
+#if defined(USE_INTRINSICS_SSE)
+
+	const __m128 vector_float_zero = _mm_setzero_ps();
+	const __m128 vector_float_one = _mm_set1_ps( 1.0f );
+	const __m128 vector_float_offset = _mm_set1_ps( offset );
+	const __m128 vector_float_neg_offset = _mm_set1_ps( -offset );
+	const __m128 vector_float_dist = _mm_set1_ps( planeDist );
+
+	// distance from plane for trace start and end
+	const __m128 t1 = _mm_sub_ps( _mm_load_ps( packet.p1[planeType] ), vector_float_dist );
+	const __m128 t2 = _mm_sub_ps( _mm_load_ps( packet.p2[planeType] ), vector_float_dist );
+
+	// see which sides we need to consider
+	frontMask = _mm_movemask_ps( _mm_and_ps( _mm_cmpge_ps( t1, vector_float_offset ), _mm_cmpge_ps( t2, vector_float_offset ) ) );
+	backMask = _mm_movemask_ps( _mm_and_ps( _mm_cmplt_ps( t1, vector_float_neg_offset ), _mm_cmplt_ps( t2, vector_float_neg_offset ) ) );
+
+	const __m128 side1 = _mm_cmplt_ps( t1, t2 );
+	const __m128 equal = _mm_cmpeq_ps( t1, t2 );
+	side1Mask = _mm_movemask_ps( side1 );
+
+	const __m128 idist = _mm_div_ps( vector_float_one, _mm_sub_ps( t1, t2 ) );
+	const __m128 s = _mm_sel_ps( vector_float_offset, vector_float_neg_offset, side1 );
+	__m128 frac = _mm_mul_ps( _mm_add_ps( t1, s ), idist );
+	__m128 frac2 = _mm_mul_ps( _mm_sub_ps( t1, s ), idist );
+	frac = _mm_sel_ps( frac, vector_float_one, equal );
+	frac2 = _mm_sel_ps( frac2, vector_float_zero, equal );
+
+	// move up to the node and go past the node
+	frac = _mm_min_ps( _mm_max_ps( frac, vector_float_zero ), vector_float_one );
+	frac2 = _mm_min_ps( _mm_max_ps( frac2, vector_float_zero ), vector_float_one );
+
+	const __m128 p1f = _mm_load_ps( packet.p1f );
+	const __m128 p2f = _mm_load_ps( packet.p2f );
+	const __m128 df = _mm_sub_ps( p2f, p1f );
+
+	_mm_store_ps( nearPacket.p1f, p1f );
+	_mm_store_ps( nearPacket.p2f, _mm_add_ps( p1f, _mm_mul_ps( df, frac ) ) );
+	_mm_store_ps( farPacket.p1f, _mm_add_ps( p1f, _mm_mul_ps( df, frac2 ) ) );
+	_mm_store_ps( farPacket.p2f, p2f );
+
+	for( int i = 0; i < 3; i++ )
+	{
+		const __m128 p1 = _mm_load_ps( packet.p1[i] );
+		const __m128 p2 = _mm_load_ps( packet.p2[i] );
+		const __m128 d = _mm_sub_ps( p2, p1 );
+
+		_mm_store_ps( nearPacket.p1[i], p1 );
+		_mm_store_ps( nearPacket.p2[i], _mm_add_ps( p1, _mm_mul_ps( frac, d ) ) );
+		_mm_store_ps( farPacket.p1[i], _mm_add_ps( p1, _mm_mul_ps( frac2, d ) ) );
+		_mm_store_ps( farPacket.p2[i], p2 );
+	}
+
+#else
+
+	frontMask = backMask = side1Mask = 0;
+
+	for( int j = 0; j < CM_RAY_PACKET_SIZE; j++ )
+	{
+		float frac, frac2, idist;
+
+		// distance from plane for trace start and end
+		const float t1 = packet.p1[planeType][j] - planeDist;
+		const float t2 = packet.p2[planeType][j] - planeDist;
+
+		// see which sides we need to consider
+		if( t1 >= offset && t2 >= offset )
+		{
+			frontMask |= 1 << j;
+		}
+		if( t1 < -offset && t2 < -offset )
+		{
+			backMask |= 1 << j;
+		}
+
+		if( t1 < t2 )
+		{
+			idist = 1.0f / ( t1 - t2 );
+			side1Mask |= 1 << j;
+			frac2 = ( t1 + offset ) * idist;
+			frac = ( t1 - offset ) * idist;
+		}
+		else if( t1 > t2 )
+		{
+			idist = 1.0f / ( t1 - t2 );
+			frac2 = ( t1 - offset ) * idist;
+			frac = ( t1 + offset ) * idist;
+		}
+		else
+		{
+			frac = 1.0f;
+			frac2 = 0.0f;
+		}
+
+		// move up to the node and go past the node
+		frac = idMath::ClampFloat( 0.0f, 1.0f, frac );
+		frac2 = idMath::ClampFloat( 0.0f, 1.0f, frac2 );
+
+		const float p1f = packet.p1f[j];
+		const float p2f = packet.p2f[j];
+
+		nearPacket.p1f[j] = p1f;
+		nearPacket.p2f[j] = p1f + ( p2f - p1f ) * frac;
+		farPacket.p1f[j] = p1f + ( p2f - p1f ) * frac2;
+		farPacket.p2f[j] = p2f;
+
+		for( int i = 0; i < 3; i++ )
+		{
+			const float p1 = packet.p1[i][j];
+			const float p2 = packet.p2[i][j];
+
+			nearPacket.p1[i][j] = p1;
+			nearPacket.p2[i][j] = p1 + frac * ( p2 - p1 );
+			farPacket.p1[i][j] = p1 + frac2 * ( p2 - p1 );
+			farPacket.p2[i][j] = p2;
+		}
+	}
+
+#endif
+}
+
+/*
+================
+idCollisionModelManagerLocal::TracePacketThroughAxialBSPTree_r
+
+  every ray visits the nodes in the same order as it would when traced alone
+================
+*/
+void idCollisionModelManagerLocal::TracePacketThroughAxialBSPTree_r( cm_traceWork_t* packetWork, int activeMask, cm_node_t* node, const cm_rayPacket_t& packet )
+{
+	if( !node )
+	{
+		return;
+	}
+
+	for( int i = 0; i < CM_RAY_PACKET_SIZE; i++ )
+	{
+		if( !( activeMask & ( 1 << i ) ) )
+		{
+			continue;
+		}
+		// stop immediately or already hit something nearer
+		if( packetWork[i].quickExit || packetWork[i].trace.fraction <= packet.p1f[i] )
+		{
+			activeMask &= ~( 1 << i );
+		}
+	}
+
+	if( !activeMask )
+	{
+		return;
+	}
+
+	// if we need to test this node for collisions
+	if( node->polygons )
+	{
+		for( int i = 0; i < CM_RAY_PACKET_SIZE; i++ )
+		{
+			if( activeMask & ( 1 << i ) )
+			{
+				// trace through node with collision data
+				idCollisionModelManagerLocal::TraceTrmThroughNode( &packetWork[i], node );
+			}
+		}
+	}
+	// if this is a leaf node
+	if( node->planeType == -1 )
+	{
+		return;
+	}
+
+	int frontMask, backMask, side1Mask;
+	ALIGN16( cm_rayPacket_t nearPacket );
+	ALIGN16( cm_rayPacket_t farPacket );
+
+	// all point traces use the same extents
+	CM_SplitPacket( packet, node->planeType, node->planeDist, CM_BOX_EPSILON, frontMask, backMask, side1Mask, nearPacket, farPacket );
+
+	frontMask &= activeMask;
+	backMask &= activeMask & ~frontMask;
+	const int splitMask = activeMask & ~( frontMask | backMask );
+
+	if( !splitMask )
+	{
+		if( frontMask )
+		{
+			idCollisionModelManagerLocal::TracePacketThroughAxialBSPTree_r( packetWork, frontMask, node->children[0], packet );
+		}
+		if( backMask )
+		{
+			idCollisionModelManagerLocal::TracePacketThroughAxialBSPTree_r( packetWork, backMask, node->children[1], packet );
+		}
+		return;
+	}
+
+	// the side the first split ray starts on is visited first, split rays starting on the
+	// other side go through that side again afterwards so each ray keeps its own near to far order
+	const int firstSide = ( side1Mask & ( splitMask & -splitMask ) ) ? 1 : 0;
+	const int splitFirstMask = splitMask & ( firstSide ? side1Mask : ~side1Mask );
+	const int splitOtherMask = splitMask & ~splitFirstMask;
+	const int firstMask = firstSide ? backMask : frontMask;
+	const int otherMask = firstSide ? frontMask : backMask;
+
+	ALIGN16( cm_rayPacket_t childPacket );
+
+	CM_SelectPacket( childPacket, splitFirstMask, nearPacket, packet );
+	idCollisionModelManagerLocal::TracePacketThroughAxialBSPTree_r( packetWork, firstMask | splitFirstMask, node->children[firstSide], childPacket );
+
+	CM_SelectPacket( childPacket, splitOtherMask, nearPacket, packet );
+	CM_SelectPacket( childPacket, splitFirstMask, farPacket, childPacket );
+	idCollisionModelManagerLocal::TracePacketThroughAxialBSPTree_r( packetWork, otherMask | splitMask, node->children[firstSide ^ 1], childPacket );
+
+	if( splitOtherMask )
+	{
+		idCollisionModelManagerLocal::TracePacketThroughAxialBSPTree_r( packetWork, splitOtherMask, node->children[firstSide], farPacket );
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::SetupPointTrace
+================
+*/
+void idCollisionModelManagerLocal::SetupPointTrace( cm_traceWork_t* tw, const idVec3& start, const idVec3& end, int contentMask,
+		cm_model_t* model, const idVec3& modelOrigin, const idMat3& modelAxis, bool modelRotated )
+{
+	tw->trace.fraction = 1.0f;
+	tw->trace.c.contents = 0;
+	tw->trace.c.type = CONTACT_NONE;
+	tw->trace.c.material = NULL;
+	tw->trace.c.id = 0;
+	tw->contents = contentMask;
+	tw->isConvex = true;
+	tw->rotation = false;
+	tw->positionTest = false;
+	tw->quickExit = false;
+	tw->getContacts = false;
+	tw->contacts = NULL;
+	tw->maxContacts = 0;
+	tw->numContacts = 0;
+	tw->model = model;
+	tw->start = start - modelOrigin;
+	tw->end = end - modelOrigin;
+	tw->dir = end - start;
+
+	if( modelRotated )
+	{
+		// rotate trace instead of model
+		const idMat3 invModelAxis = modelAxis.Transpose();
+		tw->start *= invModelAxis;
+		tw->end *= invModelAxis;
+		tw->dir *= invModelAxis;
+	}
+
+	// trace bounds
+	for( int i = 0; i < 3; i++ )
+	{
+		if( tw->start[i] < tw->end[i] )
+		{
+			tw->bounds[0][i] = tw->start[i] - CM_BOX_EPSILON;
+			tw->bounds[1][i] = tw->end[i] + CM_BOX_EPSILON;
+		}
+		else
+		{
+			tw->bounds[0][i] = tw->end[i] - CM_BOX_EPSILON;
+			tw->bounds[1][i] = tw->start[i] + CM_BOX_EPSILON;
+		}
+	}
+	tw->extents[0] = tw->extents[1] = tw->extents[2] = CM_BOX_EPSILON;
+	tw->size.Zero();
+
+	// setup trace heart planes
+	idCollisionModelManagerLocal::SetupTranslationHeartPlanes( tw );
+	tw->maxDistFromHeartPlane1 = CM_BOX_EPSILON;
+	tw->maxDistFromHeartPlane2 = CM_BOX_EPSILON;
+	// collision with single point
+	tw->numVerts = 1;
+	tw->vertices[0].p = tw->start;
+	tw->vertices[0].endp = tw->vertices[0].p + tw->dir;
+	tw->vertices[0].pl.FromRay( tw->vertices[0].p, tw->dir );
+	tw->numEdges = tw->numPolys = 0;
+	tw->pointTrace = true;
+}
+
+/*
+================
+idCollisionModelManagerLocal::TracePoints
+================
+*/
+void idCollisionModelManagerLocal::TracePoints( trace_t* results, const idVec3* starts, const idVec3* ends, const int numPoints, int contentMask,
+		cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis )
+{
+	if( numPoints <= 0 )
+	{
+		return;
+	}
+
+	memset( results, 0, numPoints * sizeof( results[0] ) );
+
+	if( model < 0 || model > MAX_SUBMODELS || model > idCollisionModelManagerLocal::maxModels )
+	{
+		common->Printf( "idCollisionModelManagerLocal::TracePoints: invalid model handle\n" );
+		return;
+	}
+	if( !idCollisionModelManagerLocal::models[model] )
+	{
+		common->Printf( "idCollisionModelManagerLocal::TracePoints: invalid model\n" );
+		return;
+	}
+
+	cm_queryContext_t* context = idCollisionModelManagerLocal::GetQueryContext();
+	if( !context->packetWork )
+	{
+		context->packetWork = new( TAG_COLLISION ) cm_traceWork_t[CM_RAY_PACKET_SIZE];
+	}
+	cm_traceWork_t* packetWork = context->packetWork;
+
+	cm_model_t* cmodel = idCollisionModelManagerLocal::models[model];
+	const bool modelRotated = modelAxis.IsRotated();
+
+	int rayNums[CM_RAY_PACKET_SIZE];
+	int numRays = 0;
+
+	for( int n = 0; n < numPoints; n++ )
+	{
+		const idVec3& start = starts[n];
+		const idVec3& end = ends[n];
+
+		// position tests are not traced through the tree
+		if( start[0] == end[0] && start[1] == end[1] && start[2] == end[2] )
+		{
+			idCollisionModelManagerLocal::Translation( &results[n], start, end, NULL, mat3_identity, contentMask, model, modelOrigin, modelAxis );
+		}
+		else
+		{
+			rayNums[numRays++] = n;
+		}
+
+		if( numRays < CM_RAY_PACKET_SIZE && n < numPoints - 1 )
+		{
+			continue;
+		}
+		if( !numRays )
+		{
+			continue;
+		}
+
+		// trace the packet through the model
+		ALIGN16( cm_rayPacket_t packet );
+		memset( &packet, 0, sizeof( packet ) );
+
+		for( int i = 0; i < numRays; i++ )
+		{
+			cm_traceWork_t* tw = &packetWork[i];
+			idCollisionModelManagerLocal::SetupPointTrace( tw, starts[rayNums[i]], ends[rayNums[i]], contentMask, cmodel, modelOrigin, modelAxis, modelRotated );
+			// every ray is a query of its own
+			idCollisionModelManagerLocal::SetupQueryChecks( tw, context );
+
+			for( int j = 0; j < 3; j++ )
+			{
+				packet.p1[j][i] = tw->start[j];
+				packet.p2[j][i] = tw->end[j];
+			}
+			packet.p1f[i] = 0.0f;
+			packet.p2f[i] = 1.0f;
+		}
+
+		idCollisionModelManagerLocal::TracePacketThroughAxialBSPTree_r( packetWork, ( 1 << numRays ) - 1, cmodel->node, packet );
+
+		// store results
+		for( int i = 0; i < numRays; i++ )
+		{
+			trace_t* result = &results[rayNums[i]];
+
+			*result = packetWork[i].trace;
+			result->endpos = starts[rayNums[i]] + result->fraction * ( ends[rayNums[i]] - starts[rayNums[i]] );
+			result->endAxis = mat3_identity;
+
+			if( result->fraction < 1.0f )
+			{
+				// rotate trace plane normal if there was a collision with a rotated model
+				if( modelRotated )
+				{
+					result->c.normal *= modelAxis;
+					result->c.point *= modelAxis;
+				}
+				result->c.point += modelOrigin;
+				result->c.dist += modelOrigin * result->c.normal;
+			}
+		}
+		numRays = 0;
+	}
+}
@@ -554,7 +554,7 @@ void idCollisionModelManagerLocal::RotateTrmEdgeThroughPolygon( cm_traceWork_t*
 		edge = tw->model->edges + abs( edgeNum );
 
 		// if this edge is already checked
-		if( edge->checkcount == idCollisionModelManagerLocal::checkCount )
+		if( tw->edgeChecks[abs( edgeNum )].checkcount == tw->checkCount )
 		{
 			continue;
 		}
@@ -1190,14 +1190,15 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon( cm_traceWork_t* tw,
 	cm_trmPolygon_t* bp;
 	cm_vertex_t* v;
 	cm_edge_t* e;
+	cm_sideCheck_t* vCheck, *eCheck;
 	idVec3* rotationOrigin;
 
 	// if already checked this polygon
-	if( p->checkcount == idCollisionModelManagerLocal::checkCount )
+	if( tw->polygonChecks[p->checkNum] == tw->checkCount )
 	{
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
+	tw->polygonChecks[p->checkNum] = tw->checkCount;
 
 	// if this polygon does not have the right contents behind it
 	if( !( p->contents & tw->contents ) )
@@ -1310,13 +1311,14 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon( cm_traceWork_t* tw,
 		{
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs( edgeNum );
+			eCheck = tw->edgeChecks + abs( edgeNum );
 
-			if( e->checkcount == idCollisionModelManagerLocal::checkCount )
+			if( eCheck->checkcount == tw->checkCount )
 			{
 				continue;
 			}
 			// set edge check count
-			e->checkcount = idCollisionModelManagerLocal::checkCount;
+			eCheck->checkcount = tw->checkCount;
 			// can never collide with internal edges
 			if( e->internal )
 			{
@@ -1327,14 +1329,15 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon( cm_traceWork_t* tw,
 			{
 
 				v = tw->model->vertices + e->vertexNum[k ^ INT32_SIGNBITSET( edgeNum )];
+				vCheck = tw->vertexChecks + e->vertexNum[k ^ INT32_SIGNBITSET( edgeNum )];
 
 				// if this vertex is already checked
-				if( v->checkcount == idCollisionModelManagerLocal::checkCount )
+				if( vCheck->checkcount == tw->checkCount )
 				{
 					continue;
 				}
 				// set vertex check count
-				v->checkcount = idCollisionModelManagerLocal::checkCount;
+				vCheck->checkcount = tw->checkCount;
 
 				// if the vertex is outside the trm rotation bounds
 				if( !tw->bounds.ContainsPoint( v->p ) )
@@ -1428,7 +1431,7 @@ void idCollisionModelManagerLocal::Rotation180( trace_t* results, const idVec3&
 	cm_trmPolygon_t* poly;
 	cm_trmEdge_t* edge;
 	cm_trmVertex_t* vert;
-	ALIGN16( static cm_traceWork_t tw );
+	ALIGN16( cm_traceWork_t tw );
 
 	if( model < 0 || model > MAX_SUBMODELS || model > idCollisionModelManagerLocal::maxModels )
 	{
@@ -1441,11 +1444,11 @@ void idCollisionModelManagerLocal::Rotation180( trace_t* results, const idVec3&
 		return;
 	}
 
-	idCollisionModelManagerLocal::checkCount++;
-
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
 	tw.trace.c.type = CONTACT_NONE;
+	tw.trace.c.material = NULL;
+	tw.trace.c.id = 0;
 	tw.contents = contentMask;
 	tw.isConvex = true;
 	tw.rotation = true;
@@ -1455,7 +1458,10 @@ void idCollisionModelManagerLocal::Rotation180( trace_t* results, const idVec3&
 	tw.angle = endAngle - startAngle;
 	assert( tw.angle > -180.0f && tw.angle < 180.0f );
 	tw.maxTan = initialTan = idMath::Fabs( tan( ( idMath::PI / 360.0f ) * tw.angle ) );
+	tw.getContacts = false;
+	tw.numContacts = 0;
 	tw.model = idCollisionModelManagerLocal::models[model];
+	idCollisionModelManagerLocal::SetupQueryChecks( &tw, idCollisionModelManagerLocal::GetQueryContext() );
 	tw.start = start - modelOrigin;
 	// rotation axis, axis is assumed to be normalized
 	tw.axis = axis;
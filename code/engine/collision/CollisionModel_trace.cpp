@@ -42,6 +42,119 @@ If you have questions concerning this license or the applicable additional terms
 /*
 ===============================================================================
 
+Query contexts
+
+===============================================================================
+*/
+
+static ID_TLS cm_threadQueryContext;
+
+/*
+================
+idCollisionModelManagerLocal::GetQueryContext
+
+  returns the query context of the calling thread, contexts live until shutdown
+================
+*/
+cm_queryContext_t* idCollisionModelManagerLocal::GetQueryContext()
+{
+	cm_queryContext_t* context = ( cm_queryContext_t* )( ptrdiff_t )cm_threadQueryContext;
+	if( context )
+	{
+		return context;
+	}
+
+	context = new( TAG_COLLISION ) cm_queryContext_t;
+	context->checkCount = 0;
+	context->getContacts = false;
+	context->contacts = NULL;
+	context->maxContacts = 0;
+	context->numContacts = 0;
+	context->packetWork = NULL;
+
+	queryContextMutex.Lock();
+	queryContexts.Append( context );
+	queryContextMutex.Unlock();
+
+	cm_threadQueryContext = ( ptrdiff_t )context;
+	return context;
+}
+
+/*
+================
+CM_GrowCheckTable
+================
+*/
+template< typename type >
+static ID_INLINE void CM_GrowCheckTable( idList<type, TAG_COLLISION>& table, int num )
+{
+	if( table.Num() < num )
+	{
+		const int oldNum = table.Num();
+		table.SetNum( num );
+		memset( table.Ptr() + oldNum, 0, ( num - oldNum ) * sizeof( type ) );
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::SetupQueryChecks
+
+  starts a new query for tw->model in the given context
+================
+*/
+void idCollisionModelManagerLocal::SetupQueryChecks( cm_traceWork_t* tw, cm_queryContext_t* context )
+{
+	const cm_model_t* model = tw->model;
+
+	CM_GrowCheckTable( context->vertexChecks, model->maxVertices );
+	CM_GrowCheckTable( context->edgeChecks, model->maxEdges );
+	CM_GrowCheckTable( context->polygonChecks, model->numPolygonChecks );
+	CM_GrowCheckTable( context->brushChecks, model->numBrushChecks );
+
+	// start over before the check count wraps around
+	if( context->checkCount == INT_MAX )
+	{
+		memset( context->vertexChecks.Ptr(), 0, context->vertexChecks.Num() * sizeof( cm_sideCheck_t ) );
+		memset( context->edgeChecks.Ptr(), 0, context->edgeChecks.Num() * sizeof( cm_sideCheck_t ) );
+		memset( context->polygonChecks.Ptr(), 0, context->polygonChecks.Num() * sizeof( int ) );
+		memset( context->brushChecks.Ptr(), 0, context->brushChecks.Num() * sizeof( int ) );
+		context->checkCount = 0;
+	}
+	context->checkCount++;
+
+	tw->checkCount = context->checkCount;
+	tw->vertexChecks = context->vertexChecks.Ptr();
+	tw->edgeChecks = context->edgeChecks.Ptr();
+	tw->polygonChecks = context->polygonChecks.Ptr();
+	tw->brushChecks = context->brushChecks.Ptr();
+}
+
+/*
+================
+idCollisionModelManagerLocal::ClearQueryContexts
+
+  frees the check tables, no queries may run while the map is freed
+================
+*/
+void idCollisionModelManagerLocal::ClearQueryContexts()
+{
+	queryContextMutex.Lock();
+	for( int i = 0; i < queryContexts.Num(); i++ )
+	{
+		cm_queryContext_t* context = queryContexts[i];
+		context->checkCount = 0;
+		context->vertexChecks.Clear();
+		context->edgeChecks.Clear();
+		context->polygonChecks.Clear();
+		context->brushChecks.Clear();
+	}
+	queryContextMutex.Unlock();
+}
+
+/*
+===============================================================================
+
 Trace through the spatial subdivision
 
 ===============================================================================
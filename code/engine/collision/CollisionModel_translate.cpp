@@ -205,7 +205,7 @@ CM_SetVertexSidedness
   stores for the given model vertex at which side of one of the trm edges it passes
 ================
 */
-ID_INLINE void CM_SetVertexSidedness( cm_vertex_t* v, const idPluecker& vpl, const idPluecker& epl, const int bitNum )
+ID_INLINE void CM_SetVertexSidedness( cm_sideCheck_t* v, const idPluecker& vpl, const idPluecker& epl, const int bitNum )
 {
 	const int mask = 1 << bitNum;
 	if( ( v->sideSet & mask ) == 0 )
@@ -223,7 +223,7 @@ CM_SetEdgeSidedness
   stores for the given model edge at which side one of the trm vertices
 ================
 */
-ID_INLINE void CM_SetEdgeSidedness( cm_edge_t* edge, const idPluecker& vpl, const idPluecker& epl, const int bitNum )
+ID_INLINE void CM_SetEdgeSidedness( cm_sideCheck_t* edge, const idPluecker& vpl, const idPluecker& epl, const int bitNum )
 {
 	const int mask = 1 << bitNum;
 	if( ( edge->sideSet & mask ) == 0 )
@@ -245,7 +245,7 @@ void idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon( cm_traceWork_
 	float f1, f2, dist, d1, d2;
 	idVec3 start, end, normal;
 	cm_edge_t* edge;
-	cm_vertex_t* v1, *v2;
+	cm_sideCheck_t* edgeCheck, *v1, *v2;
 	idPluecker* pl, epsPl;
 
 	// check edges for a collision
@@ -253,8 +253,9 @@ void idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon( cm_traceWork_
 	{
 		edgeNum = poly->edges[i];
 		edge = tw->model->edges + abs( edgeNum );
+		edgeCheck = tw->edgeChecks + abs( edgeNum );
 		// if this edge is already checked
-		if( edge->checkcount == idCollisionModelManagerLocal::checkCount )
+		if( edgeCheck->checkcount == tw->checkCount )
 		{
 			continue;
 		}
@@ -265,17 +266,17 @@ void idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon( cm_traceWork_
 		}
 		pl = &tw->polygonEdgePlueckerCache[i];
 		// get the sides at which the trm edge vertices pass the polygon edge
-		CM_SetEdgeSidedness( edge, *pl, tw->vertices[trmEdge->vertexNum[0]].pl, trmEdge->vertexNum[0] );
-		CM_SetEdgeSidedness( edge, *pl, tw->vertices[trmEdge->vertexNum[1]].pl, trmEdge->vertexNum[1] );
+		CM_SetEdgeSidedness( edgeCheck, *pl, tw->vertices[trmEdge->vertexNum[0]].pl, trmEdge->vertexNum[0] );
+		CM_SetEdgeSidedness( edgeCheck, *pl, tw->vertices[trmEdge->vertexNum[1]].pl, trmEdge->vertexNum[1] );
 		// if the trm edge start and end vertex do not pass the polygon edge at different sides
-		if( !( ( ( edge->side >> trmEdge->vertexNum[0] ) ^ ( edge->side >> trmEdge->vertexNum[1] ) ) & 1 ) )
+		if( !( ( ( edgeCheck->side >> trmEdge->vertexNum[0] ) ^ ( edgeCheck->side >> trmEdge->vertexNum[1] ) ) & 1 ) )
 		{
 			continue;
 		}
 		// get the sides at which the polygon edge vertices pass the trm edge
-		v1 = tw->model->vertices + edge->vertexNum[INT32_SIGNBITSET( edgeNum )];
+		v1 = tw->vertexChecks + edge->vertexNum[INT32_SIGNBITSET( edgeNum )];
 		CM_SetVertexSidedness( v1, tw->polygonVertexPlueckerCache[i], trmEdge->pl, trmEdge->bitNum );
-		v2 = tw->model->vertices + edge->vertexNum[INT32_SIGNBITNOTSET( edgeNum )];
+		v2 = tw->vertexChecks + edge->vertexNum[INT32_SIGNBITNOTSET( edgeNum )];
 		CM_SetVertexSidedness( v2, tw->polygonVertexPlueckerCache[i + 1], trmEdge->pl, trmEdge->bitNum );
 		// if the polygon edge start and end vertex do not pass the trm edge at different sides
 		if( !( ( v1->side ^ v2->side ) & ( 1 << trmEdge->bitNum ) ) )
@@ -389,7 +390,7 @@ void idCollisionModelManagerLocal::TranslateTrmVertexThroughPolygon( cm_traceWor
 {
 	int i, edgeNum;
 	float f;
-	cm_edge_t* edge;
+	cm_sideCheck_t* edge;
 
 	f = CM_TranslationPlaneFraction( poly->plane, v->p, v->endp );
 	if( f < tw->trace.fraction )
@@ -398,7 +399,7 @@ void idCollisionModelManagerLocal::TranslateTrmVertexThroughPolygon( cm_traceWor
 		for( i = 0; i < poly->numEdges; i++ )
 		{
 			edgeNum = poly->edges[i];
-			edge = tw->model->edges + abs( edgeNum );
+			edge = tw->edgeChecks + abs( edgeNum );
 			CM_SetEdgeSidedness( edge, tw->polygonEdgePlueckerCache[i], v->pl, bitNum );
 			if( INT32_SIGNBITSET( edgeNum ) ^ ( ( edge->side >> bitNum ) & 1 ) )
 			{
@@ -439,6 +440,7 @@ void idCollisionModelManagerLocal::TranslatePointThroughPolygon( cm_traceWork_t*
 	int i, edgeNum;
 	float f;
 	cm_edge_t* edge;
+	cm_sideCheck_t* edgeCheck;
 	idPluecker pl;
 
 	f = CM_TranslationPlaneFraction( poly->plane, v->p, v->endp );
@@ -449,18 +451,19 @@ void idCollisionModelManagerLocal::TranslatePointThroughPolygon( cm_traceWork_t*
 		{
 			edgeNum = poly->edges[i];
 			edge = tw->model->edges + abs( edgeNum );
+			edgeCheck = tw->edgeChecks + abs( edgeNum );
 			// if we didn't yet calculate the sidedness for this edge
-			if( edge->checkcount != idCollisionModelManagerLocal::checkCount )
+			if( edgeCheck->checkcount != tw->checkCount )
 			{
 				float fl;
-				edge->checkcount = idCollisionModelManagerLocal::checkCount;
+				edgeCheck->checkcount = tw->checkCount;
 				pl.FromLine( tw->model->vertices[edge->vertexNum[0]].p, tw->model->vertices[edge->vertexNum[1]].p );
 				fl = v->pl.PermutedInnerProduct( pl );
-				edge->side = ( fl < 0.0f );
+				edgeCheck->side = ( fl < 0.0f );
 			}
 			// if the point passes the edge at the wrong side
 			//if ( (edgeNum > 0) == edge->side ) {
-			if( INT32_SIGNBITSET( edgeNum ) ^ edge->side )
+			if( INT32_SIGNBITSET( edgeNum ) ^ edgeCheck->side )
 			{
 				return;
 			}
@@ -499,18 +502,20 @@ void idCollisionModelManagerLocal::TranslateVertexThroughTrmPolygon( cm_traceWor
 	int i, edgeNum;
 	float f;
 	cm_trmEdge_t* edge;
+	cm_sideCheck_t* vertexCheck;
 
 	f = CM_TranslationPlaneFraction( trmpoly->plane, v->p, endp );
 	if( f < tw->trace.fraction )
 	{
+		vertexCheck = tw->vertexChecks + ( v - tw->model->vertices );
 
 		for( i = 0; i < trmpoly->numEdges; i++ )
 		{
 			edgeNum = trmpoly->edges[i];
 			edge = tw->edges + abs( edgeNum );
 
-			CM_SetVertexSidedness( v, pl, edge->pl, edge->bitNum );
-			if( INT32_SIGNBITSET( edgeNum ) ^ ( ( v->side >> edge->bitNum ) & 1 ) )
+			CM_SetVertexSidedness( vertexCheck, pl, edge->pl, edge->bitNum );
+			if( INT32_SIGNBITSET( edgeNum ) ^ ( ( vertexCheck->side >> edge->bitNum ) & 1 ) )
 			{
 				return;
 			}
@@ -555,13 +560,14 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t* t
 	cm_trmPolygon_t* bp;
 	cm_vertex_t* v;
 	cm_edge_t* e;
+	cm_sideCheck_t* vCheck, *eCheck;
 
 	// if already checked this polygon
-	if( p->checkcount == idCollisionModelManagerLocal::checkCount )
+	if( tw->polygonChecks[p->checkNum] == tw->checkCount )
 	{
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
+	tw->polygonChecks[p->checkNum] = tw->checkCount;
 
 	// if this polygon does not have the right contents behind it
 	if( !( p->contents & tw->contents ) )
@@ -624,20 +630,22 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t* t
 		{
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs( edgeNum );
+			eCheck = tw->edgeChecks + abs( edgeNum );
 			// reset sidedness cache if this is the first time we encounter this edge during this trace
-			if( e->checkcount != idCollisionModelManagerLocal::checkCount )
+			if( eCheck->checkcount != tw->checkCount )
 			{
-				e->sideSet = 0;
+				eCheck->sideSet = 0;
 			}
 			// pluecker coordinate for edge
 			tw->polygonEdgePlueckerCache[i].FromLine( tw->model->vertices[e->vertexNum[0]].p,
 					tw->model->vertices[e->vertexNum[1]].p );
 
 			v = &tw->model->vertices[e->vertexNum[INT32_SIGNBITSET( edgeNum )]];
+			vCheck = tw->vertexChecks + e->vertexNum[INT32_SIGNBITSET( edgeNum )];
 			// reset sidedness cache if this is the first time we encounter this vertex during this trace
-			if( v->checkcount != idCollisionModelManagerLocal::checkCount )
+			if( vCheck->checkcount != tw->checkCount )
 			{
-				v->sideSet = 0;
+				vCheck->sideSet = 0;
 			}
 			// pluecker coordinate for vertex movement vector
 			tw->polygonVertexPlueckerCache[i].FromRay( v->p, -tw->dir );
@@ -670,13 +678,14 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t* t
 		{
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs( edgeNum );
+			eCheck = tw->edgeChecks + abs( edgeNum );
 
-			if( e->checkcount == idCollisionModelManagerLocal::checkCount )
+			if( eCheck->checkcount == tw->checkCount )
 			{
 				continue;
 			}
 			// set edge check count
-			e->checkcount = idCollisionModelManagerLocal::checkCount;
+			eCheck->checkcount = tw->checkCount;
 			// can never collide with internal edges
 			if( e->internal )
 			{
@@ -687,13 +696,14 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t* t
 			{
 
 				v = tw->model->vertices + e->vertexNum[k ^ INT32_SIGNBITSET( edgeNum )];
+				vCheck = tw->vertexChecks + e->vertexNum[k ^ INT32_SIGNBITSET( edgeNum )];
 				// if this vertex is already checked
-				if( v->checkcount == idCollisionModelManagerLocal::checkCount )
+				if( vCheck->checkcount == tw->checkCount )
 				{
 					continue;
 				}
 				// set vertex check count
-				v->checkcount = idCollisionModelManagerLocal::checkCount;
+				vCheck->checkcount = tw->checkCount;
 
 				// if the vertex is outside the trace bounds
 				if( !tw->bounds.ContainsPoint( v->p ) )
@@ -823,7 +833,7 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 	cm_trmPolygon_t* poly;
 	cm_trmEdge_t* edge;
 	cm_trmVertex_t* vert;
-	ALIGN16( static cm_traceWork_t tw );
+	ALIGN16( cm_traceWork_t tw );
 
 	assert( ( ( byte* )&start ) < ( ( byte* )results ) || ( ( byte* )&start ) >= ( ( ( byte* )results ) + sizeof( trace_t ) ) );
 	assert( ( ( byte* )&end ) < ( ( byte* )results ) || ( ( byte* )&end ) >= ( ( ( byte* )results ) + sizeof( trace_t ) ) );
@@ -849,12 +859,14 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 		return;
 	}
 
+	cm_queryContext_t* context = idCollisionModelManagerLocal::GetQueryContext();
+
 #ifdef _DEBUG
 	bool startsolid = false;
 	// test whether or not stuck to begin with
 	if( cm_debugCollision.GetBool() )
 	{
-		if( !entered && !idCollisionModelManagerLocal::getContacts )
+		if( !entered && !context->getContacts )
 		{
 			entered = 1;
 			// if already messed up to begin with
@@ -867,8 +879,6 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 	}
 #endif
 
-	idCollisionModelManagerLocal::checkCount++;
-
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
 	tw.trace.c.type = CONTACT_NONE;
@@ -879,11 +889,12 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 	tw.rotation = false;
 	tw.positionTest = false;
 	tw.quickExit = false;
-	tw.getContacts = idCollisionModelManagerLocal::getContacts;
-	tw.contacts = idCollisionModelManagerLocal::contacts;
-	tw.maxContacts = idCollisionModelManagerLocal::maxContacts;
+	tw.getContacts = context->getContacts;
+	tw.contacts = context->contacts;
+	tw.maxContacts = context->maxContacts;
 	tw.numContacts = 0;
 	tw.model = idCollisionModelManagerLocal::models[model];
+	idCollisionModelManagerLocal::SetupQueryChecks( &tw, context );
 	tw.start = start - modelOrigin;
 	tw.end = end - modelOrigin;
 	tw.dir = end - start;
@@ -954,7 +965,7 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 			results->c.point += modelOrigin;
 			results->c.dist += modelOrigin * results->c.normal;
 		}
-		idCollisionModelManagerLocal::numContacts = tw.numContacts;
+		context->numContacts = tw.numContacts;
 		return;
 	}
 
@@ -1185,7 +1196,7 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 				tw.contacts[i].dist += modelOrigin * tw.contacts[i].normal;
 			}
 		}
-		idCollisionModelManagerLocal::numContacts = tw.numContacts;
+		context->numContacts = tw.numContacts;
 	}
 	else
 	{
@@ -1216,7 +1227,7 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 	// test for missed collisions
 	if( cm_debugCollision.GetBool() )
 	{
-		if( !entered && !idCollisionModelManagerLocal::getContacts )
+		if( !entered && !context->getContacts )
 		{
 			entered = 1;
 			// if the trm is stuck in the model
@@ -145,6 +145,7 @@ private:
 	idDecl* 					self;
 
 	idStr						name;					// name of the decl
+	idName						nameId;					// interned canonical name, used for lookups
 	char* 						textSource;				// decl text definition
 	int							textLength;				// length of textSource
 	int							compressedLength;		// compressed length
@@ -238,6 +239,7 @@ public:
 public:
 	static void					MakeNameCanonical( const char* name, char* result, int maxLength );
 	idDeclLocal* 				FindTypeWithoutParsing( declType_t type, const char* name, bool makeDefault = true );
+	idDeclLocal* 				FindByCanonicalName( int typeIndex, const idName& canonicalName ) const;
 
 	idDeclType* 				GetDeclType( int type ) const
 	{
@@ -272,6 +274,7 @@ private:
 	static void					ListDecls_f( const idCmdArgs& args );
 	static void					ReloadDecls_f( const idCmdArgs& args );
 	static void					TouchDecl_f( const idCmdArgs& args );
+	static void					TestNameLookup_f( const idCmdArgs& args );
 	// RB begin
 	static void                 ExportEntityDefsToBlender_f( const idCmdArgs& args );
 	static void                 ExportMaterialsToBlender_f( const idCmdArgs& args );
@@ -941,6 +944,7 @@ void idDeclManagerLocal::Init()
 
 	cmdSystem->AddCommand( "reloadDecls", ReloadDecls_f, CMD_FL_SYSTEM, "reloads decls" );
 	cmdSystem->AddCommand( "touch", TouchDecl_f, CMD_FL_SYSTEM, "touches a decl" );
+	cmdSystem->AddCommand( "testNameLookup", TestNameLookup_f, CMD_FL_SYSTEM, "times the spawn arg and entityDef lookups of all entityDefs by string and by interned name" );
 
 	cmdSystem->AddCommand( "listTables", idListDecls_f<DECL_TABLE>, CMD_FL_SYSTEM, "lists tables", idCmdSystem::ArgCompletion_String<listDeclStrings> );
 	cmdSystem->AddCommand( "listMaterials", idListDecls_f<DECL_MATERIAL>, CMD_FL_SYSTEM, "lists materials", idCmdSystem::ArgCompletion_String<listDeclStrings> );
@@ -1622,7 +1626,7 @@ idDeclManagerLocal::CreateNewDecl
 idDecl* idDeclManagerLocal::CreateNewDecl( declType_t type, const char* name, const char* _fileName )
 {
 	int typeIndex = ( int )type;
-	int i, hash;
+	int i;
 
 	if( typeIndex < 0 || typeIndex >= declTypes.Num() || declTypes[typeIndex] == NULL || typeIndex >= DECL_MAX_TYPES )
 	{
@@ -1638,14 +1642,12 @@ idDecl* idDeclManagerLocal::CreateNewDecl( declType_t type, const char* name, co
 	fileName.BackSlashesToSlashes();
 
 	// see if it already exists
-	hash = hashTables[typeIndex].GenerateKey( canonicalName, false );
-	for( i = hashTables[typeIndex].First( hash ); i >= 0; i = hashTables[typeIndex].Next( i ) )
+	const idName nameId( canonicalName );
+	idDeclLocal* existing = FindByCanonicalName( typeIndex, nameId );
+	if( existing != NULL )
 	{
-		if( linearLists[typeIndex][i]->name.Icmp( canonicalName ) == 0 )
-		{
-			linearLists[typeIndex][i]->AllocateSelf();
-			return linearLists[typeIndex][i]->self;
-		}
+		existing->AllocateSelf();
+		return existing->self;
 	}
 
 	idDeclFile* sourceFile;
@@ -1670,6 +1672,7 @@ idDecl* idDeclManagerLocal::CreateNewDecl( declType_t type, const char* name, co
 
 	idDeclLocal* decl = new( TAG_DECL ) idDeclLocal;
 	decl->name = canonicalName;
+	decl->nameId = nameId;
 	decl->type = type;
 	decl->declState = DS_UNPARSED;
 	decl->AllocateSelf();
@@ -1700,7 +1703,7 @@ idDecl* idDeclManagerLocal::CreateNewDecl( declType_t type, const char* name, co
 
 	// add it to the hash table and linear list
 	decl->index = linearLists[typeIndex].Num();
-	hashTables[typeIndex].Add( hash, linearLists[typeIndex].Append( decl ) );
+	hashTables[typeIndex].Add( hashTables[typeIndex].GenerateKey( nameId.GetHash() ), linearLists[typeIndex].Append( decl ) );
 
 	return decl->self;
 }
@@ -1723,20 +1726,12 @@ bool idDeclManagerLocal::RenameDecl( declType_t type, const char* oldName, const
 
 	// make sure it already exists
 	int typeIndex = ( int )type;
-	int i, hash;
-	hash = hashTables[typeIndex].GenerateKey( canonicalOldName, false );
-	for( i = hashTables[typeIndex].First( hash ); i >= 0; i = hashTables[typeIndex].Next( i ) )
-	{
-		if( linearLists[typeIndex][i]->name.Icmp( canonicalOldName ) == 0 )
-		{
-			decl = linearLists[typeIndex][i];
-			break;
-		}
-	}
+	decl = FindByCanonicalName( typeIndex, idName::Find( canonicalOldName ) );
 	if( !decl )
 	{
 		return false;
 	}
+	int hash = hashTables[typeIndex].GenerateKey( decl->nameId.GetHash() );
 
 	//if ( !hashTables[(int)type].Get( canonicalOldName, &declPtr ) )
 	//	return false;
@@ -1745,11 +1740,12 @@ bool idDeclManagerLocal::RenameDecl( declType_t type, const char* oldName, const
 
 	//Change the name
 	decl->name = canonicalNewName;
+	decl->nameId = idName( canonicalNewName );
 
 
 	// add it to the hash table
 	//hashTables[(int)decl->type].Set( decl->name, decl );
-	int newhash = hashTables[typeIndex].GenerateKey( canonicalNewName, false );
+	int newhash = hashTables[typeIndex].GenerateKey( decl->nameId.GetHash() );
 	hashTables[typeIndex].Add( newhash, decl->index );
 
 	//Remove the old hash item
@@ -2032,6 +2028,115 @@ void idDeclManagerLocal::TouchDecl_f( const idCmdArgs& args )
 	}
 }
 
+/*
+===================
+idDeclManagerLocal::TestNameLookup_f
+
+Times the lookups an entity spawn does: the spawn args of every entityDef are
+looked up by string, by interned name and with keys that don't exist, and every
+entityDef is looked up by name.
+===================
+*/
+void idDeclManagerLocal::TestNameLookup_f( const idCmdArgs& args )
+{
+	const int numIterations = ( args.Argc() > 1 ) ? Max( 1, atoi( args.Argv( 1 ) ) ) : 10;
+
+	idList<const idDict*> dicts;
+	idList<int> firstKey;
+	idStrList keyStrings;
+	idStrList missStrings;
+	idList<idName> keyNames;
+	idStrList declNames;
+
+	for( int i = 0; i < declManagerLocal.linearLists[ DECL_ENTITYDEF ].Num(); i++ )
+	{
+		const idDeclEntityDef* decl = static_cast<const idDeclEntityDef*>( declManagerLocal.FindType( DECL_ENTITYDEF, declManagerLocal.linearLists[ DECL_ENTITYDEF ][ i ]->GetName(), false ) );
+		if( decl == NULL )
+		{
+			continue;
+		}
+
+		declNames.Append( decl->GetName() );
+		dicts.Append( &decl->dict );
+		firstKey.Append( keyStrings.Num() );
+
+		for( int j = 0; j < decl->dict.GetNumKeyVals(); j++ )
+		{
+			const idKeyValue* kv = decl->dict.GetKeyVal( j );
+			keyStrings.Append( kv->GetKey() );
+			keyNames.Append( kv->GetKeyName() );
+			missStrings.Append( kv->GetKey() + "_unused" );
+		}
+	}
+	firstKey.Append( keyStrings.Num() );
+
+	if( keyStrings.Num() == 0 )
+	{
+		common->Printf( "no entityDefs loaded\n" );
+		return;
+	}
+
+	int numFound = 0;
+
+	uint64 start = Sys_Microseconds();
+	for( int n = 0; n < numIterations; n++ )
+	{
+		for( int i = 0; i < dicts.Num(); i++ )
+		{
+			for( int j = firstKey[i]; j < firstKey[i + 1]; j++ )
+			{
+				numFound += ( dicts[i]->FindKey( keyStrings[j] ) != NULL );
+			}
+		}
+	}
+	const uint64 stringTime = Sys_Microseconds() - start;
+
+	start = Sys_Microseconds();
+	for( int n = 0; n < numIterations; n++ )
+	{
+		for( int i = 0; i < dicts.Num(); i++ )
+		{
+			for( int j = firstKey[i]; j < firstKey[i + 1]; j++ )
+			{
+				numFound += ( dicts[i]->FindKey( keyNames[j] ) != NULL );
+			}
+		}
+	}
+	const uint64 nameTime = Sys_Microseconds() - start;
+
+	start = Sys_Microseconds();
+	for( int n = 0; n < numIterations; n++ )
+	{
+		for( int i = 0; i < dicts.Num(); i++ )
+		{
+			for( int j = firstKey[i]; j < firstKey[i + 1]; j++ )
+			{
+				numFound += ( dicts[i]->FindKey( missStrings[j] ) != NULL );
+			}
+		}
+	}
+	const uint64 missTime = Sys_Microseconds() - start;
+
+	start = Sys_Microseconds();
+	for( int n = 0; n < numIterations; n++ )
+	{
+		for( int i = 0; i < declNames.Num(); i++ )
+		{
+			numFound += ( declManagerLocal.FindType( DECL_ENTITYDEF, declNames[i], false ) != NULL );
+		}
+	}
+	const uint64 declTime = Sys_Microseconds() - start;
+
+	const double keyLookups = ( double )keyStrings.Num() * numIterations;
+	const double declLookups = ( double )declNames.Num() * numIterations;
+
+	common->Printf( "%d entityDefs with %d spawn args, %d iterations (%d found)\n", declNames.Num(), keyStrings.Num(), numIterations, numFound );
+	common->Printf( "FindKey by string:     %6.1f ns\n", stringTime * 1000.0 / keyLookups );
+	common->Printf( "FindKey by idName:     %6.1f ns\n", nameTime * 1000.0 / keyLookups );
+	common->Printf( "FindKey missing key:   %6.1f ns\n", missTime * 1000.0 / keyLookups );
+	common->Printf( "FindType entityDef:    %6.1f ns\n", declTime * 1000.0 / declLookups );
+}
+
 // RB begin
 #if !defined( DMAP )
 
@@ -4164,7 +4269,6 @@ This finds or creats the decl, but does not cause a parse.  This is only used in
 idDeclLocal* idDeclManagerLocal::FindTypeWithoutParsing( declType_t type, const char* name, bool makeDefault )
 {
 	int typeIndex = ( int )type;
-	int i, hash;
 
 	if( typeIndex < 0 || typeIndex >= declTypes.Num() || declTypes[typeIndex] == NULL || typeIndex >= DECL_MAX_TYPES )
 	{
@@ -4177,18 +4281,16 @@ idDeclLocal* idDeclManagerLocal::FindTypeWithoutParsing( declType_t type, const
 	MakeNameCanonical( name, canonicalName, sizeof( canonicalName ) );
 
 	// see if it already exists
-	hash = hashTables[typeIndex].GenerateKey( canonicalName, false );
-	for( i = hashTables[typeIndex].First( hash ); i >= 0; i = hashTables[typeIndex].Next( i ) )
+	idName nameId = idName::Find( canonicalName );
+	idDeclLocal* existing = FindByCanonicalName( typeIndex, nameId );
+	if( existing != NULL )
 	{
-		if( linearLists[typeIndex][i]->name.Icmp( canonicalName ) == 0 )
+		// only print these when decl_show is set to 2, because it can be a lot of clutter
+		if( decl_show.GetInteger() > 1 )
 		{
-			// only print these when decl_show is set to 2, because it can be a lot of clutter
-			if( decl_show.GetInteger() > 1 )
-			{
-				MediaPrint( "referencing %s %s\n", declTypes[ type ]->typeName.c_str(), name );
-			}
-			return linearLists[typeIndex][i];
+			MediaPrint( "referencing %s %s\n", declTypes[ type ]->typeName.c_str(), name );
 		}
+		return existing;
 	}
 
 	if( !makeDefault )
@@ -4196,9 +4298,15 @@ idDeclLocal* idDeclManagerLocal::FindTypeWithoutParsing( declType_t type, const
 		return NULL;
 	}
 
+	if( nameId.IsEmpty() )
+	{
+		nameId = idName( canonicalName );
+	}
+
 	idDeclLocal* decl = new( TAG_DECL ) idDeclLocal;
 	decl->self = NULL;
 	decl->name = canonicalName;
+	decl->nameId = nameId;
 	decl->type = type;
 	decl->declState = DS_UNPARSED;
 	decl->textSource = NULL;
@@ -4211,11 +4319,36 @@ idDeclLocal* idDeclManagerLocal::FindTypeWithoutParsing( declType_t type, const
 
 	// add it to the linear list and hash table
 	decl->index = linearLists[typeIndex].Num();
-	hashTables[typeIndex].Add( hash, linearLists[typeIndex].Append( decl ) );
+	hashTables[typeIndex].Add( hashTables[typeIndex].GenerateKey( nameId.GetHash() ), linearLists[typeIndex].Append( decl ) );
 
 	return decl;
 }
 
+/*
+===================
+idDeclManagerLocal::FindByCanonicalName
+
+A name that was never interned can't belong to a decl, so misses usually don't touch the hash table.
+===================
+*/
+idDeclLocal* idDeclManagerLocal::FindByCanonicalName( int typeIndex, const idName& canonicalName ) const
+{
+	if( canonicalName.IsEmpty() )
+	{
+		return NULL;
+	}
+
+	const int hash = hashTables[typeIndex].GenerateKey( canonicalName.GetHash() );
+	for( int i = hashTables[typeIndex].First( hash ); i >= 0; i = hashTables[typeIndex].Next( i ) )
+	{
+		if( linearLists[typeIndex][i]->nameId == canonicalName )
+		{
+			return linearLists[typeIndex][i];
+		}
+	}
+	return NULL;
+}
+
 /*
 =================
 idDeclManagerLocal::ConvertPDAsToStrings
@@ -59,6 +59,7 @@ public:
 
 private:
 	idStr					nameString;				// name
+	idName					nameId;					// interned name used for lookups
 	idStr					resetString;			// resetting will change to this value
 	idStr					valueString;			// value
 	idStr					descriptionString;		// description
@@ -89,6 +90,7 @@ idInternalCVar::idInternalCVar
 idInternalCVar::idInternalCVar( const char* newName, const char* newValue, int newFlags )
 {
 	nameString = newName;
+	nameId = idName( newName );
 	name = nameString.c_str();
 	valueString = newValue;
 	value = valueString.c_str();
@@ -113,6 +115,7 @@ idInternalCVar::idInternalCVar
 idInternalCVar::idInternalCVar( const idCVar* cvar )
 {
 	nameString = cvar->GetName();
+	nameId = idName( cvar->GetName() );
 	name = nameString.c_str();
 	valueString = cvar->GetString();
 	value = valueString.c_str();
@@ -529,6 +532,7 @@ public:
 
 	void					RegisterInternal( idCVar* cvar );
 	idInternalCVar* 		FindInternal( const char* name ) const;
+	idInternalCVar* 		FindInternal( const idName& name ) const;
 	void					SetInternal( const char* name, const char* value, int flags );
 
 private:
@@ -590,10 +594,26 @@ idCVarSystemLocal::FindInternal
 */
 idInternalCVar* idCVarSystemLocal::FindInternal( const char* name ) const
 {
-	int hash = cvarHash.GenerateKey( name, false );
+	// a name that was never interned can't belong to a cvar
+	return FindInternal( idName::Find( name ) );
+}
+
+/*
+============
+idCVarSystemLocal::FindInternal
+============
+*/
+idInternalCVar* idCVarSystemLocal::FindInternal( const idName& name ) const
+{
+	if( name.IsEmpty() )
+	{
+		return NULL;
+	}
+
+	int hash = cvarHash.GenerateKey( name.GetHash() );
 	for( int i = cvarHash.First( hash ); i != -1; i = cvarHash.Next( i ) )
 	{
-		if( cvars[i]->nameString.Icmp( name ) == 0 )
+		if( cvars[i]->nameId == name )
 		{
 			return cvars[i];
 		}
@@ -622,7 +642,7 @@ void idCVarSystemLocal::SetInternal( const char* name, const char* value, int fl
 	else
 	{
 		internal = new( TAG_SYSTEM ) idInternalCVar( name, value, flags );
-		hash = cvarHash.GenerateKey( internal->nameString.c_str(), false );
+		hash = cvarHash.GenerateKey( internal->nameId.GetHash() );
 		cvarHash.Add( hash, cvars.Append( internal ) );
 	}
 }
@@ -705,7 +725,7 @@ void idCVarSystemLocal::Register( idCVar* cvar )
 	else
 	{
 		internal = new( TAG_SYSTEM ) idInternalCVar( cvar );
-		hash = cvarHash.GenerateKey( internal->nameString.c_str(), false );
+		hash = cvarHash.GenerateKey( internal->nameId.GetHash() );
 		cvarHash.Add( hash, cvars.Append( internal ) );
 	}
 
@@ -1012,7 +1032,7 @@ void idCVarSystemLocal::SetCVarsFromDict( const idDict& dict )
 	for( int i = 0; i < dict.GetNumKeyVals(); i++ )
 	{
 		const idKeyValue* kv = dict.GetKeyVal( i );
-		internal = FindInternal( kv->GetKey() );
+		internal = FindInternal( kv->GetKeyName() );
 		if( internal )
 		{
 			internal->InternalServerSetString( kv->GetValue() );
@@ -1429,7 +1449,7 @@ void idCVarSystemLocal::Restart_f( const idCmdArgs& args )
 		// throw out any variables the user created
 		if( !( cvar->flags & CVAR_STATIC ) )
 		{
-			hash = localCVarSystem.cvarHash.GenerateKey( cvar->nameString, false );
+			hash = localCVarSystem.cvarHash.GenerateKey( cvar->nameId.GetHash() );
 			delete cvar;
 			localCVarSystem.cvars.RemoveIndex( i );
 			localCVarSystem.cvarHash.RemoveIndex( hash, i );
@@ -46,7 +46,9 @@ If you have questions concerning this license or the applicable additional terms
 typedef struct commandDef_s
 {
 	struct commandDef_s* 	next;
+	struct commandDef_s* 	hashNext;
 	char* 					name;
+	idName					nameId;
 	cmdFunction_t			function;
 	argCompletion_t			argCompletion;
 	int						flags;
@@ -95,8 +97,10 @@ public:
 
 private:
 	static const int		MAX_CMD_BUFFER = 0x10000;
+	static const int		CMD_HASH_SIZE = 1024;
 
 	commandDef_t* 			commands;
+	commandDef_t* 			commandHash[CMD_HASH_SIZE];	// chained on the hash of the interned name
 
 	int						wait;
 	int						textLength;
@@ -112,6 +116,9 @@ private:
 	idCmdArgs				postReload;
 
 private:
+	commandDef_t* 			FindCommand( const idName& name, const char* exactName = NULL ) const;
+	void					FreeCommand( commandDef_t* cmd );
+
 	void					ExecuteTokenizedString( const idCmdArgs& args );
 	void					InsertCommandText( const char* text );
 
@@ -406,9 +413,7 @@ void idCmdSystemLocal::Shutdown()
 	for( cmd = commands; cmd; cmd = commands )
 	{
 		commands = commands->next;
-		Mem_Free( cmd->name );
-		Mem_Free( cmd->description );
-		delete cmd;
+		FreeCommand( cmd );
 	}
 
 	completionString.Clear();
@@ -425,28 +430,77 @@ idCmdSystemLocal::AddCommand
 void idCmdSystemLocal::AddCommand( const char* cmdName, cmdFunction_t function, int flags, const char* description, argCompletion_t argCompletion )
 {
 	commandDef_t* cmd;
+	const idName nameId( cmdName );
 
-	// fail if the command already exists
-	for( cmd = commands; cmd; cmd = cmd->next )
+	// fail if the command already exists, names only differing in case are separate commands
+	cmd = FindCommand( nameId, cmdName );
+	if( cmd != NULL )
 	{
-		if( idStr::Cmp( cmdName, cmd->name ) == 0 )
+		if( function != cmd->function )
 		{
-			if( function != cmd->function )
-			{
-				common->Printf( "idCmdSystemLocal::AddCommand: %s already defined\n", cmdName );
-			}
-			return;
+			common->Printf( "idCmdSystemLocal::AddCommand: %s already defined\n", cmdName );
 		}
+		return;
 	}
 
 	cmd = new( TAG_SYSTEM ) commandDef_t;
 	cmd->name = Mem_CopyString( cmdName );
+	cmd->nameId = nameId;
 	cmd->function = function;
 	cmd->argCompletion = argCompletion;
 	cmd->flags = flags;
 	cmd->description = Mem_CopyString( description );
 	cmd->next = commands;
 	commands = cmd;
+
+	const int hash = nameId.GetHash() & ( CMD_HASH_SIZE - 1 );
+	cmd->hashNext = commandHash[hash];
+	commandHash[hash] = cmd;
+}
+
+/*
+============
+idCmdSystemLocal::FindCommand
+
+Commands are executed case-insensitive, but added and removed by their exact name.
+============
+*/
+commandDef_t* idCmdSystemLocal::FindCommand( const idName& name, const char* exactName ) const
+{
+	if( name.IsEmpty() )
+	{
+		return NULL;
+	}
+
+	for( commandDef_t* cmd = commandHash[name.GetHash() & ( CMD_HASH_SIZE - 1 )]; cmd; cmd = cmd->hashNext )
+	{
+		if( cmd->nameId == name && ( exactName == NULL || idStr::Cmp( exactName, cmd->name ) == 0 ) )
+		{
+			return cmd;
+		}
+	}
+	return NULL;
+}
+
+/*
+============
+idCmdSystemLocal::FreeCommand
+
+Unlinks the command from the hash chains, the caller unlinks it from the command list.
+============
+*/
+void idCmdSystemLocal::FreeCommand( commandDef_t* cmd )
+{
+	commandDef_t** last = &commandHash[cmd->nameId.GetHash() & ( CMD_HASH_SIZE - 1 )];
+	while( *last != cmd )
+	{
+		last = &( *last )->hashNext;
+	}
+	*last = cmd->hashNext;
+
+	Mem_Free( cmd->name );
+	Mem_Free( cmd->description );
+	delete cmd;
 }
 
 /*
@@ -458,14 +512,18 @@ void idCmdSystemLocal::RemoveCommand( const char* cmdName )
 {
 	commandDef_t* cmd, **last;
 
+	const commandDef_t* remove = FindCommand( idName::Find( cmdName ), cmdName );
+	if( remove == NULL )
+	{
+		return;
+	}
+
 	for( last = &commands, cmd = *last; cmd; cmd = *last )
 	{
-		if( idStr::Cmp( cmdName, cmd->name ) == 0 )
+		if( cmd == remove )
 		{
 			*last = cmd->next;
-			Mem_Free( cmd->name );
-			Mem_Free( cmd->description );
-			delete cmd;
+			FreeCommand( cmd );
 			return;
 		}
 		last = &cmd->next;
@@ -486,9 +544,7 @@ void idCmdSystemLocal::RemoveFlaggedCommands( int flags )
 		if( cmd->flags & flags )
 		{
 			*last = cmd->next;
-			Mem_Free( cmd->name );
-			Mem_Free( cmd->description );
-			delete cmd;
+			FreeCommand( cmd );
 			continue;
 		}
 		last = &cmd->next;
@@ -522,17 +578,10 @@ void idCmdSystemLocal::ArgCompletion( const char* cmdString, void( *callback )(
 
 	args.TokenizeString( cmdString, false );
 
-	for( cmd = commands; cmd; cmd = cmd->next )
+	cmd = FindCommand( idName::Find( args.Argv( 0 ) ) );
+	if( cmd != NULL && cmd->argCompletion )
 	{
-		if( !cmd->argCompletion )
-		{
-			continue;
-		}
-		if( idStr::Icmp( args.Argv( 0 ), cmd->name ) == 0 )
-		{
-			cmd->argCompletion( args, callback );
-			break;
-		}
+		cmd->argCompletion( args, callback );
 	}
 }
 
@@ -543,7 +592,7 @@ idCmdSystemLocal::ExecuteTokenizedString
 */
 void idCmdSystemLocal::ExecuteTokenizedString( const idCmdArgs& args )
 {
-	commandDef_t* cmd, **prev;
+	commandDef_t* cmd;
 
 	// execute the command line
 	if( !args.Argc() )
@@ -552,33 +601,17 @@ void idCmdSystemLocal::ExecuteTokenizedString( const idCmdArgs& args )
 	}
 
 	// check registered command functions
-	for( prev = &commands; *prev; prev = &cmd->next )
+	cmd = FindCommand( idName::Find( args.Argv( 0 ) ) );
+	if( cmd != NULL && cmd->function )
 	{
-		cmd = *prev;
-		if( idStr::Icmp( args.Argv( 0 ), cmd->name ) == 0 )
+		if( ( cmd->flags & ( CMD_FL_CHEAT | CMD_FL_TOOL ) ) && common->IsMultiplayer() && !net_allowCheats.GetBool() )
 		{
-			// rearrange the links so that the command will be
-			// near the head of the list next time it is used
-			*prev = cmd->next;
-			cmd->next = commands;
-			commands = cmd;
-
-			if( ( cmd->flags & ( CMD_FL_CHEAT | CMD_FL_TOOL ) ) && common->IsMultiplayer() && !net_allowCheats.GetBool() )
-			{
-				common->Printf( "Command '%s' not valid in multiplayer mode.\n", cmd->name );
-				return;
-			}
-			// perform the action
-			if( !cmd->function )
-			{
-				break;
-			}
-			else
-			{
-				cmd->function( args );
-			}
+			common->Printf( "Command '%s' not valid in multiplayer mode.\n", cmd->name );
 			return;
 		}
+		// perform the action
+		cmd->function( args );
+		return;
 	}
 
 	// check cvars
@@ -1186,6 +1186,9 @@ void idCommonLocal::Init( int argc, const char* const* argv, const char* cmdline
 		// register all static CVars
 		idCVar::RegisterStaticVars();
 
+		// start writing the log file and terminal output off the printing threads
+		printThread.StartThread( "Print", CORE_ANY, THREAD_BELOW_NORMAL );
+
 		idLib::Printf( "QA Timing INIT: %06dms\n", Sys_Milliseconds() );
 
 		// print engine version
@@ -1591,7 +1594,11 @@ void idCommonLocal::Shutdown()
 	printf( "stringsFile.Clear( true );\n" );
 	stringsFile.Clear( true );
 
-	// only shut down the log file after all output is done
+	// only shut down the log file after all output is done,
+	// whatever the print thread left queued is flushed there
+	printf( "printThread.StopThread();\n" );
+	printThread.StopThread();
+
 	printf( "CloseLogFile();\n" );
 	CloseLogFile();
 
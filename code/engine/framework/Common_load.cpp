@@ -32,6 +32,7 @@ If you have questions concerning this license or the applicable additional terms
 #pragma hdrstop
 
 #include "Common_local.h"
+#include "LoadGraph.h"
 #include "../sys/sys_lobby_backend.h"
 
 
@@ -41,6 +42,7 @@ If you have questions concerning this license or the applicable additional terms
 idCVar com_wipeSeconds( "com_wipeSeconds", "1", CVAR_SYSTEM, "" );
 idCVar com_disableAutoSaves( "com_disableAutoSaves", "0", CVAR_SYSTEM | CVAR_BOOL, "" );
 idCVar com_disableAllSaves( "com_disableAllSaves", "0", CVAR_SYSTEM | CVAR_BOOL, "" );
+idCVar com_parallelLoad( "com_parallelLoad", "1", CVAR_SYSTEM | CVAR_BOOL, "run the independent level load stages on job threads" );
 
 
 extern idCVar sys_lang;
@@ -50,6 +52,88 @@ extern idCVar g_demoMode;
 // This is for the dirty hack to get a dialog to show up before we capture the screen for autorender.
 const int NumScreenUpdatesToShowDialog = 25;
 
+struct mapLoadStages_t
+{
+	const char* 	mapName;
+	const char* 	fullMapName;
+	idRenderWorld* 	renderWorld;
+};
+
+/*
+===============
+MapLoad_Preload
+===============
+*/
+static void MapLoad_Preload( void* data )
+{
+	const mapLoadStages_t* load = ( const mapLoadStages_t* )data;
+
+	if( fileSystem->UsingResourceFiles() )
+	{
+		idStrStatic< MAX_OSPATH > manifestName = load->mapName;
+		manifestName.Replace( "game/", "maps/" );
+		manifestName.Replace( "/mp/", "/" );
+		manifestName += ".preload";
+		idPreloadManifest manifest;
+		manifest.LoadManifest( manifestName );
+		renderSystem->Preload( manifest, load->mapName );
+		soundSystem->Preload( manifest );
+		game->Preload( manifest );
+	}
+}
+
+/*
+===============
+MapLoad_ReadAAS
+
+Reads the files idGameLocal::LoadMap is going to ask for.
+===============
+*/
+static void MapLoad_ReadAAS( void* data )
+{
+	const mapLoadStages_t* load = ( const mapLoadStages_t* )data;
+
+	const idDeclEntityDef* aasTypes = static_cast< const idDeclEntityDef* >( declManager->FindType( DECL_ENTITYDEF, "aas_types", false ) );
+	if( aasTypes == NULL )
+	{
+		return;
+	}
+
+	idStr aasName;
+	for( const idKeyValue* kv = aasTypes->dict.MatchPrefix( "type" ); kv != NULL; kv = aasTypes->dict.MatchPrefix( "type", kv ) )
+	{
+		aasName = load->fullMapName;
+		aasName.SetFileExtension( kv->GetValue() );
+		AASFileManager->PreloadAAS( aasName );
+	}
+}
+
+/*
+===============
+MapLoad_ParseAAS
+===============
+*/
+static void MapLoad_ParseAAS( void* data )
+{
+	AASFileManager->ParsePreloads();
+}
+
+/*
+===============
+MapLoad_World
+===============
+*/
+static void MapLoad_World( void* data )
+{
+	const mapLoadStages_t* load = ( const mapLoadStages_t* )data;
+
+	// let the renderSystem load all the geometry
+	if( !load->renderWorld->InitFromMap( load->fullMapName ) )
+	{
+		common->Error( "couldn't load %s", load->fullMapName );
+	}
+}
+
 
 
 /*
@@ -490,19 +574,6 @@ void idCommonLocal::ExecuteMapChange()
 	ClearWipe();
 
 
-	if( fileSystem->UsingResourceFiles() )
-	{
-		idStrStatic< MAX_OSPATH > manifestName = currentMapName;
-		manifestName.Replace( "game/", "maps/" );
-		manifestName.Replace( "/mp/", "/" );
-		manifestName += ".preload";
-		idPreloadManifest manifest;
-		manifest.LoadManifest( manifestName );
-		renderSystem->Preload( manifest, currentMapName );
-		soundSystem->Preload( manifest );
-		game->Preload( manifest );
-	}
-
 	if( common->IsMultiplayer() )
 	{
 		// In multiplayer, make sure the player is either 60Hz or 120Hz
@@ -525,16 +596,28 @@ void idCommonLocal::ExecuteMapChange()
 	// before we do this potentially long operation
 	Sys_GrabMouseCursor( false );
 
-	// let the renderSystem load all the geometry
-	if( !renderWorld->InitFromMap( fullMapName ) )
-	{
-		common->Error( "couldn't load %s", fullMapName.c_str() );
-	}
+	// the AAS files are parsed on a job thread while the media is preloaded and the
+	// world is loaded, the game picks them up from the AAS file manager when it spawns
+	mapLoadStages_t mapLoad;
+	mapLoad.mapName = currentMapName;
+	mapLoad.fullMapName = fullMapName;
+	mapLoad.renderWorld = renderWorld;
+
+	idLoadGraph loadGraph;
+	const int readAAS = loadGraph.AddStage( "read aas", MapLoad_ReadAAS, &mapLoad, false );
+	const int parseAAS = loadGraph.AddStage( "parse aas", MapLoad_ParseAAS, &mapLoad, true );
+	const int preload = loadGraph.AddStage( "preload media", MapLoad_Preload, &mapLoad, false );
+	const int world = loadGraph.AddStage( "render world", MapLoad_World, &mapLoad, false );
+	loadGraph.AddDependency( parseAAS, readAAS );
+	loadGraph.AddDependency( world, preload );
+	loadGraph.Run( com_parallelLoad.GetBool() );
 
 	// for the synchronous networking we needed to roll the angles over from
 	// level to level, but now we can just clear everything
 	usercmdGen->InitForNewMap();
 
+	const int gameStartTime = Sys_Milliseconds();
+
 	// load and spawn all other entities ( from a savegame possibly )
 	if( mapSpawnData.savegameFile )
 	{
@@ -557,6 +640,11 @@ void idCommonLocal::ExecuteMapChange()
 		game->InitFromNewMap( fullMapName, renderWorld, soundWorld, matchParameters.gameMode, Sys_Milliseconds() );
 	}
 
+	loadGraph.AddTimelineEntry( "spawn game", gameStartTime, Sys_Milliseconds() );
+	loadGraph.Wait();
+	loadGraph.PrintTimeline();
+	AASFileManager->FreePreloads();
+
 	game->Shell_CreateMenu( true );
 
 	// Reset some values important to multiplayer
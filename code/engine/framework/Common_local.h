@@ -101,6 +101,19 @@ private:
 	bool			isClient;
 };
 
+/*
+================================================
+idPrintThread drains the per-thread print rings into
+the log file and the terminal so that printing threads
+never block on file or tty I/O.
+================================================
+*/
+class idPrintThread : public idSysThread
+{
+private:
+	virtual int	Run();
+};
+
 enum errorParm_t
 {
 	ERP_NONE,
@@ -270,6 +283,11 @@ public:
 public:
 	void	Draw();			// called by gameThread
 
+	// writes out everything queued by the print rings, called
+	// before errors and when the log file is closed
+	void	FlushPrints();
+	void	DrainPrints( bool flushRepeats );
+
 	// foresthale 2014-03-01: added WaitGameThread() method
 	void	WaitGameThread()
 	{
@@ -296,6 +314,11 @@ public:
 		return time_backend;
 	}
 
+	uint64		GetRendererBackEndShadowMicroseconds() const
+	{
+		return stats_backend.cpuShadowMicroSec;
+	}
+
 	uint64		GetRendererMaskedOcclusionRasterizationMicroseconds() const
 	{
 		return time_moc;
@@ -486,6 +509,9 @@ private:
 
 	idFile* 					logFile;
 
+	idPrintThread				printThread;	// writes the log file and terminal echo for com_asyncPrint
+	idSysMutex					printMutex;		// serializes draining the print rings
+
 	char						errorMessage[MAX_PRINT_MSG_SIZE];
 
 	char* 						rd_buffer;
@@ -678,6 +704,7 @@ private:
 	void	ParseCommandLine( int argc, const char* const* argv );
 	bool	SafeMode();
 	void	CloseLogFile();
+	bool	QueuePrint( const char* msg, int flags );
 	void	WriteConfiguration();
 	void	DumpWarnings();
 	void	LoadGameDLL();
@@ -31,14 +31,471 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "Common_local.h"
 
+#include <atomic>
+
 idCVar com_logFile( "logFile", "0", CVAR_SYSTEM | CVAR_NOCHEAT, "1 = buffer log, 2 = flush after each print", 0, 2, idCmdSystem::ArgCompletion_Integer<0, 2> );
 idCVar com_logFileName( "logFileName", "qconsole.log", CVAR_SYSTEM | CVAR_NOCHEAT, "name of log file, if empty, qconsole.log will be used" );
 idCVar com_timestampPrints( "com_timestampPrints", "0", CVAR_SYSTEM, "print time with each console print, 1 = msec, 2 = sec", 0, 2, idCmdSystem::ArgCompletion_Integer<0, 2> );
 
+idCVar com_asyncPrint( "com_asyncPrint", "1", CVAR_SYSTEM | CVAR_BOOL | CVAR_NOCHEAT, "queue terminal and log file output and write it from the print thread" );
+idCVar com_logFileStamps( "com_logFileStamps", "1", CVAR_SYSTEM | CVAR_BOOL | CVAR_NOCHEAT, "prefix queued log file lines with the print time and the printing thread" );
+
 #ifndef ID_RETAIL
 	idCVar com_printFilter( "com_printFilter", "", CVAR_SYSTEM, "only print lines that contain this, add multiple filters with a ; delimeter" );
 #endif
 
+/*
+===============================================================================
+
+	Print rings
+
+	Every printing thread owns a single producer / single consumer byte ring.
+	Producers never lock, a message is copied in behind the write position
+	and published with a release store. The print thread merges all rings by
+	a global sequence number, so the log keeps the order the prints were made
+	in. When a ring is full the printing thread writes out the backlog once
+	itself, if that doesn't make room the message is dropped and counted.
+
+===============================================================================
+*/
+
+static const int PRINT_RING_SIZE		= 64 * 1024;	// must be a power of two
+static const int PRINT_RING_MASK		= PRINT_RING_SIZE - 1;
+static const int MAX_PRINT_RINGS		= 32;
+static const int PRINT_BATCH_SIZE		= 32 * 1024;
+static const int PRINT_REPEAT_MSEC		= 1000;			// identical lines are held back at most this long
+static const int PRINT_THREAD_MSEC		= 5;
+
+enum
+{
+	PRINT_ECHO		= 1,		// echo to the terminal
+	PRINT_LOG		= 2			// write to the log file
+};
+
+struct printHeader_t
+{
+	int				length;
+	unsigned int	sequence;
+	int				time;
+	int				flags;
+};
+
+class idPrintRing
+{
+public:
+	bool						Write( const printHeader_t& header, const char* text );
+	bool						Peek( printHeader_t& header ) const;
+	void						Read( const printHeader_t& header, char* text );
+
+	std::atomic<bool>			inUse;
+	std::atomic<int>			numDropped;
+	bool						mainThread;
+
+private:
+	void						CopyIn( unsigned int pos, const void* src, int size );
+	void						CopyOut( unsigned int pos, void* dst, int size ) const;
+
+	std::atomic<unsigned int>	writePos;
+	std::atomic<unsigned int>	readPos;
+	byte						buffer[PRINT_RING_SIZE];
+};
+
+/*
+========================
+idPrintRing::CopyIn
+========================
+*/
+void idPrintRing::CopyIn( unsigned int pos, const void* src, int size )
+{
+	const int offset = pos & PRINT_RING_MASK;
+	const int first = Min( size, PRINT_RING_SIZE - offset );
+	memcpy( buffer + offset, src, first );
+	memcpy( buffer, ( const byte* )src + first, size - first );
+}
+
+/*
+========================
+idPrintRing::CopyOut
+========================
+*/
+void idPrintRing::CopyOut( unsigned int pos, void* dst, int size ) const
+{
+	const int offset = pos & PRINT_RING_MASK;
+	const int first = Min( size, PRINT_RING_SIZE - offset );
+	memcpy( dst, buffer + offset, first );
+	memcpy( ( byte* )dst + first, buffer, size - first );
+}
+
+/*
+========================
+idPrintRing::Write
+
+Only called by the thread that owns the ring.
+========================
+*/
+bool idPrintRing::Write( const printHeader_t& header, const char* text )
+{
+	const unsigned int total = sizeof( header ) + header.length;
+	const unsigned int write = writePos.load( std::memory_order_relaxed );
+	const unsigned int read = readPos.load( std::memory_order_acquire );
+
+	if( PRINT_RING_SIZE - ( write - read ) < total )
+	{
+		return false;
+	}
+
+	CopyIn( write, &header, sizeof( header ) );
+	CopyIn( write + sizeof( header ), text, header.length );
+	writePos.store( write + total, std::memory_order_release );
+	return true;
+}
+
+/*
+========================
+idPrintRing::Peek
+
+Only called with the print mutex held.
+========================
+*/
+bool idPrintRing::Peek( printHeader_t& header ) const
+{
+	const unsigned int read = readPos.load( std::memory_order_relaxed );
+	const unsigned int write = writePos.load( std::memory_order_acquire );
+
+	if( read == write )
+	{
+		return false;
+	}
+	CopyOut( read, &header, sizeof( header ) );
+	return true;
+}
+
+/*
+========================
+idPrintRing::Read
+========================
+*/
+void idPrintRing::Read( const printHeader_t& header, char* text )
+{
+	const unsigned int read = readPos.load( std::memory_order_relaxed );
+
+	CopyOut( read + sizeof( header ), text, header.length );
+	text[header.length] = '\0';
+	readPos.store( read + sizeof( header ) + header.length, std::memory_order_release );
+}
+
+/*
+================================================
+idPrintRingOwner hands the ring back when its thread exits,
+anything still queued in it is drained by the next flush.
+================================================
+*/
+struct idPrintRingOwner
+{
+	~idPrintRingOwner()
+	{
+		if( ring != NULL )
+		{
+			ring->inUse.store( false, std::memory_order_release );
+		}
+	}
+
+	idPrintRing*	ring = NULL;
+	bool			failed = false;
+};
+
+struct printBatch_t
+{
+	char	text[PRINT_BATCH_SIZE];
+	int		length;
+};
+
+static idPrintRing						printRings[MAX_PRINT_RINGS];
+static std::atomic<int>					numPrintRings;
+static std::atomic<unsigned int>		printSequence;
+static thread_local idPrintRingOwner	threadPrintRing;
+static thread_local bool				threadDrainingPrints;
+
+// only touched with the print mutex held
+static printBatch_t		printEcho;
+static printBatch_t		printLog;
+static bool				printLogLineStart = true;
+static char				printText[MAX_PRINT_MSG_SIZE];
+static char				printLastText[MAX_PRINT_MSG_SIZE];
+static printHeader_t	printLastHeader;
+static int				printLastRing;
+static int				printRepeats;
+
+/*
+==================
+GetThreadPrintRing
+==================
+*/
+static idPrintRing* GetThreadPrintRing()
+{
+	idPrintRingOwner& owner = threadPrintRing;
+
+	if( owner.ring == NULL && !owner.failed )
+	{
+		for( int i = 0; i < MAX_PRINT_RINGS; i++ )
+		{
+			bool expected = false;
+			if( printRings[i].inUse.compare_exchange_strong( expected, true, std::memory_order_acquire ) )
+			{
+				printRings[i].mainThread = idLib::IsMainThread();
+				owner.ring = &printRings[i];
+
+				int num = numPrintRings.load( std::memory_order_relaxed );
+				while( num < i + 1 && !numPrintRings.compare_exchange_weak( num, i + 1 ) )
+				{
+				}
+				break;
+			}
+		}
+
+		// too many threads are printing, this one stays synchronous
+		owner.failed = ( owner.ring == NULL );
+	}
+
+	return owner.ring;
+}
+
+/*
+==================
+FlushPrintBatches
+==================
+*/
+static void FlushPrintBatches( idFile* logFile )
+{
+	if( printEcho.length > 0 )
+	{
+		printEcho.text[printEcho.length] = '\0';
+#if defined(_WIN32)
+		OutputDebugString( printEcho.text );
+#else
+		Sys_Printf( "%s", printEcho.text );
+#endif
+		printEcho.length = 0;
+	}
+
+	if( printLog.length > 0 )
+	{
+		if( logFile != NULL )
+		{
+			logFile->Write( printLog.text, printLog.length );
+			logFile->Flush();
+		}
+		printLog.length = 0;
+	}
+}
+
+/*
+==================
+AppendPrintBatch
+==================
+*/
+static void AppendPrintBatch( printBatch_t& batch, const char* text, int length, idFile* logFile )
+{
+	if( batch.length + length >= PRINT_BATCH_SIZE )
+	{
+		FlushPrintBatches( logFile );
+	}
+	memcpy( batch.text + batch.length, text, length );
+	batch.length += length;
+}
+
+/*
+==================
+EmitPrint
+==================
+*/
+static void EmitPrint( const printHeader_t& header, int ring, const char* text, idFile* logFile )
+{
+	if( header.flags & PRINT_ECHO )
+	{
+		AppendPrintBatch( printEcho, text, header.length, logFile );
+	}
+
+	if( ( header.flags & PRINT_LOG ) && logFile != NULL )
+	{
+		if( com_logFileStamps.GetBool() && printLogLineStart )
+		{
+			char stamp[32];
+			int length;
+			if( printRings[ring].mainThread )
+			{
+				length = idStr::snPrintf( stamp, sizeof( stamp ), "[%9.3f main] ", header.time * 0.001f );
+			}
+			else
+			{
+				length = idStr::snPrintf( stamp, sizeof( stamp ), "[%9.3f t%02d ] ", header.time * 0.001f, ring );
+			}
+			AppendPrintBatch( printLog, stamp, length, logFile );
+		}
+		AppendPrintBatch( printLog, text, header.length, logFile );
+		printLogLineStart = ( header.length > 0 && text[header.length - 1] == '\n' );
+	}
+}
+
+/*
+==================
+EmitPrintRepeats
+==================
+*/
+static void EmitPrintRepeats( idFile* logFile )
+{
+	if( printRepeats > 0 )
+	{
+		printHeader_t header = printLastHeader;
+		header.length = idStr::snPrintf( printText, sizeof( printText ), "last message repeated %d times\n", printRepeats );
+		EmitPrint( header, printLastRing, printText, logFile );
+	}
+	printLastHeader.length = 0;
+	printRepeats = 0;
+}
+
+/*
+==================
+idPrintThread::Run
+==================
+*/
+int idPrintThread::Run()
+{
+	while( !IsTerminating() )
+	{
+		commonLocal.DrainPrints( false );
+		Sys_Sleep( PRINT_THREAD_MSEC );
+	}
+	return 0;
+}
+
+/*
+==================
+idCommonLocal::DrainPrints
+
+Merges the queued prints of all threads in sequence order, collapses runs of
+identical lines and writes the result with one log file write per batch.
+==================
+*/
+void idCommonLocal::DrainPrints( bool flushRepeats )
+{
+	idScopedCriticalSection lock( printMutex );
+
+	threadDrainingPrints = true;
+
+	const int numRings = numPrintRings.load( std::memory_order_acquire );
+	while( true )
+	{
+		int best = -1;
+		printHeader_t bestHeader;
+		for( int i = 0; i < numRings; i++ )
+		{
+			printHeader_t header;
+			if( printRings[i].Peek( header ) && ( best == -1 || ( int )( header.sequence - bestHeader.sequence ) < 0 ) )
+			{
+				best = i;
+				bestHeader = header;
+			}
+		}
+		if( best == -1 )
+		{
+			break;
+		}
+
+		printRings[best].Read( bestHeader, printText );
+
+		if( printLastHeader.length > 0 && printLastHeader.length == bestHeader.length && printLastHeader.flags == bestHeader.flags && memcmp( printLastText, printText, bestHeader.length ) == 0 )
+		{
+			printLastHeader.time = bestHeader.time;
+			printRepeats++;
+			continue;
+		}
+
+		EmitPrintRepeats( logFile );
+
+		// only complete lines are collapsed, progress output is printed in pieces
+		if( bestHeader.length > 0 && printText[bestHeader.length - 1] == '\n' )
+		{
+			memcpy( printLastText, printText, bestHeader.length );
+			printLastHeader = bestHeader;
+			printLastRing = best;
+		}
+
+		EmitPrint( bestHeader, best, printText, logFile );
+	}
+
+	if( printRepeats > 0 && ( flushRepeats || Sys_Milliseconds() - printLastHeader.time > PRINT_REPEAT_MSEC ) )
+	{
+		EmitPrintRepeats( logFile );
+	}
+
+	for( int i = 0; i < numRings; i++ )
+	{
+		const int numDropped = printRings[i].numDropped.exchange( 0, std::memory_order_relaxed );
+		if( numDropped > 0 )
+		{
+			printHeader_t header;
+			header.time = Sys_Milliseconds();
+			header.flags = PRINT_ECHO | PRINT_LOG;
+			header.length = idStr::snPrintf( printText, sizeof( printText ), "WARNING: %d prints dropped, print ring full\n", numDropped );
+			EmitPrint( header, i, printText, logFile );
+		}
+	}
+
+	FlushPrintBatches( logFile );
+
+	threadDrainingPrints = false;
+}
+
+/*
+==================
+idCommonLocal::QueuePrint
+
+Returns false if the calling thread has no ring and must print synchronously.
+==================
+*/
+bool idCommonLocal::QueuePrint( const char* msg, int flags )
+{
+	idPrintRing* ring = GetThreadPrintRing();
+	if( ring == NULL )
+	{
+		return false;
+	}
+
+	printHeader_t header;
+	header.length = strlen( msg );
+	header.sequence = printSequence.fetch_add( 1, std::memory_order_relaxed );
+	header.time = Sys_Milliseconds();
+	header.flags = flags;
+
+	if( !ring->Write( header, msg ) )
+	{
+		// the print thread can't keep up, write out the backlog here once
+		// and drop the message if that doesn't make room for it either
+		FlushPrints();
+		if( !ring->Write( header, msg ) )
+		{
+			ring->numDropped.fetch_add( 1, std::memory_order_relaxed );
+		}
+	}
+	return true;
+}
+
+/*
+==================
+idCommonLocal::FlushPrints
+==================
+*/
+void idCommonLocal::FlushPrints()
+{
+	// an error raised while writing the queued prints must not wait on itself
+	if( threadDrainingPrints )
+	{
+		return;
+	}
+	DrainPrints( true );
+}
+
 /*
 ==================
 idCommonLocal::BeginRedirect
@@ -81,9 +538,14 @@ idCommonLocal::CloseLogFile
 */
 void idCommonLocal::CloseLogFile()
 {
+	// write out everything still queued before the file goes away
+	FlushPrints();
+
 	if( logFile )
 	{
 		com_logFile.SetBool( false ); // make sure no further VPrintf attempts to open the log file again
+
+		idScopedCriticalSection lock( printMutex );
 		fileSystem->CloseFile( logFile );
 		logFile = NULL;
 	}
@@ -177,8 +639,32 @@ void idCommonLocal::VPrintf( const char* fmt, va_list args )
 #endif
 
 
+	// "logFile 2" flushes after each print so the log survives a crash,
+	// which only works if nothing is left sitting in the print rings
+	const bool syncLog = com_logFile.GetInteger() > 1;
+	const bool asyncPrint = com_asyncPrint.GetBool() && printThread.IsRunning() && !syncLog;
+
 	if( !idLib::IsMainThread() )
 	{
+		if( asyncPrint )
+		{
+			idStr::RemoveColors( msg );
+			if( QueuePrint( msg, PRINT_ECHO | PRINT_LOG ) )
+			{
+				return;
+			}
+		}
+
+		if( syncLog && !threadDrainingPrints )
+		{
+			idScopedCriticalSection lock( printMutex );
+			if( logFile )
+			{
+				logFile->Write( msg, strlen( msg ) );
+				logFile->Flush();
+			}
+		}
+
 		// RB: printf should be thread-safe on Linux
 #if defined(_WIN32)
 		OutputDebugString( msg );
@@ -195,9 +681,6 @@ void idCommonLocal::VPrintf( const char* fmt, va_list args )
 	// remove any color codes
 	idStr::RemoveColors( msg );
 
-	// echo to dedicated console and early console
-	Sys_Printf( "%s", msg );
-
 	// print to script debugger server
 	// DebuggerServerPrint( msg );
 
@@ -222,8 +705,8 @@ void idCommonLocal::VPrintf( const char* fmt, va_list args )
 			// fileSystem->OpenFileWrite can cause recursive prints into here
 			recursing = true;
 
-			logFile = fileSystem->OpenFileWrite( fileName );
-			if( !logFile )
+			idFile* file = fileSystem->OpenFileWrite( fileName );
+			if( !file )
 			{
 				logFileFailed = true;
 				FatalError( "failed to open log file '%s'\n", fileName );
@@ -235,9 +718,14 @@ void idCommonLocal::VPrintf( const char* fmt, va_list args )
 			{
 				// force it to not buffer so we get valid
 				// data even if we are crashing
-				logFile->ForceFlush();
+				file->ForceFlush();
 			}
 
+			// the print thread may be writing queued prints
+			printMutex.Lock();
+			logFile = file;
+			printMutex.Unlock();
+
 			time_t aclock;
 			time( &aclock );
 			struct tm* newtime = localtime( &aclock );
@@ -246,10 +734,39 @@ void idCommonLocal::VPrintf( const char* fmt, va_list args )
 			// print engine version
 			Printf( "%s\n", com_version.GetString() );
 		}
-		if( logFile )
+	}
+
+	// echo to dedicated console and early console and write the log file,
+	// the win32 dedicated console can only be used from the main thread
+#if defined(_WIN32)
+	const int echoFlag = 0;
+#else
+	const int echoFlag = PRINT_ECHO;
+#endif
+	const bool queued = asyncPrint && QueuePrint( msg, echoFlag | PRINT_LOG );
+	if( !queued || echoFlag == 0 )
+	{
+		Sys_Printf( "%s", msg );
+	}
+	if( !queued && logFile )
+	{
+		if( syncLog )
+		{
+			// write out anything queued before the log mode changed first
+			FlushPrints();
+		}
+
+		// the print thread may be writing queued prints, unless
+		// this print comes from draining them on this thread
+		if( !threadDrainingPrints )
+		{
+			printMutex.Lock();
+		}
+		logFile->Write( msg, strlen( msg ) );
+		logFile->Flush();	// ForceFlush doesn't help a whole lot
+		if( !threadDrainingPrints )
 		{
-			logFile->Write( msg, strlen( msg ) );
-			logFile->Flush();	// ForceFlush doesn't help a whole lot
+			printMutex.Unlock();
 		}
 	}
 
@@ -506,6 +1023,9 @@ void idCommonLocal::Error( const char* fmt, ... )
 	// always turn this off after an error
 	com_refreshOnPrint = false;
 
+	// get everything printed so far out before the error
+	FlushPrints();
+
 	if( com_productionMode.GetInteger() == 3 )
 	{
 		Sys_Quit();
@@ -591,6 +1111,8 @@ void idCommonLocal::Error( const char* fmt, ... )
 		cmdSystem->BufferCommandText( CMD_EXEC_NOW, "vid_restart partial windowed\n" );
 	}
 
+	FlushPrints();
+
 	Sys_Error( "%s", errorMessage );
 
 }
@@ -606,6 +1128,9 @@ void idCommonLocal::FatalError( const char* fmt, ... )
 {
 	va_list		argptr;
 
+	// get everything printed so far out before the error
+	FlushPrints();
+
 	if( com_productionMode.GetInteger() == 3 )
 	{
 		Sys_Quit();
@@ -645,6 +1170,8 @@ void idCommonLocal::FatalError( const char* fmt, ... )
 
 	Sys_SetFatalError( errorMessage );
 
+	FlushPrints();
+
 	Sys_Error( "%s", errorMessage );
 
 }
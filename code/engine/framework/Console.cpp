@@ -298,6 +298,7 @@ float idConsoleLocal::DrawFPS( float y )
 	const uint64 gameThreadRenderTime	= commonLocal.mainFrameTiming.finishDrawTime - commonLocal.mainFrameTiming.finishGameTime;
 
 	const uint64 rendererBackEndTime = commonLocal.GetRendererBackEndMicroseconds();
+	const uint64 rendererBackEndShadowTime = commonLocal.GetRendererBackEndShadowMicroseconds();
 	const uint64 rendererMaskedOcclusionCullingTime = commonLocal.GetRendererMaskedOcclusionRasterizationMicroseconds();
 	const uint64 rendererGPUTime = commonLocal.GetRendererGPUMicroseconds();
 	const uint64 rendererGPUEarlyZTime = commonLocal.GetRendererGpuBeginDrawingMicroseconds() + commonLocal.GetRendererGpuEarlyZMicroseconds() + commonLocal.GetRendererGpuGeometryMicroseconds();
@@ -349,7 +350,7 @@ float idConsoleLocal::DrawFPS( float y )
 		if( com_showFPS.GetInteger() > 2 )
 		{
 			statsWindowWidth += 230;
-			statsWindowHeight += 140;
+			statsWindowHeight += 160;
 		}
 
 		ImVec2 pos;
@@ -531,6 +532,18 @@ float idConsoleLocal::DrawFPS( float y )
 			ImGui::TextColored( colorLtGrey, "UPDATES: entityUpdates:%-3i  entityRefs:%-3i  lightUpdates:%-2i  lightRefs:%i\n",
 								commonLocal.stats_frontend.c_entityUpdates, commonLocal.stats_frontend.c_entityReferences,
 								commonLocal.stats_frontend.c_lightUpdates, commonLocal.stats_frontend.c_lightReferences );
+
+			static int64 previousNumAllocsTotal = 0;
+
+			memHeapStats_t heapStats;
+			Mem_GetHeapStats( heapStats );
+
+			ImGui::TextColored( colorLtGrey, "HEAP: %lld MB in %i blocks, reserved:%lld MB, allocs/frame:%lld",
+								( long long )( heapStats.numBytes >> 20 ), heapStats.numAllocs,
+								( long long )( heapStats.reservedBytes >> 20 ),
+								( long long )( heapStats.numAllocsTotal - previousNumAllocsTotal ) );
+
+			previousNumAllocsTotal = heapStats.numAllocsTotal;
 		}
 
 		//ImGui::Text( "frameData: %i (%i)\n", frameData->frameMemoryAllocated.GetValue(), frameData->highWaterAllocated );
@@ -566,7 +579,7 @@ float idConsoleLocal::DrawFPS( float y )
 		ImGui::TextColored( rendererGPUInteractionsTime > maxTime ? colorRed : colorWhite,	"Sync:    %5lld us   Interactions: %5llu us", frameSyncTime, rendererGPUInteractionsTime );
 		ImGui::TextColored( rendererGPUShaderPassesTime > maxTime ? colorRed : colorWhite,	"                    Shader Pass:  %5llu us", rendererGPUShaderPassesTime );
 #endif
-		ImGui::TextColored( rendererGPU_TAATime > maxTime ? colorRed : colorWhite,			"                    TAA:          %5llu us", rendererGPU_TAATime );
+		ImGui::TextColored( rendererGPU_TAATime > maxTime ? colorRed : colorWhite,			"RB Shdw: %5llu us   TAA:          %5llu us", rendererBackEndShadowTime, rendererGPU_TAATime );
 		//ImGui::TextColored( rendererGPUToneMapPassTime > maxTime ? colorRed : colorWhite,	"                    ToneMap:      %5llu us", rendererGPUToneMapPassTime );
 		ImGui::TextColored( rendererGPUPostProcessingTime > maxTime ? colorRed : colorWhite, "                    PostFX:       %5llu us", rendererGPUPostProcessingTime );
 		ImGui::TextColored( frameBusyTime > maxTime || rendererGPUTime > maxTime ? colorRed : colorWhite, "Total:   %5lld us   Total:        %5lld us", frameBusyTime, rendererGPUTime );
@@ -587,6 +600,55 @@ idConsoleLocal::DrawMemoryUsage
 */
 float idConsoleLocal::DrawMemoryUsage( float y )
 {
+	static int64 previousNumAllocsTotal = 0;
+
+	memHeapStats_t heapStats;
+	Mem_GetHeapStats( heapStats );
+
+	DrawTextRightAlign( LOCALSAFE_RIGHT, y, "heap %lldkB in %i blocks", ( long long )( heapStats.numBytes >> 10 ), heapStats.numAllocs );
+	DrawTextRightAlign( LOCALSAFE_RIGHT, y, "%lld allocs/frame", ( long long )( heapStats.numAllocsTotal - previousNumAllocsTotal ) );
+
+	previousNumAllocsTotal = heapStats.numAllocsTotal;
+
+	// the tags holding the most memory
+	const int MAX_DRAWN_TAGS = 8;
+
+	int drawnTags[MAX_DRAWN_TAGS];
+	memTagStats_t drawnStats[MAX_DRAWN_TAGS];
+	int numDrawnTags = 0;
+
+	for( int i = 0; i < TAG_NUM_TAGS; i++ )
+	{
+		memTagStats_t stats;
+		Mem_GetTagStats( ( memTag_t )i, stats );
+		if( stats.numAllocs == 0 )
+		{
+			continue;
+		}
+
+		int j = numDrawnTags;
+		while( j > 0 && drawnStats[j - 1].numBytes < stats.numBytes )
+		{
+			if( j < MAX_DRAWN_TAGS )
+			{
+				drawnTags[j] = drawnTags[j - 1];
+				drawnStats[j] = drawnStats[j - 1];
+			}
+			j--;
+		}
+		if( j < MAX_DRAWN_TAGS )
+		{
+			drawnTags[j] = i;
+			drawnStats[j] = stats;
+			numDrawnTags = Min( numDrawnTags + 1, MAX_DRAWN_TAGS );
+		}
+	}
+
+	for( int i = 0; i < numDrawnTags; i++ )
+	{
+		DrawTextRightAlign( LOCALSAFE_RIGHT, y, "%s %lldkB", Mem_GetTagName( ( memTag_t )drawnTags[i] ), ( long long )( drawnStats[i].numBytes >> 10 ) );
+	}
+
 	return y;
 }
 
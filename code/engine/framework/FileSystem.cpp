@@ -134,6 +134,30 @@ struct searchpath_t
 	idList< idZipContainer* > zipFiles;
 };
 
+// range of a mapped resource file queued for prefetching
+struct preloadRange_t
+{
+	const idResourceContainer* owner;
+	int		offset;
+	int		length;
+};
+
+class idSort_PreloadRange : public idSort_Quick< preloadRange_t, idSort_PreloadRange >
+{
+public:
+	int Compare( const preloadRange_t& a, const preloadRange_t& b ) const
+	{
+		if( a.owner != b.owner )
+		{
+			return ( a.owner < b.owner ) ? -1 : 1;
+		}
+		return a.offset - b.offset;
+	}
+};
+
+// ranges closer than this are prefetched as one
+#define PRELOAD_MERGE_GAP		( 64 * 1024 )
+
 // search flags when opening a file
 #define FSFLAG_SEARCH_DIRS		( 1 << 0 )
 #define FSFLAG_RETURN_FILE_MEM	( 1 << 1 )
@@ -279,6 +303,7 @@ private:
 	idStr					manifestName;
 	idStrList				fileManifest;
 	idPreloadManifest		preloadList;
+	idList< preloadRange_t, TAG_RESOURCE >	preloadRanges;
 
 	byte* 	resourceBufferPtr;
 	int		resourceBufferSize;
@@ -341,7 +366,8 @@ idCVar  idFileSystemLocal::fs_game_base( "fs_game_base", "mod_icedhellfire", CVA
 idCVar	fs_basepath( "fs_basepath", "", CVAR_SYSTEM | CVAR_INIT, "" );
 idCVar	fs_savepath( "fs_savepath", "", CVAR_SYSTEM | CVAR_INIT, "" );
 idCVar	fs_resourceLoadPriority( "fs_resourceLoadPriority", "0", CVAR_SYSTEM , "if 1, open requests will be honored from resource files first; if 0, the resource files are checked after normal search paths" );
-idCVar	fs_enableBackgroundCaching( "fs_enableBackgroundCaching", "1", CVAR_SYSTEM , "if 1 allow the 360 to precache game files in the background" );
+idCVar	fs_enableBackgroundCaching( "fs_enableBackgroundCaching", "1", CVAR_SYSTEM , "if 1 prefetch the files listed in the map manifest from mapped resource files while the level loads" );
+idCVar	fs_mapResources( "fs_mapResources", "1", CVAR_SYSTEM | CVAR_INIT | CVAR_BOOL, "if 1 memory map .resources files and read from them without copying" );
 
 idFileSystemLocal	fileSystemLocal;
 idFileSystem* 		fileSystem = &fileSystemLocal;
@@ -367,6 +393,56 @@ idFileSystemLocal::StartPreload
 */
 void idFileSystemLocal::StartPreload( const idStrList& _preload )
 {
+	StopPreload();
+
+	idResourceCacheEntry rc;
+	for( int i = 0; i < _preload.Num(); i++ )
+	{
+		if( GetResourceCacheEntry( _preload[ i ], rc ) && rc.owner->IsMapped() )
+		{
+			preloadRange_t& range = preloadRanges.Alloc();
+			range.owner = rc.owner;
+			range.offset = rc.offset;
+			range.length = rc.length;
+		}
+	}
+
+	if( preloadRanges.Num() == 0 )
+	{
+		return;
+	}
+
+	// issue the reads in file order and merge neighbours so the OS sees a few long
+	// sequential ranges instead of one request per resource
+	preloadRanges.SortWithTemplate( idSort_PreloadRange() );
+
+	int numRanges = 0;
+	for( int i = 1; i < preloadRanges.Num(); i++ )
+	{
+		preloadRange_t& last = preloadRanges[ numRanges ];
+		const preloadRange_t& range = preloadRanges[ i ];
+		if( range.owner == last.owner && range.offset <= last.offset + last.length + PRELOAD_MERGE_GAP )
+		{
+			last.length = Max( last.length, range.offset + range.length - last.offset );
+		}
+		else
+		{
+			preloadRanges[ ++numRanges ] = range;
+		}
+	}
+	preloadRanges.SetNum( numRanges + 1 );
+
+	int totalBytes = 0;
+	for( int i = 0; i < preloadRanges.Num(); i++ )
+	{
+		preloadRanges[ i ].owner->Prefetch( preloadRanges[ i ].offset, preloadRanges[ i ].length );
+		totalBytes += preloadRanges[ i ].length;
+	}
+
+	if( fs_debugResources.GetBool() )
+	{
+		idLib::Printf( "RES: prefetching %d files in %d ranges, %d kB\n", _preload.Num(), preloadRanges.Num(), totalBytes >> 10 );
+	}
 }
 
 /*
@@ -376,6 +452,8 @@ idFileSystemLocal::StopPreload
 */
 void idFileSystemLocal::StopPreload()
 {
+	// the reads already handed to the OS finish on their own
+	preloadRanges.Clear();
 }
 
 /*
@@ -718,6 +796,11 @@ void idFileSystemLocal::EnableBackgroundCache( bool enable )
 	{
 		return;
 	}
+
+	if( !enable )
+	{
+		StopPreload();
+	}
 }
 
 /*
@@ -749,6 +832,30 @@ void idFileSystemLocal::BeginLevelLoad( const char* name, char* _blockBuffer, in
 	if( UsingResourceFiles() )
 	{
 		AddResourceFile( va( "%s.resources", manifestName.c_str() ) );
+
+		if( fs_enableBackgroundCaching.GetBool() )
+		{
+			// start reading everything the level is going to ask for while the map itself parses
+			idFileManifest manifest;
+			if( manifest.LoadManifest( va( "maps/%s.manifest", manifestName.c_str() ) ) )
+			{
+				idStrList files;
+				for( int i = 0; i < manifest.NumFiles(); i++ )
+				{
+					files.Append( manifest.GetFileNameByIndex( i ) );
+				}
+				StartPreload( files );
+			}
+			else
+			{
+				idVec2i idx = FindResourceFile( va( "%s.resources", manifestName.c_str() ) );
+				if( idx.x >= 0 && idx.y >= 0 )
+				{
+					const idResourceContainer* rc = searchPaths[ idx.x ].resourceFiles[ idx.y ];
+					rc->Prefetch( 0, rc->tableOffset );
+				}
+			}
+		}
 	}
 
 }
@@ -3670,6 +3777,13 @@ idFile* idFileSystemLocal::GetResourceFile( const char* fileName, bool memFile )
 			idLib::Printf( "RES: loading file %s\n", rc.filename.c_str() );
 		}
 
+		// mapped containers hand out views of the mapping, the pages are read on first access
+		idFile* mapped = rc.owner->OpenMappedFile( rc );
+		if( mapped != NULL )
+		{
+			return mapped;
+		}
+
 		idFile_InnerResource* file = new idFile_InnerResource( rc.filename, rc.owner->resourceFile, rc.offset, rc.length );
 
 		// DG: add parenthesis to make sure this block is only entered when file != NULL - bug found by clang.
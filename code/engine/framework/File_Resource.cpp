@@ -33,6 +33,8 @@ If you have questions concerning this license or the applicable additional terms
 #include "../sound/WaveFile.h"
 #include "../renderer/CmdlineProgressbar.h"
 
+extern idCVar fs_mapResources;
+
 /*
 ================================================================================================
 
@@ -121,9 +123,47 @@ bool idResourceContainer::Init( const char* _fileName )
 	}
 	Mem_Free( buf );
 
+	// the in memory _ordered.resources is already resident
+	if( fs_mapResources.GetBool() && resourceFile->GetFullPath()[0] != '\0' && idStr::Icmp( _fileName, "_ordered.resources" ) != 0 )
+	{
+		mappedData = Sys_MapFile( resourceFile->GetFullPath(), mappedLength );
+		if( mappedData == NULL )
+		{
+			idLib::Warning( "Unable to map resource file %s, falling back to reads", _fileName );
+		}
+	}
+
 	return true;
 }
 
+/*
+========================
+idResourceContainer::OpenMappedFile
+========================
+*/
+idFile* idResourceContainer::OpenMappedFile( const idResourceCacheEntry& rc ) const
+{
+	if( mappedData == NULL || rc.offset < 0 || rc.length < 0 || ( size_t )rc.offset + rc.length > mappedLength )
+	{
+		return NULL;
+	}
+	return new idFile_Memory( rc.filename, ( const char* )( mappedData + rc.offset ), rc.length );
+}
+
+/*
+========================
+idResourceContainer::Prefetch
+========================
+*/
+void idResourceContainer::Prefetch( int offset, int length ) const
+{
+	if( mappedData == NULL || offset < 0 || length <= 0 || ( size_t )offset >= mappedLength )
+	{
+		return;
+	}
+	Sys_PrefetchMappedFile( mappedData + offset, Min( ( size_t )length, mappedLength - offset ) );
+}
+
 
 /*
 ========================
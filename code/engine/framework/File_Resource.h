@@ -90,9 +90,12 @@ public:
 		tableLength = 0;
 		resourceMagic = 0;
 		numFileResources = 0;
+		mappedData = NULL;
+		mappedLength = 0;
 	}
 	~idResourceContainer()
 	{
+		Sys_UnmapFile( mappedData, mappedLength );
 		delete resourceFile;
 		cacheTable.Clear();
 	}
@@ -113,6 +116,15 @@ public:
 	{
 		return numFileResources;
 	}
+
+	bool IsMapped() const
+	{
+		return mappedData != NULL;
+	}
+	// returns a view straight into the mapped container, NULL if it isn't mapped
+	idFile* OpenMappedFile( const idResourceCacheEntry& rc ) const;
+	// asks the OS to start reading a range of the mapped container
+	void Prefetch( int offset, int length ) const;
 private:
 	idStrStatic< 256 > fileName;
 	idFile* 	resourceFile;			// open file handle
@@ -124,6 +136,8 @@ private:
 	int		numFileResources;		// number of file resources in this container
 	idList< idResourceCacheEntry, TAG_RESOURCE>	cacheTable;
 	idHashIndex	cacheHash;
+	const byte* mappedData;			// whole container mapped into memory, or NULL
+	size_t		mappedLength;
 };
 
 
@@ -0,0 +1,277 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "precompiled.h"
+#pragma hdrstop
+
+#include "LoadGraph.h"
+
+static idParallelJobRegistration registerLoadStage( ( jobRun_t )idLoadGraph::RunStage, "idLoadGraph::RunStage" );
+
+/*
+========================
+idLoadGraph::idLoadGraph
+========================
+*/
+idLoadGraph::idLoadGraph()
+{
+	doneStages = 0;
+	graphStartTime = Sys_Milliseconds();
+}
+
+/*
+========================
+idLoadGraph::~idLoadGraph
+========================
+*/
+idLoadGraph::~idLoadGraph()
+{
+	Wait();
+}
+
+/*
+========================
+idLoadGraph::AddStage
+========================
+*/
+int idLoadGraph::AddStage( const char* name, loadStageFunc_t function, void* data, bool threaded )
+{
+	assert( stages.Num() < MAX_LOAD_STAGES );
+
+	loadStage_t& stage = *stages.Alloc();
+	stage.name = name;
+	stage.function = function;
+	stage.data = data;
+	stage.threaded = threaded;
+	stage.dependencies = 0;
+	stage.state = STAGE_WAITING;
+	stage.jobList = NULL;
+	stage.startTime = 0;
+	stage.endTime = 0;
+	stage.ranOnJobThread = false;
+
+	return stages.Num() - 1;
+}
+
+/*
+========================
+idLoadGraph::AddDependency
+========================
+*/
+void idLoadGraph::AddDependency( int stage, int dependsOn )
+{
+	// only allowing earlier stages keeps the graph free of cycles
+	assert( dependsOn >= 0 && dependsOn < stage && stage < stages.Num() );
+	stages[ stage ].dependencies |= BIT( dependsOn );
+}
+
+/*
+========================
+idLoadGraph::IsReady
+========================
+*/
+bool idLoadGraph::IsReady( const loadStage_t& stage ) const
+{
+	return stage.state == STAGE_WAITING && ( stage.dependencies & ~doneStages ) == 0;
+}
+
+/*
+========================
+idLoadGraph::RunStage
+========================
+*/
+void idLoadGraph::RunStage( loadStage_t* stage )
+{
+	stage->ranOnJobThread = !idLib::IsMainThread();
+	stage->startTime = Sys_Milliseconds();
+	stage->function( stage->data );
+	stage->endTime = Sys_Milliseconds();
+}
+
+/*
+========================
+idLoadGraph::FinishThreadedStage
+========================
+*/
+void idLoadGraph::FinishThreadedStage( int stageNum )
+{
+	loadStage_t& stage = stages[ stageNum ];
+	parallelJobManager->FreeJobList( stage.jobList );
+	stage.jobList = NULL;
+	stage.state = STAGE_DONE;
+	doneStages |= BIT( stageNum );
+}
+
+/*
+========================
+idLoadGraph::Run
+========================
+*/
+void idLoadGraph::Run( bool parallel )
+{
+	graphStartTime = Sys_Milliseconds();
+
+	while( true )
+	{
+		// pick up threaded stages that finished
+		for( int i = 0; i < stages.Num(); i++ )
+		{
+			if( stages[ i ].state == STAGE_RUNNING && stages[ i ].jobList->TryWait() )
+			{
+				FinishThreadedStage( i );
+			}
+		}
+
+		// start threaded stages first so they overlap with the next main thread stage
+		if( parallel )
+		{
+			for( int i = 0; i < stages.Num(); i++ )
+			{
+				loadStage_t& stage = stages[ i ];
+				if( stage.threaded && IsReady( stage ) )
+				{
+					stage.state = STAGE_RUNNING;
+					stage.jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_LOW, 1, 0, NULL );
+					stage.jobList->AddJob( ( jobRun_t )RunStage, &stage );
+					stage.jobList->Submit();
+				}
+			}
+		}
+
+		bool ranStage = false;
+		bool waiting = false;
+		for( int i = 0; i < stages.Num(); i++ )
+		{
+			loadStage_t& stage = stages[ i ];
+			if( stage.state != STAGE_WAITING || ( stage.threaded && parallel ) )
+			{
+				continue;
+			}
+			if( !IsReady( stage ) )
+			{
+				waiting = true;
+				continue;
+			}
+
+			RunStage( &stage );
+			stage.state = STAGE_DONE;
+			doneStages |= BIT( i );
+			ranStage = true;
+			break;
+		}
+
+		if( ranStage )
+		{
+			continue;
+		}
+
+		if( !waiting )
+		{
+			bool allStarted = true;
+			for( int i = 0; i < stages.Num(); i++ )
+			{
+				if( stages[ i ].state == STAGE_WAITING )
+				{
+					allStarted = false;
+					break;
+				}
+			}
+			if( allStarted )
+			{
+				break;
+			}
+		}
+
+		// a main thread stage is waiting for a threaded one
+		common->UpdateLevelLoadPacifier();
+		Sys_Sleep( 1 );
+	}
+}
+
+/*
+========================
+idLoadGraph::Wait
+========================
+*/
+void idLoadGraph::Wait()
+{
+	for( int i = 0; i < stages.Num(); i++ )
+	{
+		if( stages[ i ].state == STAGE_RUNNING )
+		{
+			stages[ i ].jobList->Wait();
+			FinishThreadedStage( i );
+		}
+	}
+}
+
+/*
+========================
+idLoadGraph::AddTimelineEntry
+========================
+*/
+void idLoadGraph::AddTimelineEntry( const char* name, int startTime, int endTime )
+{
+	if( stages.Num() >= MAX_LOAD_STAGES )
+	{
+		return;
+	}
+
+	const int stageNum = AddStage( name, NULL, NULL, false );
+	loadStage_t& stage = stages[ stageNum ];
+	stage.state = STAGE_DONE;
+	stage.startTime = startTime;
+	stage.endTime = endTime;
+	doneStages |= BIT( stageNum );
+}
+
+/*
+========================
+idLoadGraph::PrintTimeline
+========================
+*/
+void idLoadGraph::PrintTimeline() const
+{
+	int endTime = graphStartTime;
+	int stageTime = 0;
+
+	common->Printf( "----- Level load timeline -----\n" );
+	for( int i = 0; i < stages.Num(); i++ )
+	{
+		const loadStage_t& stage = stages[ i ];
+		if( stage.state != STAGE_DONE )
+		{
+			continue;
+		}
+		common->Printf( "%6d - %6d msec  %-4s  %s\n", stage.startTime - graphStartTime, stage.endTime - graphStartTime, stage.ranOnJobThread ? "job" : "main", stage.name );
+
+		endTime = Max( endTime, stage.endTime );
+		stageTime += stage.endTime - stage.startTime;
+	}
+	common->Printf( "%6d msec wall clock for %d msec of stages\n", endTime - graphStartTime, stageTime );
+}
@@ -0,0 +1,105 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#ifndef __LOADGRAPH_H__
+#define __LOADGRAPH_H__
+
+/*
+===============================================================================
+
+	Level load graph
+
+	The level load is split into stages with explicit dependencies. Stages that
+	only touch their own data are flagged as threaded and run on a job thread
+	next to the main thread stages, everything else stays on the main thread in
+	the order it was added. A stage can only depend on stages added before it.
+
+===============================================================================
+*/
+
+typedef void ( *loadStageFunc_t )( void* data );
+
+static const int MAX_LOAD_STAGES = 32;
+
+class idLoadGraph
+{
+public:
+	idLoadGraph();
+	~idLoadGraph();
+
+	int						AddStage( const char* name, loadStageFunc_t function, void* data, bool threaded );
+	void					AddDependency( int stage, int dependsOn );
+
+	// runs all main thread stages and starts the threaded ones as soon as their
+	// dependencies are done, threaded stages may still be running on return
+	void					Run( bool parallel );
+	// waits for the threaded stages to finish
+	void					Wait();
+
+	// adds work done outside the graph to the timeline
+	void					AddTimelineEntry( const char* name, int startTime, int endTime );
+	void					PrintTimeline() const;
+
+private:
+	struct loadStage_t;
+
+public:
+	// job entry point for the threaded stages
+	static void				RunStage( loadStage_t* stage );
+
+private:
+	enum stageState_t
+	{
+		STAGE_WAITING,
+		STAGE_RUNNING,
+		STAGE_DONE
+	};
+
+	struct loadStage_t
+	{
+		const char* 		name;
+		loadStageFunc_t		function;
+		void* 				data;
+		bool				threaded;
+		int					dependencies;		// bit mask of the stages that have to be done first
+		stageState_t		state;
+		idParallelJobList* 	jobList;
+		int					startTime;
+		int					endTime;
+		bool				ranOnJobThread;
+	};
+
+	idStaticList< loadStage_t, MAX_LOAD_STAGES >	stages;
+	int						doneStages;				// bit mask
+	int						graphStartTime;
+
+	bool					IsReady( const loadStage_t& stage ) const;
+	void					FinishThreadedStage( int stageNum );
+};
+
+#endif /* !__LOADGRAPH_H__ */
@@ -0,0 +1,112 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "precompiled.h"
+#pragma hdrstop
+
+#include "BoundsSoA.h"
+
+/*
+========================
+idBoundsSoA::ClearAll
+========================
+*/
+void idBoundsSoA::ClearAll()
+{
+	for( int i = 0; i < 6; i++ )
+	{
+		values[i].Clear();
+	}
+}
+
+/*
+========================
+idBoundsSoA::SetIndex
+========================
+*/
+void idBoundsSoA::SetIndex( const int index, const idBounds& bounds )
+{
+	assert( index >= 0 );
+
+	if( index >= Num() )
+	{
+		const int oldNum = Num();
+		for( int i = 0; i < 6; i++ )
+		{
+			values[i].SetGranularity( 256 );
+			values[i].SetNum( index + 1 );
+		}
+		for( int i = oldNum; i < index; i++ )
+		{
+			ClearIndex( i );
+		}
+	}
+
+	for( int i = 0; i < 3; i++ )
+	{
+		values[0 + i][index] = bounds[0][i];
+		values[3 + i][index] = bounds[1][i];
+	}
+}
+
+/*
+========================
+idBoundsSoA::ClearIndex
+========================
+*/
+void idBoundsSoA::ClearIndex( const int index )
+{
+	if( index >= Num() )
+	{
+		return;
+	}
+
+	// CullBoundsSoAToMVP always culls inverted bounds, the extremes are finite
+	// so the center and extents of a cleared entry never become NaN
+	for( int i = 0; i < 3; i++ )
+	{
+		values[0 + i][index] = idMath::INFINITUM;
+		values[3 + i][index] = -idMath::INFINITUM;
+	}
+}
+
+/*
+========================
+idBoundsSoA::GetBounds
+========================
+*/
+boundsSoA_t idBoundsSoA::GetBounds() const
+{
+	boundsSoA_t bounds;
+	for( int i = 0; i < 3; i++ )
+	{
+		bounds.min[i] = values[0 + i].Ptr();
+		bounds.max[i] = values[3 + i].Ptr();
+	}
+	return bounds;
+}
@@ -0,0 +1,64 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#ifndef __BOUNDSSOA_H__
+#define __BOUNDSSOA_H__
+
+/*
+================================================================================================
+
+idBoundsSoA
+
+Keeps the global bounds of all entity or light defs of a world in separate arrays for the
+min and max of each axis, indexed by the def index. This lets the front end cull whole lists
+of defs with idRenderMatrix::CullBoundsSoAToMVP instead of one bounds at a time.
+
+================================================================================================
+*/
+class idBoundsSoA
+{
+public:
+	void			ClearAll();
+
+	void			SetIndex( const int index, const idBounds& bounds );
+
+	// a cleared index is always culled
+	void			ClearIndex( const int index );
+
+	int				Num() const
+	{
+		return values[0].Num();
+	}
+
+	boundsSoA_t		GetBounds() const;
+
+private:
+	idList<float, TAG_RENDER>	values[6];	// min x, y, z and max x, y, z
+};
+
+#endif // __BOUNDSSOA_H__
@@ -76,6 +76,9 @@ extern "C"
 }
 #include <queue>
 #define NUM_LAG_FRAMES 15	// SRS - Lag audio by 15 frames (~1/2 sec at 30 fps) for ffmpeg bik decoder AV sync
+#define NUM_QUEUED_FRAMES 4	// converted frames the decode thread keeps ahead of playback
+
+idCVar r_cinematicDecodeThread( "r_cinematicDecodeThread", "1", CVAR_RENDERER | CVAR_BOOL, "decode and convert FFmpeg cinematics ahead of playback on a background thread" );
 #endif
 
 #ifdef USE_BINKDEC
@@ -89,8 +92,41 @@ extern "C"
 	#include <BinkDecoder.h>
 #endif // USE_BINKDEC
 
+#if defined(USE_FFMPEG)
+class idCinematicLocal;
+
+/*
+================================================
+idCinematicDecodeThread
+
+Fills the frame queues of the FFmpeg cinematics that are playing. One thread
+is shared by all cinematics, it is started when the first one plays past its
+first frame. A cinematic asks for more frames after each ImageForTime call.
+================================================
+*/
+class idCinematicDecodeThread : public idSysThread
+{
+public:
+	virtual int				Run();
+
+	void					AddCinematic( idCinematicLocal* cinematic );
+	void					RemoveCinematic( idCinematicLocal* cinematic );
+
+private:
+	idSysMutex				pendingMutex;
+	idList<idCinematicLocal*, TAG_CINEMATIC>	pending;	// cinematics with free queue slots
+};
+
+static idCinematicDecodeThread* cinematicDecodeThread = NULL;
+#endif
+
 class idCinematicLocal : public idCinematic
 {
+#if defined(USE_FFMPEG)
+	friend class idCinematicDecodeThread;
+	friend void BenchCinematic_f( const idCmdArgs& args );
+#endif
+
 public:
 	idCinematicLocal();
 	virtual					~idCinematicLocal();
@@ -114,7 +150,6 @@ private:
 	int						audio_stream_index; //GK: Make extra indexer for audio
 	AVFormatContext*		fmt_ctx;
 	AVFrame*				frame;
-	AVFrame*				frame2;
 	AVFrame*				frame3; //GK: make extra frame for audio
 #if LIBAVCODEC_VERSION_MAJOR > 58
 	const AVCodec*			dec;
@@ -137,6 +172,31 @@ private:
 	std::queue<uint8_t*>	lagBuffer;
 	std::queue<int>			lagBufSize;
 	bool					skipLag;
+
+	// decoded and converted video frames, with the audio that was decoded along with them
+	struct decodedFrame_t
+	{
+		byte*					image;
+		uint8_t*				data[4];
+		int						linesize[4];
+		long					framePos;
+		std::queue<uint8_t*>	audio;
+		std::queue<int>			audioSize;
+	};
+	decodedFrame_t			frameQueue[NUM_QUEUED_FRAMES];
+	int						queueRead;		// oldest decoded frame
+	int						queueCount;		// only the decode thread adds, only ImageForTime removes
+	long					decodedFrames;	// frames decoded since the last reset
+	bool					decodeEOF;
+	idSysMutex				decodeMutex;	// held by whoever uses the queue and the decoder
+
+	cinData_t				UpdateFFMPEGFrame( int thisTime, nvrhi::ICommandList* commandList );
+	bool					DecodeFFMPEGFrame();
+	void					DecodeFFMPEGAhead();
+	bool					WantsFFMPEGDecodeAhead() const;
+	const byte*				AdvanceFFMPEGFrames( int thisTime, long desiredFrame );
+	void					FlushFFMPEGFrames();
+	void					FreeFFMPEGFrames();
 #endif
 #ifdef USE_BINKDEC
 	BinkHandle				binkHandle;
@@ -259,6 +319,79 @@ static unsigned short* 	vq8 = NULL;
 
 extern idCVar s_noSound;
 
+#if defined(USE_FFMPEG)
+/*
+==============
+BenchCinematic_f
+
+Decodes a FFmpeg video without uploading it to the renderer, first on the calling
+thread and then through the decode thread, paced at the video frame rate.
+Prints what each frame costs the thread that calls ImageForTime.
+==============
+*/
+void BenchCinematic_f( const idCmdArgs& args )
+{
+	if( args.Argc() < 2 )
+	{
+		common->Printf( "usage: benchCinematic <video> [numFrames]\n" );
+		return;
+	}
+
+	const int numFrames = ( args.Argc() > 2 ) ? Max( 1, atoi( args.Argv( 2 ) ) ) : 150;
+	const bool useThread = r_cinematicDecodeThread.GetBool();
+
+	for( int pass = 0; pass < 2; pass++ )
+	{
+		r_cinematicDecodeThread.SetBool( pass == 1 );
+
+		idCinematicLocal* cin = new idCinematicLocal;
+		if( !cin->InitFromFile( args.Argv( 1 ), false, NULL ) || cin->isRoQ )
+		{
+			common->Printf( "benchCinematic: '%s' is not a FFmpeg video\n", args.Argv( 1 ) );
+			delete cin;
+			break;
+		}
+
+		const int frameMsec = idMath::Ftoi( 1000.0f / Max( cin->frameRate, 1.0f ) );
+
+		uint64 totalTime = 0;
+		uint64 worstTime = 0;
+		int frames = 0;
+		for( ; frames < numFrames; frames++ )
+		{
+			const uint64 start = Sys_Microseconds();
+
+			cin->decodeMutex.Lock();
+			const byte* image = cin->AdvanceFFMPEGFrames( 0, cin->framePos + 1 );
+			const bool decodeAhead = cin->WantsFFMPEGDecodeAhead();
+			cin->decodeMutex.Unlock();
+			if( image != NULL && decodeAhead )
+			{
+				cinematicDecodeThread->AddCinematic( cin );
+			}
+
+			const uint64 elapsed = Sys_Microseconds() - start;
+			if( image == NULL )
+			{
+				break;
+			}
+			totalTime += elapsed;
+			worstTime = Max( worstTime, elapsed );
+
+			// stands in for rendering the frame
+			Sys_Sleep( frameMsec );
+		}
+
+		common->Printf( "%s: %i frames, %.2f ms average, %.2f ms worst\n", ( pass == 1 ) ? "decode thread" : "synchronous  ", frames,
+						( frames > 0 ) ? totalTime / ( 1000.0 * frames ) : 0.0, worstTime / 1000.0 );
+
+		delete cin;
+	}
+
+	r_cinematicDecodeThread.SetBool( useThread );
+}
+#endif
+
 
 //===========================================
 
@@ -295,6 +428,12 @@ void idCinematic::InitCinematic()
 	vq4 = ( word* )Mem_Alloc( 256 * 64 * 4 * sizeof( word ), TAG_CINEMATIC );
 	vq8 = ( word* )Mem_Alloc( 256 * 256 * 4 * sizeof( word ), TAG_CINEMATIC );
 
+#if defined(USE_FFMPEG)
+	// only started once a cinematic plays past its first frame
+	cinematicDecodeThread = new( TAG_CINEMATIC ) idCinematicDecodeThread;
+
+	cmdSystem->AddCommand( "benchCinematic", BenchCinematic_f, CMD_FL_RENDERER, "decodes a video without uploading it and prints the cost per frame" );
+#endif
 }
 
 /*
@@ -304,6 +443,13 @@ idCinematic::ShutdownCinematic
 */
 void idCinematic::ShutdownCinematic()
 {
+#if defined(USE_FFMPEG)
+	// stopped before its pending list is destroyed
+	cinematicDecodeThread->StopThread();
+	delete cinematicDecodeThread;
+	cinematicDecodeThread = NULL;
+#endif
+
 	// Carl: Original Doom 3 RoQ files:
 	Mem_Free( file );
 	file = NULL;
@@ -456,11 +602,9 @@ idCinematicLocal::idCinematicLocal()
 	// Carl: ffmpeg stuff, for bink and normal video files:
 #if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(55,28,1)
 	frame = av_frame_alloc();
-	frame2 = av_frame_alloc();
 	frame3 = av_frame_alloc();
 #else
 	frame = avcodec_alloc_frame();
-	frame2 = avcodec_alloc_frame();
 	frame3 = avcodec_alloc_frame();
 #endif // LIBAVCODEC_VERSION_INT
 	dec_ctx = NULL;
@@ -474,6 +618,15 @@ idCinematicLocal::idCinematicLocal()
 	hasFrame = false;
 	framePos = -1;
 	skipLag = false;
+	for( int i = 0; i < NUM_QUEUED_FRAMES; i++ )
+	{
+		frameQueue[i].image = NULL;
+		frameQueue[i].framePos = -1;
+	}
+	queueRead = 0;
+	queueCount = 0;
+	decodedFrames = 0;
+	decodeEOF = false;
 #endif
 
 #ifdef USE_BINKDEC
@@ -553,11 +706,9 @@ idCinematicLocal::~idCinematicLocal()
 	// SRS - Should use the same version criteria as when the frames are allocated in idCinematicLocal() above
 #if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(55,28,1)
 	av_frame_free( &frame );
-	av_frame_free( &frame2 );
 	av_frame_free( &frame3 );
 #else
 	av_freep( &frame );
-	av_freep( &frame2 );
 	av_freep( &frame3 );
 #endif
 #endif
@@ -711,6 +862,9 @@ bool idCinematicLocal::InitFromFFMPEGFile( const char* qpath, bool amilooping, n
 	//dec_ctx->time_base = fmt_ctx->streams[video_stream_index]->time_base;			// SRS - decoder timebase is set by avcodec_open2()
 	dec_ctx->framerate = fmt_ctx->streams[video_stream_index]->avg_frame_rate;
 	dec_ctx->pkt_timebase = fmt_ctx->streams[video_stream_index]->time_base;		// SRS - packet timebase for frame->pts timestamps
+	// slice threads only, frame threading delays output and would drop the last frames at EOF
+	dec_ctx->thread_count = 0;
+	dec_ctx->thread_type = FF_THREAD_SLICE;
 	/* init the video decoder */
 	if( ( ret = avcodec_open2( dec_ctx, dec, NULL ) ) < 0 )
 	{
@@ -809,17 +963,13 @@ bool idCinematicLocal::InitFromFFMPEGFile( const char* qpath, bool amilooping, n
 	frameRate = av_q2d( fmt_ctx->streams[video_stream_index]->avg_frame_rate );
 	common->Printf( "Loaded FFMPEG file: '%s', looping=%d, %dx%d, %3.2f FPS, %4.1f sec\n", qpath, looping, CIN_WIDTH, CIN_HEIGHT, frameRate, durationSec );
 
-	// SRS - Get image buffer size (dimensions mod 32 for bik & webm codecs, subsumes mod 16 for mp4 codec), then allocate image and fill with correct parameters
-	int bufWidth = ( CIN_WIDTH + 31 ) & ~31;
-	int bufHeight = ( CIN_HEIGHT + 31 ) & ~31;
-	int img_bytes = av_image_get_buffer_size( AV_PIX_FMT_BGR32, bufWidth, bufHeight, 1 );
-	image = ( byte* )Mem_Alloc( img_bytes, TAG_CINEMATIC );
-	av_image_fill_arrays( frame2->data, frame2->linesize, image, AV_PIX_FMT_BGR32, CIN_WIDTH, CIN_HEIGHT, 1 ); //GK: Straight out of the FFMPEG source code
+	// the frame queue images are allocated when frames are first decoded into them
 	img_convert_ctx = sws_getContext( dec_ctx->width, dec_ctx->height, dec_ctx->pix_fmt, CIN_WIDTH, CIN_HEIGHT, AV_PIX_FMT_BGR32, SWS_BICUBIC, NULL, NULL, NULL );
 
 	status = FMV_PLAY;
 	hasFrame = false;
 	framePos = -1;
+	FlushFFMPEGFrames();
 	ImageForTime( 0, commandList );
 	status = ( looping ) ? FMV_PLAY : FMV_IDLE;
 
@@ -838,6 +988,8 @@ void idCinematicLocal::FFMPEGReset()
 	// RB: don't reset startTime here because that breaks video replays in the PDAs
 	//startTime = 0;
 
+	FlushFFMPEGFrames();
+
 	framePos = -1;
 
 	// SRS - If we have cinematic audio, reset audio to release any stale buffers and avoid AV drift if looping
@@ -1154,6 +1306,16 @@ void idCinematicLocal::Close()
 #if defined(USE_FFMPEG)
 	else //if( !isRoQ )
 	{
+		// once it is off the list, the decode thread is done with this cinematic when it gives up the lock
+		if( cinematicDecodeThread != NULL )
+		{
+			cinematicDecodeThread->RemoveCinematic( this );
+		}
+		decodeMutex.Lock();
+		FlushFFMPEGFrames();
+		FreeFFMPEGFrames();
+		decodeMutex.Unlock();
+
 		if( img_convert_ctx )
 		{
 			sws_freeContext( img_convert_ctx );
@@ -1370,12 +1532,31 @@ idCinematicLocal::ImageForTimeFFMPEG
 */
 #if defined(USE_FFMPEG)
 cinData_t idCinematicLocal::ImageForTimeFFMPEG( int thisTime, nvrhi::ICommandList* commandList )
+{
+	decodeMutex.Lock();
+	const cinData_t cinData = UpdateFFMPEGFrame( thisTime, commandList );
+	const bool decodeAhead = WantsFFMPEGDecodeAhead();
+	decodeMutex.Unlock();
+
+	// refill the queue while the frame is rendered
+	if( decodeAhead )
+	{
+		cinematicDecodeThread->AddCinematic( this );
+	}
+
+	return cinData;
+}
+
+/*
+==============
+idCinematicLocal::UpdateFFMPEGFrame
+
+Uploads the frame for the time, decodeMutex must be held
+==============
+*/
+cinData_t idCinematicLocal::UpdateFFMPEGFrame( int thisTime, nvrhi::ICommandList* commandList )
 {
 	cinData_t	cinData;
-	char		error[64];
-	uint8_t*	audioBuffer = NULL;
-	int			num_bytes = 0;
-	bool		syncLost = false;
 
 	memset( &cinData, 0, sizeof( cinData ) );
 	if( !fmt_ctx )
@@ -1415,183 +1596,416 @@ cinData_t idCinematicLocal::ImageForTimeFFMPEG( int thisTime, nvrhi::ICommandLis
 		return cinData;
 	}
 
-	AVPacket packet;
+	// only the newest of the frames that became due is uploaded
+	const byte* newImage = AdvanceFFMPEGFrames( thisTime, desiredFrame );
+	if( newImage == NULL )
+	{
+		return cinData;
+	}
+
+	cinData.imageWidth = CIN_WIDTH;
+	cinData.imageHeight = CIN_HEIGHT;
+	cinData.status = status;
+	img->UploadScratch( newImage, CIN_WIDTH, CIN_HEIGHT, commandList );
+	hasFrame = true;
+	cinData.image = img;
+
+	return cinData;
+}
+
+/*
+==============
+idCinematicLocal::WantsFFMPEGDecodeAhead
+
+Opening a cinematic only decodes its first frame, the frame queue is
+filled ahead once playback moved past it. decodeMutex must be held.
+==============
+*/
+bool idCinematicLocal::WantsFFMPEGDecodeAhead() const
+{
+	return r_cinematicDecodeThread.GetBool() && cinematicDecodeThread != NULL && framePos > 0 && !decodeEOF && queueCount < NUM_QUEUED_FRAMES;
+}
+
+/*
+==============
+idCinematicLocal::AdvanceFFMPEGFrames
+
+Takes decoded frames off the queue until desiredFrame is reached, decoding on the
+calling thread if the decode thread fell behind, and plays the audio that came
+with them. Returns the newest frame or NULL once a non looping video ended.
+==============
+*/
+const byte* idCinematicLocal::AdvanceFFMPEGFrames( int thisTime, long desiredFrame )
+{
+	const byte*	newImage = NULL;
+	bool		syncLost = false;
+
 	while( framePos < desiredFrame )
 	{
-		int frameFinished = -1;
-		int res = 0;
+		if( queueCount == 0 && !decodeEOF )
+		{
+			DecodeFFMPEGFrame();
+		}
 
-		// Do a single frame by getting packets until we have a full frame
-		while( frameFinished != 0 )
+		if( queueCount == 0 )
 		{
-			// if we got to the end or failed
-			if( av_read_frame( fmt_ctx, &packet ) < 0 )
+			// can't read any more, set to EOF
+			status = FMV_EOF;
+			if( looping )
 			{
-				// can't read any more, set to EOF
-				status = FMV_EOF;
-				if( looping )
-				{
-					desiredFrame = 0;
-					FFMPEGReset();
-					hasFrame = false;
-					startTime = thisTime;
-					if( av_read_frame( fmt_ctx, &packet ) < 0 )
-					{
-						status = FMV_IDLE;
-						return cinData;
-					}
-					status = FMV_PLAY;
-				}
-				else
+				desiredFrame = 0;
+				FFMPEGReset();
+				hasFrame = false;
+				startTime = thisTime;
+				if( !DecodeFFMPEGFrame() )
 				{
-					hasFrame = false;
 					status = FMV_IDLE;
-					return cinData;
+					return NULL;
 				}
+				status = FMV_PLAY;
+			}
+			else
+			{
+				// playback ended, nothing is decoded until the cinematic is reset
+				FreeFFMPEGFrames();
+				hasFrame = false;
+				status = FMV_IDLE;
+				return NULL;
+			}
+		}
+
+		decodedFrame_t& decoded = frameQueue[queueRead];
+		framePos = decoded.framePos;
+
+		const bool hasAudio = !decoded.audio.empty();
+		while( !decoded.audio.empty() )
+		{
+			// SRS - If queue is at max size we have lost a/v sync: drop frame and set syncLost flag
+			if( lagBuffer.size() == ( skipLag ? 1 : NUM_LAG_FRAMES ) )
+			{
+				av_freep( &lagBuffer.front() );
+				lagBuffer.pop();
+				lagBufSize.pop();
+
+				syncLost = true;
+			}
+
+			// SRS - Save the current (new) audio buffer and its size to play during the desired frame
+			lagBuffer.push( decoded.audio.front() );
+			lagBufSize.push( decoded.audioSize.front() );
+			decoded.audio.pop();
+			decoded.audioSize.pop();
+		}
+
+		// SRS - If we have any synced audio frames available for the desired frame, play now and drain queue
+		if( hasAudio && framePos == desiredFrame )
+		{
+			if( syncLost )
+			{
+				// SRS - If we have lost sync, reset / resync audio stream before starting to play again
+				cinematicAudio->ResetAudio();
+				syncLost = false;
 			}
-			// Is this a packet from the video stream?
-			if( packet.stream_index == video_stream_index )
+
+			while( !lagBuffer.empty() )
 			{
-				// Decode video frame
-				if( ( res = avcodec_send_packet( dec_ctx, &packet ) ) != 0 )
+				// SRS - Note that PlayAudio() is responsible for releasing any audio buffers sent to it
+				if( !s_noSound.GetBool() )
 				{
-					av_strerror( res, error, sizeof( error ) );
-					common->Warning( "idCinematic: Failed to send video packet for decoding with error: %s\n", error );
+					cinematicAudio->PlayAudio( lagBuffer.front(), lagBufSize.front() );
 				}
 				else
 				{
-					frameFinished = avcodec_receive_frame( dec_ctx, frame );
-					if( frameFinished != 0 && frameFinished != AVERROR( EAGAIN ) )
-					{
-						av_strerror( frameFinished, error, sizeof( error ) );
-						common->Warning( "idCinematic: Failed to receive video frame from decoding with error: %s\n", error );
-					}
+					av_freep( &lagBuffer.front() );
 				}
+
+				lagBuffer.pop();
+				lagBufSize.pop();
 			}
-			//GK:Begin
-			else if( cinematicAudio && packet.stream_index == audio_stream_index ) //Check if it found any audio data
+		}
+
+		// the slot isn't written again before the decode thread is signaled
+		newImage = decoded.image;
+		queueRead = ( queueRead + 1 ) % NUM_QUEUED_FRAMES;
+		queueCount--;
+	}
+
+	return newImage;
+}
+
+/*
+==============
+idCinematicLocal::DecodeFFMPEGFrame
+
+Reads packets until the next video frame is complete and converts it into the next
+free queue slot. Audio decoded on the way is attached to that frame. Runs on the
+decode thread, or on the calling thread when there is none.
+==============
+*/
+bool idCinematicLocal::DecodeFFMPEGFrame()
+{
+	char		error[64];
+	uint8_t*	audioBuffer = NULL;
+	int			num_bytes = 0;
+
+	if( queueCount == NUM_QUEUED_FRAMES || decodeEOF )
+	{
+		return false;
+	}
+
+	// decoding without the thread keeps using the first slot and its image
+	if( queueCount == 0 )
+	{
+		queueRead = 0;
+	}
+
+	decodedFrame_t& decoded = frameQueue[( queueRead + queueCount ) % NUM_QUEUED_FRAMES];
+
+	AVPacket packet;
+	int frameFinished = -1;
+	int res = 0;
+
+	// Do a single frame by getting packets until we have a full frame
+	while( frameFinished != 0 )
+	{
+		// if we got to the end or failed
+		if( av_read_frame( fmt_ctx, &packet ) < 0 )
+		{
+			// audio without a frame to go with it is dropped
+			while( !decoded.audio.empty() )
+			{
+				av_freep( &decoded.audio.front() );
+				decoded.audio.pop();
+				decoded.audioSize.pop();
+			}
+			decodeEOF = true;
+			return false;
+		}
+		// Is this a packet from the video stream?
+		if( packet.stream_index == video_stream_index )
+		{
+			// Decode video frame
+			if( ( res = avcodec_send_packet( dec_ctx, &packet ) ) != 0 )
+			{
+				av_strerror( res, error, sizeof( error ) );
+				common->Warning( "idCinematic: Failed to send video packet for decoding with error: %s\n", error );
+			}
+			else
 			{
-				res = avcodec_send_packet( dec_ctx2, &packet );
-				if( res != 0 && res != AVERROR( EAGAIN ) )
+				frameFinished = avcodec_receive_frame( dec_ctx, frame );
+				if( frameFinished != 0 && frameFinished != AVERROR( EAGAIN ) )
 				{
-					av_strerror( res, error, sizeof( error ) );
-					common->Warning( "idCinematic: Failed to send audio packet for decoding with error: %s\n", error );
+					av_strerror( frameFinished, error, sizeof( error ) );
+					common->Warning( "idCinematic: Failed to receive video frame from decoding with error: %s\n", error );
 				}
-				//SRS - Separate frame finisher for audio since there can be multiple audio frames per video frame (e.g. at bik startup)
-				int frameFinished1 = 0;
-				while( frameFinished1 == 0 )
+			}
+		}
+		//GK:Begin
+		else if( cinematicAudio && packet.stream_index == audio_stream_index ) //Check if it found any audio data
+		{
+			res = avcodec_send_packet( dec_ctx2, &packet );
+			if( res != 0 && res != AVERROR( EAGAIN ) )
+			{
+				av_strerror( res, error, sizeof( error ) );
+				common->Warning( "idCinematic: Failed to send audio packet for decoding with error: %s\n", error );
+			}
+			//SRS - Separate frame finisher for audio since there can be multiple audio frames per video frame (e.g. at bik startup)
+			int frameFinished1 = 0;
+			while( frameFinished1 == 0 )
+			{
+				if( ( frameFinished1 = avcodec_receive_frame( dec_ctx2, frame3 ) ) != 0 )
 				{
-					if( ( frameFinished1 = avcodec_receive_frame( dec_ctx2, frame3 ) ) != 0 )
+					if( frameFinished1 != AVERROR( EAGAIN ) )
 					{
-						if( frameFinished1 != AVERROR( EAGAIN ) )
-						{
-							av_strerror( frameFinished1, error, sizeof( error ) );
-							common->Warning( "idCinematic: Failed to receive audio frame from decoding with error: %s\n", error );
-						}
+						av_strerror( frameFinished1, error, sizeof( error ) );
+						common->Warning( "idCinematic: Failed to receive audio frame from decoding with error: %s\n", error );
 					}
-					// SRS - Allocate audio buffer, convert to packed format, save in queue, and play synced audio for desired frame
-					else
-					{
-						// SRS - Since destination sample format is packed (non-planar), returned bufflinesize equals num_bytes
+				}
+				// SRS - Allocate audio buffer, convert to packed format and keep it with the frame being decoded
+				else
+				{
+					// SRS - Since destination sample format is packed (non-planar), returned bufflinesize equals num_bytes
 #if	LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59,37,100)
-						res = av_samples_alloc( &audioBuffer, &num_bytes, frame3->ch_layout.nb_channels, frame3->nb_samples, dst_smp, 0 );
+					res = av_samples_alloc( &audioBuffer, &num_bytes, frame3->ch_layout.nb_channels, frame3->nb_samples, dst_smp, 0 );
 #else
-						res = av_samples_alloc( &audioBuffer, &num_bytes, frame3->channels, frame3->nb_samples, dst_smp, 0 );
+					res = av_samples_alloc( &audioBuffer, &num_bytes, frame3->channels, frame3->nb_samples, dst_smp, 0 );
 #endif
-						if( res < 0 || res != num_bytes )
-						{
-							common->Warning( "idCinematic: Failed to allocate audio buffer with result: %d\n", res );
-						}
-						if( hasplanar )
-						{
-							// SRS - Convert from planar to packed format keeping sample count the same
-							res = swr_convert( swr_ctx, &audioBuffer, frame3->nb_samples, ( const uint8_t** )frame3->extended_data, frame3->nb_samples );
-							if( res < 0 || res != frame3->nb_samples )
-							{
-								common->Warning( "idCinematic: Failed to convert planar audio data to packed format with result: %d\n", res );
-							}
-						}
-						else
+					if( res < 0 || res != num_bytes )
+					{
+						common->Warning( "idCinematic: Failed to allocate audio buffer with result: %d\n", res );
+					}
+					if( hasplanar )
+					{
+						// SRS - Convert from planar to packed format keeping sample count the same
+						res = swr_convert( swr_ctx, &audioBuffer, frame3->nb_samples, ( const uint8_t** )frame3->extended_data, frame3->nb_samples );
+						if( res < 0 || res != frame3->nb_samples )
 						{
-							// SRS - Since audio is already in packed format, just copy into audio buffer
-							if( num_bytes > 0 )
-							{
-								memcpy( audioBuffer, frame3->extended_data[0], num_bytes );
-							}
+							common->Warning( "idCinematic: Failed to convert planar audio data to packed format with result: %d\n", res );
 						}
-
-						// SRS - If we have cinematic audio data, save the current frame onto the back of the queue
+					}
+					else
+					{
+						// SRS - Since audio is already in packed format, just copy into audio buffer
 						if( num_bytes > 0 )
 						{
-							// SRS - If queue is at max size we have lost a/v sync: drop frame and set syncLost flag
-							if( lagBuffer.size() == ( skipLag ? 1 : NUM_LAG_FRAMES ) )
-							{
-								av_freep( &lagBuffer.front() );
-								lagBuffer.pop();
-								lagBufSize.pop();
-
-								syncLost = true;
-							}
-
-							// SRS - Save the current (new) audio buffer and its size to play during the desired frame
-							lagBuffer.push( audioBuffer );
-							lagBufSize.push( num_bytes );
-						}
-						// SRS - Not sure if an audioBuffer can ever be allocated on failure, but check and free just in case
-						else if( audioBuffer )
-						{
-							av_freep( &audioBuffer );
+							memcpy( audioBuffer, frame3->extended_data[0], num_bytes );
 						}
+					}
 
-						// SRS - If we have any synced audio frames available for the desired frame, play now and drain queue
-						if( framePos + 1 == desiredFrame )
-						{
-							if( syncLost )
-							{
-								// SRS - If we have lost sync, reset / resync audio stream before starting to play again
-								cinematicAudio->ResetAudio();
-								syncLost = false;
-							}
-
-							while( !lagBuffer.empty() )
-							{
-								// SRS - Note that PlayAudio() is responsible for releasing any audio buffers sent to it
-								if( !s_noSound.GetBool() )
-								{
-									cinematicAudio->PlayAudio( lagBuffer.front(), lagBufSize.front() );
-								}
-								else
-								{
-									av_freep( &lagBuffer.front() );
-								}
-
-								lagBuffer.pop();
-								lagBufSize.pop();
-							}
-						}
-						//common->Printf( "idCinematic: video pts = %7.3f, audio pts = %7.3f, samples = %4d, num_bytes = %5d\n", static_cast<double>( frame->pts ) * av_q2d( dec_ctx->pkt_timebase ), static_cast<double>( frame3->pts ) * av_q2d( dec_ctx2->pkt_timebase ), frame3->nb_samples, num_bytes );
+					if( num_bytes > 0 )
+					{
+						decoded.audio.push( audioBuffer );
+						decoded.audioSize.push( num_bytes );
+					}
+					// SRS - Not sure if an audioBuffer can ever be allocated on failure, but check and free just in case
+					else if( audioBuffer )
+					{
+						av_freep( &audioBuffer );
 					}
+					//common->Printf( "idCinematic: video pts = %7.3f, audio pts = %7.3f, samples = %4d, num_bytes = %5d\n", static_cast<double>( frame->pts ) * av_q2d( dec_ctx->pkt_timebase ), static_cast<double>( frame3->pts ) * av_q2d( dec_ctx2->pkt_timebase ), frame3->nb_samples, num_bytes );
 				}
 			}
-			//GK:End
-			// Free the packet that was allocated by av_read_frame
-			av_packet_unref( &packet );
 		}
+		//GK:End
+		// Free the packet that was allocated by av_read_frame
+		av_packet_unref( &packet );
+	}
 
-		framePos++;
+	if( decoded.image == NULL )
+	{
+		// SRS - Get image buffer size (dimensions mod 32 for bik & webm codecs, subsumes mod 16 for mp4 codec), then allocate image and fill with correct parameters
+		int bufWidth = ( CIN_WIDTH + 31 ) & ~31;
+		int bufHeight = ( CIN_HEIGHT + 31 ) & ~31;
+		int img_bytes = av_image_get_buffer_size( AV_PIX_FMT_BGR32, bufWidth, bufHeight, 1 );
+		decoded.image = ( byte* )Mem_Alloc( img_bytes, TAG_CINEMATIC );
+		av_image_fill_arrays( decoded.data, decoded.linesize, decoded.image, AV_PIX_FMT_BGR32, CIN_WIDTH, CIN_HEIGHT, 1 ); //GK: Straight out of the FFMPEG source code
 	}
 
-	// We have reached the desired frame
 	// Convert the image from its native format to RGB
-	sws_scale( img_convert_ctx, frame->data, frame->linesize, 0, dec_ctx->height, frame2->data, frame2->linesize );
-	cinData.imageWidth = CIN_WIDTH;
-	cinData.imageHeight = CIN_HEIGHT;
-	cinData.status = status;
-	img->UploadScratch( image, CIN_WIDTH, CIN_HEIGHT, commandList );
-	hasFrame = true;
-	cinData.image = img;
+	sws_scale( img_convert_ctx, frame->data, frame->linesize, 0, dec_ctx->height, decoded.data, decoded.linesize );
 
-	return cinData;
+	decoded.framePos = decodedFrames++;
+	queueCount++;
+
+	return true;
+}
+
+/*
+==============
+idCinematicLocal::DecodeFFMPEGAhead
+==============
+*/
+void idCinematicLocal::DecodeFFMPEGAhead()
+{
+	while( DecodeFFMPEGFrame() )
+	{
+	}
+}
+
+/*
+==============
+idCinematicLocal::FlushFFMPEGFrames
+
+Drops all queued frames and their audio, the decode thread must be idle.
+==============
+*/
+void idCinematicLocal::FlushFFMPEGFrames()
+{
+	for( int i = 0; i < NUM_QUEUED_FRAMES; i++ )
+	{
+		decodedFrame_t& decoded = frameQueue[i];
+		while( !decoded.audio.empty() )
+		{
+			av_freep( &decoded.audio.front() );
+			decoded.audio.pop();
+			decoded.audioSize.pop();
+		}
+		decoded.framePos = -1;
+	}
+	queueRead = 0;
+	queueCount = 0;
+	decodedFrames = 0;
+	decodeEOF = false;
+}
+
+/*
+==============
+idCinematicLocal::FreeFFMPEGFrames
+
+Frees the images of the frame queue, they are allocated again when decoding resumes.
+==============
+*/
+void idCinematicLocal::FreeFFMPEGFrames()
+{
+	assert( queueCount == 0 );
+
+	for( int i = 0; i < NUM_QUEUED_FRAMES; i++ )
+	{
+		Mem_Free( frameQueue[i].image );
+		frameQueue[i].image = NULL;
+	}
+}
+
+/*
+==============
+idCinematicDecodeThread::Run
+==============
+*/
+int idCinematicDecodeThread::Run()
+{
+	while( true )
+	{
+		pendingMutex.Lock();
+		if( pending.Num() == 0 )
+		{
+			pendingMutex.Unlock();
+			break;
+		}
+		idCinematicLocal* cinematic = pending[0];
+		pending.RemoveIndex( 0 );
+
+		// the cinematic is locked before the list is unlocked, so Close waits until it is decoded,
+		// it is skipped while its ImageForTime runs, which adds it again
+		const bool locked = cinematic->decodeMutex.Lock( false );
+		pendingMutex.Unlock();
+
+		if( locked )
+		{
+			cinematic->DecodeFFMPEGAhead();
+			cinematic->decodeMutex.Unlock();
+		}
+	}
+	return 0;
+}
+
+/*
+==============
+idCinematicDecodeThread::AddCinematic
+==============
+*/
+void idCinematicDecodeThread::AddCinematic( idCinematicLocal* cinematic )
+{
+	pendingMutex.Lock();
+	if( !IsRunning() )
+	{
+		StartWorkerThread( "Cinematic", CORE_ANY, THREAD_NORMAL );
+	}
+	pending.AddUnique( cinematic );
+	pendingMutex.Unlock();
+
+	SignalWork();
+}
+
+/*
+==============
+idCinematicDecodeThread::RemoveCinematic
+==============
+*/
+void idCinematicDecodeThread::RemoveCinematic( idCinematicLocal* cinematic )
+{
+	pendingMutex.Lock();
+	pending.Remove( cinematic );
+	pendingMutex.Unlock();
 }
 #endif
 
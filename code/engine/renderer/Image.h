@@ -389,6 +389,23 @@ public:
 
 	bool				IsLoaded() const;
 
+	// an evicted texture only holds its smallest mips until it is bound again
+	bool				IsEvicted() const
+	{
+		return droppedLevels > 0;
+	}
+
+	int					LastUsedFrame() const
+	{
+		return lastUsedFrame;
+	}
+
+	// number of top mip levels the residency manager may drop, 0 if the image can't be evicted
+	int					EvictableLevels() const;
+
+	// called by the backend for every bind
+	void				MarkUsed( bool resident );
+
 	// Creates a sampler for this texture to use in the shader.
 	void				CreateSampler();
 
@@ -464,6 +481,9 @@ private:
 
 	void				DeriveOpts();
 	void				AllocImage();
+
+	// allocates the texture for the droppedLevels and uploads the mips of the .bimage
+	void				UploadBinaryImage( idBinaryImage& im, nvrhi::ICommandList* commandList );
 	void				SetSamplerState( textureFilter_t tf, textureRepeat_t tr );
 
 	// parameters that define this image
@@ -487,6 +507,12 @@ private:
 
 	int					refCount;				// overall ref count
 
+	// texture residency, see idImageManager::UpdateResidency
+	int					droppedLevels;			// top mip levels left out of the texture while evicted
+	int					lastUsedFrame;			// tr.frameCount of the last bind
+	int					bindHits;				// binds that found the full texture resident
+	int					bindMisses;				// binds that had to load the texture or found it evicted
+
 	static const uint32 TEXTURE_NOT_LOADED = 0xFFFFFFFF;
 
 	nvrhi::TextureHandle	texture;
@@ -515,6 +541,31 @@ void	R_WritePNG( const char* filename, const byte* data, int bytesPerPixel, int
 void	R_WriteEXR( const char* filename, const void* data, int channelsPerPixel, int width, int height, const char* basePath = "fs_savepath" );
 // RB end
 
+/*
+================================================
+idImageResidencyThread
+
+Reads the .bimage files of the textures idImageManager::UpdateResidency
+replaces next, so the backend only uploads them.
+================================================
+*/
+class idImageResidencyThread : public idSysThread
+{
+public:
+	virtual int			Run();
+};
+
+// a texture replaced by UpdateResidency once its .bimage was read
+struct imageResidencyLoad_t
+{
+	idImage*			image;
+	int					droppedLevels;		// top mip levels left out, 0 restores the full mip chain
+	idFile*				file;				// opened by the backend, read by the residency thread
+	idBinaryImage*		binaryImage;
+	ID_TIME_T			sourceFileTime;
+	bool				loaded;				// set by the residency thread
+};
+
 class idImageManager
 {
 	friend class idImage;
@@ -526,6 +577,8 @@ public:
 		insideLevelLoad = false;
 		preloadingMapImages = false;
 		cacheImages = false;
+		numEvictions = 0;
+		numRestores = 0;
 		commandList = nullptr;
 	}
 
@@ -579,6 +632,14 @@ public:
 
 	void				LoadDeferredImages( nvrhi::ICommandList* commandList = nullptr );
 
+	// restores the evicted images that were bound and evicts the least recently
+	// bound ones beyond image_memoryBudget, returns true if any texture was replaced
+	bool				UpdateResidency( nvrhi::ICommandList* commandList );
+	void				PrintResidency();
+
+	// runs on the residency thread, the backend doesn't touch the loads until the thread is done
+	void				ReadResidencyLoads();
+
 	// built-in images
 	void				CreateIntrinsicImages();
 	idImage* 			defaultImage;
@@ -661,6 +722,18 @@ private:
 	// Transient list of images to load on the main thread to the gpu. Freed after images are loaded.
 	idList<idImage*, TAG_IDLIB_LIST_IMAGE>	imagesToLoad;
 
+	// evicted images that were bound since the last UpdateResidency
+	idList<idImage*, TAG_IDLIB_LIST_IMAGE>	imagesToRestore;
+	int										numEvictions;
+	int										numRestores;
+
+	idImageResidencyThread					residencyThread;
+	idList<imageResidencyLoad_t, TAG_IDLIB_LIST_IMAGE>	residencyLoads;
+
+	bool				QueueResidencyLoad( idImage* image, int droppedLevels );
+	bool				UploadResidencyLoads( nvrhi::ICommandList* commandList );
+	void				FreeResidencyLoads();
+
 	bool									insideLevelLoad;			// don't actually load images now
 	bool									preloadingMapImages;		// unless this is set
 	bool									cacheImages;				// similar to preload but surpresses prints
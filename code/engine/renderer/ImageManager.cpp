@@ -47,6 +47,10 @@ idImageManager* globalImages = &imageManager;
 
 idCVar preLoad_Images( "preLoad_Images", "1", CVAR_SYSTEM | CVAR_BOOL, "preload images during beginlevelload" );
 
+idCVar image_memoryBudget( "image_memoryBudget", "0", CVAR_RENDERER | CVAR_INTEGER | CVAR_ARCHIVE, "MB of texture memory before the least recently used images are evicted to their small mips, 0 = no budget" );
+idCVar image_evictedSize( "image_evictedSize", "64", CVAR_RENDERER | CVAR_INTEGER, "evicted images keep the mips of at least this size", 4, 1024 );
+idCVar image_residencyUploads( "image_residencyUploads", "8", CVAR_RENDERER | CVAR_INTEGER, "max images read ahead for a restore or eviction at once", 1, 256 );
+
 /*
 ===============
 R_ReloadImages_f
@@ -151,6 +155,7 @@ void idImageManager::R_ListImages_f( const idCmdArgs& args )
 	bool	overSized = false;
 	bool	sortByName = false;
 	bool	deferred = false;
+	bool	residency = false;
 
 	if( args.Argc() == 1 )
 	{
@@ -187,6 +192,10 @@ void idImageManager::R_ListImages_f( const idCmdArgs& args )
 		{
 			deferred = true;
 		}
+		else if( idStr::Icmp( args.Argv( 1 ), "residency" ) == 0 )
+		{
+			residency = true;
+		}
 		else
 		{
 			failed = true;
@@ -199,7 +208,13 @@ void idImageManager::R_ListImages_f( const idCmdArgs& args )
 
 	if( failed )
 	{
-		common->Printf( "usage: listImages [ sorted | namesort | unloaded | duplicated | showOverSized ]\n" );
+		common->Printf( "usage: listImages [ sorted | namesort | unloaded | duplicated | showOverSized | residency ]\n" );
+		return;
+	}
+
+	if( residency )
+	{
+		globalImages->PrintResidency();
 		return;
 	}
 
@@ -644,6 +659,9 @@ PurgeAllImages
 */
 void idImageManager::PurgeAllImages()
 {
+	imagesToRestore.Clear();
+	FreeResidencyLoads();
+
 	for( int i = 0; i < images.Num() ; i++ )
 	{
 		images[ i ]->PurgeImage();
@@ -657,6 +675,8 @@ ReloadImages
 */
 void idImageManager::ReloadImages( bool all, nvrhi::ICommandList* commandList )
 {
+	FreeResidencyLoads();
+
 	for( int i = 0 ; i < images.Num() ; i++ )
 	{
 		images[ i ]->Reload( all, commandList );
@@ -786,6 +806,9 @@ Shutdown
 */
 void idImageManager::Shutdown()
 {
+	imagesToRestore.Clear();
+	FreeResidencyLoads();
+	residencyThread.StopThread();
 	images.DeleteContents( true );
 	imageHash.Clear();
 	commandList.Reset();
@@ -800,6 +823,8 @@ Frees all images used by the previous level
 void idImageManager::BeginLevelLoad()
 {
 	insideLevelLoad = true;
+	imagesToRestore.Clear();
+	FreeResidencyLoads();
 
 	for( int i = 0 ; i < images.Num() ; i++ )
 	{
@@ -1110,6 +1135,317 @@ void idImageManager::LoadDeferredImages( nvrhi::ICommandList* _commandList )
 	globalImages->imagesToLoad.Clear();
 }
 
+/*
+=======================
+idSort_ImageLastUsed
+=======================
+*/
+class idSort_ImageLastUsed : public idSort_Quick< idImage*, idSort_ImageLastUsed >
+{
+public:
+	int Compare( idImage* const& a, idImage* const& b ) const
+	{
+		return a->LastUsedFrame() - b->LastUsedFrame();
+	}
+};
+
+/*
+===============
+idImageResidencyThread::Run
+===============
+*/
+int idImageResidencyThread::Run()
+{
+	globalImages->ReadResidencyLoads();
+	return 0;
+}
+
+/*
+===============
+idImageManager::ReadResidencyLoads
+===============
+*/
+void idImageManager::ReadResidencyLoads()
+{
+	for( int i = 0; i < residencyLoads.Num(); i++ )
+	{
+		imageResidencyLoad_t& load = residencyLoads[i];
+		load.loaded = load.binaryImage->LoadFromGeneratedFile( load.file, load.sourceFileTime );
+	}
+}
+
+/*
+===============
+idImageManager::QueueResidencyLoad
+
+Opening the file is left to the backend, the file system isn't thread safe.
+Mapped resource files and loose files are only read by the residency thread.
+===============
+*/
+bool idImageManager::QueueResidencyLoad( idImage* image, int droppedLevels )
+{
+	idStrStatic< MAX_OSPATH > generatedName = image->GetName();
+	idImage::GetGeneratedName( generatedName, image->usage, image->cubeFiles );
+
+	idStr binaryFileName;
+	idBinaryImage::GetGeneratedFileName( binaryFileName, generatedName );
+
+	idFile* file = fileSystem->OpenFileRead( binaryFileName );
+	if( file == NULL )
+	{
+		return false;
+	}
+
+	imageResidencyLoad_t& load = residencyLoads.Alloc();
+	load.image = image;
+	load.droppedLevels = droppedLevels;
+	load.file = file;
+	load.binaryImage = new( TAG_IMAGE ) idBinaryImage( generatedName );
+	load.sourceFileTime = image->sourceFileTime;
+	load.loaded = false;
+
+	return true;
+}
+
+/*
+===============
+idImageManager::UploadResidencyLoads
+
+Images that were purged or reloaded while their file was read are skipped.
+===============
+*/
+bool idImageManager::UploadResidencyLoads( nvrhi::ICommandList* _commandList )
+{
+	bool replaced = false;
+
+	for( int i = 0; i < residencyLoads.Num(); i++ )
+	{
+		imageResidencyLoad_t& load = residencyLoads[i];
+		idImage* image = load.image;
+		const bimageFile_t& header = load.binaryImage->GetFileHeader();
+
+		bool current = load.loaded && image->IsLoaded() &&
+					   header.width == image->opts.width && header.height == image->opts.height && header.numLevels == image->opts.numLevels &&
+					   header.format == image->opts.format && header.textureType == image->opts.textureType;
+		if( load.droppedLevels > 0 )
+		{
+			current = current && image->EvictableLevels() == load.droppedLevels;
+		}
+		else
+		{
+			current = current && image->IsEvicted();
+		}
+
+		if( current )
+		{
+			image->droppedLevels = load.droppedLevels;
+			image->UploadBinaryImage( *load.binaryImage, _commandList );
+
+			if( load.droppedLevels > 0 )
+			{
+				numEvictions++;
+			}
+			else
+			{
+				numRestores++;
+			}
+			replaced = true;
+		}
+	}
+
+	FreeResidencyLoads();
+
+	return replaced;
+}
+
+/*
+===============
+idImageManager::FreeResidencyLoads
+===============
+*/
+void idImageManager::FreeResidencyLoads()
+{
+	// the residency thread may still read the files
+	if( residencyThread.IsRunning() )
+	{
+		residencyThread.WaitForThread();
+	}
+
+	for( int i = 0; i < residencyLoads.Num(); i++ )
+	{
+		delete residencyLoads[i].file;
+		delete residencyLoads[i].binaryImage;
+	}
+	residencyLoads.Clear();
+}
+
+/*
+===============
+idImageManager::UpdateResidency
+
+Called by the backend at the start of each frame, before anything is bound.
+The .bimage files of up to image_residencyUploads images are read on the
+residency thread, and their textures are replaced at the start of the first
+frame after the reads are done. The backend never waits for the reads.
+Images bound in the last two frames are never evicted.
+===============
+*/
+bool idImageManager::UpdateResidency( nvrhi::ICommandList* _commandList )
+{
+	if( insideLevelLoad )
+	{
+		return false;
+	}
+
+	if( residencyThread.IsRunning() && !residencyThread.IsWorkDone() )
+	{
+		return false;
+	}
+
+	const bool replaced = UploadResidencyLoads( _commandList );
+
+	int numLoads = 0;
+	const int maxLoads = image_residencyUploads.GetInteger();
+
+	// bring back the full mip chain of the evicted images that were bound
+	while( imagesToRestore.Num() > 0 && numLoads < maxLoads )
+	{
+		idImage* image = imagesToRestore[0];
+		imagesToRestore.RemoveIndex( 0 );
+
+		if( image->IsEvicted() && QueueResidencyLoad( image, 0 ) )
+		{
+			numLoads++;
+		}
+	}
+
+	const int64 budget = ( int64 )image_memoryBudget.GetInteger() * 1024 * 1024;
+	if( budget > 0 && numLoads < maxLoads )
+	{
+		int64 totalSize = 0;
+		idList<idImage*, TAG_IDLIB_LIST_IMAGE> candidates;
+		for( int i = 0; i < images.Num(); i++ )
+		{
+			idImage* image = images[i];
+			totalSize += image->StorageSize();
+
+			if( image->lastUsedFrame < tr.frameCount - 2 && image->EvictableLevels() > 0 )
+			{
+				candidates.Append( image );
+			}
+		}
+
+		if( totalSize > budget )
+		{
+			candidates.SortWithTemplate( idSort_ImageLastUsed() );
+
+			for( int i = 0; i < candidates.Num() && totalSize > budget && numLoads < maxLoads; i++ )
+			{
+				idImage* image = candidates[i];
+				const int levels = image->EvictableLevels();
+				const int fullSize = image->StorageSize();
+
+				if( QueueResidencyLoad( image, levels ) )
+				{
+					// each dropped level quarters the size
+					totalSize -= fullSize - ( fullSize >> ( 2 * levels ) );
+					numLoads++;
+				}
+			}
+		}
+	}
+
+	if( residencyLoads.Num() > 0 )
+	{
+		if( !residencyThread.IsRunning() )
+		{
+			residencyThread.StartWorkerThread( "Image Residency", CORE_ANY, THREAD_NORMAL );
+		}
+		residencyThread.SignalWork();
+	}
+
+	return replaced;
+}
+
+/*
+===============
+idImageManager::PrintResidency
+===============
+*/
+void idImageManager::PrintResidency()
+{
+	static const char* usageNames[] =
+	{
+		"specular", "diffuse", "default", "bump", "font", "light", "lookupMono", "lookupAlpha",
+		"lookupRGB1", "lookupRGBA", "coverage", "depth", "rmao", "rmaod", "hqCube", "lqCube",
+		"shadowArray", "rg16f", "rgba16f", "rgba16s", "rgba32f", "lightprobe", "hdri", "r32f",
+		"r8f", "ldr", "depthStencil"
+	};
+	static const int numUsages = sizeof( usageNames ) / sizeof( usageNames[0] );
+
+	idList<sortedImage_t> sortedImages;
+	int64 usageSize[numUsages] = {};
+	int usageCount[numUsages] = {};
+	int64 totalSize = 0;
+	int64 evictedSize = 0;
+	int numEvicted = 0;
+
+	for( int i = 0; i < images.Num(); i++ )
+	{
+		idImage* image = images[i];
+		if( !image->IsLoaded() )
+		{
+			continue;
+		}
+
+		sortedImage_t& sorted = sortedImages.Alloc();
+		sorted.image = image;
+		sorted.size = image->StorageSize();
+		sorted.index = i;
+
+		totalSize += sorted.size;
+		if( image->IsEvicted() )
+		{
+			evictedSize += sorted.size;
+			numEvicted++;
+		}
+
+		const int usage = image->GetUsage();
+		if( usage >= 0 && usage < numUsages )
+		{
+			usageSize[usage] += sorted.size;
+			usageCount[usage]++;
+		}
+	}
+
+	qsort( sortedImages.Ptr(), sortedImages.Num(), sizeof( sortedImage_t ), R_QsortImageSizes );
+
+	common->Printf( "\n        size   -hits- misses  idle -name-------\n" );
+	for( int i = 0; i < sortedImages.Num(); i++ )
+	{
+		const idImage* image = sortedImages[i].image;
+		common->Printf( "%4i: %c%6ik %7i %6i %5i %s\n", sortedImages[i].index, image->IsEvicted() ? 'E' : ' ', sortedImages[i].size / 1024,
+						image->bindHits, image->bindMisses, Min( tr.frameCount - image->lastUsedFrame, 99999 ), image->GetName() );
+	}
+
+	common->Printf( "\n---- per usage ----\n" );
+	for( int i = 0; i < numUsages; i++ )
+	{
+		if( usageCount[i] > 0 )
+		{
+			common->Printf( "%-14s %5i images %7.1f MB\n", usageNames[i], usageCount[i], usageSize[i] / ( 1024 * 1024.0 ) );
+		}
+	}
+
+	common->Printf( "\n%i images loaded, %7.1f MB", sortedImages.Num(), totalSize / ( 1024 * 1024.0 ) );
+	if( image_memoryBudget.GetInteger() > 0 )
+	{
+		common->Printf( " of a %i MB budget", image_memoryBudget.GetInteger() );
+	}
+	common->Printf( "\n%i evicted to their small mips, %7.1f MB\n", numEvicted, evictedSize / ( 1024 * 1024.0 ) );
+	common->Printf( "%i evictions, %i restores since startup\n\n", numEvictions, numRestores );
+}
+
 #include "CmdlineProgressbar.h"
 
 #if !defined( DMAP )
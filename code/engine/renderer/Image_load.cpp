@@ -875,6 +875,18 @@ void idImage::ActuallyLoadImage( bool fromBackEnd, nvrhi::ICommandList* commandL
 	}
 #endif
 
+	UploadBinaryImage( im, commandList );
+}
+
+/*
+===============
+idImage::UploadBinaryImage
+
+An evicted texture is allocated without its top droppedLevels mips
+===============
+*/
+void idImage::UploadBinaryImage( idBinaryImage& im, nvrhi::ICommandList* commandList )
+{
 	AllocImage();
 
 #if defined( USE_NVRHI ) && !defined( DMAP )
@@ -885,7 +897,13 @@ void idImage::ActuallyLoadImage( bool fromBackEnd, nvrhi::ICommandList* commandL
 		const bimageImage_t& img = im.GetImageHeader( i );
 		const byte* pic = im.GetImageData( i );
 
-		commandList->writeTexture( texture, img.destZ, img.level, pic, GetRowPitch( opts.format, img.width ) );
+		// an evicted texture only gets the smaller mips
+		if( img.level < droppedLevels )
+		{
+			continue;
+		}
+
+		commandList->writeTexture( texture, img.destZ, img.level - droppedLevels, pic, GetRowPitch( opts.format, img.width ) );
 	}
 	commandList->setPermanentTextureState( texture, nvrhi::ResourceStates::ShaderResource );
 	commandList->commitBarriers();
@@ -916,6 +934,57 @@ void idImage::DeferredPurgeImage()
 	globalImages->imagesToLoad.Remove( this );
 }
 
+extern idCVar image_evictedSize;
+
+/*
+===============
+idImage::EvictableLevels
+
+Only plain 2D textures with a .bimage can be evicted, reloading any other
+would compress the source image again. The dropped levels leave a mip chain
+of at least image_evictedSize texels
+===============
+*/
+int idImage::EvictableLevels() const
+{
+	if( !isLoaded || defaulted || IsEvicted() || generatorFunction != NULL || opts.isRenderTarget ||
+			opts.textureType != DTT_2D || cubeFiles != CF_2D || binaryFileTime == FILE_NOT_FOUND_TIMESTAMP )
+	{
+		return 0;
+	}
+
+	const int minSize = Max( image_evictedSize.GetInteger(), 4 );
+
+	int levels = 0;
+	while( levels + 1 < opts.numLevels && ( opts.width >> ( levels + 1 ) ) >= minSize && ( opts.height >> ( levels + 1 ) ) >= minSize )
+	{
+		levels++;
+	}
+	return levels;
+}
+
+/*
+===============
+idImage::MarkUsed
+===============
+*/
+void idImage::MarkUsed( bool resident )
+{
+	lastUsedFrame = tr.frameCount;
+
+	if( resident )
+	{
+		bindHits++;
+		return;
+	}
+
+	bindMisses++;
+	if( IsEvicted() )
+	{
+		globalImages->imagesToRestore.AddUnique( this );
+	}
+}
+
 /*
 =============
 RB_UploadScratchImage
@@ -1032,8 +1101,8 @@ int idImage::StorageSize() const
 		return 0;
 	}
 
-	size_t baseSize = opts.width * opts.height;
-	if( opts.numLevels > 1 && !opts.isRenderTarget )
+	size_t baseSize = Max( opts.width >> droppedLevels, 1 ) * Max( opts.height >> droppedLevels, 1 );
+	if( opts.numLevels - droppedLevels > 1 && !opts.isRenderTarget )
 	{
 		baseSize *= 4;
 		baseSize /= 3;
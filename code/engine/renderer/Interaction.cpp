@@ -417,14 +417,13 @@ idInteraction* idInteraction::AllocAndLink( idRenderEntityLocal* edef, idRenderL
 	}
 
 	// update the interaction table
-	if( renderWorld->interactionTable != NULL )
+	if( renderWorld->interactionTable.IsInitialized() )
 	{
-		int index = ldef->index * renderWorld->interactionTableWidth + edef->index;
-		if( renderWorld->interactionTable[index] != NULL )
+		if( renderWorld->interactionTable.Find( ldef->index, edef->index ) != NULL )
 		{
 			common->Error( "idInteraction::AllocAndLink: non NULL table entry" );
 		}
-		renderWorld->interactionTable[ index ] = interaction;
+		renderWorld->interactionTable.Set( ldef->index, edef->index, interaction );
 	}
 
 	return interaction;
@@ -511,14 +510,14 @@ void idInteraction::UnlinkAndFree()
 	idRenderWorldLocal* renderWorld = this->lightDef->world;
 
 	// RB: added check for NULL
-	if( renderWorld->interactionTable != NULL )
+	if( renderWorld->interactionTable.IsInitialized() )
 	{
-		int index = this->lightDef->index * renderWorld->interactionTableWidth + this->entityDef->index;
-		if( renderWorld->interactionTable[index] != this && renderWorld->interactionTable[index] != INTERACTION_EMPTY )
+		const idInteraction* entry = renderWorld->interactionTable.Find( this->lightDef->index, this->entityDef->index );
+		if( entry != this && entry != INTERACTION_EMPTY )
 		{
 			common->Error( "idInteraction::UnlinkAndFree: interactionTable wasn't set" );
 		}
-		renderWorld->interactionTable[index] = NULL;
+		renderWorld->interactionTable.Remove( this->lightDef->index, this->entityDef->index );
 	}
 	// RB end
 
@@ -575,9 +574,206 @@ void idInteraction::MakeEmpty()
 	}
 
 	// store the special marker in the interaction table
-	const int interactionIndex = lightDef->index * entityDef->world->interactionTableWidth + entityDef->index;
-	assert( entityDef->world->interactionTable[ interactionIndex ] == this );
-	entityDef->world->interactionTable[ interactionIndex ] = INTERACTION_EMPTY;
+	assert( entityDef->world->interactionTable.Find( lightDef->index, entityDef->index ) == this );
+	entityDef->world->interactionTable.Set( lightDef->index, entityDef->index, INTERACTION_EMPTY );
+}
+
+/*
+===============================================================================
+
+	idInteractionTable
+
+===============================================================================
+*/
+
+/*
+===============
+idInteractionTable::idInteractionTable
+===============
+*/
+idInteractionTable::idInteractionTable()
+{
+	slots = NULL;
+	mask = 0;
+	num = 0;
+}
+
+/*
+===============
+idInteractionTable::~idInteractionTable
+===============
+*/
+idInteractionTable::~idInteractionTable()
+{
+	Shutdown();
+}
+
+/*
+===============
+idInteractionTable::Init
+===============
+*/
+void idInteractionTable::Init( int expectedInteractions )
+{
+	Shutdown();
+
+	// keep the load factor at or below one half
+	Resize( idMath::CeilPowerOfTwo( Max( expectedInteractions * 2, 1024 ) ) );
+}
+
+/*
+===============
+idInteractionTable::Shutdown
+===============
+*/
+void idInteractionTable::Shutdown()
+{
+	if( slots != NULL )
+	{
+		R_StaticFree( slots );
+		slots = NULL;
+	}
+	mask = 0;
+	num = 0;
+}
+
+/*
+===============
+idInteractionTable::Resize
+===============
+*/
+void idInteractionTable::Resize( int newSize )
+{
+	slot_t* oldSlots = slots;
+	const int oldSize = ( oldSlots != NULL ) ? mask + 1 : 0;
+
+	slots = ( slot_t* )R_ClearedStaticAlloc( newSize * sizeof( slot_t ) );
+	mask = newSize - 1;
+	num = 0;
+
+	for( int i = 0; i < oldSize; i++ )
+	{
+		if( oldSlots[ i ].interaction != NULL )
+		{
+			Set( oldSlots[ i ].lightIndex, oldSlots[ i ].entityIndex, oldSlots[ i ].interaction );
+		}
+	}
+
+	if( oldSlots != NULL )
+	{
+		R_StaticFree( oldSlots );
+	}
+}
+
+/*
+===============
+idInteractionTable::Find
+===============
+*/
+idInteraction* idInteractionTable::Find( int lightIndex, int entityIndex ) const
+{
+	if( slots == NULL )
+	{
+		return NULL;
+	}
+
+	for( int i = Slot( lightIndex, entityIndex ); ; i = ( i + 1 ) & mask )
+	{
+		const slot_t& slot = slots[ i ];
+		if( slot.interaction == NULL )
+		{
+			return NULL;
+		}
+		if( slot.lightIndex == lightIndex && slot.entityIndex == entityIndex )
+		{
+			return slot.interaction;
+		}
+	}
+}
+
+/*
+===============
+idInteractionTable::Set
+===============
+*/
+void idInteractionTable::Set( int lightIndex, int entityIndex, idInteraction* interaction )
+{
+	assert( slots != NULL && interaction != NULL );
+
+	int i = Slot( lightIndex, entityIndex );
+	while( slots[ i ].interaction != NULL )
+	{
+		if( slots[ i ].lightIndex == lightIndex && slots[ i ].entityIndex == entityIndex )
+		{
+			slots[ i ].interaction = interaction;
+			return;
+		}
+		i = ( i + 1 ) & mask;
+	}
+
+	slots[ i ].lightIndex = lightIndex;
+	slots[ i ].entityIndex = entityIndex;
+	slots[ i ].interaction = interaction;
+	num++;
+
+	if( num * 2 > mask + 1 )
+	{
+		Resize( ( mask + 1 ) * 2 );
+	}
+}
+
+/*
+===============
+idInteractionTable::Remove
+
+Shifts the following entries of the probe sequence back, so no tombstones are needed.
+===============
+*/
+void idInteractionTable::Remove( int lightIndex, int entityIndex )
+{
+	if( slots == NULL )
+	{
+		return;
+	}
+
+	int i = Slot( lightIndex, entityIndex );
+	while( true )
+	{
+		if( slots[ i ].interaction == NULL )
+		{
+			return;
+		}
+		if( slots[ i ].lightIndex == lightIndex && slots[ i ].entityIndex == entityIndex )
+		{
+			break;
+		}
+		i = ( i + 1 ) & mask;
+	}
+
+	int hole = i;
+	for( int j = ( i + 1 ) & mask; slots[ j ].interaction != NULL; j = ( j + 1 ) & mask )
+	{
+		// an entry can move into the hole if the hole lies between its home slot and where it is now
+		const int home = Slot( slots[ j ].lightIndex, slots[ j ].entityIndex );
+		if( ( ( j - home ) & mask ) >= ( ( j - hole ) & mask ) )
+		{
+			slots[ hole ] = slots[ j ];
+			hole = j;
+		}
+	}
+	slots[ hole ].interaction = NULL;
+	num--;
+}
+
+/*
+===============
+idInteractionTable::PrintStats
+===============
+*/
+void idInteractionTable::PrintStats( int numLights, int numEntities ) const
+{
+	const size_t denseSize = ( size_t )numLights * numEntities * sizeof( idInteraction* );
+	common->Printf( "interaction table: %i entries in %i kB, a dense table would be %i kB\n", num, ( int )( Allocated() >> 10 ), ( int )( denseSize >> 10 ) );
 }
 
 /*
@@ -773,4 +969,6 @@ void R_ShowInteractionMemory_f( const idCmdArgs& args )
 	common->Printf( "%5i indexes in %5i shadow tris\n", shadowTriIndexes, shadowTris );
 	common->Printf( "%i maxInteractionsForEntity\n", maxInteractionsForEntity );
 	common->Printf( "%i maxInteractionsForLight\n", maxInteractionsForLight );
+
+	tr.primaryWorld->interactionTable.PrintStats( tr.primaryWorld->lightDefs.Num(), tr.primaryWorld->entityDefs.Num() );
 }
@@ -146,6 +146,70 @@ private:
 	void					Unlink();
 };
 
+/*
+===============================================================================
+
+	Sparse light / entity interaction lookup.
+
+	Open addressing with linear probing, keyed by the lightDef and entityDef
+	index. Only pairs that actually got an interaction use a slot, so the size
+	follows the number of interactions instead of lights * entities.
+	Iterating the interactions of one def still goes through the def chains.
+
+===============================================================================
+*/
+
+class idInteractionTable
+{
+public:
+	idInteractionTable();
+	~idInteractionTable();
+
+	void					Init( int expectedInteractions );
+	void					Shutdown();
+	bool					IsInitialized() const
+	{
+		return slots != NULL;
+	}
+
+	// returns NULL if there is no entry, INTERACTION_EMPTY if the pair was checked and doesn't interact
+	idInteraction* 			Find( int lightIndex, int entityIndex ) const;
+	void					Set( int lightIndex, int entityIndex, idInteraction* interaction );
+	void					Remove( int lightIndex, int entityIndex );
+
+	int						Num() const
+	{
+		return num;
+	}
+	size_t					Allocated() const
+	{
+		return ( slots != NULL ) ? ( size_t )( mask + 1 ) * sizeof( slot_t ) : 0;
+	}
+
+	// prints the memory use compared to a dense numLights * numEntities table
+	void					PrintStats( int numLights, int numEntities ) const;
+
+private:
+	struct slot_t
+	{
+		int					lightIndex;
+		int					entityIndex;
+		idInteraction* 		interaction;		// NULL for a free slot
+	};
+
+	slot_t* 				slots;
+	int						mask;
+	int						num;
+
+	int						Slot( int lightIndex, int entityIndex ) const
+	{
+		uint32 hash = ( uint32 )lightIndex * 0x9E3779B1u ^ ( uint32 )entityIndex * 0x85EBCA77u;
+		hash ^= hash >> 15;
+		return ( int )( hash & ( uint32 )mask );
+	}
+	void					Resize( int newSize );
+};
+
 void R_ShowInteractionMemory_f( const idCmdArgs& args );
 
 #endif /* !__INTERACTION_H__ */
@@ -43,12 +43,15 @@ idCVar idRenderModelStatic::r_mergeModelSurfaces( "r_mergeModelSurfaces", "1", C
 idCVar idRenderModelStatic::r_slopVertex( "r_slopVertex", "0.01", CVAR_RENDERER, "merge xyz coordinates this far apart" );
 idCVar idRenderModelStatic::r_slopTexCoord( "r_slopTexCoord", "0.001", CVAR_RENDERER, "merge texture coordinates this far apart" );
 idCVar idRenderModelStatic::r_slopNormal( "r_slopNormal", "0.02", CVAR_RENDERER, "merge normals that dot less than this" );
+idCVar idRenderModelStatic::r_modelLodGenerate( "r_modelLodGenerate", "1", CVAR_BOOL | CVAR_RENDERER, "generate simplified detail levels when static models are imported" );
 
 static const byte BRM_VERSION_BFG = 108;
 static const byte BRM_VERSION_MOC_DATA = 110;
-static const byte BRM_VERSION = BRM_VERSION_MOC_DATA;
+static const byte BRM_VERSION_LODS = 111;
+static const byte BRM_VERSION = BRM_VERSION_LODS;
 
 static const unsigned int BRM_MAGIC_BFG = ( 'B' << 24 ) | ( 'R' << 16 ) | ( 'M' << 8 ) | BRM_VERSION_BFG;
+static const unsigned int BRM_MAGIC_MOC_DATA = ( 'B' << 24 ) | ( 'R' << 16 ) | ( 'M' << 8 ) | BRM_VERSION_MOC_DATA;
 static const unsigned int BRM_MAGIC = ( 'B' << 24 ) | ( 'R' << 16 ) | ( 'M' << 8 ) | BRM_VERSION;
 
 /*
@@ -77,6 +80,7 @@ idRenderModelStatic::idRenderModelStatic()
 	numInvertedJoints = 0;
 	jointsInverted = NULL;
 	jointsInvertedBuffer = 0;
+	numLods = 0;
 }
 
 /*
@@ -151,6 +155,19 @@ int idRenderModelStatic::Memory() const
 		totalBytes += R_TriSurfMemory( surf->geometry );
 	}
 
+	// detail levels only own their indexes
+	for( int lod = 0; lod < numLods; lod++ )
+	{
+		for( int j = 0; j < lods[lod].surfaces.Num(); j++ )
+		{
+			const srfTriangles_t* lodTri = lods[lod].surfaces[j];
+			if( lodTri != NULL )
+			{
+				totalBytes += sizeof( *lodTri ) + lodTri->numIndexes * sizeof( lodTri->indexes[0] );
+			}
+		}
+	}
+
 	return totalBytes;
 }
 
@@ -182,7 +199,9 @@ void idRenderModelStatic::List() const
 		totalTris += surf->geometry->numIndexes / 3;
 		totalVerts += surf->geometry->numVerts;
 	}
-	common->Printf( "%c%4ik %3i %4i %4i '%s'", closed, totalBytes / 1024, NumSurfaces(), totalVerts, totalTris, Name() );
+	// triangles saved at the coarsest detail level
+	const int lodSaved = ( numLods > 0 ) ? totalTris - LodTriangles( numLods ) : 0;
+	common->Printf( "%c%4ik %3i %4i %4i %i %5i '%s'", closed, totalBytes / 1024, NumSurfaces(), totalVerts, totalTris, numLods, lodSaved, Name() );
 
 	if( IsDynamicModel() == DM_CACHED )
 	{
@@ -376,6 +395,8 @@ void idRenderModelStatic::InitFromFile( const char* fileName, const idImportOpti
 
 	// create the bounds for culling and dynamic surface creation
 	FinishSurfaces( useMikktspace );
+
+	GenerateLods();
 }
 
 /*
@@ -392,7 +413,7 @@ bool idRenderModelStatic::LoadBinaryModel( idFile* file, const ID_TIME_T sourceT
 
 	unsigned int magic = 0;
 	file->ReadBig( magic );
-	if( magic != BRM_MAGIC_BFG && magic != BRM_MAGIC )
+	if( magic != BRM_MAGIC_BFG && magic != BRM_MAGIC_MOC_DATA && magic != BRM_MAGIC )
 	{
 		return false;
 	}
@@ -571,7 +592,7 @@ bool idRenderModelStatic::LoadBinaryModel( idFile* file, const ID_TIME_T sourceT
 			}
 
 			// RB: read MOC data
-			if( magic == BRM_MAGIC )
+			if( magic != BRM_MAGIC_BFG )
 			{
 				tri.mocVerts = NULL;
 				tri.mocIndexes = NULL;
@@ -621,6 +642,14 @@ bool idRenderModelStatic::LoadBinaryModel( idFile* file, const ID_TIME_T sourceT
 	file->ReadBig( hasInteractingSurfaces );
 	file->ReadBig( hasShadowCastingSurfaces );
 
+	if( magic == BRM_MAGIC )
+	{
+		if( !ReadLods( file ) )
+		{
+			return false;
+		}
+	}
+
 	return true;
 }
 
@@ -789,6 +818,8 @@ void idRenderModelStatic::WriteBinaryModel( idFile* file, ID_TIME_T* _timeStamp
 	file->WriteBig( hasDrawingSurfaces );
 	file->WriteBig( hasInteractingSurfaces );
 	file->WriteBig( hasShadowCastingSurfaces );
+
+	WriteLods( file );
 }
 
 // RB begin
@@ -3238,6 +3269,8 @@ idRenderModelStatic::PurgeModel
 */
 void idRenderModelStatic::PurgeModel()
 {
+	FreeLods();
+
 	for( int i = 0; i < surfaces.Num(); i++ )
 	{
 		modelSurface_t* surf = &surfaces[i];
@@ -3258,6 +3291,20 @@ void idRenderModelStatic::PurgeModel()
 	purged = true;
 }
 
+/*
+================
+idRenderModelStatic::EvictSurfaces
+
+The model stays loaded with its bounds, so FindModel won't
+try to reload a streamed world area from a file
+================
+*/
+void idRenderModelStatic::EvictSurfaces()
+{
+	PurgeModel();
+	purged = false;
+}
+
 /*
 ==============
 idRenderModelStatic::FreeVertexCache
@@ -3276,6 +3323,17 @@ void idRenderModelStatic::FreeVertexCache()
 		}
 		R_FreeStaticTriSurfVertexCaches( tri );
 	}
+
+	for( int lod = 0; lod < numLods; lod++ )
+	{
+		for( int j = 0; j < lods[lod].surfaces.Num(); j++ )
+		{
+			if( lods[lod].surfaces[j] != NULL )
+			{
+				R_FreeStaticTriSurfVertexCaches( lods[lod].surfaces[j] );
+			}
+		}
+	}
 }
 
 /*
@@ -3347,6 +3405,8 @@ bool idRenderModelStatic::DeleteSurfaceWithId( int id )
 	{
 		if( surfaces[i].id == id )
 		{
+			// the detail levels are parallel to the surface list
+			FreeLods();
 			R_FreeStaticTriSurf( surfaces[i].geometry );
 			surfaces.RemoveIndex( i );
 			return true;
@@ -3366,6 +3426,7 @@ void idRenderModelStatic::DeleteSurfacesWithNegativeId()
 	{
 		if( surfaces[i].id < 0 )
 		{
+			FreeLods();
 			R_FreeStaticTriSurf( surfaces[i].geometry );
 			surfaces.RemoveIndex( i );
 			i--;
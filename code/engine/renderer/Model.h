@@ -301,6 +301,24 @@ public:
 	// Returns number of the joint nearest to the given triangle.
 	virtual int					NearestJoint( int surfaceNum, int a, int c, int b ) const = 0;
 
+	// number of automatically generated detail levels, 0 if the model is only drawn at full detail
+	virtual int					NumLods() const
+	{
+		return 0;
+	};
+
+	// object space error of a detail level, level 0 is the full detail model
+	virtual float				LodError( int lod ) const
+	{
+		return 0.0f;
+	};
+
+	// geometry to draw for a surface at the given detail level
+	virtual srfTriangles_t* 	LodSurface( int lod, int surfaceNum ) const
+	{
+		return Surface( surfaceNum )->geometry;
+	};
+
 	// if false, the model doesn't need to be linked into the world, because it
 	// can't contribute visually -- triggers, etc
 	virtual bool				ModelHasDrawingSurfaces() const
@@ -144,8 +144,8 @@ void idRenderModelManagerLocal::ListModels_f( const idCmdArgs& args )
 	int		totalMem = 0;
 	int		inUse = 0;
 
-	common->Printf( " mem   srf verts tris\n" );
-	common->Printf( " ---   --- ----- ----\n" );
+	common->Printf( " mem   srf verts tris lod saved\n" );
+	common->Printf( " ---   --- ----- ---- --- -----\n" );
 
 	for( int i = 0; i < localModelManager.models.Num(); i++ )
 	{
@@ -160,8 +160,8 @@ void idRenderModelManagerLocal::ListModels_f( const idCmdArgs& args )
 		inUse++;
 	}
 
-	common->Printf( " ---   --- ----- ----\n" );
-	common->Printf( " mem   srf verts tris\n" );
+	common->Printf( " ---   --- ----- ---- --- -----\n" );
+	common->Printf( " mem   srf verts tris lod saved\n" );
 
 	common->Printf( "%i loaded models\n", inUse );
 	common->Printf( "total memory: %4.1fM\n", ( float )totalMem / ( 1024 * 1024 ) );
@@ -986,7 +986,20 @@ void idRenderModelManagerLocal::EndLevelLoad()
 		{
 			for( int j = 0; j < model->NumSurfaces(); j++ )
 			{
-				R_CreateStaticBuffersForTri( *( model->Surface( j )->geometry ), commandList );
+				srfTriangles_t* tri = model->Surface( j )->geometry;
+				R_CreateStaticBuffersForTri( *tri, commandList );
+
+				// surfaces that were not simplified at a level share the finer level's geometry
+				const srfTriangles_t* finerTri = tri;
+				for( int lod = 1; lod <= model->NumLods(); lod++ )
+				{
+					srfTriangles_t* lodTri = model->LodSurface( lod, j );
+					if( lodTri != finerTri )
+					{
+						R_CreateStaticBuffersForLodTri( *lodTri, *tri, commandList );
+					}
+					finerTri = lodTri;
+				}
 			}
 		}
 	}
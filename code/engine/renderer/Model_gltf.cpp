@@ -737,6 +737,11 @@ void idRenderModelGLTF::InitFromFile( const char* fileName, const idImportOption
 	// derive mikktspace tangents from normals
 	FinishSurfaces( useMikktspace );
 
+	if( model_state == DM_STATIC )
+	{
+		GenerateLods();
+	}
+
 	LoadModel();
 
 	// it is now available for use
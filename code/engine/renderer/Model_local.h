@@ -43,6 +43,15 @@ class idJointMat;
 struct deformInfo_t;
 struct objModel_t;		// RB: Wavefront OBJ support
 
+// automatically generated detail levels of static models, see Model_lod.cpp
+static const int MAX_MODEL_LODS = 3;
+
+struct modelLod_t
+{
+	float								error;		// object space error of this level against the full detail model
+	idList<srfTriangles_t*, TAG_MODEL>	surfaces;	// parallel to the model surfaces, NULL if the finer level is used
+};
+
 class idRenderModelStatic : public idRenderModel
 {
 public:
@@ -102,6 +111,9 @@ public:
 	virtual int					NearestJoint( int surfaceNum, int a, int b, int c ) const;
 	virtual idBounds			Bounds( const struct renderEntity_s* ent ) const;
 	virtual float				DepthHack() const;
+	virtual int					NumLods() const;
+	virtual float				LodError( int lod ) const;
+	virtual srfTriangles_t* 	LodSurface( int lod, int surfaceNum ) const;
 
 	virtual bool				ModelHasDrawingSurfaces() const
 	{
@@ -118,6 +130,9 @@ public:
 
 	void						MakeDefaultModel();
 
+	// frees the surfaces of a streamed world area without purging the model
+	void						EvictSurfaces();
+
 	bool						LoadASE( const char* fileName, ID_TIME_T* sourceTimeStamp );
 	bool						LoadLWO( const char* fileName, ID_TIME_T* sourceTimeStamp );
 	bool						LoadMA( const char* filename, ID_TIME_T* sourceTimeStamp );
@@ -135,6 +150,12 @@ public:
 	void						DeleteSurfacesWithNegativeId();
 	bool						FindSurfaceWithId( int id, int& surfaceNum ) const;
 
+	void						GenerateLods();
+	void						FreeLods();
+	int							LodTriangles( int lod ) const;
+	bool						ReadLods( idFile* file );
+	void						WriteLods( idFile* file ) const;
+
 public:
 	idList<modelSurface_t, TAG_MODEL>	surfaces;
 	idBounds					bounds;
@@ -163,10 +184,14 @@ protected:
 	ID_TIME_T					declTimeStamp;			// RB: only != 0 if initialized from modelDef
 	idStr						declModelDefName;		// RB
 
+	int							numLods;
+	modelLod_t					lods[MAX_MODEL_LODS];
+
 	static idCVar				r_mergeModelSurfaces;	// combine model surfaces with the same material
 	static idCVar				r_slopVertex;			// merge xyz coordinates this far apart
 	static idCVar				r_slopTexCoord;			// merge texture coordinates this far apart
 	static idCVar				r_slopNormal;			// merge normals that dot less than this
+	static idCVar				r_modelLodGenerate;		// simplify static models into detail levels on import
 };
 
 
@@ -0,0 +1,822 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "precompiled.h"
+#pragma hdrstop
+
+
+#include "RenderCommon.h"
+#include "Model_local.h"
+
+/*
+
+Automatically generated detail levels for static models.
+
+Each level is a new index list over the vertexes of the full detail surface, built by
+collapsing edges in order of their quadric error. Vertexes are never moved or created,
+so all levels share the vertex buffer of the full detail surface and only need their
+own index buffer. Vertexes on open borders and on texture or normal seams are locked,
+which keeps the silhouette and the texture mapping intact.
+
+The levels are generated once when the model is imported and stored in the binary model.
+
+*/
+
+static const int	LOD_MIN_SURFACE_TRIS	= 64;		// smaller surfaces are always drawn at full detail
+static const float	LOD_MIN_REDUCTION		= 0.75f;	// a level must keep at most this fraction of the triangles of the previous level
+static const float	LOD_MAX_ERROR			= 0.01f;	// fraction of the model radius the first level may deviate, doubled for every level
+
+/*
+===============================================================================
+
+	Quadric error metric
+
+===============================================================================
+*/
+
+class idLodQuadric
+{
+public:
+	void			Clear()
+	{
+		memset( this, 0, sizeof( *this ) );
+	}
+
+	void			FromPlane( const idVec3& n, const float d, const float w )
+	{
+		a00 = w * n.x * n.x;
+		a01 = w * n.x * n.y;
+		a02 = w * n.x * n.z;
+		a11 = w * n.y * n.y;
+		a12 = w * n.y * n.z;
+		a22 = w * n.z * n.z;
+		b0 = w * n.x * d;
+		b1 = w * n.y * d;
+		b2 = w * n.z * d;
+		c = w * d * d;
+		weight = w;
+	}
+
+	void			Add( const idLodQuadric& q )
+	{
+		a00 += q.a00;
+		a01 += q.a01;
+		a02 += q.a02;
+		a11 += q.a11;
+		a12 += q.a12;
+		a22 += q.a22;
+		b0 += q.b0;
+		b1 += q.b1;
+		b2 += q.b2;
+		c += q.c;
+		weight += q.weight;
+	}
+
+	// area weighted mean squared distance of p to the planes
+	float			Error( const idVec3& p ) const
+	{
+		if( weight <= 0.0 )
+		{
+			return 0.0f;
+		}
+		const double x = p.x;
+		const double y = p.y;
+		const double z = p.z;
+		double e = a00 * x * x + 2.0 * a01 * x * y + 2.0 * a02 * x * z
+				   + a11 * y * y + 2.0 * a12 * y * z + a22 * z * z
+				   + 2.0 * ( b0 * x + b1 * y + b2 * z ) + c;
+		return ( float )( Max( e, 0.0 ) / weight );
+	}
+
+private:
+	double			a00, a01, a02, a11, a12, a22;
+	double			b0, b1, b2;
+	double			c;
+	double			weight;
+};
+
+struct lodCollapse_t
+{
+	int				from;
+	int				to;
+	float			error;
+};
+
+class idSort_LodCollapse : public idSort_Quick< lodCollapse_t, idSort_LodCollapse >
+{
+public:
+	int Compare( const lodCollapse_t& a, const lodCollapse_t& b ) const
+	{
+		if( a.error < b.error )
+		{
+			return -1;
+		}
+		if( a.error > b.error )
+		{
+			return 1;
+		}
+		return 0;
+	}
+};
+
+struct lodEdge_t
+{
+	int				v0;
+	int				v1;
+	int				count;
+};
+
+/*
+====================
+R_LodNearestWedge
+
+Finds the vertex at the position of welded vertex 'to' whose texture coordinates and
+normal are closest to the vertex that is being collapsed onto it.
+====================
+*/
+static int R_LodNearestWedge( const idDrawVert* verts, const idList<int>& nextWedge, const int to, const idDrawVert& from )
+{
+	const idVec2 st = from.GetTexCoord();
+	const idVec3 normal = from.GetNormal();
+
+	int best = to;
+	float bestDist = idMath::INFINITUM;
+	int v = to;
+	do
+	{
+		const float dist = ( verts[v].GetTexCoord() - st ).LengthSqr() + ( 1.0f - verts[v].GetNormal() * normal );
+		if( dist < bestDist )
+		{
+			bestDist = dist;
+			best = v;
+		}
+		v = nextWedge[v];
+	}
+	while( v != to );
+
+	return best;
+}
+
+/*
+====================
+R_SimplifyTriSurfIndexes
+
+Reduces the indexes towards targetIndexes without exceeding maxError in object space.
+Returns the number of indexes written to outIndexes, which must have room for numIndexes.
+====================
+*/
+static int R_SimplifyTriSurfIndexes( const srfTriangles_t* tri, const triIndex_t* indexes, const int numIndexes, const int targetIndexes, const float maxError, triIndex_t* outIndexes, float& resultError )
+{
+	const int numVerts = tri->numVerts;
+	const idDrawVert* verts = tri->verts;
+
+	resultError = 0.0f;
+
+	// weld vertexes with the same position, the welded vertex is the first one at that position
+	// and all vertexes at a position are linked in a circular list
+	idList<int> remap;
+	idList<int> nextWedge;
+	remap.SetNum( numVerts );
+	nextWedge.SetNum( numVerts );
+
+	idHashIndex posHash( 1024, numVerts );
+	for( int i = 0; i < numVerts; i++ )
+	{
+		const int key = posHash.GenerateKey( verts[i].xyz );
+		int j;
+		for( j = posHash.First( key ); j != -1; j = posHash.Next( j ) )
+		{
+			if( verts[j].xyz == verts[i].xyz )
+			{
+				break;
+			}
+		}
+		if( j == -1 )
+		{
+			posHash.Add( key, i );
+			remap[i] = i;
+			nextWedge[i] = i;
+		}
+		else
+		{
+			remap[i] = j;
+			nextWedge[i] = nextWedge[j];
+			nextWedge[j] = i;
+		}
+	}
+
+	// lock seams, open borders and non-manifold edges
+	idList<bool> locked;
+	locked.SetNum( numVerts );
+	for( int i = 0; i < numVerts; i++ )
+	{
+		locked[i] = ( nextWedge[i] != i );
+	}
+
+	idList<lodEdge_t> edges;
+	idHashIndex edgeHash( 1024, numIndexes );
+	for( int i = 0; i < numIndexes; i += 3 )
+	{
+		for( int k = 0; k < 3; k++ )
+		{
+			const int a = remap[indexes[i + k]];
+			const int b = remap[indexes[i + ( k + 1 ) % 3]];
+			if( a == b )
+			{
+				continue;
+			}
+			const int v0 = Min( a, b );
+			const int v1 = Max( a, b );
+			const int key = edgeHash.GenerateKey( v0 * 1031, v1 );
+			int e;
+			for( e = edgeHash.First( key ); e != -1; e = edgeHash.Next( e ) )
+			{
+				if( edges[e].v0 == v0 && edges[e].v1 == v1 )
+				{
+					edges[e].count++;
+					break;
+				}
+			}
+			if( e == -1 )
+			{
+				lodEdge_t& edge = edges.Alloc();
+				edge.v0 = v0;
+				edge.v1 = v1;
+				edge.count = 1;
+				edgeHash.Add( key, edges.Num() - 1 );
+			}
+		}
+	}
+	for( int i = 0; i < edges.Num(); i++ )
+	{
+		if( edges[i].count != 2 )
+		{
+			locked[edges[i].v0] = true;
+			locked[edges[i].v1] = true;
+		}
+	}
+
+	// accumulate the planes of all triangles at each welded vertex
+	idList<idLodQuadric> quadrics;
+	quadrics.SetNum( numVerts );
+	for( int i = 0; i < numVerts; i++ )
+	{
+		quadrics[i].Clear();
+	}
+	for( int i = 0; i < numIndexes; i += 3 )
+	{
+		const int w0 = remap[indexes[i + 0]];
+		const int w1 = remap[indexes[i + 1]];
+		const int w2 = remap[indexes[i + 2]];
+		idVec3 normal = ( verts[w1].xyz - verts[w0].xyz ).Cross( verts[w2].xyz - verts[w0].xyz );
+		const float area = normal.Normalize() * 0.5f;
+		if( area <= 0.0f )
+		{
+			continue;
+		}
+		idLodQuadric q;
+		q.FromPlane( normal, -( normal * verts[w0].xyz ), area );
+		quadrics[w0].Add( q );
+		quadrics[w1].Add( q );
+		quadrics[w2].Add( q );
+	}
+
+	idList<triIndex_t> current;
+	current.SetNum( numIndexes );
+	memcpy( current.Ptr(), indexes, numIndexes * sizeof( indexes[0] ) );
+	int numCurrent = numIndexes;
+
+	idList<int> collapseTo;
+	idList<bool> touched;
+	idList<int> adjStart;
+	idList<int> adjFill;
+	idList<int> adjTris;
+	idList<lodCollapse_t> collapses;
+	collapseTo.SetNum( numVerts );
+	touched.SetNum( numVerts );
+	adjStart.SetNum( numVerts + 1 );
+	adjFill.SetNum( numVerts );
+	for( int i = 0; i < numVerts; i++ )
+	{
+		collapseTo[i] = -1;
+	}
+
+	const float maxErrorSqr = maxError * maxError;
+
+	// every pass collapses a set of independent edges, cheapest first
+	while( numCurrent > targetIndexes )
+	{
+		// triangles around each welded vertex
+		memset( adjStart.Ptr(), 0, adjStart.Num() * sizeof( int ) );
+		for( int i = 0; i < numCurrent; i++ )
+		{
+			adjStart[remap[current[i]] + 1]++;
+		}
+		for( int i = 0; i < numVerts; i++ )
+		{
+			adjStart[i + 1] += adjStart[i];
+			adjFill[i] = adjStart[i];
+		}
+		adjTris.SetNum( numCurrent );
+		for( int i = 0; i < numCurrent; i++ )
+		{
+			adjTris[adjFill[remap[current[i]]]++] = i - ( i % 3 );
+		}
+
+		collapses.SetNum( 0 );
+		for( int i = 0; i < numCurrent; i += 3 )
+		{
+			for( int k = 0; k < 3; k++ )
+			{
+				const int a = remap[current[i + k]];
+				const int b = remap[current[i + ( k + 1 ) % 3]];
+				if( a == b )
+				{
+					continue;
+				}
+				for( int dir = 0; dir < 2; dir++ )
+				{
+					const int from = dir ? b : a;
+					const int to = dir ? a : b;
+					if( locked[from] )
+					{
+						continue;
+					}
+					idLodQuadric q = quadrics[from];
+					q.Add( quadrics[to] );
+
+					lodCollapse_t& collapse = collapses.Alloc();
+					collapse.from = from;
+					collapse.to = to;
+					collapse.error = q.Error( verts[to].xyz );
+				}
+			}
+		}
+		collapses.SortWithTemplate( idSort_LodCollapse() );
+
+		memset( touched.Ptr(), 0, touched.Num() * sizeof( bool ) );
+		const int wantRemoved = numCurrent - targetIndexes;
+		int removed = 0;
+		int numCollapsed = 0;
+		for( int c = 0; c < collapses.Num() && removed < wantRemoved; c++ )
+		{
+			const lodCollapse_t& collapse = collapses[c];
+			if( collapse.error > maxErrorSqr )
+			{
+				break;
+			}
+			if( touched[collapse.from] || touched[collapse.to] )
+			{
+				continue;
+			}
+
+			// don't flip any of the triangles that remain around the collapsed vertex
+			bool valid = true;
+			for( int a = adjStart[collapse.from]; a < adjStart[collapse.from + 1] && valid; a++ )
+			{
+				const int t = adjTris[a];
+				const int w[3] = { remap[current[t + 0]], remap[current[t + 1]], remap[current[t + 2]] };
+				if( w[0] == collapse.to || w[1] == collapse.to || w[2] == collapse.to )
+				{
+					continue;
+				}
+				idVec3 before[3];
+				idVec3 after[3];
+				for( int k = 0; k < 3; k++ )
+				{
+					before[k] = verts[w[k]].xyz;
+					after[k] = ( w[k] == collapse.from ) ? verts[collapse.to].xyz : before[k];
+				}
+				const idVec3 n0 = ( before[1] - before[0] ).Cross( before[2] - before[0] );
+				const idVec3 n1 = ( after[1] - after[0] ).Cross( after[2] - after[0] );
+				if( n0 * n1 <= 0.0f )
+				{
+					valid = false;
+				}
+			}
+			if( !valid )
+			{
+				continue;
+			}
+
+			collapseTo[collapse.from] = collapse.to;
+			quadrics[collapse.to].Add( quadrics[collapse.from] );
+			resultError = Max( resultError, collapse.error );
+			numCollapsed++;
+
+			// the triangles around the collapsed vertex change, so no vertex of them
+			// may take part in another collapse during this pass
+			for( int a = adjStart[collapse.from]; a < adjStart[collapse.from + 1]; a++ )
+			{
+				const int t = adjTris[a];
+				bool degenerate = false;
+				for( int k = 0; k < 3; k++ )
+				{
+					const int w = remap[current[t + k]];
+					touched[w] = true;
+					if( w == collapse.to )
+					{
+						degenerate = true;
+					}
+				}
+				if( degenerate )
+				{
+					removed += 3;
+				}
+			}
+		}
+
+		if( numCollapsed == 0 )
+		{
+			break;
+		}
+
+		// apply the collapses and drop the triangles that became degenerate
+		int numRemaining = 0;
+		for( int i = 0; i < numCurrent; i += 3 )
+		{
+			triIndex_t v[3];
+			for( int k = 0; k < 3; k++ )
+			{
+				v[k] = current[i + k];
+				const int to = collapseTo[remap[v[k]]];
+				if( to != -1 )
+				{
+					v[k] = R_LodNearestWedge( verts, nextWedge, to, verts[v[k]] );
+				}
+			}
+			if( remap[v[0]] == remap[v[1]] || remap[v[1]] == remap[v[2]] || remap[v[2]] == remap[v[0]] )
+			{
+				continue;
+			}
+			current[numRemaining + 0] = v[0];
+			current[numRemaining + 1] = v[1];
+			current[numRemaining + 2] = v[2];
+			numRemaining += 3;
+		}
+		numCurrent = numRemaining;
+
+		for( int i = 0; i < numVerts; i++ )
+		{
+			collapseTo[i] = -1;
+		}
+	}
+
+	memcpy( outIndexes, current.Ptr(), numCurrent * sizeof( outIndexes[0] ) );
+	resultError = idMath::Sqrt( resultError );
+
+	return numCurrent;
+}
+
+/*
+====================
+R_AllocLodTriSurf
+
+A detail level references the vertexes of the full detail surface and owns only its indexes.
+====================
+*/
+static srfTriangles_t* R_AllocLodTriSurf( const srfTriangles_t* tri, const int numIndexes )
+{
+	srfTriangles_t* lodTri = R_AllocStaticTriSurf();
+
+	lodTri->bounds = tri->bounds;
+	lodTri->generateNormals = tri->generateNormals;
+	lodTri->tangentsCalculated = tri->tangentsCalculated;
+	lodTri->referencedVerts = true;
+	lodTri->numVerts = tri->numVerts;
+	lodTri->verts = tri->verts;
+
+	R_AllocStaticTriSurfIndexes( lodTri, numIndexes );
+	lodTri->numIndexes = numIndexes;
+
+	return lodTri;
+}
+
+/*
+====================
+R_LodSurfaceIsSimplifiable
+====================
+*/
+static bool R_LodSurfaceIsSimplifiable( const modelSurface_t& surf )
+{
+	const srfTriangles_t* tri = surf.geometry;
+	if( tri == NULL || tri->verts == NULL || tri->indexes == NULL || tri->staticModelWithJoints != NULL )
+	{
+		return false;
+	}
+	if( tri->numIndexes / 3 < LOD_MIN_SURFACE_TRIS )
+	{
+		return false;
+	}
+
+	// deforms rebuild the geometry every frame, and materials with the lod keywords
+	// already come with hand made detail levels
+	if( surf.shader == NULL || surf.shader->Deform() != DFRM_NONE || surf.shader->IsLOD() )
+	{
+		return false;
+	}
+	return true;
+}
+
+/*
+====================
+idRenderModelStatic::GenerateLods
+
+Every level halves the triangles of the previous one within twice the error budget,
+until a level no longer removes enough triangles to be worth drawing.
+====================
+*/
+void idRenderModelStatic::GenerateLods()
+{
+	FreeLods();
+
+	if( !r_modelLodGenerate.GetBool() || isStaticWorldModel || fastLoad )
+	{
+		return;
+	}
+
+	const float radius = bounds.GetRadius();
+	if( radius <= 0.0f )
+	{
+		return;
+	}
+
+	idList<triIndex_t> simplified;
+
+	for( int lod = 0; lod < MAX_MODEL_LODS; lod++ )
+	{
+		modelLod_t& level = lods[lod];
+		level.error = 0.0f;
+		level.surfaces.SetNum( surfaces.Num() );
+
+		const float maxError = radius * LOD_MAX_ERROR * ( 1 << lod );
+		const float previousError = ( lod > 0 ) ? lods[lod - 1].error : 0.0f;
+
+		int previousTris = 0;
+		int levelTris = 0;
+		for( int i = 0; i < surfaces.Num(); i++ )
+		{
+			level.surfaces[i] = NULL;
+
+			const srfTriangles_t* tri = surfaces[i].geometry;
+			if( tri == NULL )
+			{
+				continue;
+			}
+
+			// build on the previous level so the error accumulates predictably
+			const srfTriangles_t* previous = ( lod > 0 ) ? LodSurface( lod, i ) : tri;
+			previousTris += previous->numIndexes / 3;
+
+			if( !R_LodSurfaceIsSimplifiable( surfaces[i] ) )
+			{
+				levelTris += previous->numIndexes / 3;
+				continue;
+			}
+
+			simplified.SetNum( previous->numIndexes );
+			float error = 0.0f;
+			const int numIndexes = R_SimplifyTriSurfIndexes( tri, previous->indexes, previous->numIndexes, ( previous->numIndexes / 6 ) * 3, maxError, simplified.Ptr(), error );
+
+			if( numIndexes == 0 || numIndexes > previous->numIndexes * LOD_MIN_REDUCTION )
+			{
+				// keep drawing the previous level of this surface
+				levelTris += previous->numIndexes / 3;
+				continue;
+			}
+
+			level.surfaces[i] = R_AllocLodTriSurf( tri, numIndexes );
+			memcpy( level.surfaces[i]->indexes, simplified.Ptr(), numIndexes * sizeof( simplified[0] ) );
+			level.error = Max( level.error, previousError + error );
+			levelTris += numIndexes / 3;
+		}
+
+		if( levelTris == 0 || levelTris > previousTris * LOD_MIN_REDUCTION )
+		{
+			for( int i = 0; i < level.surfaces.Num(); i++ )
+			{
+				R_FreeStaticTriSurf( level.surfaces[i] );
+			}
+			level.surfaces.Clear();
+			level.error = 0.0f;
+			break;
+		}
+
+		// surfaces that stayed the same still carry the error of the previous level
+		level.error = Max( level.error, previousError );
+		numLods = lod + 1;
+	}
+}
+
+/*
+====================
+idRenderModelStatic::FreeLods
+====================
+*/
+void idRenderModelStatic::FreeLods()
+{
+	for( int lod = 0; lod < MAX_MODEL_LODS; lod++ )
+	{
+		for( int i = 0; i < lods[lod].surfaces.Num(); i++ )
+		{
+			R_FreeStaticTriSurf( lods[lod].surfaces[i] );
+		}
+		lods[lod].surfaces.Clear();
+		lods[lod].error = 0.0f;
+	}
+	numLods = 0;
+}
+
+/*
+====================
+idRenderModelStatic::NumLods
+====================
+*/
+int idRenderModelStatic::NumLods() const
+{
+	return numLods;
+}
+
+/*
+====================
+idRenderModelStatic::LodError
+====================
+*/
+float idRenderModelStatic::LodError( int lod ) const
+{
+	if( lod <= 0 || lod > numLods )
+	{
+		return 0.0f;
+	}
+	return lods[lod - 1].error;
+}
+
+/*
+====================
+idRenderModelStatic::LodSurface
+
+Surfaces that were not simplified at a level fall back to the next finer level.
+====================
+*/
+srfTriangles_t* idRenderModelStatic::LodSurface( int lod, int surfaceNum ) const
+{
+	for( lod = Min( lod, numLods ); lod > 0; lod-- )
+	{
+		const modelLod_t& level = lods[lod - 1];
+		if( surfaceNum < level.surfaces.Num() && level.surfaces[surfaceNum] != NULL )
+		{
+			return level.surfaces[surfaceNum];
+		}
+	}
+	return surfaces[surfaceNum].geometry;
+}
+
+/*
+====================
+idRenderModelStatic::LodTriangles
+
+Number of triangles drawn at the given level.
+====================
+*/
+int idRenderModelStatic::LodTriangles( int lod ) const
+{
+	int numTris = 0;
+	for( int i = 0; i < surfaces.Num(); i++ )
+	{
+		const srfTriangles_t* tri = LodSurface( lod, i );
+		if( tri != NULL )
+		{
+			numTris += tri->numIndexes / 3;
+		}
+	}
+	return numTris;
+}
+
+/*
+====================
+idRenderModelStatic::ReadLods
+
+Every index is checked against the vertexes of the full detail surface, a
+damaged or stale file returns false so the model is built from its source.
+====================
+*/
+bool idRenderModelStatic::ReadLods( idFile* file )
+{
+	FreeLods();
+
+	int numLevels = 0;
+	if( file->ReadBig( numLevels ) != sizeof( numLevels ) || numLevels < 0 || numLevels > MAX_MODEL_LODS )
+	{
+		return false;
+	}
+
+	for( int lod = 0; lod < numLevels; lod++ )
+	{
+		modelLod_t& level = lods[lod];
+		level.surfaces.SetNum( surfaces.Num() );
+		for( int i = 0; i < surfaces.Num(); i++ )
+		{
+			level.surfaces[i] = NULL;
+		}
+		numLods = lod + 1;
+
+		if( file->ReadFloat( level.error ) != sizeof( level.error ) )
+		{
+			FreeLods();
+			return false;
+		}
+
+		for( int i = 0; i < surfaces.Num(); i++ )
+		{
+			bool isGeometry = false;
+			if( file->ReadBig( isGeometry ) != sizeof( isGeometry ) )
+			{
+				FreeLods();
+				return false;
+			}
+			if( !isGeometry )
+			{
+				continue;
+			}
+
+			const srfTriangles_t* tri = surfaces[i].geometry;
+
+			int numIndexes = 0;
+			if( file->ReadBig( numIndexes ) != sizeof( numIndexes ) || tri == NULL ||
+					numIndexes <= 0 || numIndexes % 3 != 0 || numIndexes > tri->numIndexes )
+			{
+				FreeLods();
+				return false;
+			}
+
+			srfTriangles_t* lodTri = R_AllocLodTriSurf( tri, numIndexes );
+			level.surfaces[i] = lodTri;
+
+			if( file->ReadBigArray( lodTri->indexes, numIndexes ) != numIndexes * sizeof( lodTri->indexes[0] ) )
+			{
+				FreeLods();
+				return false;
+			}
+
+			for( int j = 0; j < numIndexes; j++ )
+			{
+				if( lodTri->indexes[j] >= tri->numVerts )
+				{
+					FreeLods();
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+/*
+====================
+idRenderModelStatic::WriteLods
+====================
+*/
+void idRenderModelStatic::WriteLods( idFile* file ) const
+{
+	file->WriteBig( numLods );
+	for( int lod = 0; lod < numLods; lod++ )
+	{
+		const modelLod_t& level = lods[lod];
+		file->WriteFloat( level.error );
+		for( int i = 0; i < surfaces.Num(); i++ )
+		{
+			const srfTriangles_t* lodTri = ( i < level.surfaces.Num() ) ? level.surfaces[i] : NULL;
+			file->WriteBig( lodTri != NULL );
+			if( lodTri != NULL )
+			{
+				file->WriteBig( lodTri->numIndexes );
+				file->WriteBigArray( lodTri->indexes, lodTri->numIndexes );
+			}
+		}
+	}
+}
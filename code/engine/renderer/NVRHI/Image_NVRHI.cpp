@@ -133,6 +133,11 @@ idImage::idImage( const char* name ) : imgName( name )
 	binaryFileTime = FILE_NOT_FOUND_TIMESTAMP;
 	refCount = 0;
 
+	droppedLevels = 0;
+	lastUsedFrame = 0;
+	bindHits = 0;
+	bindMisses = 0;
+
 #if 0
 	// debugging code
 	idStr ext;
@@ -343,7 +348,10 @@ This should not be done during normal game-play, if you can avoid it.
 */
 void idImage::AllocImage()
 {
+	// PurgeImage forgets the eviction, but the new texture is allocated for it
+	const int levels = droppedLevels;
 	PurgeImage();
+	droppedLevels = levels;
 
 	nvrhi::Format format = nvrhi::Format::RGBA8_UINT;
 	int bpp = 4;
@@ -466,8 +474,8 @@ void idImage::AllocImage()
 		return;
 	}
 
-	uint originalWidth = opts.width;
-	uint originalHeight = opts.height;
+	uint originalWidth = Max( opts.width >> droppedLevels, 1 );
+	uint originalHeight = Max( opts.height >> droppedLevels, 1 );
 
 	if( IsCompressed() )
 	{
@@ -507,7 +515,7 @@ void idImage::AllocImage()
 					   .setFormat( format )
 					   .setIsUAV( opts.isUAV )
 					   .setSampleCount( opts.samples )
-					   .setMipLevels( opts.numLevels );
+					   .setMipLevels( opts.numLevels - droppedLevels );
 
 	if( opts.colorFormat == CFM_GREEN_ALPHA )
 	{
@@ -603,7 +611,7 @@ void idImage::AllocImage()
 		imageCreateInfo.extent.width = scaledWidth;
 		imageCreateInfo.extent.height = scaledHeight;
 		imageCreateInfo.extent.depth = 1;
-		imageCreateInfo.mipLevels = opts.numLevels;
+		imageCreateInfo.mipLevels = opts.numLevels - droppedLevels;
 		imageCreateInfo.arrayLayers = textureDesc.arraySize;
 		imageCreateInfo.samples = static_cast< VkSampleCountFlagBits >( opts.samples );
 		imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
@@ -651,6 +659,7 @@ void idImage::PurgeImage()
 	sampler.Reset();
 	isLoaded = false;
 	defaulted = false;
+	droppedLevels = 0;
 }
 
 /*
@@ -314,7 +314,7 @@ void idRenderBackend::Shutdown()
 idRenderBackend::DrawElementsWithCounters
 =============
 */
-void idRenderBackend::DrawElementsWithCounters( const drawSurf_t* surf, bool shadowCounter )
+void idRenderBackend::DrawElementsWithCounters( const drawSurf_t* surf, bool shadowCounter, int numInstances )
 {
 	//
 	// get vertex buffer
@@ -383,9 +383,9 @@ void idRenderBackend::DrawElementsWithCounters( const drawSurf_t* surf, bool sha
 	}
 
 	//
-	// get GPU Skinning joint buffer
+	// get GPU Skinning joint buffer, instanced draws put their transforms in there as well
 	//
-	const vertCacheHandle_t jointHandle = surf->jointCache;
+	const vertCacheHandle_t jointHandle = ( numInstances > 1 ) ? surf->instanceCache : surf->jointCache;
 	currentJointBuffer = nullptr;
 	currentJointOffset = 0;
 
@@ -535,6 +535,7 @@ void idRenderBackend::DrawElementsWithCounters( const drawSurf_t* surf, bool sha
 	args.startVertexLocation = currentVertexOffset / sizeof( idDrawVert );
 	args.startIndexLocation = currentIndexOffset / sizeof( triIndex_t );
 	args.vertexCount = surf->numIndexes;
+	args.instanceCount = Max( numInstances, 1 );
 	commandList->drawIndexed( args );
 
 	// keep track of last context to avoid setting up the binding layout and binding set again.
@@ -549,7 +550,7 @@ void idRenderBackend::DrawElementsWithCounters( const drawSurf_t* surf, bool sha
 	else
 	{
 		pc.c_drawElements++;
-		pc.c_drawIndexes += surf->numIndexes;
+		pc.c_drawIndexes += surf->numIndexes * args.instanceCount;
 	}
 }
 
@@ -2012,6 +2013,13 @@ void idRenderBackend::GL_StartFrame()
 	// this can be expensive here because of the runtime image compression
 	//globalImages->LoadDeferredImages( commandList );
 
+	// swap the mip chains of evicted and restored images, the cached binding sets
+	// still reference the old textures so they have to go as well
+	if( globalImages->UpdateResidency( commandList ) )
+	{
+		bindingCache.Clear();
+	}
+
 	extern idCVar r_useNewSsaoPass;
 
 	if( !ssaoPass && r_useNewSsaoPass.GetBool() )
@@ -2601,6 +2609,7 @@ void idRenderBackend::StereoRenderExecuteBackEndCommands( const emptyCommand_t*
 			switch( cmds->commandId )
 			{
 				case RC_NOP:
+				case RC_STATIC_UPLOADS:
 					break;
 
 				case RC_DRAW_VIEW_GUI:
@@ -2716,6 +2725,8 @@ void idRenderBackend::ResizeImages()
 
 void idRenderBackend::SetCurrentImage( idImage* image )
 {
+	image->MarkUsed( image->IsLoaded() && !image->IsEvicted() );
+
 	// load the image if necessary (FIXME: not SMP safe!)
 	// RB: don't try again if last time failed
 	if( !image->IsLoaded() && !image->IsDefaulted() )
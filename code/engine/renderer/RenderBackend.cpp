@@ -54,6 +54,7 @@ idCVar r_useStencilShadowPreload( "r_useStencilShadowPreload", "0", CVAR_RENDERE
 idCVar r_skipShaderPasses( "r_skipShaderPasses", "0", CVAR_RENDERER | CVAR_BOOL, "" );
 idCVar r_skipInteractionFastPath( "r_skipInteractionFastPath", "1", CVAR_RENDERER | CVAR_BOOL, "" );
 idCVar r_useLightStencilSelect( "r_useLightStencilSelect", "0", CVAR_RENDERER | CVAR_BOOL, "use stencil select pass" );
+idCVar r_useParallelShadowMapViews( "r_useParallelShadowMapViews", "1", CVAR_RENDERER | CVAR_BOOL | CVAR_NOCHEAT, "calculate the shadow map matrices and surface lists of all lights in parallel with jobs" );
 
 extern idCVar stereoRender_swapEyes;
 
@@ -991,6 +992,30 @@ void idRenderBackend::FillDepthBufferFast( drawSurf_t** drawSurfs, int numDrawSu
 			continue;
 		}
 
+		// already drawn by the instanced draw of an earlier surface
+		if( surf->numInstances < 0 )
+		{
+			continue;
+		}
+
+		// the instanced program takes every transform from the instance buffer
+		if( surf->numInstances > 1 )
+		{
+			renderLog.OpenBlock( va( "%s (%i instances)", shader->GetName(), surf->numInstances ), colorMdGrey );
+
+			renderProgManager.BindShader_DepthInstanced();
+
+			assert( ( GL_GetCurrentState() & GLS_DEPTHFUNC_BITS ) == GLS_DEPTHFUNC_LESS );
+
+			DrawElementsWithCounters( surf, false, surf->numInstances );
+
+			pc.c_instancedDraws++;
+			pc.c_instancedSurfaces += surf->numInstances;
+
+			renderLog.CloseBlock();
+			continue;
+		}
+
 		// set polygon offset?
 
 		// set mvp matrix
@@ -3066,19 +3091,298 @@ void idRenderBackend::SetupShadowMapMatrices( viewLight_t* vLight, int side, idR
 	}
 }
 
+/*
+=====================
+RB_GetShadowMapSides
+
+The shadow map sides of a point light, the cascades of a parallel light
+or the single side -1 of a spot light.
+=====================
+*/
+static void RB_GetShadowMapSides( const viewLight_t* vLight, int& side, int& sideStop )
+{
+	if( vLight->parallel )
+	{
+		side = 0;
+		sideStop = r_shadowMapSplits.GetInteger() + 1;
+	}
+	else if( vLight->pointLight )
+	{
+		if( r_shadowMapSingleSide.GetInteger() != -1 )
+		{
+			side = r_shadowMapSingleSide.GetInteger();
+			sideStop = side + 1;
+		}
+		else
+		{
+			side = 0;
+			sideStop = 6;
+		}
+	}
+	else
+	{
+		side = -1;
+		sideStop = 0;
+	}
+}
+
+/*
+=====================
+RB_ShadowMapMVP
+=====================
+*/
+static void RB_ShadowMapMVP( const viewEntity_t* space, const viewLight_t* vLight, int side, const idRenderMatrix& lightProjectionRenderMatrix, const idRenderMatrix& lightViewRenderMatrix, idRenderMatrix& mvp )
+{
+	// model -> world
+	idRenderMatrix modelRenderMatrix;
+	idRenderMatrix::Transpose( *( idRenderMatrix* )space->modelMatrix, modelRenderMatrix );
+
+	// world -> light = light camera view of model in Doom
+	idRenderMatrix modelToLightRenderMatrix;
+	idRenderMatrix::Multiply( lightViewRenderMatrix, modelRenderMatrix, modelToLightRenderMatrix );
+
+	idRenderMatrix clipMVP;
+	idRenderMatrix::Multiply( lightProjectionRenderMatrix, modelToLightRenderMatrix, clipMVP );
+
+	if( vLight->parallel || side >= 0 )
+	{
+		// cascaded sun light shadowmap or point light
+		mvp = clipMVP;
+	}
+	else
+	{
+		// spot light
+		idRenderMatrix::Multiply( renderMatrix_windowSpaceToClipSpace, clipMVP, mvp );
+	}
+}
+
+/*
+=====================
+idRenderBackend::PrepareShadowMapView
+
+May be run in parallel.
+
+Calculates the shadow matrices of the light side and the clip space matrix of every
+surface that has to be drawn into it. The solid surfaces are stored first, followed
+by the perforated surfaces that need the general code path.
+=====================
+*/
+void idRenderBackend::PrepareShadowMapView( shadowMapView_t* view )
+{
+	viewLight_t* vLight = view->vLight;
+	const int side = view->side;
+
+	idRenderMatrix lightProjectionRenderMatrix;
+	idRenderMatrix lightViewRenderMatrix;
+	SetupShadowMapMatrices( vLight, side, lightProjectionRenderMatrix, lightViewRenderMatrix, view->stereoOrigin );
+
+	view->numSolidSurfs = 0;
+	view->numPerforatedSurfs = 0;
+
+	for( const drawSurf_t* drawSurf = vLight->globalShadows; drawSurf != NULL; drawSurf = drawSurf->nextOnLight )
+	{
+		if( drawSurf->numIndexes == 0 || drawSurf->material == NULL )
+		{
+			continue;
+		}
+		if( drawSurf->material->Coverage() == MC_PERFORATED )
+		{
+			view->numPerforatedSurfs++;
+		}
+		else if( drawSurf->material->Coverage() != MC_TRANSLUCENT )
+		{
+			view->numSolidSurfs++;
+		}
+	}
+
+	shadowMapSurf_t* solidSurfs = shadowMapSurfs.Ptr() + view->firstSurf;
+	shadowMapSurf_t* perforatedSurfs = solidSurfs + view->numSolidSurfs;
+
+	const viewEntity_t* space = NULL;
+	idRenderMatrix spaceMVP;
+
+	for( const drawSurf_t* drawSurf = vLight->globalShadows; drawSurf != NULL; drawSurf = drawSurf->nextOnLight )
+	{
+		if( drawSurf->numIndexes == 0 )
+		{
+			continue;	// a job may have created an empty shadow geometry
+		}
+
+		const idMaterial* shader = drawSurf->material;
+
+		if( shader == NULL )
+		{
+			continue;
+		}
+
+		// translucent surfaces don't put anything in the depth buffer
+		if( shader->Coverage() == MC_TRANSLUCENT )
+		{
+			continue;
+		}
+
+		if( drawSurf->space != space )
+		{
+			RB_ShadowMapMVP( drawSurf->space, vLight, side, lightProjectionRenderMatrix, lightViewRenderMatrix, spaceMVP );
+			space = drawSurf->space;
+		}
+
+		shadowMapSurf_t* surf = ( shader->Coverage() == MC_PERFORATED ) ? perforatedSurfs++ : solidSurfs++;
+		surf->mvp = spaceMVP;
+		surf->drawSurf = drawSurf;
+	}
+}
+
+/*
+=====================
+RB_PrepareShadowMapView
+=====================
+*/
+static void RB_PrepareShadowMapView( shadowMapView_t* view )
+{
+	backEnd.PrepareShadowMapView( view );
+}
+
+REGISTER_PARALLEL_JOB( RB_PrepareShadowMapView, "RB_PrepareShadowMapView" );
+
+/*
+=====================
+idRenderBackend::PrepareShadowMapViews
+
+Collects all shadow map sides and cascades of the shadow casting lights in the view
+and prepares them with parallel jobs. The caller has to wait for tr.backEndJobList
+before any of the views are drawn, the waiting can be overlapped with other work.
+=====================
+*/
+void idRenderBackend::PrepareShadowMapViews( const stereoOrigin_t stereoOrigin )
+{
+	shadowMapViews.SetNum( 0 );
+	shadowMapSurfs.SetNum( 0 );
+
+	if( r_skipShadows.GetBool() || ( viewDef->renderView.rdflags & RDF_NOSHADOWS ) )
+	{
+		return;
+	}
+
+	int numSurfs = 0;
+
+	for( viewLight_t* vLight = viewDef->viewLights; vLight != NULL; vLight = vLight->next )
+	{
+		if( vLight->lightShader->IsFogLight() || vLight->lightShader->IsBlendLight() )
+		{
+			continue;
+		}
+
+		if( vLight->localInteractions == NULL && vLight->globalInteractions == NULL && vLight->translucentInteractions == NULL )
+		{
+			continue;
+		}
+
+		if( vLight->shadowLOD == -1 || vLight->globalShadows == NULL )
+		{
+			// light doesn't cast shadows
+			continue;
+		}
+
+		int numLightSurfs = 0;
+		for( const drawSurf_t* drawSurf = vLight->globalShadows; drawSurf != NULL; drawSurf = drawSurf->nextOnLight )
+		{
+			numLightSurfs++;
+		}
+
+		int	side, sideStop;
+		RB_GetShadowMapSides( vLight, side, sideStop );
+
+		for( ; side < sideStop ; side++ )
+		{
+			vLight->shadowMapViewNum[ Max( 0, side ) ] = shadowMapViews.Num();
+
+			shadowMapView_t& view = shadowMapViews.Alloc();
+			view.vLight = vLight;
+			view.side = side;
+			view.stereoOrigin = stereoOrigin;
+			view.firstSurf = numSurfs;
+			view.numSolidSurfs = 0;
+			view.numPerforatedSurfs = 0;
+
+			numSurfs += numLightSurfs;
+		}
+	}
+
+	// the surface list must not be resized while the jobs are running
+	shadowMapSurfs.SetNum( numSurfs );
+
+	if( r_useParallelShadowMapViews.GetBool() )
+	{
+		for( int i = 0; i < shadowMapViews.Num(); i++ )
+		{
+			tr.backEndJobList->AddJob( ( jobRun_t )RB_PrepareShadowMapView, &shadowMapViews[i] );
+		}
+		tr.backEndJobList->Submit();
+	}
+	else
+	{
+		for( int i = 0; i < shadowMapViews.Num(); i++ )
+		{
+			PrepareShadowMapView( &shadowMapViews[i] );
+		}
+	}
+}
+
+/*
+=====================
+idRenderBackend::GetShadowMapView
+
+Returns the prepared view of the light side, or prepares it right away if it wasn't
+collected by PrepareShadowMapViews.
+=====================
+*/
+const shadowMapView_t& idRenderBackend::GetShadowMapView( viewLight_t* vLight, int side, const stereoOrigin_t stereoOrigin )
+{
+	const int viewNum = vLight->shadowMapViewNum[ Max( 0, side ) ];
+	if( viewNum >= 0 && viewNum < shadowMapViews.Num() )
+	{
+		const shadowMapView_t& view = shadowMapViews[ viewNum ];
+		if( view.vLight == vLight && view.side == side && view.stereoOrigin == stereoOrigin )
+		{
+			return view;
+		}
+	}
+
+	int numLightSurfs = 0;
+	for( const drawSurf_t* drawSurf = vLight->globalShadows; drawSurf != NULL; drawSurf = drawSurf->nextOnLight )
+	{
+		numLightSurfs++;
+	}
+
+	vLight->shadowMapViewNum[ Max( 0, side ) ] = shadowMapViews.Num();
+
+	shadowMapView_t& view = shadowMapViews.Alloc();
+	view.vLight = vLight;
+	view.side = side;
+	view.stereoOrigin = stereoOrigin;
+	view.firstSurf = shadowMapSurfs.Num();
+
+	shadowMapSurfs.SetNum( view.firstSurf + numLightSurfs );
+
+	PrepareShadowMapView( &view );
+
+	return view;
+}
+
 /*
 =====================
 idRenderBackend::ShadowMapPassPerforated
 =====================
 */
-void idRenderBackend::ShadowMapPassPerforated( const drawSurf_t** drawSurfs, int numDrawSurfs, viewLight_t* vLight, int side, const idRenderMatrix& lightProjectionRenderMatrix, const idRenderMatrix& lightViewRenderMatrix )
+void idRenderBackend::ShadowMapPassPerforated( const shadowMapSurf_t* surfs, int numSurfs )
 {
 	if( r_skipShadows.GetBool() )
 	{
 		return;
 	}
 
-	if( drawSurfs == NULL || numDrawSurfs <= 0 )
+	if( surfs == NULL || numSurfs <= 0 )
 	{
 		return;
 	}
@@ -3125,44 +3429,13 @@ void idRenderBackend::ShadowMapPassPerforated( const drawSurf_t** drawSurfs, int
 	// process the chain of shadows with the current rendering state
 	currentSpace = NULL;
 
-	for( int surfNum = 0; surfNum < numDrawSurfs; surfNum++ )
+	for( int surfNum = 0; surfNum < numSurfs; surfNum++ )
 	{
-		const drawSurf_t* drawSurf = drawSurfs[ surfNum ];
+		const drawSurf_t* drawSurf = surfs[ surfNum ].drawSurf;
 
 		if( drawSurf->space != currentSpace )
 		{
-			// model -> world
-			idRenderMatrix modelRenderMatrix;
-			idRenderMatrix::Transpose( *( idRenderMatrix* )drawSurf->space->modelMatrix, modelRenderMatrix );
-
-			// world -> light = light camera view of model in Doom
-			idRenderMatrix modelToLightRenderMatrix;
-			idRenderMatrix::Multiply( lightViewRenderMatrix, modelRenderMatrix, modelToLightRenderMatrix );
-
-			idRenderMatrix clipMVP;
-			idRenderMatrix::Multiply( lightProjectionRenderMatrix, modelToLightRenderMatrix, clipMVP );
-
-			if( vLight->parallel )
-			{
-				// cascaded sun light shadowmap
-				idRenderMatrix MVP;
-				idRenderMatrix::Multiply( renderMatrix_clipSpaceToWindowSpace, clipMVP, MVP );
-
-				RB_SetMVP( clipMVP );
-			}
-			else if( side < 0 )
-			{
-				// spot light
-				idRenderMatrix MVP;
-				idRenderMatrix::Multiply( renderMatrix_windowSpaceToClipSpace, clipMVP, MVP );
-
-				RB_SetMVP( MVP );
-			}
-			else
-			{
-				// point light
-				RB_SetMVP( clipMVP );
-			}
+			RB_SetMVP( surfs[ surfNum ].mvp );
 
 			// set the local light position to allow the vertex program to project the shadow volume end cap to infinity
 			/*
@@ -3174,6 +3447,7 @@ void idRenderBackend::ShadowMapPassPerforated( const drawSurf_t** drawSurfs, int
 			currentSpace = drawSurf->space;
 		}
 
+
 		bool didDraw = false;
 
 		const idMaterial* shader = drawSurf->material;
@@ -3295,14 +3569,17 @@ void idRenderBackend::ShadowMapPassPerforated( const drawSurf_t** drawSurfs, int
 idRenderBackend::ShadowMapPassFast
 =====================
 */
-void idRenderBackend::ShadowMapPassFast( const drawSurf_t* drawSurfs, viewLight_t* vLight, int side, bool atlas, const stereoOrigin_t stereoOrigin )
+void idRenderBackend::ShadowMapPassFast( const shadowMapView_t& view, bool atlas )
 {
 	if( r_skipShadows.GetBool() )
 	{
 		return;
 	}
 
-	if( drawSurfs == NULL )
+	const viewLight_t* vLight = view.vLight;
+	const int side = view.side;
+
+	if( vLight->globalShadows == NULL )
 	{
 		return;
 	}
@@ -3351,10 +3628,6 @@ void idRenderBackend::ShadowMapPassFast( const drawSurf_t* drawSurfs, viewLight_
 			break;
 	}
 
-	idRenderMatrix lightProjectionRenderMatrix;
-	idRenderMatrix lightViewRenderMatrix;
-	SetupShadowMapMatrices( vLight, side, lightProjectionRenderMatrix, lightViewRenderMatrix, stereoOrigin );
-
 	int slice = Max( 0, side );
 
 	if( atlas )
@@ -3381,83 +3654,20 @@ void idRenderBackend::ShadowMapPassFast( const drawSurf_t* drawSurfs, viewLight_
 	// process the chain of shadows with the current rendering state
 	currentSpace = NULL;
 
-	int numDrawSurfs = 0;
-	for( const drawSurf_t* drawSurf = drawSurfs; drawSurf != NULL; drawSurf = drawSurf->nextOnLight )
-	{
-		numDrawSurfs++;
-	}
-
-	const drawSurf_t** perforatedSurfaces = ( const drawSurf_t** )_alloca( numDrawSurfs * sizeof( drawSurf_t* ) );
-	int numPerforatedSurfaces = 0;
+	const shadowMapSurf_t* surfs = shadowMapSurfs.Ptr() + view.firstSurf;
 
-	for( const drawSurf_t* drawSurf = drawSurfs; drawSurf != NULL; drawSurf = drawSurf->nextOnLight )
+	for( int surfNum = 0; surfNum < view.numSolidSurfs; surfNum++ )
 	{
-
-		if( drawSurf->numIndexes == 0 )
-		{
-			continue;	// a job may have created an empty shadow geometry
-		}
-
-		const idMaterial* shader = drawSurf->material;
-
-		if( shader == NULL )
-		{
-			continue;
-		}
-
-		// translucent surfaces don't put anything in the depth buffer
-		if( shader->Coverage() == MC_TRANSLUCENT )
-		{
-			continue;
-		}
-
-		if( shader->Coverage() == MC_PERFORATED )
-		{
-			// save for later drawing
-			perforatedSurfaces[ numPerforatedSurfaces ] = drawSurf;
-			numPerforatedSurfaces++;
-			continue;
-		}
+		const drawSurf_t* drawSurf = surfs[ surfNum ].drawSurf;
 
 		if( drawSurf->space != currentSpace )
 		{
-			// model -> world
-			idRenderMatrix modelRenderMatrix;
-			idRenderMatrix::Transpose( *( idRenderMatrix* )drawSurf->space->modelMatrix, modelRenderMatrix );
-
-			// world -> light = light camera view of model in Doom
-			idRenderMatrix modelToLightRenderMatrix;
-			idRenderMatrix::Multiply( lightViewRenderMatrix, modelRenderMatrix, modelToLightRenderMatrix );
-
-			idRenderMatrix clipMVP;
-			idRenderMatrix::Multiply( lightProjectionRenderMatrix, modelToLightRenderMatrix, clipMVP );
-
-			if( vLight->parallel )
-			{
-				// cascaded sun light shadowmap
-				idRenderMatrix MVP;
-				idRenderMatrix::Multiply( renderMatrix_clipSpaceToWindowSpace, clipMVP, MVP );
-
-				RB_SetMVP( clipMVP );
-			}
-			else if( side < 0 )
-			{
-				// spot light
-				idRenderMatrix MVP;
-				idRenderMatrix::Multiply( renderMatrix_windowSpaceToClipSpace, clipMVP, MVP );
-
-				RB_SetMVP( MVP );
-			}
-			else
-			{
-				// point light
-				RB_SetMVP( clipMVP );
-			}
+			RB_SetMVP( surfs[ surfNum ].mvp );
 
 			currentSpace = drawSurf->space;
 		}
 
-		renderLog.OpenBlock( shader->GetName(), colorMdGrey );
+		renderLog.OpenBlock( drawSurf->material->GetName(), colorMdGrey );
 
 		if( drawSurf->jointCache )
 		{
@@ -3478,9 +3688,9 @@ void idRenderBackend::ShadowMapPassFast( const drawSurf_t* drawSurfs, viewLight_
 	}
 
 	// draw all perforated surfaces with the general code path
-	if( numPerforatedSurfaces > 0 )
+	if( view.numPerforatedSurfs > 0 )
 	{
-		ShadowMapPassPerforated( perforatedSurfaces, numPerforatedSurfaces, vLight, side, lightProjectionRenderMatrix, lightViewRenderMatrix );
+		ShadowMapPassPerforated( surfs + view.numSolidSurfs, view.numPerforatedSurfs );
 	}
 
 	renderLog.CloseBlock();
@@ -3520,6 +3730,13 @@ void idRenderBackend::ShadowAtlasPass( const viewDef_t* _viewDef, const stereoOr
 	OPTICK_GPU_CONTEXT( ( void* ) commandList->getNativeObject( commandObject ) );
 	OPTICK_GPU_EVENT( "Render_ShadowAtlas" );
 
+	// backend thread time of the whole pass, compare with r_useParallelShadowMapViews 0
+	const uint64 shadowStartTime = Sys_Microseconds();
+
+	// the shadow matrices and surface lists are calculated by jobs
+	// while the lights are sorted into the atlas
+	PrepareShadowMapViews( stereoOrigin );
+
 	renderLog.OpenMainBlock( MRB_SHADOW_ATLAS_PASS );
 	renderLog.OpenBlock( "Render_ShadowAtlas", colorYellow );
 
@@ -3685,6 +3902,8 @@ void idRenderBackend::ShadowAtlasPass( const viewDef_t* _viewDef, const stereoOr
 		}
 	}
 
+	tr.backEndJobList->Wait();
+
 	//
 	// for each light, perform shadowing to a big atlas Framebuffer
 	//
@@ -3769,7 +3988,7 @@ void idRenderBackend::ShadowAtlasPass( const viewDef_t* _viewDef, const stereoOr
 				continue;
 			}
 
-			ShadowMapPassFast( vLight->globalShadows, vLight, side, true, stereoOrigin );
+			ShadowMapPassFast( GetShadowMapView( vLight, side, stereoOrigin ), true );
 		}
 
 		if( !imageFitsIntoAtlas )
@@ -3805,6 +4024,8 @@ void idRenderBackend::ShadowAtlasPass( const viewDef_t* _viewDef, const stereoOr
 
 	renderLog.CloseBlock();
 	renderLog.CloseMainBlock();
+
+	pc.cpuShadowMicroSec += Sys_Microseconds() - shadowStartTime;
 }
 
 /*
@@ -3845,6 +4066,14 @@ void idRenderBackend::DrawInteractions( const viewDef_t* _viewDef, stereoOrigin_
 
 	Framebuffer* previousFramebuffer = Framebuffer::GetActiveFramebuffer();
 
+	if( !r_useShadowAtlas.GetBool() )
+	{
+		const uint64 shadowStartTime = Sys_Microseconds();
+		PrepareShadowMapViews( stereoOrigin );
+		tr.backEndJobList->Wait();
+		pc.cpuShadowMicroSec += Sys_Microseconds() - shadowStartTime;
+	}
+
 	//
 	// for each light, perform shadowing and adding
 	//
@@ -3904,12 +4133,13 @@ void idRenderBackend::DrawInteractions( const viewDef_t* _viewDef, stereoOrigin_
 					sideStop = 0;
 				}
 
+				const uint64 shadowStartTime = Sys_Microseconds();
 				for( ; side < sideStop ; side++ )
 				{
 					// vLight is const but we make an exception here to store the shadow matrices per vLight
-					// OPTIMIZE: these calculations could be moved to the renderer frontend into the multithreaded job
-					ShadowMapPassFast( vLight->globalShadows, ( viewLight_t* ) vLight, side, false, stereoOrigin );
+					ShadowMapPassFast( GetShadowMapView( ( viewLight_t* ) vLight, side, stereoOrigin ), false );
 				}
+				pc.cpuShadowMicroSec += Sys_Microseconds() - shadowStartTime;
 
 				// go back to main render target
 				if( previousFramebuffer != NULL )
@@ -5475,6 +5705,7 @@ void idRenderBackend::ExecuteBackEndCommands( const emptyCommand_t* cmds )
 		switch( cmds->commandId )
 		{
 			case RC_NOP:
+			case RC_STATIC_UPLOADS:	// already executed by RenderCommandBuffers
 				break;
 
 			case RC_DRAW_VIEW_GUI:
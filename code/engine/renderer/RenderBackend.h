@@ -106,6 +106,32 @@ struct debugPolygon_t
 void RB_SetMVP( const idRenderMatrix& mvp );
 void RB_SetVertexColorParms( stageVertexColor_t svc );
 
+/*
+================================================
+shadowMapView_t
+
+A single shadow map side or cascade of a light. The light matrices and the clip space
+matrix of every shadow surface are calculated by parallel jobs before the shadow pass,
+so the backend thread only has to record the draws.
+================================================
+*/
+struct shadowMapSurf_t
+{
+	idRenderMatrix			mvp;
+	const drawSurf_t* 		drawSurf;
+};
+
+struct shadowMapView_t
+{
+	viewLight_t* 			vLight;
+	int						side;
+	stereoOrigin_t			stereoOrigin;
+
+	int						firstSurf;				// into idRenderBackend::shadowMapSurfs
+	int						numSolidSurfs;
+	int						numPerforatedSurfs;		// stored after the solid surfaces
+};
+
 /*
 ===========================================================================
 
@@ -142,7 +168,7 @@ public:
 
 	static void			ImGui_RenderDrawLists( ImDrawData* draw_data );
 
-	void				DrawElementsWithCounters( const drawSurf_t* surf, bool shadowCounter = false );
+	void				DrawElementsWithCounters( const drawSurf_t* surf, bool shadowCounter = false, int numInstances = 1 );
 
 private:
 	void				DrawFlickerBox();
@@ -183,8 +209,10 @@ private:
 	void				AmbientPass( const drawSurf_t* const* drawSurfs, int numDrawSurfs, bool fillGbuffer, const stereoOrigin_t stereoOrigin );
 
 	void				SetupShadowMapMatrices( viewLight_t* vLight, int side, idRenderMatrix& lightProjectionRenderMatrix, idRenderMatrix& lightViewRenderMatrix, const stereoOrigin_t stereoOrigin );
-	void				ShadowMapPassFast( const drawSurf_t* drawSurfs, viewLight_t* vLight, int side, bool atlas, const stereoOrigin_t stereoOrigin );
-	void				ShadowMapPassPerforated( const drawSurf_t** drawSurfs, int numDrawSurfs, viewLight_t* vLight, int side, const idRenderMatrix& lightProjectionRenderMatrix, const idRenderMatrix& lightViewRenderMatrix );
+	void				PrepareShadowMapViews( const stereoOrigin_t stereoOrigin );
+	const shadowMapView_t& GetShadowMapView( viewLight_t* vLight, int side, const stereoOrigin_t stereoOrigin );
+	void				ShadowMapPassFast( const shadowMapView_t& view, bool atlas );
+	void				ShadowMapPassPerforated( const shadowMapSurf_t* surfs, int numSurfs );
 
 	void				ShadowAtlasPass( const viewDef_t* _viewDef, const stereoOrigin_t stereoOrigin );
 
@@ -325,6 +353,9 @@ private:
 	void				DBG_RenderDebugTools( drawSurf_t** drawSurfs, int numDrawSurfs );
 
 public:
+	// may be run in parallel
+	void				PrepareShadowMapView( shadowMapView_t* view );
+
 	backEndCounters_t	pc;
 
 	// surfaces used for code-based drawing
@@ -359,6 +390,10 @@ private:
 	// quad-tree for managing tiles within tiled shadow map
 	TileMap				tileMap;
 
+	// shadow map views of the current view, filled by PrepareShadowMapViews
+	idList<shadowMapView_t, TAG_RENDER>	shadowMapViews;
+	idList<shadowMapSurf_t, TAG_RENDER>	shadowMapSurfs;
+
 private:
 	idScreenRect					stateViewport;
 	idScreenRect					stateScissor;
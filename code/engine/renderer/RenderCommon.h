@@ -102,8 +102,13 @@ struct drawSurf_t
 	drawSurf_t** 			linkChain;			// defer linking to lights to a serial section to avoid a mutex
 	idScreenRect			scissorRect;		// for scissor clipping, local inside renderView viewport
 	const struct portalArea_s*	area;			// RB: if != NULL then the area provides valid lightgrid
+	int						numInstances;		// 0 = single draw, > 1 = leads an instanced depth batch, < 0 = drawn by another batch
+	vertCacheHandle_t		instanceCache;		// numInstances * 4 idVec4 MVP rows, only valid for batch leaders
 };
 
+// instance transforms share the skinning structured buffer binding, which is bound with 480 idVec4
+const int MAX_DEPTH_INSTANCES = 120;
+
 // areas have references to hold all the lights and entities in them
 struct areaReference_t
 {
@@ -313,6 +318,8 @@ public:
 	idInteraction* 			lastInteraction;
 
 	bool					needsPortalSky;
+
+	int						lodLevel;				// generated detail level picked in the last primary view
 };
 
 struct shadowOnlyEntity_t
@@ -354,6 +361,10 @@ struct viewLight_t
 	};
 	byte* 					entityInteractionState;		// [numEntities]
 
+	// R_AddSingleLight batched bounds culling stats, summed up serially in R_AddLights
+	int						boxCullIn;
+	int						boxCullOut;
+
 	idVec3					globalLightOrigin;			// global light origin used by backend
 	idPlane					lightProject[4];			// light project used by backend
 	idPlane					fogPlane;					// fog plane for backend fog volume rendering
@@ -368,6 +379,7 @@ struct viewLight_t
 	idRenderMatrix			shadowP[6];					// shadow depth projection matrix for lighting pass
 	idVec2i					imageSize;
 	idVec2i					imageAtlasOffset[6];
+	int						shadowMapViewNum[6];		// index of the backend shadowMapView_t of each side
 	// RB end
 	idRenderMatrix			inverseBaseLightProject;	// the matrix for deforming the 'zeroOneCubeModel' to exactly cover the light volume in world space
 	const idMaterial* 		lightShader;				// light shader used by backend
@@ -667,6 +679,7 @@ enum renderCommand_t
 	RC_COPY_RENDER,
 	RC_POST_PROCESS,		// postfx after scene rendering is done but before GUI rendering
 	RC_CRT_POST_PROCESS,	// CRT simulation after everything has been rendered on the final swapchain image
+	RC_STATIC_UPLOADS,		// static buffer uploads recorded by the front end, executed before the frame is drawn
 };
 
 struct emptyCommand_t
@@ -717,6 +730,13 @@ struct crtPostProcessCommand_t
 	int					padding;
 };
 
+struct staticUploadsCommand_t
+{
+	renderCommand_t		commandId;
+	renderCommand_t* 	next;
+	nvrhi::ICommandList*	commandList;	// closed, holds a reference until the back end has executed it
+};
+
 //=======================================================================
 
 // this is the inital allocation for max number of drawsurfs
@@ -736,6 +756,7 @@ enum frameAllocType_t
 	FRAME_ALLOC_SHADER_REGISTER,
 	FRAME_ALLOC_DRAW_SURFACE_POINTER,
 	FRAME_ALLOC_DRAW_COMMAND,
+	FRAME_ALLOC_CULL_LIST,
 	FRAME_ALLOC_UNKNOWN,
 	FRAME_ALLOC_MAX
 };
@@ -766,6 +787,7 @@ extern	idFrameData*	frameData;
 
 void R_AddDrawViewCmd( viewDef_t* parms, bool guiOnly );
 void R_AddDrawPostProcess( viewDef_t* parms );
+void R_AddStaticUploadsCmd( nvrhi::ICommandList* commandList );
 
 void R_ReloadGuis_f( const idCmdArgs& args );
 void R_ListGuis_f( const idCmdArgs& args );
@@ -1036,6 +1058,7 @@ public:
 	drawSurf_t				testImageSurface_;
 
 	idParallelJobList* 		frontEndJobList;
+	idParallelJobList* 		backEndJobList;
 
 	// RB irradiance and GGX background jobs
 	idParallelJobList* 					envprobeJobList;
@@ -1563,6 +1586,33 @@ void R_AddModels();
 /*
 ============================================================
 
+TR_FRONTEND_INSTANCING
+
+============================================================
+*/
+
+struct instancedSurf_t
+{
+	int					surfNum;			// index into the draw surf list
+	vertCacheHandle_t	ambientCache;
+	vertCacheHandle_t	indexCache;
+	int					numIndexes;
+};
+
+struct instanceBatch_t
+{
+	int					firstInstance;		// into the sorted instancedSurf_t list, [0] is the batch leader
+	int					numInstances;
+};
+
+bool R_SurfIsInstanceable( const drawSurf_t* drawSurf );
+int R_GroupInstancedSurfs( instancedSurf_t* surfs, int numSurfs, int minInstances, instanceBatch_t* batches );
+void R_BuildInstanceMatrices( const drawSurf_t* const* drawSurfs, const instancedSurf_t* surfs, const instanceBatch_t& batch, idVec4* rows );
+void R_AddInstancedDepthSurfs( viewDef_t* viewDef );
+
+/*
+============================================================
+
 TR_FRONTEND_MASKED_OCCLUSION_CULLING
 
 ============================================================
@@ -1664,6 +1714,7 @@ void				R_InitDrawSurfFromTri( drawSurf_t& ds, srfTriangles_t& tri, nvrhi::IComm
 // For static surfaces, the indexes, ambient, and shadow buffers can be pre-created at load
 // time, rather than being re-created each frame in the frame temporary buffers.
 void				R_CreateStaticBuffersForTri( srfTriangles_t& tri, nvrhi::ICommandList* commandList );
+void				R_CreateStaticBuffersForLodTri( srfTriangles_t& tri, const srfTriangles_t& baseTri, nvrhi::ICommandList* commandList );
 
 // RB
 idVec3				R_ClosestPointPointTriangle( const idVec3& point, const idVec3& vertex1, const idVec3& vertex2, const idVec3& vertex3 );
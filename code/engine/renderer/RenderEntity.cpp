@@ -53,6 +53,7 @@ idRenderEntityLocal::idRenderEntityLocal()
 	firstInteraction		= NULL;
 	lastInteraction			= NULL;
 	needsPortalSky			= false;
+	lodLevel				= 0;
 }
 
 void idRenderEntityLocal::FreeRenderEntity()
@@ -365,6 +365,7 @@ enum
 
 	BUILTIN_DEPTH,
 	BUILTIN_DEPTH_SKINNED,
+	BUILTIN_DEPTH_INSTANCED,
 
 	BUILTIN_BLENDLIGHT,
 	BUILTIN_BLENDLIGHT_SKINNED,
@@ -808,6 +809,11 @@ public:
 		BindShader_Builtin( BUILTIN_DEPTH_SKINNED );
 	}
 
+	void	BindShader_DepthInstanced()
+	{
+		BindShader_Builtin( BUILTIN_DEPTH_INSTANCED );
+	}
+
 	void	BindShader_BlendLight()
 	{
 		BindShader_Builtin( BUILTIN_BLENDLIGHT );
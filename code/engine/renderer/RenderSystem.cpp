@@ -61,6 +61,15 @@ void idRenderSystemLocal::PrintPerformanceCounters()
 						( backEnd.pc.c_drawIndexes + backEnd.pc.c_shadowIndexes ) / 3,
 						backEnd.pc.c_shadowIndexes / 3
 					  );
+
+		if( backEnd.pc.c_instancedDraws > 0 )
+		{
+			common->Printf( "instanced depth draws:%i surfs:%i (draws without instancing:%i)\n",
+							backEnd.pc.c_instancedDraws,
+							backEnd.pc.c_instancedSurfaces,
+							backEnd.pc.c_drawElements + backEnd.pc.c_shadowElements - backEnd.pc.c_instancedDraws + backEnd.pc.c_instancedSurfaces
+						  );
+		}
 	}
 
 	if( r_showDynamic.GetBool() )
@@ -77,8 +86,8 @@ void idRenderSystemLocal::PrintPerformanceCounters()
 
 	if( r_showCull.GetBool() )
 	{
-		common->Printf( "%i box in %i box out\n",
-						pc.c_box_cull_in, pc.c_box_cull_out );
+		common->Printf( "%i box tested %i box in %i box out\n",
+						pc.c_box_cull_in + pc.c_box_cull_out, pc.c_box_cull_in, pc.c_box_cull_out );
 	}
 
 	if( r_showAddModel.GetBool() )
@@ -110,6 +119,18 @@ RenderCommandBuffers
 */
 void idRenderSystemLocal::RenderCommandBuffers( const emptyCommand_t* const cmdHead )
 {
+	// the front end can't use the device while the back end is drawing,
+	// so the static buffer uploads it recorded are executed here first, even if nothing is drawn
+	for( const emptyCommand_t* cmd = cmdHead ; cmd ; cmd = ( const emptyCommand_t* )cmd->next )
+	{
+		if( cmd->commandId == RC_STATIC_UPLOADS )
+		{
+			const staticUploadsCommand_t* uploads = ( const staticUploadsCommand_t* )cmd;
+			deviceManager->GetDevice()->executeCommandList( uploads->commandList );
+			uploads->commandList->Release();
+		}
+	}
+
 	// if there isn't a draw view command, do nothing to avoid swapping a bad frame
 	bool	hasView = false;
 	for( const emptyCommand_t* cmd = cmdHead ; cmd ; cmd = ( const emptyCommand_t* )cmd->next )
@@ -215,6 +236,22 @@ void	R_AddDrawPostProcess( viewDef_t* parms )
 	cmd->viewDef = parms;
 }
 
+/*
+=============
+R_AddStaticUploadsCmd
+
+Hands a closed command list with static buffer uploads to the back end,
+which executes it before anything of this frame is drawn.
+=============
+*/
+void	R_AddStaticUploadsCmd( nvrhi::ICommandList* commandList )
+{
+	staticUploadsCommand_t* cmd = ( staticUploadsCommand_t* )R_GetCommandBuffer( sizeof( *cmd ) );
+	cmd->commandId = RC_STATIC_UPLOADS;
+	cmd->commandList = commandList;
+	cmd->commandList->AddRef();
+}
+
 
 //=================================================================================
 
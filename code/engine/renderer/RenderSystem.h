@@ -159,6 +159,8 @@ struct backEndCounters_t
 
 	int		c_drawElements;
 	int		c_drawIndexes;
+	int		c_instancedDraws;		// depth prepass draws that covered more than one surface
+	int		c_instancedSurfaces;	// surfaces folded into those draws
 
 	int		c_shadowAtlasUsage; // allocated pixels in the atlas
 	int		c_shadowViews;
@@ -170,7 +172,7 @@ struct backEndCounters_t
 	float	c_overDraw;
 
 	uint64	cpuTotalMicroSec;		// total microseconds for backend run
-	uint64	cpuShadowMicroSec;
+	uint64	cpuShadowMicroSec;		// backend thread time spent preparing and recording shadow maps
 	uint64	gpuBeginDrawingMicroSec;
 	uint64	gpuDepthMicroSec;
 	uint64	gpuGeometryMicroSec;
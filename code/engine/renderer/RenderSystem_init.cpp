@@ -1845,6 +1845,7 @@ void idRenderSystemLocal::Clear()
 	}
 
 	frontEndJobList = NULL;
+	backEndJobList = NULL;
 
 	// RB
 	envprobeJobList = NULL;
@@ -2351,6 +2352,7 @@ void idRenderSystemLocal::Init()
 	}
 
 	frontEndJobList = parallelJobManager->AllocJobList( JOBLIST_RENDERER_FRONTEND, JOBLIST_PRIORITY_MEDIUM, 2048, 0, NULL );
+	backEndJobList = parallelJobManager->AllocJobList( JOBLIST_RENDERER_BACKEND, JOBLIST_PRIORITY_HIGH, 2048, 0, NULL );
 	envprobeJobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, 2048, 0, NULL ); // RB
 
 	if( deviceManager->GetGraphicsAPI() == nvrhi::GraphicsAPI::VULKAN )
@@ -2432,6 +2434,7 @@ void idRenderSystemLocal::Shutdown()
 
 	parallelJobManager->FreeJobList( envprobeJobList );
 	parallelJobManager->FreeJobList( frontEndJobList );
+	parallelJobManager->FreeJobList( backEndJobList );
 
 	Clear();
 
@@ -133,6 +133,8 @@ void R_ListRenderEntityDefs_f( const idCmdArgs& args )
 	}
 
 	common->Printf( "total active: %i\n", active );
+
+	tr.primaryWorld->interactionTable.PrintStats( tr.primaryWorld->lightDefs.Num(), tr.primaryWorld->entityDefs.Num() );
 }
 
 /*
@@ -156,9 +158,9 @@ idRenderWorldLocal::idRenderWorldLocal()
 	doublePortals = NULL;
 	numInterAreaPortals = 0;
 
-	interactionTable = 0;
-	interactionTableWidth = 0;
-	interactionTableHeight = 0;
+	streamFile = NULL;
+	streamMemory = 0;
+	streamThread.world = this;
 
 	for( int i = 0; i < decals.Num(); i++ )
 	{
@@ -185,6 +187,11 @@ idRenderWorldLocal::~idRenderWorldLocal()
 	// free all the entityDefs, lightDefs, portals, etc
 	FreeWorld();
 
+	if( streamThread.IsRunning() )
+	{
+		streamThread.StopThread();
+	}
+
 	for( int i = 0; i < decals.Num(); i++ )
 	{
 		delete decals[i].decals;
@@ -201,37 +208,6 @@ idRenderWorldLocal::~idRenderWorldLocal()
 	RB_ClearDebugText( 0 );
 }
 
-/*
-===================
-ResizeInteractionTable
-===================
-*/
-void idRenderWorldLocal::ResizeInteractionTable()
-{
-	// we overflowed the interaction table, so make it larger
-	common->Printf( "idRenderWorldLocal::ResizeInteractionTable: overflowed interactionTable, resizing\n" );
-
-	const int oldInteractionTableWidth = interactionTableWidth;
-	const int oldIinteractionTableHeight = interactionTableHeight;
-	idInteraction** oldInteractionTable = interactionTable;
-
-	// build the interaction table
-	// this will be dynamically resized if the entity / light counts grow too much
-	interactionTableWidth = entityDefs.Num() + 100;
-	interactionTableHeight = lightDefs.Num() + 100;
-	const int	size =  interactionTableWidth * interactionTableHeight * sizeof( *interactionTable );
-	interactionTable = ( idInteraction** )R_ClearedStaticAlloc( size );
-	for( int l = 0; l < oldIinteractionTableHeight; l++ )
-	{
-		for( int e = 0; e < oldInteractionTableWidth; e++ )
-		{
-			interactionTable[ l * interactionTableWidth + e ] = oldInteractionTable[ l * oldInteractionTableWidth + e ];
-		}
-	}
-
-	R_StaticFree( oldInteractionTable );
-}
-
 /*
 ===================
 AddEntityDef
@@ -244,11 +220,6 @@ qhandle_t idRenderWorldLocal::AddEntityDef( const renderEntity_t* re )
 	if( entityHandle == -1 )
 	{
 		entityHandle = entityDefs.Append( NULL );
-
-		if( interactionTable && entityDefs.Num() > interactionTableWidth )
-		{
-			ResizeInteractionTable();
-		}
 	}
 
 	UpdateEntityDef( entityHandle, re );
@@ -406,6 +377,7 @@ void idRenderWorldLocal::FreeEntityDef( qhandle_t entityHandle )
 
 	delete def;
 	entityDefs[ entityHandle ] = NULL;
+	entityBounds.ClearIndex( entityHandle );
 }
 
 /*
@@ -446,10 +418,6 @@ qhandle_t idRenderWorldLocal::AddLightDef( const renderLight_t* rlight )
 	if( lightHandle == -1 )
 	{
 		lightHandle = lightDefs.Append( NULL );
-		if( interactionTable && lightDefs.Num() > interactionTableHeight )
-		{
-			ResizeInteractionTable();
-		}
 	}
 	UpdateLightDef( lightHandle, rlight );
 
@@ -563,6 +531,7 @@ void idRenderWorldLocal::FreeLightDef( qhandle_t lightHandle )
 
 	delete light;
 	lightDefs[lightHandle] = NULL;
+	lightBounds.ClearIndex( lightHandle );
 }
 
 /*
@@ -1102,6 +1071,9 @@ void idRenderWorldLocal::RenderScene( const renderView_t* renderView )
 	tr.primaryRenderView = *renderView;
 	tr.primaryView = parms;
 
+	// bring in the area geometry around the view before it is flooded
+	UpdateAreaStreaming( parms->initialViewAreaOrigin );
+
 	// rendering this view may cause other views to be rendered
 	// for mirrors / portals / shadows / environment maps
 	// this will also cause any necessary entities and lights to be
@@ -1930,11 +1902,8 @@ void idRenderWorldLocal::GenerateAllInteractions()
 	tr.viewDef = NULL;
 
 	// build the interaction table
-	// this will be dynamically resized if the entity / light counts grow too much
-	interactionTableWidth = entityDefs.Num() + 100;
-	interactionTableHeight = lightDefs.Num() + 100;
-	int	size =  interactionTableWidth * interactionTableHeight * sizeof( *interactionTable );
-	interactionTable = ( idInteraction** )R_ClearedStaticAlloc( size );
+	// it grows with the number of interactions, so give it a rough guess
+	interactionTable.Init( lightDefs.Num() * 16 );
 
 	tr.commandList->open();
 
@@ -1998,7 +1967,7 @@ void idRenderWorldLocal::GenerateAllInteractions()
 	int	msec = end - start;
 
 	common->Printf( "idRenderWorld::GenerateAllInteractions, msec = %i\n", msec );
-	common->Printf( "interactionTable size: %i bytes\n", size );
+	interactionTable.PrintStats( lightDefs.Num(), entityDefs.Num() );
 	common->Printf( "%i interactions take %i bytes\n", count, count * sizeof( idInteraction ) );
 
 	// entities flagged as noDynamicInteractions will no longer make any
@@ -485,6 +485,10 @@ public:
 	virtual	void			SetPortalState( qhandle_t portal, int blockingBits ) = 0;
 	virtual int				GetPortalState( qhandle_t portal ) = 0;
 
+	// changes whenever a portal state change alters what the portals block,
+	// so the sound system can tell when cached portal paths are stale
+	virtual int				PortalStateChangeCount() const = 0;
+
 	// returns true only if a chain of portals without the given connection bits set
 	// exists between the two areas (a door doesn't separate them, etc)
 	virtual	bool			AreasAreConnected( int areaNum1, int areaNum2, portalConnection_t connection ) const = 0;
@@ -56,6 +56,11 @@ void R_DeriveEntityData( idRenderEntityLocal* entity )
 
 	// calculate the global model bounds by inverse projecting the unit cube with the 'inverseBaseModelProject'
 	idRenderMatrix::ProjectedBounds( entity->globalReferenceBounds, entity->inverseBaseModelProject, bounds_unitCube, false );
+
+	if( entity->world != NULL )
+	{
+		entity->world->entityBounds.SetIndex( entity->index, entity->globalReferenceBounds );
+	}
 }
 
 /*
@@ -466,6 +471,12 @@ void R_DeriveLightData( idRenderLightLocal* light )
 
 	// calculate the global light bounds by inverse projecting the zero to one cube with the 'inverseBaseLightProject'
 	idRenderMatrix::ProjectedBounds( light->globalLightBounds, light->inverseBaseLightProject, bounds_zeroOneCube, false );
+
+	// the fake lights of R_RenderLightFrustum don't belong to a world
+	if( light->world != NULL )
+	{
+		light->world->lightBounds.SetIndex( light->index, light->globalLightBounds );
+	}
 }
 
 /*
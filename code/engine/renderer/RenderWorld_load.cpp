@@ -31,6 +31,7 @@ If you have questions concerning this license or the applicable additional terms
 #pragma hdrstop
 
 #include "RenderCommon.h"
+#include "Model_local.h"
 
 
 /*
@@ -93,6 +94,9 @@ void idRenderWorldLocal::FreeWorld()
 		areaNodes = NULL;
 	}
 
+	// the streamed areas point into localModels
+	FreeAreaStreams();
+
 	// free all the inline idRenderModels
 	for( int i = 0; i < localModels.Num(); i++ )
 	{
@@ -140,7 +144,142 @@ idRenderModel* idRenderWorldLocal::ReadBinaryModel( idFile* fileIn )
 	return NULL;
 }
 
+/*
+================
+R_AreaModelNeedsPortalSky
+================
+*/
+static bool R_AreaModelNeedsPortalSky( const idRenderModel* model )
+{
+	for( int i = 0; i < model->NumSurfaces(); i++ )
+	{
+		const modelSurface_t* surf = model->Surface( i );
+
+		if( surf->shader->GetName() == idStr( "textures/smf/portal_sky" ) ||
+				surf->shader->IsPortalSky() )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+================
+idRenderWorldLocal::ReadBinaryAreaModel
+
+Area models are stored as chunks with a small header, so the
+surfaces can be skipped and read later by the area streaming
+================
+*/
+idRenderModel* idRenderWorldLocal::ReadBinaryAreaModel( idFile* fileIn, bool stream )
+{
+	idStrStatic< MAX_OSPATH > name;
+	fileIn->ReadString( name );
+
+	idBounds bounds;
+	fileIn->ReadVec3( bounds[0] );
+	fileIn->ReadVec3( bounds[1] );
+
+	bool needsPortalSky = false;
+	fileIn->ReadBig( needsPortalSky );
+
+	// register the materials now, so their images are loaded with the level
+	int numMaterials = 0;
+	fileIn->ReadBig( numMaterials );
+	for( int i = 0; i < numMaterials; i++ )
+	{
+		idStrStatic< MAX_OSPATH > materialName;
+		fileIn->ReadString( materialName );
+		if( stream )
+		{
+			declManager->FindMaterial( materialName );
+		}
+	}
+
+	int chunkSize = 0;
+	fileIn->ReadBig( chunkSize );
+
+	idRenderModel* model = renderModelManager->AllocModel();
+	model->InitEmpty( name );
+
+	if( !stream )
+	{
+		if( model->LoadBinaryModel( fileIn, mapTimeStamp, 0 ) )
+		{
+			return model;
+		}
+		return NULL;
+	}
+
+	int areaNum = atoi( name.c_str() + 5 );
+	if( areaNum < 0 || chunkSize <= 0 )
+	{
+		return NULL;
+	}
+
+	areaStreams.AssureSize( areaNum + 1 );
+
+	areaStream_t& areaStream = areaStreams[areaNum];
+	areaStream.model = model;
+	areaStream.fileOffset = fileIn->Tell();
+	areaStream.fileSize = chunkSize;
+	areaStream.needsPortalSky = needsPortalSky;
+
+	// the entity references need the bounds before the surfaces are loaded
+	static_cast< idRenderModelStatic* >( model )->bounds = bounds;
+
+	fileIn->Seek( chunkSize, FS_SEEK_CUR );
+
+	return model;
+}
+
+/*
+================
+idRenderWorldLocal::WriteBinaryAreaModel
+================
+*/
+void idRenderWorldLocal::WriteBinaryAreaModel( idFile* fileOut, const idRenderModel* model, ID_TIME_T timeStamp )
+{
+	const idBounds& bounds = model->Bounds();
+	fileOut->WriteVec3( bounds[0] );
+	fileOut->WriteVec3( bounds[1] );
+
+	fileOut->WriteBig( R_AreaModelNeedsPortalSky( model ) );
+
+	idStrList materials;
+	for( int i = 0; i < model->NumSurfaces(); i++ )
+	{
+		const idMaterial* shader = model->Surface( i )->shader;
+		if( shader != NULL )
+		{
+			materials.AddUnique( shader->GetName() );
+		}
+	}
+
+	fileOut->WriteBig( materials.Num() );
+	for( int i = 0; i < materials.Num(); i++ )
+	{
+		fileOut->WriteString( materials[i] );
+	}
+
+	// the chunk size is patched in once the model is written
+	int chunkSize = 0;
+	int sizeOffset = fileOut->Tell();
+	fileOut->WriteBig( chunkSize );
+
+	int chunkStart = fileOut->Tell();
+	model->WriteBinaryModel( fileOut, &timeStamp );
+	int chunkEnd = fileOut->Tell();
+
+	chunkSize = chunkEnd - chunkStart;
+	fileOut->Seek( sizeOffset, FS_SEEK_SET );
+	fileOut->WriteBig( chunkSize );
+	fileOut->Seek( chunkEnd, FS_SEEK_SET );
+}
+
 extern idCVar binaryLoadRenderModels;
+extern idCVar r_streamWorldAreas;
 
 /*
 ================
@@ -162,7 +301,7 @@ idRenderModel* idRenderWorldLocal::ParseModel( idLexer* src, const char* mapName
 	if( fileOut != NULL )
 	{
 		// write out the type so the binary reader knows what to instantiate
-		fileOut->WriteString( "model" );
+		fileOut->WriteString( model->IsStaticWorldModel() ? "areamodel" : "model" );
 		fileOut->WriteString( token );
 	}
 
@@ -307,7 +446,14 @@ idRenderModel* idRenderWorldLocal::ParseModel( idLexer* src, const char* mapName
 
 	if( fileOut != NULL && model->SupportsBinaryModel() && binaryLoadRenderModels.GetBool() )
 	{
-		model->WriteBinaryModel( fileOut, &mapTimeStamp );
+		if( model->IsStaticWorldModel() )
+		{
+			WriteBinaryAreaModel( fileOut, model, mapTimeStamp );
+		}
+		else
+		{
+			model->WriteBinaryModel( fileOut, &mapTimeStamp );
+		}
 	}
 
 	return model;
@@ -668,11 +814,7 @@ void idRenderWorldLocal::FreeDefs()
 {
 	generateAllInteractionsCalled = false;
 
-	if( interactionTable )
-	{
-		R_StaticFree( interactionTable );
-		interactionTable = NULL;
-	}
+	interactionTable.Shutdown();
 
 	// free all lightDefs
 	for( int i = 0; i < lightDefs.Num(); i++ )
@@ -708,6 +850,9 @@ void idRenderWorldLocal::FreeDefs()
 	}
 	// RB end
 
+	entityBounds.ClearAll();
+	lightBounds.ClearAll();
+
 	// Reset decals and overlays
 	for( int i = 0; i < decals.Num(); i++ )
 	{
@@ -763,6 +908,14 @@ bool idRenderWorldLocal::InitFromMap( const char* name )
 		{
 			common->Printf( "idRenderWorldLocal::InitFromMap: retaining existing map\n" );
 			FreeDefs();
+
+			// the static vertex cache was cleared for the new level
+			for( int i = 0; i < areaStreams.Num(); i++ )
+			{
+				EvictArea( i );
+				areaStreams[i].staticCache.Clear();
+			}
+
 			TouchWorldModels();
 			AddWorldModelEntities();
 			ClearPortalStates();
@@ -777,10 +930,12 @@ bool idRenderWorldLocal::InitFromMap( const char* name )
 	// see if we have a generated version of this
 	static const byte BPROC_VERSION_BFG = 1;
 	static const byte BPROC_VERSION_MOC_DATA = 2;
-	static const byte BPROC_VERSION = BPROC_VERSION_MOC_DATA;
+	static const byte BPROC_VERSION_AREA_CHUNKS = 3;
+	static const byte BPROC_VERSION = BPROC_VERSION_AREA_CHUNKS;
 
 
 	static const unsigned int BPROC_MAGIC_BFG = ( 'P' << 24 ) | ( 'R' << 16 ) | ( 'O' << 8 ) | BPROC_VERSION_BFG;
+	static const unsigned int BPROC_MAGIC_MOC_DATA = ( 'P' << 24 ) | ( 'R' << 16 ) | ( 'O' << 8 ) | BPROC_VERSION_MOC_DATA;
 	static const unsigned int BPROC_MAGIC = ( 'P' << 24 ) | ( 'R' << 16 ) | ( 'O' << 8 ) | BPROC_VERSION;
 	bool loaded = false;
 	idFileLocal file( fileSystem->OpenFileReadMemory( generatedFileName ) );
@@ -789,18 +944,38 @@ bool idRenderWorldLocal::InitFromMap( const char* name )
 		int numEntries = 0;
 		int magic = 0;
 		file->ReadBig( magic );
-		if( magic == BPROC_MAGIC_BFG || magic == BPROC_MAGIC )
+		if( magic == BPROC_MAGIC_BFG || magic == BPROC_MAGIC_MOC_DATA || magic == BPROC_MAGIC )
 		{
 			file->ReadBig( numEntries );
 			file->ReadString( mapName );
 			file->ReadBig( mapTimeStamp );
 			loaded = true;
+
+			// only the area chunks of the current version can be skipped and streamed later
+			bool streamAreas = false;
+			if( r_streamWorldAreas.GetBool() && magic == BPROC_MAGIC )
+			{
+				streamFile = fileSystem->OpenFileRead( generatedFileName );
+				streamAreas = ( streamFile != NULL );
+			}
+
 			for( int i = 0; i < numEntries; i++ )
 			{
 				idStrStatic< MAX_OSPATH > type;
 				file->ReadString( type );
 				type.ToLower();
-				if( type == "model" )
+				if( type == "areamodel" )
+				{
+					idRenderModel* lastModel = ReadBinaryAreaModel( file, streamAreas );
+					if( lastModel == NULL )
+					{
+						loaded = false;
+						break;
+					}
+					renderModelManager->AddModel( lastModel );
+					localModels.Append( lastModel );
+				}
+				else if( type == "model" )
 				{
 					idRenderModel* lastModel = ReadBinaryModel( file );
 					if( lastModel == NULL )
@@ -836,6 +1011,15 @@ bool idRenderWorldLocal::InitFromMap( const char* name )
 					idLib::Error( "Binary proc file failed, unexpected type %s\n", type.c_str() );
 				}
 			}
+
+			if( !loaded || areaStreams.Num() == 0 )
+			{
+				FreeAreaStreams();
+			}
+			else if( !streamThread.IsRunning() )
+			{
+				streamThread.StartWorkerThread( "World Stream", CORE_ANY, THREAD_NORMAL );
+			}
 		}
 	}
 
@@ -1016,17 +1200,14 @@ void idRenderWorldLocal::AddWorldModelEntities()
 			common->Error( "idRenderWorldLocal::InitFromMap: bad area model lookup" );
 		}
 
-		idRenderModel* hModel = def->parms.hModel;
-
-		for( int j = 0; j < hModel->NumSurfaces(); j++ )
+		// areas that are streamed in later know it from their chunk header
+		if( i < areaStreams.Num() && areaStreams[i].model == def->parms.hModel )
 		{
-			const modelSurface_t* surf = hModel->Surface( j );
-
-			if( surf->shader->GetName() == idStr( "textures/smf/portal_sky" ) ||
-					surf->shader->IsPortalSky() )
-			{
-				def->needsPortalSky = true;
-			}
+			def->needsPortalSky = areaStreams[i].needsPortalSky;
+		}
+		else
+		{
+			def->needsPortalSky = R_AreaModelNeedsPortalSky( def->parms.hModel );
 		}
 
 		// the local and global reference bounds are the same for area models
@@ -31,6 +31,7 @@ If you have questions concerning this license or the applicable additional terms
 #define __RENDERWORLDLOCAL_H__
 
 #include "BoundsTrack.h"
+#include "BoundsSoA.h"
 
 // assume any lightDef or entityDef index above this is an internal error
 const int LUDICROUS_INDEX	= 10000;
@@ -152,6 +153,66 @@ struct reusableOverlay_t
 	idRenderModelOverlay* 	overlays;
 };
 
+// the surfaces of an area model that stay in the .bproc until the area
+// comes within r_streamWorldDistance portals of the view
+struct areaStream_t
+{
+	enum streamState_t
+	{
+		AREA_UNLOADED,
+		AREA_REQUESTED,		// queued for the stream thread
+		AREA_READ,			// chunk is in memory, waiting for the main thread to load it
+		AREA_RESIDENT
+	};
+
+	areaStream_t() :
+		model( NULL ),
+		fileOffset( 0 ),
+		fileSize( 0 ),
+		needsPortalSky( false ),
+		state( AREA_UNLOADED ),
+		data( NULL ),
+		lastNeededFrame( 0 ),
+		memory( 0 )
+	{
+	}
+
+	idRenderModel* 			model;
+	int						fileOffset;			// start of the binary model in the .bproc
+	int						fileSize;
+	bool					needsPortalSky;
+	streamState_t			state;
+	byte* 					data;				// read by the stream thread
+	int						lastNeededFrame;
+	int						memory;				// while resident
+
+	// the static vertex cache can't free single allocations, so the buffers
+	// of the first upload are kept and rebound when the area comes back
+	idList<vertCacheHandle_t, TAG_RENDER>	staticCache;
+};
+
+class idRenderWorldLocal;
+
+/*
+================================================
+idWorldStreamThread
+
+Reads the requested area chunks between two frames.
+================================================
+*/
+class idWorldStreamThread : public idSysThread
+{
+public:
+	idWorldStreamThread() :
+		world( NULL )
+	{
+	}
+
+	virtual int		Run();
+
+	idRenderWorldLocal*	world;
+};
+
 struct portalStack_t;
 
 class idRenderWorldLocal : public idRenderWorld
@@ -245,6 +306,10 @@ public:
 	idList<idRenderLightLocal*, TAG_LIGHT>			lightDefs;
 	idList<RenderEnvprobeLocal*, TAG_ENVPROBE>		envprobeDefs; // RB
 
+	// global bounds of the entityDefs / lightDefs by index for batched culling
+	idBoundsSoA				entityBounds;
+	idBoundsSoA				lightBounds;
+
 	idBlockAlloc<areaReference_t, 1024> areaReferenceAllocator;
 	idBlockAlloc<idInteraction, 256>	interactionAllocator;
 
@@ -257,13 +322,8 @@ public:
 	idArray<reusableOverlay_t, MAX_DECAL_SURFACES>	overlays;
 
 	// all light / entity interactions are referenced here for fast lookup without
-	// having to crawl the doubly linked lists.  EnntityDefs are sequential for better
-	// cache access, because the table is accessed by light in idRenderWorldLocal::CreateLightDefInteractions()
-	// Growing this table is time consuming, so we add a pad value to the number
-	// of entityDefs and lightDefs
-	idInteraction** 		interactionTable;
-	int						interactionTableWidth;		// entityDefs
-	int						interactionTableHeight;		// lightDefs
+	// having to crawl the doubly linked lists, only initialized by GenerateAllInteractions()
+	idInteractionTable		interactionTable;
 
 	bool					generateAllInteractionsCalled;
 
@@ -284,6 +344,24 @@ public:
 	void					ReadBinaryAreaPortals( idFile* file );
 	void					ReadBinaryNodes( idFile* file );
 	idRenderModel* 			ReadBinaryModel( idFile* file );
+	idRenderModel* 			ReadBinaryAreaModel( idFile* file, bool stream );
+	void					WriteBinaryAreaModel( idFile* file, const idRenderModel* model, ID_TIME_T timeStamp );
+
+	//--------------------------
+	// RenderWorld_stream.cpp
+
+	idList<areaStream_t, TAG_RENDER>	areaStreams;	// indexed by area number, empty if the areas are not streamed
+	idFile* 				streamFile;
+	idWorldStreamThread		streamThread;
+	int						streamMemory;			// bytes of resident streamed area geometry
+
+	void					UpdateAreaStreaming( const idVec3& origin );
+	void					ReadAreaChunks();
+	void					LoadAreaChunk( int areaNum, nvrhi::ICommandList* commandList );
+	void					EvictArea( int areaNum );
+	void					RegenerateAreaInteractions( int areaNum, nvrhi::ICommandList* commandList );
+	void					WaitForAreaStreams();
+	void					FreeAreaStreams();
 
 	//--------------------------
 	// RenderWorld_portals.cpp
@@ -329,6 +407,7 @@ public:
 	qhandle_t				FindPortal( const idBounds& b ) const;
 	void					SetPortalState( qhandle_t portal, int blockingBits );
 	int						GetPortalState( qhandle_t portal );
+	int						PortalStateChangeCount() const;
 	bool					AreasAreConnected( int areaNum1, int areaNum2, portalConnection_t connection ) const;
 	void					FloodConnectedAreas( portalArea_t* area, int portalAttributeIndex );
 	idScreenRect& 			GetAreaScreenRect( int areaNum ) const
@@ -340,8 +419,6 @@ public:
 	//--------------------------
 	// RenderWorld.cpp
 
-	void					ResizeInteractionTable();
-
 	void					AddEntityRefToArea( idRenderEntityLocal* def, portalArea_t* area );
 	void					AddLightRefToArea( idRenderLightLocal* light, portalArea_t* area );
 	void					AddEnvprobeRefToArea( RenderEnvprobeLocal* probe, portalArea_t* area ); // RB
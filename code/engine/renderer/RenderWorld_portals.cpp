@@ -414,6 +414,12 @@ void idRenderWorldLocal::AddAreaToView( int areaNum, const portalStack_t* ps )
 	// mark the viewCount, so r_showPortals can display the considered portals
 	portalAreas[ areaNum ].viewCount = tr.viewCount;
 
+	// a streamed area seen beyond r_streamWorldDistance must not be evicted while it is drawn
+	if( areaNum < areaStreams.Num() )
+	{
+		areaStreams[ areaNum ].lastNeededFrame = tr.frameCount;
+	}
+
 	// add the models and lights, using more precise culling to the planes
 	AddAreaViewEntities( areaNum, ps );
 	AddAreaViewLights( areaNum, ps );
@@ -1154,3 +1160,13 @@ int idRenderWorldLocal::GetPortalState( qhandle_t portal )
 	return doublePortals[portal - 1].blockingBits;
 }
 
+/*
+==============
+PortalStateChangeCount
+==============
+*/
+int idRenderWorldLocal::PortalStateChangeCount() const
+{
+	return connectedAreaNum;
+}
+
@@ -0,0 +1,498 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "precompiled.h"
+#pragma hdrstop
+
+#include "RenderCommon.h"
+#include "Model_local.h"
+
+#include <engine/sys/DeviceManager.h>
+extern DeviceManager* deviceManager;
+
+/*
+===============================================================================
+
+	World area streaming
+
+	With r_streamWorldAreas the surfaces of the area models stay in the .bproc
+	until the area comes within r_streamWorldDistance portals of the view.
+	Only the chunk headers are read with the map. The stream thread reads the
+	requested chunks between two frames and the front end loads them into
+	the area models before the view is flooded. Their static buffer uploads
+	are only recorded there and executed by the back end at the start of the
+	frame, because the back end may be drawing the previous frame on another
+	thread. Areas that have not been needed for the longest time are evicted
+	when the resident geometry grows beyond r_streamWorldMemory, but never
+	while the back end may still draw them.
+
+===============================================================================
+*/
+
+idCVar r_streamWorldAreas( "r_streamWorldAreas", "0", CVAR_RENDERER | CVAR_BOOL | CVAR_ARCHIVE, "load the surfaces of world areas on demand, takes effect on the next map load" );
+idCVar r_streamWorldDistance( "r_streamWorldDistance", "3", CVAR_RENDERER | CVAR_INTEGER, "areas within this many portals of the view area are kept loaded", 1, 64 );
+idCVar r_streamWorldMemory( "r_streamWorldMemory", "256", CVAR_RENDERER | CVAR_INTEGER, "MB of streamed area geometry that may stay loaded outside the stream distance" );
+idCVar r_showWorldStreaming( "r_showWorldStreaming", "0", CVAR_RENDERER | CVAR_BOOL, "print area streaming loads and evictions" );
+
+/*
+========================
+idWorldStreamThread::Run
+========================
+*/
+int idWorldStreamThread::Run()
+{
+	world->ReadAreaChunks();
+	return 0;
+}
+
+/*
+========================
+idRenderWorldLocal::ReadAreaChunks
+
+Runs on the stream thread, the front end doesn't touch the
+area streams or the stream file until it has waited for it
+========================
+*/
+void idRenderWorldLocal::ReadAreaChunks()
+{
+	for( int i = 0; i < areaStreams.Num(); i++ )
+	{
+		areaStream_t& areaStream = areaStreams[i];
+		if( areaStream.state != areaStream_t::AREA_REQUESTED )
+		{
+			continue;
+		}
+
+		areaStream.data = ( byte* )Mem_Alloc( areaStream.fileSize, TAG_RENDER );
+		if( streamFile->Seek( areaStream.fileOffset, FS_SEEK_SET ) != 0 ||
+				streamFile->Read( areaStream.data, areaStream.fileSize ) != areaStream.fileSize )
+		{
+			Mem_Free( areaStream.data );
+			areaStream.data = NULL;
+		}
+
+		areaStream.state = areaStream_t::AREA_READ;
+	}
+}
+
+/*
+========================
+idRenderWorldLocal::WaitForAreaStreams
+========================
+*/
+void idRenderWorldLocal::WaitForAreaStreams()
+{
+	if( streamThread.IsRunning() )
+	{
+		streamThread.WaitForThread();
+	}
+}
+
+/*
+========================
+R_BindStreamedAreaBuffers
+
+The first load of an area allocates its static buffers, later loads
+rebind them because the same chunk gives the same geometry
+========================
+*/
+static void R_BindStreamedAreaBuffers( areaStream_t& areaStream, srfTriangles_t* tri, const srfTriangles_t* baseTri, int& cacheNum, nvrhi::ICommandList* commandList )
+{
+	if( cacheNum + 2 <= areaStream.staticCache.Num() )
+	{
+		tri->indexCache = areaStream.staticCache[cacheNum++];
+		tri->ambientCache = areaStream.staticCache[cacheNum++];
+		return;
+	}
+
+	if( baseTri != NULL )
+	{
+		R_CreateStaticBuffersForLodTri( *tri, *baseTri, commandList );
+	}
+	else
+	{
+		R_CreateStaticBuffersForTri( *tri, commandList );
+	}
+
+	areaStream.staticCache.Append( tri->indexCache );
+	areaStream.staticCache.Append( tri->ambientCache );
+	cacheNum += 2;
+}
+
+/*
+========================
+idRenderWorldLocal::LoadAreaChunk
+========================
+*/
+void idRenderWorldLocal::LoadAreaChunk( int areaNum, nvrhi::ICommandList* commandList )
+{
+	areaStream_t& areaStream = areaStreams[areaNum];
+	assert( areaStream.state == areaStream_t::AREA_READ );
+
+	idRenderModel* model = areaStream.model;
+
+	bool loaded = false;
+	if( areaStream.data != NULL )
+	{
+		idFile_Memory file( model->Name(), ( const char* )areaStream.data, areaStream.fileSize );
+		loaded = model->LoadBinaryModel( &file, mapTimeStamp, 0 );
+
+		Mem_Free( areaStream.data );
+		areaStream.data = NULL;
+	}
+
+	// the area stays resident without surfaces, so a broken chunk isn't requested every frame
+	areaStream.state = areaStream_t::AREA_RESIDENT;
+	if( !loaded )
+	{
+		common->Warning( "idRenderWorldLocal::LoadAreaChunk: couldn't load %s from the streamed .bproc", model->Name() );
+		static_cast< idRenderModelStatic* >( model )->EvictSurfaces();
+		return;
+	}
+
+	// same order as idRenderModelManagerLocal::EndLevelLoad, the cache handles are rebound in it
+	int cacheNum = 0;
+	for( int j = 0; j < model->NumSurfaces(); j++ )
+	{
+		srfTriangles_t* tri = model->Surface( j )->geometry;
+		R_BindStreamedAreaBuffers( areaStream, tri, NULL, cacheNum, commandList );
+
+		const srfTriangles_t* finerTri = tri;
+		for( int lod = 1; lod <= model->NumLods(); lod++ )
+		{
+			srfTriangles_t* lodTri = model->LodSurface( lod, j );
+			if( lodTri != finerTri )
+			{
+				R_BindStreamedAreaBuffers( areaStream, lodTri, tri, cacheNum, commandList );
+			}
+			finerTri = lodTri;
+		}
+	}
+
+	areaStream.memory = model->Memory();
+	streamMemory += areaStream.memory;
+
+	RegenerateAreaInteractions( areaNum, commandList );
+
+	if( r_showWorldStreaming.GetBool() )
+	{
+		common->Printf( "streamed in area %i, %i kB\n", areaNum, areaStream.memory >> 10 );
+	}
+}
+
+/*
+========================
+idRenderWorldLocal::RegenerateAreaInteractions
+
+GenerateAllInteractions found no surfaces in an area that wasn't loaded, and
+an empty static interaction keeps the light from being considered at all.
+Interactions with surfaces stay valid while the area is evicted, because
+its geometry comes back unchanged.
+========================
+*/
+void idRenderWorldLocal::RegenerateAreaInteractions( int areaNum, nvrhi::ICommandList* commandList )
+{
+	if( !generateAllInteractionsCalled )
+	{
+		return;
+	}
+
+	portalArea_t* area = &portalAreas[areaNum];
+	idRenderEntityLocal* def = NULL;
+	for( areaReference_t* ref = area->entityRefs.areaNext; ref != &area->entityRefs; ref = ref->areaNext )
+	{
+		if( ref->entity->parms.hModel == areaStreams[areaNum].model )
+		{
+			def = ref->entity;
+			break;
+		}
+	}
+
+	if( def == NULL )
+	{
+		return;
+	}
+
+	idList<idRenderLightLocal*, TAG_RENDER> lights;
+	idInteraction* next;
+	for( idInteraction* inter = def->firstInteraction; inter != NULL; inter = next )
+	{
+		next = inter->entityNext;
+		if( inter->staticInteraction && inter->IsEmpty() )
+		{
+			lights.Append( inter->lightDef );
+			inter->UnlinkAndFree();
+		}
+	}
+
+	// there is no view to optimize for
+	viewDef_t* viewDef = tr.viewDef;
+	tr.viewDef = NULL;
+
+	for( int i = 0; i < lights.Num(); i++ )
+	{
+		idInteraction* inter = idInteraction::AllocAndLink( def, lights[i] );
+		inter->CreateStaticInteraction( commandList );
+	}
+
+	tr.viewDef = viewDef;
+}
+
+/*
+========================
+idRenderWorldLocal::EvictArea
+========================
+*/
+void idRenderWorldLocal::EvictArea( int areaNum )
+{
+	areaStream_t& areaStream = areaStreams[areaNum];
+	if( areaStream.state != areaStream_t::AREA_RESIDENT )
+	{
+		return;
+	}
+
+	static_cast< idRenderModelStatic* >( areaStream.model )->EvictSurfaces();
+
+	streamMemory -= areaStream.memory;
+	areaStream.memory = 0;
+	areaStream.state = areaStream_t::AREA_UNLOADED;
+
+	if( r_showWorldStreaming.GetBool() )
+	{
+		common->Printf( "evicted area %i\n", areaNum );
+	}
+}
+
+/*
+========================
+idRenderWorldLocal::UpdateAreaStreaming
+
+Called before each scene is rendered. Areas are needed if they are within
+r_streamWorldDistance portals of the view area, closed portals are followed
+because doors can open faster than a chunk is read.
+========================
+*/
+void idRenderWorldLocal::UpdateAreaStreaming( const idVec3& origin )
+{
+	if( streamFile == NULL )
+	{
+		return;
+	}
+
+	SCOPED_PROFILE_EVENT( "UpdateAreaStreaming" );
+
+	WaitForAreaStreams();
+
+	// the uploads are only recorded here, the back end executes them
+	nvrhi::CommandListHandle commandList;
+
+	// load what the stream thread has read since the last scene
+	for( int i = 0; i < areaStreams.Num(); i++ )
+	{
+		if( areaStreams[i].state == areaStream_t::AREA_READ )
+		{
+			if( !commandList )
+			{
+				commandList = deviceManager->GetDevice()->createCommandList();
+				commandList->open();
+			}
+			LoadAreaChunk( i, commandList );
+		}
+	}
+
+	int viewArea = PointInArea( origin );
+	if( viewArea >= 0 && viewArea < areaStreams.Num() )
+	{
+		// flood the portals breadth first
+		idTempArray<int> distance( numPortalAreas );
+		idTempArray<int> queue( numPortalAreas );
+		for( int i = 0; i < numPortalAreas; i++ )
+		{
+			distance[i] = -1;
+		}
+
+		int queueHead = 0;
+		int queueTail = 0;
+		distance[viewArea] = 0;
+		queue[queueTail++] = viewArea;
+
+		const int maxDistance = r_streamWorldDistance.GetInteger();
+		while( queueHead < queueTail )
+		{
+			const int areaNum = queue[queueHead++];
+			if( distance[areaNum] >= maxDistance )
+			{
+				continue;
+			}
+
+			for( portal_t* p = portalAreas[areaNum].portals; p != NULL; p = p->next )
+			{
+				if( distance[p->intoArea] == -1 )
+				{
+					distance[p->intoArea] = distance[areaNum] + 1;
+					queue[queueTail++] = p->intoArea;
+				}
+			}
+		}
+
+		// after a map load or a teleport everything the view can reach
+		// is loaded right away instead of popping in over the next frames
+		const bool immediate = ( areaStreams[viewArea].state != areaStream_t::AREA_RESIDENT );
+
+		bool requested = false;
+		for( int i = 0; i < queueTail; i++ )
+		{
+			const int areaNum = queue[i];
+			if( areaNum >= areaStreams.Num() || areaStreams[areaNum].model == NULL )
+			{
+				continue;
+			}
+
+			areaStream_t& areaStream = areaStreams[areaNum];
+			areaStream.lastNeededFrame = tr.frameCount;
+
+			if( areaStream.state != areaStream_t::AREA_UNLOADED )
+			{
+				continue;
+			}
+
+			areaStream.state = areaStream_t::AREA_REQUESTED;
+			requested = true;
+		}
+
+		if( immediate && requested )
+		{
+			ReadAreaChunks();
+
+			for( int i = 0; i < areaStreams.Num(); i++ )
+			{
+				if( areaStreams[i].state == areaStream_t::AREA_READ )
+				{
+					if( !commandList )
+					{
+						commandList = deviceManager->GetDevice()->createCommandList();
+						commandList->open();
+					}
+					LoadAreaChunk( i, commandList );
+				}
+			}
+			requested = false;
+		}
+
+		// evict the areas that haven't been needed for the longest time,
+		// the back end may still be drawing the previous frame
+		const int backEndFrame = tr.frameCount - 1;
+		const int memoryBudget = r_streamWorldMemory.GetInteger() * 1024 * 1024;
+		while( streamMemory > memoryBudget )
+		{
+			int oldest = -1;
+			for( int i = 0; i < areaStreams.Num(); i++ )
+			{
+				const areaStream_t& areaStream = areaStreams[i];
+				if( areaStream.state != areaStream_t::AREA_RESIDENT || areaStream.lastNeededFrame >= backEndFrame )
+				{
+					continue;
+				}
+				if( oldest == -1 || areaStream.lastNeededFrame < areaStreams[oldest].lastNeededFrame )
+				{
+					oldest = i;
+				}
+			}
+
+			if( oldest == -1 )
+			{
+				break;
+			}
+			EvictArea( oldest );
+		}
+
+		if( requested )
+		{
+			streamThread.SignalWork();
+		}
+	}
+
+	if( commandList )
+	{
+		commandList->close();
+		R_AddStaticUploadsCmd( commandList );
+	}
+}
+
+/*
+========================
+idRenderWorldLocal::FreeAreaStreams
+========================
+*/
+void idRenderWorldLocal::FreeAreaStreams()
+{
+	WaitForAreaStreams();
+
+	for( int i = 0; i < areaStreams.Num(); i++ )
+	{
+		Mem_Free( areaStreams[i].data );
+	}
+	areaStreams.Clear();
+	streamMemory = 0;
+
+	if( streamFile != NULL )
+	{
+		fileSystem->CloseFile( streamFile );
+		streamFile = NULL;
+	}
+}
+
+CONSOLE_COMMAND( listAreaStreams, "lists the streamed world areas of the current map", NULL )
+{
+	idRenderWorldLocal* world = tr.primaryWorld;
+	if( world == NULL || world->areaStreams.Num() == 0 )
+	{
+		common->Printf( "the current map doesn't stream its areas\n" );
+		return;
+	}
+
+	static const char* stateNames[] = { "unloaded", "requested", "read", "resident" };
+
+	int numResident = 0;
+	for( int i = 0; i < world->areaStreams.Num(); i++ )
+	{
+		const areaStream_t& areaStream = world->areaStreams[i];
+		if( areaStream.model == NULL )
+		{
+			continue;
+		}
+
+		common->Printf( "%4i: %-9s %6i kB chunk %6i kB resident, last needed in frame %i\n", i, stateNames[areaStream.state],
+						areaStream.fileSize >> 10, areaStream.memory >> 10, areaStream.lastNeededFrame );
+		if( areaStream.state == areaStream_t::AREA_RESIDENT )
+		{
+			numResident++;
+		}
+	}
+	common->Printf( "%i of %i areas resident, %i kB\n", numResident, world->areaStreams.Num(), world->streamMemory >> 10 );
+}
@@ -339,6 +339,17 @@ vertCacheHandle_t idVertexCache::AllocJoint( const void* data, int num, size_t s
 	return ActuallyAlloc( frameData[ listNum ], data, num * size, CACHE_JOINT, commandList );
 }
 
+/*
+==============
+idVertexCache::JointMemoryAvailable
+==============
+*/
+int idVertexCache::JointMemoryAvailable() const
+{
+	const geoBufferSet_t& vcs = frameData[ listNum ];
+	return vcs.jointBuffer.GetAllocedSize() - vcs.jointMemUsed.GetValue();
+}
+
 /*
 ==============
 idVertexCache::AllocStaticVertex
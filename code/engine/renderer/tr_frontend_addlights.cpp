@@ -47,6 +47,7 @@ extern idCVar r_useShadowPreciseInsideTest;
 
 idCVar r_useAreasConnectedForShadowCulling( "r_useAreasConnectedForShadowCulling", "2", CVAR_RENDERER | CVAR_INTEGER, "cull entities cut off by doors" );
 idCVar r_useParallelAddLights( "r_useParallelAddLights", "1", CVAR_RENDERER | CVAR_BOOL | CVAR_NOCHEAT, "aadd all lights in parallel with jobs" );
+idCVar r_useBatchedCulling( "r_useBatchedCulling", "1", CVAR_RENDERER | CVAR_BOOL, "cull light bounds, entity bounds and shadow bounds in SIMD batches before the precise per entity tests" );
 
 /*
 ============================
@@ -91,6 +92,207 @@ bool idRenderEntityLocal::IsDirectlyVisible() const
 	return true;
 }
 
+/*
+===================
+lightCullState_t
+
+Entities collected by R_AddSingleLight that are waiting for their global bounds to be
+culled to the light volume, or for their shadow bounds to be culled to the view.
+Each batch is culled with a single idRenderMatrix::CullBoundsSoAToMVP call when it
+fills up or when all areas of the light have been walked.
+===================
+*/
+static const int LIGHT_CULL_BATCH_SIZE = 256;
+
+struct lightCullState_t
+{
+	viewLight_t* 			vLight;
+	bool					lightCastsShadows;
+	bool					batched;
+
+	int						numLightCull;
+	int						lightCull[LIGHT_CULL_BATCH_SIZE];	// entityDef indices
+
+	int						numShadowCull;
+	idRenderEntityLocal* 	shadowCullEntities[LIGHT_CULL_BATCH_SIZE];
+	float					shadowCullBounds[6][LIGHT_CULL_BATCH_SIZE];	// min x, y, z and max x, y, z
+
+	int						boxCullIn;
+	int						boxCullOut;
+};
+
+/*
+===================
+R_AddShadowOnlyEntity
+===================
+*/
+static void R_AddShadowOnlyEntity( viewLight_t* vLight, idRenderEntityLocal* edef )
+{
+	// debug tool to allow viewing of only one entity at a time
+	if( r_singleEntity.GetInteger() >= 0 && r_singleEntity.GetInteger() != edef->index )
+	{
+		return;
+	}
+
+	// we do need it for shadows
+	vLight->entityInteractionState[ edef->index ] = viewLight_t::INTERACTION_YES;
+
+	// we will need to create a viewEntity_t for it in the serial code section
+	shadowOnlyEntity_t* shadEnt = ( shadowOnlyEntity_t* )R_FrameAlloc( sizeof( shadowOnlyEntity_t ), FRAME_ALLOC_SHADOW_ONLY_ENTITY );
+	shadEnt->next = vLight->shadowOnlyViewEntities;
+	shadEnt->edef = edef;
+	vLight->shadowOnlyViewEntities = shadEnt;
+}
+
+/*
+===================
+R_FlushShadowCull
+===================
+*/
+static void R_FlushShadowCull( lightCullState_t& state )
+{
+	if( state.numShadowCull == 0 )
+	{
+		return;
+	}
+
+	boundsSoA_t bounds;
+	for( int i = 0; i < 3; i++ )
+	{
+		bounds.min[i] = state.shadowCullBounds[0 + i];
+		bounds.max[i] = state.shadowCullBounds[3 + i];
+	}
+
+	// this doesn't say that the shadows can't effect anything, only that they can't
+	// effect anything in the view, so we shouldn't set up view entities
+	int visible[LIGHT_CULL_BATCH_SIZE];
+	const int numVisible = idRenderMatrix::CullBoundsSoAToMVP( tr.viewDef->worldSpace.mvp, bounds, NULL, state.numShadowCull, visible );
+
+	state.boxCullIn += numVisible;
+	state.boxCullOut += state.numShadowCull - numVisible;
+
+	for( int i = 0; i < numVisible; i++ )
+	{
+		R_AddShadowOnlyEntity( state.vLight, state.shadowCullEntities[ visible[i] ] );
+	}
+
+	state.numShadowCull = 0;
+}
+
+/*
+===================
+R_AddLightEntity
+
+The entity and light are known to overlap.
+===================
+*/
+static void R_AddLightEntity( lightCullState_t& state, idRenderEntityLocal* edef )
+{
+	viewLight_t* vLight = state.vLight;
+	const idRenderLightLocal* light = vLight->lightDef;
+
+	if( edef->IsDirectlyVisible() )
+	{
+		// entity is directly visible, so the interaction is definitely needed
+		vLight->entityInteractionState[ edef->index ] = viewLight_t::INTERACTION_YES;
+		return;
+	}
+
+	// the entity is not directly visible, but if we can tell that it may cast
+	// shadows onto visible surfaces, we must make a viewEntity for it
+	if( !state.lightCastsShadows )
+	{
+		// surfaces are never shadowed in this light
+		return;
+	}
+
+	const renderEntity_t& eParms = edef->parms;
+
+	// if we are suppressing its shadow in this view (player shadows, etc), skip
+	if( !r_skipSuppress.GetBool() )
+	{
+		if( eParms.suppressShadowInViewID && eParms.suppressShadowInViewID == tr.viewDef->renderView.viewID )
+		{
+			return;
+		}
+		if( eParms.suppressShadowInLightID && eParms.suppressShadowInLightID == light->parms.lightId )
+		{
+			return;
+		}
+	}
+
+	// should we use the shadow bounds from pre-calculated interactions?
+	idBounds shadowBounds;
+	R_ShadowBounds( edef->globalReferenceBounds, light->globalLightBounds, light->globalLightOrigin, shadowBounds );
+
+	// this test is pointless if we knew the light was completely contained
+	// in the view frustum, but the entity would also be directly visible in most
+	// of those cases.
+	if( state.batched )
+	{
+		const int n = state.numShadowCull++;
+		state.shadowCullEntities[n] = edef;
+		for( int i = 0; i < 3; i++ )
+		{
+			state.shadowCullBounds[0 + i][n] = shadowBounds[0][i];
+			state.shadowCullBounds[3 + i][n] = shadowBounds[1][i];
+		}
+		if( state.numShadowCull == LIGHT_CULL_BATCH_SIZE )
+		{
+			R_FlushShadowCull( state );
+		}
+		return;
+	}
+
+	// this doesn't say that the shadow can't effect anything, only that it can't
+	// effect anything in the view, so we shouldn't set up a view entity
+	if( idRenderMatrix::CullBoundsToMVP( tr.viewDef->worldSpace.mvp, shadowBounds ) )
+	{
+		return;
+	}
+
+	R_AddShadowOnlyEntity( vLight, edef );
+}
+
+/*
+===================
+R_FlushLightCull
+
+Culls the global bounds of the collected entities to the light volume and only does
+the precise oriented bounds test for the ones that are left.
+===================
+*/
+static void R_FlushLightCull( lightCullState_t& state )
+{
+	if( state.numLightCull == 0 )
+	{
+		return;
+	}
+
+	const idRenderLightLocal* light = state.vLight->lightDef;
+	const idRenderWorldLocal* world = light->world;
+
+	int visible[LIGHT_CULL_BATCH_SIZE];
+	const int numVisible = idRenderMatrix::CullBoundsSoAToMVP( light->baseLightProject, world->entityBounds.GetBounds(), state.lightCull, state.numLightCull, visible, true );
+
+	state.boxCullIn += numVisible;
+	state.boxCullOut += state.numLightCull - numVisible;
+	state.numLightCull = 0;
+
+	for( int i = 0; i < numVisible; i++ )
+	{
+		idRenderEntityLocal* edef = world->entityDefs[ visible[i] ];
+
+		// the global bounds are axial, so check the oriented model bounds as well
+		if( R_CullModelBoundsToLight( light, edef->localReferenceBounds, edef->modelRenderMatrix ) )
+		{
+			continue;
+		}
+
+		R_AddLightEntity( state, edef );
+	}
+}
+
 /*
 ===================
 R_AddSingleLight
@@ -467,13 +669,18 @@ static void R_AddSingleLight( viewLight_t* vLight )
 	// that may cast shadows, even if they aren't directly visible.  Any real work
 	// will be deferred until we walk through the viewEntities
 	//--------------------------------------------
-	const int renderViewID = viewDef->renderView.viewID;
+	lightCullState_t state;
+	state.vLight = vLight;
+	state.lightCastsShadows = lightCastsShadows;
+	state.batched = r_useBatchedCulling.GetBool();
+	state.numLightCull = 0;
+	state.numShadowCull = 0;
+	state.boxCullIn = 0;
+	state.boxCullOut = 0;
 
 	// this bool array will be set true whenever the entity will visibly interact with the light
 	vLight->entityInteractionState = ( byte* )R_ClearedFrameAlloc( light->world->entityDefs.Num() * sizeof( vLight->entityInteractionState[0] ), FRAME_ALLOC_INTERACTION_STATE );
 
-	idInteraction** const interactionTableRow = light->world->interactionTable + light->index * light->world->interactionTableWidth;
-
 	for( areaReference_t* lref = light->references; lref != NULL; lref = lref->ownerNext )
 	{
 		portalArea_t* area = lref->area;
@@ -503,8 +710,8 @@ static void R_AddSingleLight( viewLight_t* vLight )
 
 			// The table is updated at interaction::AllocAndLink() and interaction::UnlinkAndFree()
 
-			// TODO(Stephen): interactionTableRow is null if renderDef is used in a gui.sub
-			const idInteraction* inter = interactionTableRow[ edef->index ];
+			// the table is empty if renderDef is used in a gui.sub
+			const idInteraction* inter = light->world->interactionTable.Find( light->index, edef->index );
 
 			const renderEntity_t& eParms = edef->parms;
 			const idRenderModel* eModel = eParms.hModel;
@@ -554,6 +761,17 @@ static void R_AddSingleLight( viewLight_t* vLight )
 					continue;
 				}
 
+				// collect the entities to check their bounds against the light frustum in batches
+				if( state.batched )
+				{
+					state.lightCull[state.numLightCull++] = edef->index;
+					if( state.numLightCull == LIGHT_CULL_BATCH_SIZE )
+					{
+						R_FlushLightCull( state );
+					}
+					continue;
+				}
+
 				// do a check of the entity reference bounds against the light frustum to see if they can't
 				// possibly interact, despite sharing one or more world areas
 				if( R_CullModelBoundsToLight( light, edef->localReferenceBounds, edef->modelRenderMatrix ) )
@@ -563,68 +781,62 @@ static void R_AddSingleLight( viewLight_t* vLight )
 			}
 
 			// we now know that the entity and light do overlap
+			R_AddLightEntity( state, edef );
+		}
+	}
 
-			if( edef->IsDirectlyVisible() )
-			{
-				// entity is directly visible, so the interaction is definitely needed
-				vLight->entityInteractionState[ edef->index ] = viewLight_t::INTERACTION_YES;
-				continue;
-			}
+	R_FlushLightCull( state );
+	R_FlushShadowCull( state );
 
-			// the entity is not directly visible, but if we can tell that it may cast
-			// shadows onto visible surfaces, we must make a viewEntity for it
-			if( !lightCastsShadows )
-			{
-				// surfaces are never shadowed in this light
-				continue;
-			}
-			// if we are suppressing its shadow in this view (player shadows, etc), skip
-			if( !r_skipSuppress.GetBool() )
-			{
-				if( eParms.suppressShadowInViewID && eParms.suppressShadowInViewID == renderViewID )
-				{
-					continue;
-				}
-				if( eParms.suppressShadowInLightID && eParms.suppressShadowInLightID == light->parms.lightId )
-				{
-					continue;
-				}
-			}
+	vLight->boxCullIn = state.boxCullIn;
+	vLight->boxCullOut = state.boxCullOut;
+}
 
-			// should we use the shadow bounds from pre-calculated interactions?
-			idBounds shadowBounds;
-			R_ShadowBounds( edef->globalReferenceBounds, light->globalLightBounds, light->globalLightOrigin, shadowBounds );
+REGISTER_PARALLEL_JOB( R_AddSingleLight, "R_AddSingleLight" );
 
-			// this test is pointless if we knew the light was completely contained
-			// in the view frustum, but the entity would also be directly visible in most
-			// of those cases.
+/*
+=================
+R_CullViewLightBounds
 
-			// this doesn't say that the shadow can't effect anything, only that it can't
-			// effect anything in the view, so we shouldn't set up a view entity
-			if( idRenderMatrix::CullBoundsToMVP( viewDef->worldSpace.mvp, shadowBounds ) )
-			{
-				continue;
-			}
+Culls the global bounds of all view lights to the view frustum in one batch before any
+light jobs are added. The lights that are culled are flagged for removal from the list.
+=================
+*/
+static void R_CullViewLightBounds()
+{
+	const idRenderWorldLocal* world = tr.viewDef->renderWorld;
 
-			// debug tool to allow viewing of only one entity at a time
-			if( r_singleEntity.GetInteger() >= 0 && r_singleEntity.GetInteger() != edef->index )
-			{
-				continue;
-			}
+	int numLights = 0;
+	for( viewLight_t* vLight = tr.viewDef->viewLights; vLight != NULL; vLight = vLight->next )
+	{
+		numLights++;
+	}
+	if( numLights == 0 )
+	{
+		return;
+	}
 
-			// we do need it for shadows
-			vLight->entityInteractionState[ edef->index ] = viewLight_t::INTERACTION_YES;
+	int* lightIndices = ( int* )R_FrameAlloc( numLights * 2 * sizeof( int ), FRAME_ALLOC_CULL_LIST );
+	int* visibleIndices = lightIndices + numLights;
 
-			// we will need to create a viewEntity_t for it in the serial code section
-			shadowOnlyEntity_t* shadEnt = ( shadowOnlyEntity_t* )R_FrameAlloc( sizeof( shadowOnlyEntity_t ), FRAME_ALLOC_SHADOW_ONLY_ENTITY );
-			shadEnt->next = vLight->shadowOnlyViewEntities;
-			shadEnt->edef = edef;
-			vLight->shadowOnlyViewEntities = shadEnt;
-		}
+	numLights = 0;
+	for( viewLight_t* vLight = tr.viewDef->viewLights; vLight != NULL; vLight = vLight->next )
+	{
+		// until proven otherwise
+		vLight->removeFromList = true;
+		lightIndices[numLights++] = vLight->lightDef->index;
 	}
-}
 
-REGISTER_PARALLEL_JOB( R_AddSingleLight, "R_AddSingleLight" );
+	const int numVisible = idRenderMatrix::CullBoundsSoAToMVP( tr.viewDef->worldSpace.mvp, world->lightBounds.GetBounds(), lightIndices, numLights, visibleIndices );
+
+	for( int i = 0; i < numVisible; i++ )
+	{
+		world->lightDefs[ visibleIndices[i] ]->viewLight->removeFromList = false;
+	}
+
+	tr.pc.c_box_cull_in += numVisible;
+	tr.pc.c_box_cull_out += numLights - numVisible;
+}
 
 /*
 =================
@@ -635,6 +847,11 @@ void R_AddLights()
 {
 	SCOPED_PROFILE_EVENT( "R_AddLights" );
 
+	if( r_useBatchedCulling.GetBool() )
+	{
+		R_CullViewLightBounds();
+	}
+
 	//-------------------------------------------------
 	// check each light individually, possibly in parallel
 	//-------------------------------------------------
@@ -643,6 +860,10 @@ void R_AddLights()
 	{
 		for( viewLight_t* vLight = tr.viewDef->viewLights; vLight != NULL; vLight = vLight->next )
 		{
+			if( vLight->removeFromList )
+			{
+				continue;
+			}
 			tr.frontEndJobList->AddJob( ( jobRun_t )R_AddSingleLight, vLight );
 		}
 		tr.frontEndJobList->Submit();
@@ -652,6 +873,10 @@ void R_AddLights()
 	{
 		for( viewLight_t* vLight = tr.viewDef->viewLights; vLight != NULL; vLight = vLight->next )
 		{
+			if( vLight->removeFromList )
+			{
+				continue;
+			}
 			R_AddSingleLight( vLight );
 		}
 	}
@@ -666,6 +891,9 @@ void R_AddLights()
 	{
 		viewLight_t* vLight = *ptr;
 
+		tr.pc.c_box_cull_in += vLight->boxCullIn;
+		tr.pc.c_box_cull_out += vLight->boxCullOut;
+
 		if( vLight->removeFromList )
 		{
 			vLight->lightDef->viewCount = -1;	// this probably doesn't matter with current code
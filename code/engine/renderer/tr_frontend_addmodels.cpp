@@ -52,6 +52,10 @@ idCVar r_forceShadowMapsOnAlphaTestedSurfaces( "r_forceShadowMapsOnAlphaTestedSu
 // foresthale 2014-11-24: cvar to control the material lod flags - this is the distance at which a mesh switches from lod1 to lod2, where lod3 will appear at this distance *2, lod4 at *4, and persistentLOD keyword will disable the max distance check (thus extending this LOD to all further distances, rather than disappearing)
 idCVar r_lodMaterialDistance( "r_lodMaterialDistance", "500", CVAR_RENDERER | CVAR_FLOAT, "surfaces further than this distance will use lower quality versions (if their material uses the lod1-4 keywords, persistentLOD disables the max distance checks)" );
 
+idCVar r_modelLod( "r_modelLod", "1", CVAR_RENDERER | CVAR_BOOL, "draw static models with their generated detail levels" );
+idCVar r_modelLodPixelError( "r_modelLodPixelError", "1.0", CVAR_RENDERER | CVAR_FLOAT, "maximum geometric error in pixels a generated detail level may show on screen" );
+idCVar r_modelLodHysteresis( "r_modelLodHysteresis", "0.2", CVAR_RENDERER | CVAR_FLOAT, "fraction the pixel error must drop below the limit before switching to a coarser detail level", 0.0f, 0.9f );
+
 static const float CHECK_BOUNDS_EPSILON = 1.0f;
 
 
@@ -297,6 +301,53 @@ void R_SetupDrawSurfJoints( drawSurf_t* drawSurf, const srfTriangles_t* tri, con
 	drawSurf->jointCache = model->jointsInvertedBuffer;
 }
 
+/*
+===================
+R_ModelLodForView
+
+Picks the coarsest generated detail level whose error projects to less than
+r_modelLodPixelError pixels. Switching to a coarser level than the one drawn in
+the previous frame needs some extra margin, so models resting near a threshold
+don't flip between levels.
+===================
+*/
+static int R_ModelLodForView( const idRenderModel* model, const idBounds& localBounds, const idVec3& localViewOrigin, const int previousLod )
+{
+	const float* bounds = localBounds.ToFloatPtr();
+	idVec3 nearestPointOnBounds = localViewOrigin;
+	nearestPointOnBounds.x = Max( nearestPointOnBounds.x, bounds[0] );
+	nearestPointOnBounds.x = Min( nearestPointOnBounds.x, bounds[3] );
+	nearestPointOnBounds.y = Max( nearestPointOnBounds.y, bounds[1] );
+	nearestPointOnBounds.y = Min( nearestPointOnBounds.y, bounds[4] );
+	nearestPointOnBounds.z = Max( nearestPointOnBounds.z, bounds[2] );
+	nearestPointOnBounds.z = Min( nearestPointOnBounds.z, bounds[5] );
+	const float distance = ( nearestPointOnBounds - localViewOrigin ).LengthFast();
+	if( distance < 1.0f )
+	{
+		return 0;
+	}
+
+	// screen pixels covered by one unit of object space error at this distance
+	const viewDef_t* viewDef = tr.viewDef;
+	const float viewHeight = viewDef->viewport.y2 - viewDef->viewport.y1 + 1;
+	const float pixelsPerUnit = viewDef->projectionMatrix[1 * 4 + 1] * 0.5f * viewHeight / distance;
+
+	const float maxPixels = r_modelLodPixelError.GetFloat();
+	for( int lod = model->NumLods(); lod > 0; lod-- )
+	{
+		float limit = maxPixels;
+		if( lod > previousLod )
+		{
+			limit *= 1.0f - r_modelLodHysteresis.GetFloat();
+		}
+		if( model->LodError( lod ) * pixelsPerUnit <= limit )
+		{
+			return lod;
+		}
+	}
+	return 0;
+}
+
 /*
 ===================
 R_AddSingleModel
@@ -371,7 +422,7 @@ void R_AddSingleModel( viewEntity_t* vEntity )
 				if( vLight->entityInteractionState[entityIndex] == viewLight_t::INTERACTION_YES )
 				{
 					contactedLights[numContactedLights] = vLight;
-					staticInteractions[numContactedLights] = world->interactionTable[vLight->lightDef->index * world->interactionTableWidth + entityIndex];
+					staticInteractions[numContactedLights] = world->interactionTable.Find( vLight->lightDef->index, entityIndex );
 					if( ++numContactedLights == MAX_CONTACTED_LIGHTS )
 					{
 						break;
@@ -427,7 +478,7 @@ void R_AddSingleModel( viewEntity_t* vEntity )
 				}
 			}
 			contactedLights[numContactedLights] = vLight;
-			staticInteractions[numContactedLights] = world->interactionTable[vLight->lightDef->index * world->interactionTableWidth + entityIndex];
+			staticInteractions[numContactedLights] = world->interactionTable.Find( vLight->lightDef->index, entityIndex );
 			if( ++numContactedLights == MAX_CONTACTED_LIGHTS )
 			{
 				break;
@@ -520,6 +571,21 @@ void R_AddSingleModel( viewEntity_t* vEntity )
 	idVec3 localViewOrigin;
 	R_GlobalPointToLocal( vEntity->modelMatrix, viewDef->renderView.vieworg[STEREOPOS_CULLING], localViewOrigin );
 
+	//---------------------------
+	// pick a generated detail level for static models
+	//---------------------------
+	int lodLevel = 0;
+	if( r_modelLod.GetBool() && model->NumLods() > 0 && !renderEntity->weaponDepthHack && renderEntity->modelDepthHack == 0.0f )
+	{
+		lodLevel = R_ModelLodForView( model, entityDef->localReferenceBounds, localViewOrigin, entityDef->lodLevel );
+
+		// subviews don't move the hysteresis of the main view
+		if( !viewDef->isSubview )
+		{
+			entityDef->lodLevel = lodLevel;
+		}
+	}
+
 	//---------------------------
 	// add all the model surfaces
 	//---------------------------
@@ -538,6 +604,11 @@ void R_AddSingleModel( viewEntity_t* vEntity )
 		{
 			continue;
 		}
+		if( lodLevel > 0 )
+		{
+			tri = model->LodSurface( lodLevel, surfaceNum );
+		}
+		const bool drawingLod = ( tri != surf->geometry );
 		if( tri->numIndexes == 0 )
 		{
 			continue;		// happens for particles
@@ -915,8 +986,10 @@ void R_AddSingleModel( viewEntity_t* vEntity )
 			const idInteraction* interaction = staticInteractions[contactedLight];
 
 			// check for a static interaction
+			// the light triangles of static interactions index the full detail surface, so
+			// they would not match the depth of a simplified level
 			surfaceInteraction_t* surfInter = NULL;
-			if( interaction > INTERACTION_EMPTY && interaction->staticInteraction )
+			if( interaction > INTERACTION_EMPTY && interaction->staticInteraction && !drawingLod )
 			{
 				// we have a static interaction that was calculated accurately
 				assert( model->NumSurfaces() == interaction->numSurfaces );
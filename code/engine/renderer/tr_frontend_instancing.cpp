@@ -0,0 +1,377 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "precompiled.h"
+#pragma hdrstop
+
+#include "RenderCommon.h"
+
+/*
+==========================================================================================
+
+AUTO INSTANCING
+
+Repeated static models (crates, pillars, props placed all over a map) each produce their
+own drawSurf_t, even though they reference the very same static vertex and index cache
+entries. The depth prepass only needs the MVP of each surface, so surfaces sharing a
+piece of static geometry are collapsed into a single instanced draw. The instance
+transforms are written to the per-frame joint buffer and read by the instanced depth
+vertex program through the same structured buffer binding GPU skinning uses.
+
+==========================================================================================
+*/
+
+idCVar r_useInstancing( "r_useInstancing", "1", CVAR_RENDERER | CVAR_BOOL, "draw repeated static surfaces in the depth prepass with a single instanced draw" );
+idCVar r_instancingMinCount( "r_instancingMinCount", "2", CVAR_RENDERER | CVAR_INTEGER, "minimum number of surfaces sharing the same geometry to build an instanced draw", 2, MAX_DEPTH_INSTANCES );
+
+class idSort_InstancedSurfs : public idSort_Quick< instancedSurf_t, idSort_InstancedSurfs >
+{
+public:
+	int Compare( const instancedSurf_t& a, const instancedSurf_t& b ) const
+	{
+		if( a.ambientCache != b.ambientCache )
+		{
+			return ( a.ambientCache < b.ambientCache ) ? -1 : 1;
+		}
+		if( a.indexCache != b.indexCache )
+		{
+			return ( a.indexCache < b.indexCache ) ? -1 : 1;
+		}
+		if( a.numIndexes != b.numIndexes )
+		{
+			return a.numIndexes - b.numIndexes;
+		}
+		return a.surfNum - b.surfNum;
+	}
+};
+
+/*
+===================
+R_SurfIsInstanceable
+
+Only opaque surfaces on static geometry can be folded, everything else either
+needs per surface state in the depth pass or has per frame vertex data.
+===================
+*/
+bool R_SurfIsInstanceable( const drawSurf_t* drawSurf )
+{
+	const idMaterial* shader = drawSurf->material;
+	if( shader == NULL || shader->Coverage() != MC_OPAQUE || shader->GetSort() == SS_SUBVIEW )
+	{
+		return false;
+	}
+	if( drawSurf->space == NULL || drawSurf->jointCache != 0 || drawSurf->numIndexes <= 0 )
+	{
+		return false;
+	}
+	return idVertexCache::CacheIsStatic( drawSurf->ambientCache ) && idVertexCache::CacheIsStatic( drawSurf->indexCache );
+}
+
+/*
+===================
+R_GroupInstancedSurfs
+
+Sorts the candidates by geometry and returns the number of batches written.
+Each batch holds at least minInstances and at most MAX_DEPTH_INSTANCES surfaces,
+its first entry is the surface with the lowest draw surf index, which is the one
+that will issue the draw. batches must have room for numSurfs / minInstances entries.
+
+This does not touch the GPU so it can be exercised with fabricated cache handles.
+===================
+*/
+int R_GroupInstancedSurfs( instancedSurf_t* surfs, int numSurfs, int minInstances, instanceBatch_t* batches )
+{
+	if( numSurfs < minInstances )
+	{
+		return 0;
+	}
+
+	idSort_InstancedSurfs().Sort( surfs, numSurfs );
+
+	int numBatches = 0;
+	for( int start = 0; start < numSurfs; )
+	{
+		const instancedSurf_t& base = surfs[start];
+
+		int end = start + 1;
+		while( end < numSurfs && surfs[end].ambientCache == base.ambientCache &&
+				surfs[end].indexCache == base.indexCache && surfs[end].numIndexes == base.numIndexes )
+		{
+			end++;
+		}
+
+		// split long runs so every batch fits the bound instance range
+		for( int first = start; first < end; first += MAX_DEPTH_INSTANCES )
+		{
+			const int count = Min( end - first, MAX_DEPTH_INSTANCES );
+			if( count >= minInstances )
+			{
+				batches[numBatches].firstInstance = first;
+				batches[numBatches].numInstances = count;
+				numBatches++;
+			}
+		}
+
+		start = end;
+	}
+
+	return numBatches;
+}
+
+/*
+===================
+R_BuildInstanceMatrices
+
+Writes the four MVP rows of every surface in the batch, in the layout RB_SetMVP
+uploads them to the RENDERPARM_MVPMATRIX_* registers.
+===================
+*/
+void R_BuildInstanceMatrices( const drawSurf_t* const* drawSurfs, const instancedSurf_t* surfs, const instanceBatch_t& batch, idVec4* rows )
+{
+	for( int i = 0; i < batch.numInstances; i++ )
+	{
+		const drawSurf_t* drawSurf = drawSurfs[ surfs[ batch.firstInstance + i ].surfNum ];
+		memcpy( &rows[i * 4], drawSurf->space->mvp[0], 4 * sizeof( idVec4 ) );
+	}
+}
+
+/*
+===================
+R_AddInstancedDepthSurfs
+
+Called on the sorted draw surf list of a view. Batch leaders get the instance
+count and transform buffer, the other members of a batch are flagged so the
+depth prepass skips them. All other passes still draw every surface on its own.
+===================
+*/
+void R_AddInstancedDepthSurfs( viewDef_t* viewDef )
+{
+	if( !r_useInstancing.GetBool() || viewDef->guiMode != GUIMODE_NONE )
+	{
+		return;
+	}
+
+	const int minInstances = idMath::ClampInt( 2, MAX_DEPTH_INSTANCES, r_instancingMinCount.GetInteger() );
+	if( viewDef->numDrawSurfs < minInstances )
+	{
+		return;
+	}
+
+	drawSurf_t** drawSurfs = viewDef->drawSurfs;
+
+	instancedSurf_t* surfs = ( instancedSurf_t* )R_FrameAlloc( viewDef->numDrawSurfs * sizeof( instancedSurf_t ), FRAME_ALLOC_UNKNOWN );
+	int numSurfs = 0;
+	for( int i = 0; i < viewDef->numDrawSurfs; i++ )
+	{
+		const drawSurf_t* drawSurf = drawSurfs[i];
+		if( !R_SurfIsInstanceable( drawSurf ) )
+		{
+			continue;
+		}
+		instancedSurf_t& surf = surfs[numSurfs++];
+		surf.surfNum = i;
+		surf.ambientCache = drawSurf->ambientCache;
+		surf.indexCache = drawSurf->indexCache;
+		surf.numIndexes = drawSurf->numIndexes;
+	}
+
+	if( numSurfs < minInstances )
+	{
+		return;
+	}
+
+	instanceBatch_t* batches = ( instanceBatch_t* )R_FrameAlloc( ( numSurfs / minInstances + 1 ) * sizeof( instanceBatch_t ), FRAME_ALLOC_UNKNOWN );
+	const int numBatches = R_GroupInstancedSurfs( surfs, numSurfs, minInstances, batches );
+	if( numBatches == 0 )
+	{
+		return;
+	}
+
+	// running out of joint memory is fatal, so only use what skinning is unlikely to need
+	int budget = vertexCache.JointMemoryAvailable() / 2;
+
+	idVec4* rows = ( idVec4* )_alloca16( MAX_DEPTH_INSTANCES * 4 * sizeof( idVec4 ) );
+	for( int i = 0; i < numBatches; i++ )
+	{
+		const instanceBatch_t& batch = batches[i];
+
+		// include room for the uniform buffer offset alignment
+		const int bytes = batch.numInstances * 4 * sizeof( idVec4 ) + 256;
+		if( bytes > budget )
+		{
+			break;
+		}
+		budget -= bytes;
+
+		R_BuildInstanceMatrices( drawSurfs, surfs, batch, rows );
+
+		drawSurf_t* leader = drawSurfs[ surfs[ batch.firstInstance ].surfNum ];
+		leader->numInstances = batch.numInstances;
+		leader->instanceCache = vertexCache.AllocJoint( rows, batch.numInstances * 4, sizeof( idVec4 ) );
+
+		for( int j = 1; j < batch.numInstances; j++ )
+		{
+			drawSurfs[ surfs[ batch.firstInstance + j ].surfNum ]->numInstances = -1;
+		}
+	}
+}
+
+/*
+===================
+testInstanceGrouping
+
+Runs R_GroupInstancedSurfs on shuffled fabricated cache handles and checks the
+batch boundaries, the batch leaders and the MAX_DEPTH_INSTANCES split.
+===================
+*/
+CONSOLE_COMMAND( testInstanceGrouping, "checks the auto instancing batches built from fabricated surfaces", NULL )
+{
+	struct testGroup_t
+	{
+		vertCacheHandle_t	ambientCache;
+		vertCacheHandle_t	indexCache;
+		int					numIndexes;
+		int					numSurfs;
+	};
+
+	static const testGroup_t groups[] =
+	{
+		{ 1, 1, 36, 3 },								// one batch
+		{ 1, 1, 72, 2 },								// same buffers with another index count, a batch of its own
+		{ 2, 2, 6, 1 },									// too few surfaces
+		{ 3, 3, 12, MAX_DEPTH_INSTANCES * 2 + 1 },		// two full batches, the last surface is left over
+		{ 4, 4, 24, MAX_DEPTH_INSTANCES + 3 },			// a full batch and one of three
+	};
+	static const int numGroups = sizeof( groups ) / sizeof( groups[0] );
+	const int minInstances = 2;
+
+	int expectedBatches = 0;
+	int expectedInstances = 0;
+	idList<instancedSurf_t> surfs;
+	for( int i = 0; i < numGroups; i++ )
+	{
+		const testGroup_t& group = groups[i];
+		for( int j = 0; j < group.numSurfs; j++ )
+		{
+			instancedSurf_t& surf = surfs.Alloc();
+			surf.ambientCache = group.ambientCache;
+			surf.indexCache = group.indexCache;
+			surf.numIndexes = group.numIndexes;
+		}
+
+		const int remainder = group.numSurfs % MAX_DEPTH_INSTANCES;
+		expectedBatches += group.numSurfs / MAX_DEPTH_INSTANCES + ( remainder >= minInstances ? 1 : 0 );
+		expectedInstances += group.numSurfs - ( remainder >= minInstances ? 0 : remainder );
+	}
+
+	// the draw surf order has nothing to do with the geometry
+	idRandom random( 0 );
+	for( int i = surfs.Num() - 1; i > 0; i-- )
+	{
+		SwapValues( surfs[i], surfs[random.RandomInt( i + 1 )] );
+	}
+	for( int i = 0; i < surfs.Num(); i++ )
+	{
+		surfs[i].surfNum = i;
+	}
+	for( int i = surfs.Num() - 1; i > 0; i-- )
+	{
+		SwapValues( surfs[i], surfs[random.RandomInt( i + 1 )] );
+	}
+
+	idList<instanceBatch_t> batches;
+	batches.SetNum( surfs.Num() / minInstances + 1 );
+	const int numBatches = R_GroupInstancedSurfs( surfs.Ptr(), surfs.Num(), minInstances, batches.Ptr() );
+
+	int numErrors = 0;
+	if( numBatches != expectedBatches )
+	{
+		common->Warning( "%d batches, expected %d", numBatches, expectedBatches );
+		numErrors++;
+	}
+
+	int numInstances = 0;
+	for( int i = 0; i < numBatches; i++ )
+	{
+		const instanceBatch_t& batch = batches[i];
+		if( batch.numInstances < minInstances || batch.numInstances > MAX_DEPTH_INSTANCES || batch.firstInstance < 0 || batch.firstInstance + batch.numInstances > surfs.Num() )
+		{
+			common->Warning( "batch %d has %d instances from %d", i, batch.numInstances, batch.firstInstance );
+			numErrors++;
+			continue;
+		}
+		numInstances += batch.numInstances;
+
+		// batches follow each other and never share a surface
+		if( i > 0 && batch.firstInstance < batches[i - 1].firstInstance + batches[i - 1].numInstances )
+		{
+			common->Warning( "batch %d overlaps the previous one", i );
+			numErrors++;
+		}
+
+		// the leader has the lowest draw surf index, the others follow in draw order
+		const instancedSurf_t& leader = surfs[batch.firstInstance];
+		for( int j = 1; j < batch.numInstances; j++ )
+		{
+			const instancedSurf_t& surf = surfs[batch.firstInstance + j];
+			if( surf.ambientCache != leader.ambientCache || surf.indexCache != leader.indexCache || surf.numIndexes != leader.numIndexes )
+			{
+				common->Warning( "batch %d mixes geometry", i );
+				numErrors++;
+				break;
+			}
+			if( surf.surfNum <= surfs[batch.firstInstance + j - 1].surfNum )
+			{
+				common->Warning( "batch %d is not in draw surf order", i );
+				numErrors++;
+				break;
+			}
+		}
+
+		// a run of the same geometry is only split after a full batch
+		const int prev = batch.firstInstance - 1;
+		if( prev >= 0 && surfs[prev].ambientCache == leader.ambientCache && surfs[prev].indexCache == leader.indexCache &&
+				surfs[prev].numIndexes == leader.numIndexes )
+		{
+			if( i == 0 || batches[i - 1].firstInstance + batches[i - 1].numInstances != batch.firstInstance ||
+					batches[i - 1].numInstances != MAX_DEPTH_INSTANCES || surfs[prev].surfNum > leader.surfNum )
+			{
+				common->Warning( "batch %d splits its geometry before a full batch", i );
+				numErrors++;
+			}
+		}
+	}
+
+	if( numInstances != expectedInstances )
+	{
+		common->Warning( "%d instances in batches, expected %d", numInstances, expectedInstances );
+		numErrors++;
+	}
+
+	common->Printf( "%d surfaces, %d batches, %d instances, %d errors\n", surfs.Num(), numBatches, numInstances, numErrors );
+}
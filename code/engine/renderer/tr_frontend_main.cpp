@@ -878,6 +878,9 @@ void R_RenderView( viewDef_t* parms )
 	// sort all the ambient surfaces for translucency ordering
 	R_SortDrawSurfs( tr.viewDef->drawSurfs, tr.viewDef->numDrawSurfs );
 
+	// fold repeated static geometry into instanced depth prepass draws
+	R_AddInstancedDepthSurfs( tr.viewDef );
+
 	// generate any subviews (mirrors, cameras, etc) before adding this view
 	if( R_GenerateSubViews( tr.viewDef->drawSurfs, tr.viewDef->numDrawSurfs ) )
 	{
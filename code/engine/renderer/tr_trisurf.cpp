@@ -2068,6 +2068,25 @@ void R_CreateStaticBuffersForTri( srfTriangles_t& tri, nvrhi::ICommandList* comm
 	}
 }
 
+/*
+===================
+R_CreateStaticBuffersForLodTri
+
+Generated detail levels draw from the vertex buffer of the full detail surface,
+so only their indexes need a buffer of their own.
+===================
+*/
+void R_CreateStaticBuffersForLodTri( srfTriangles_t& tri, const srfTriangles_t& baseTri, nvrhi::ICommandList* commandList )
+{
+	tri.indexCache = 0;
+	tri.ambientCache = baseTri.ambientCache;
+
+	if( tri.indexes != NULL )
+	{
+		tri.indexCache = vertexCache.AllocStaticIndex( tri.indexes, tri.numIndexes * sizeof( tri.indexes[0] ), commandList );
+	}
+}
+
 #endif
 
 // SP begin
@@ -29,7 +29,7 @@ If you have questions concerning this license or the applicable additional terms
 #include "global_inc.hlsl"
 
 // *INDENT-OFF*
-#if USE_GPU_SKINNING
+#if USE_GPU_SKINNING || USE_INSTANCING
 StructuredBuffer<float4> matrices : register(t11);
 #endif
 
@@ -49,7 +49,7 @@ struct VS_OUT
 };
 // *INDENT-ON*
 
-void main( VS_IN vertex, out VS_OUT result )
+void main( VS_IN vertex, uint instanceID : SV_InstanceID, out VS_OUT result )
 {
 #if USE_GPU_SKINNING
 	//--------------------------------------------------------------
@@ -93,6 +93,14 @@ void main( VS_IN vertex, out VS_OUT result )
 	result.position.y = dot4( modelPosition, rpMVPmatrixY );
 	result.position.z = dot4( modelPosition, rpMVPmatrixZ );
 	result.position.w = dot4( modelPosition, rpMVPmatrixW );
+#elif USE_INSTANCING
+	// every instance stores the 4 MVP rows
+	const int row = int( instanceID ) * 4;
+
+	result.position.x = dot4( vertex.position, matrices[row + 0] );
+	result.position.y = dot4( vertex.position, matrices[row + 1] );
+	result.position.z = dot4( vertex.position, matrices[row + 2] );
+	result.position.w = dot4( vertex.position, matrices[row + 3] );
 #else
 
 	result.position.x = dot4( vertex.position, rpMVPmatrixX );
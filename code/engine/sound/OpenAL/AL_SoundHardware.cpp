@@ -52,6 +52,8 @@ idSoundHardware_OpenAL::idSoundHardware_OpenAL()
 	openalDevice = NULL;
 	openalContext = NULL;
 
+	streamThread.hardware = this;
+
 	//vuMeterRMS = NULL;
 	//vuMeterPeak = NULL;
 
@@ -267,6 +269,11 @@ void idSoundHardware_OpenAL::Init()
 	{
 		freeVoices[i] = &voices[i];
 	}
+
+	if( !streamThread.IsRunning() )
+	{
+		streamThread.StartWorkerThread( "Sound Stream", CORE_ANY, THREAD_NORMAL );
+	}
 }
 
 /*
@@ -284,6 +291,11 @@ void idSoundHardware_OpenAL::Shutdown()
 	freeVoices.Clear();
 	zombieVoices.Clear();
 
+	if( streamThread.IsRunning() )
+	{
+		streamThread.StopThread();
+	}
+
 #if defined(USE_DOOMCLASSIC)
 	// ---------------------
 	// Shutdown the Doom classic sound system.
@@ -390,6 +402,9 @@ void idSoundHardware_OpenAL::Update()
 		return;
 	}
 
+	// the stream thread only runs between two updates
+	WaitForStreams();
+
 	if( soundSystem->IsMuted() )
 	{
 		alListenerf( AL_GAIN, 0.0f );
@@ -418,6 +433,22 @@ void idSoundHardware_OpenAL::Update()
 		}
 	}
 
+	// hand the PCM decoded since the last update to OpenAL and let the
+	// stream thread refill the buffers the sources are done with
+	bool streaming = false;
+	for( int i = 0; i < voices.Num(); i++ )
+	{
+		if( voices[i].streaming )
+		{
+			voices[i].UpdateStream();
+			streaming = true;
+		}
+	}
+	if( streaming )
+	{
+		streamThread.SignalWork();
+	}
+
 	/*
 	if( s_showPerfData.GetBool() )
 	{
@@ -493,4 +524,42 @@ void idSoundHardware_OpenAL::Update()
 	*/
 }
 
+/*
+========================
+idSoundHardware_OpenAL::WaitForStreams
+========================
+*/
+void idSoundHardware_OpenAL::WaitForStreams()
+{
+	if( streamThread.IsRunning() )
+	{
+		streamThread.WaitForThread();
+	}
+}
+
+/*
+========================
+idSoundHardware_OpenAL::DecodeStreams
+========================
+*/
+void idSoundHardware_OpenAL::DecodeStreams()
+{
+	for( int i = 0; i < voices.Num(); i++ )
+	{
+		if( voices[i].streaming )
+		{
+			voices[i].DecodeStreamBuffers( MAX_QUEUED_BUFFERS );
+		}
+	}
+}
 
+/*
+========================
+idSoundStreamThread::Run
+========================
+*/
+int idSoundStreamThread::Run()
+{
+	hardware->DecodeStreams();
+	return 0;
+}
@@ -33,7 +33,25 @@ class idSoundSample_OpenAL;
 class idSoundVoice_OpenAL;
 class idSoundHardware_OpenAL;
 
+/*
+================================================
+idSoundStreamThread
+
+Decodes the Ogg data of streaming voices between two hardware updates.
+================================================
+*/
+class idSoundStreamThread : public idSysThread
+{
+public:
+	idSoundStreamThread() :
+		hardware( NULL )
+	{
+	}
 
+	virtual int		Run();
+
+	idSoundHardware_OpenAL*	hardware;
+};
 
 /*
 ================================================
@@ -69,6 +87,12 @@ public:
 		return freeVoices.Num();
 	}
 
+	// blocks until the stream thread is done with the voices
+	void			WaitForStreams();
+
+	// runs on the stream thread
+	void			DecodeStreams();
+
 	// OpenAL info
 	static void		PrintDeviceList( const char* list );
 	static void		PrintALCInfo( ALCdevice* device );
@@ -92,6 +116,8 @@ private:
 
 	int					lastResetTime;
 
+	idSoundStreamThread	streamThread;
+
 	//int				outputChannels;
 	//int				channelMask;
 
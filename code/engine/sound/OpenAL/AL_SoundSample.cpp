@@ -35,6 +35,8 @@ If you have questions concerning this license or the applicable additional terms
 extern idCVar s_useCompression;
 extern idCVar s_noSound;
 
+idCVar s_streamThreshold( "s_streamThreshold", "1024", CVAR_INTEGER, "Ogg samples that decode to more than this many kB stay compressed and are streamed, 0 decodes all of them at load time", 0, 65536 );
+
 #define GPU_CONVERT_CPU_TO_CPU_CACHED_READONLY_ADDRESS( x ) x
 
 const uint32 SOUND_MAGIC_IDMSA = 0x6D7A7274;
@@ -239,6 +241,18 @@ void idSoundSample_OpenAL::LoadResource()
 			loaded = LoadWav( sampleName );
 		}
 
+		if( !loaded )
+		{
+			sampleName.SetFileExtension( "ogg" );
+			loaded = LoadOgg( sampleName );
+		}
+
+		if( loaded && IsStreamed() )
+		{
+			// decoded into the voice's streaming buffers while playing
+			return;
+		}
+
 		if( loaded )
 		{
 			if( cvarSystem->GetCVarBool( "fs_buildresources" ) )
@@ -532,6 +546,72 @@ bool idSoundSample_OpenAL::LoadWav( const idStr& filename )
 }
 
 
+/*
+========================
+idSoundSample_OpenAL::LoadOgg
+
+Short samples are decoded to PCM right away, long ones keep the compressed
+file in memory and are decoded by the sound stream thread while playing.
+========================
+*/
+bool idSoundSample_OpenAL::LoadOgg( const idStr& filename )
+{
+	idFileLocal file( fileSystem->OpenFileRead( filename ) );
+	if( file == NULL )
+	{
+		return false;
+	}
+
+	idList<byte, TAG_AUDIO> data;
+	data.SetNum( file->Length() );
+	if( file->Read( data.Ptr(), data.Num() ) != data.Num() )
+	{
+		idLib::Warning( "LoadOgg( %s ) : read failed", filename.c_str() );
+		return false;
+	}
+	timestamp = file->Timestamp();
+
+	idSoundDecoder_Vorbis decoder;
+	if( !decoder.Open( filename, data.Ptr(), data.Num() ) )
+	{
+		return false;
+	}
+
+	decoder.GetFormat( format );
+
+	idStrStatic< MAX_OSPATH > ampName = filename;
+	ampName.SetFileExtension( "amp" );
+	LoadAmplitude( ampName );
+
+	const int64_t decodedSize = decoder.Size();
+
+	playBegin = 0;
+	playLength = decoder.CompressedSize();
+
+	if( s_streamThreshold.GetInteger() > 0 && decodedSize > s_streamThreshold.GetInteger() * 1024 )
+	{
+		compressedData.Swap( data );
+		totalBufferSize = 0;
+		return true;
+	}
+
+	totalBufferSize = ( int )decodedSize;
+
+	buffers.SetNum( 1 );
+	buffers[0].bufferSize = totalBufferSize;
+	buffers[0].numSamples = playLength;
+	buffers[0].buffer = AllocBuffer( totalBufferSize, GetName() );
+
+	if( decoder.Read( buffers[0].buffer, totalBufferSize ) != totalBufferSize )
+	{
+		idLib::Warning( "LoadOgg( %s ) : decoding failed", filename.c_str() );
+		MakeDefault();
+		return false;
+	}
+
+	return true;
+}
+
 /*
 ========================
 idSoundSample_OpenAL::MakeDefault
@@ -611,14 +691,16 @@ Called before deleting the object and at the start of LoadResource()
 */
 void idSoundSample_OpenAL::FreeData()
 {
-	if( buffers.Num() > 0 )
+	if( buffers.Num() > 0 || compressedData.Num() > 0 )
 	{
+		// streaming voices decode straight from compressedData
 		soundSystemLocal.StopVoicesWithSample( ( idSoundSample* )this );
 		for( int i = 0; i < buffers.Num(); i++ )
 		{
 			FreeBuffer( buffers[i].buffer );
 		}
 		buffers.Clear();
+		compressedData.Clear();
 	}
 	amplitude.Clear();
 
@@ -83,6 +83,21 @@ public:
 		return totalBufferSize;
 	}
 
+	// long Ogg samples stay compressed in memory and are decoded while they play
+	bool			IsStreamed() const
+	{
+		return compressedData.Num() > 0;
+	}
+	int				CompressedSize() const
+	{
+		return compressedData.Num();
+	}
+	// size of the 16 bit PCM this sample decodes to
+	int				DecodedSize() const
+	{
+		return playLength * NumChannels() * ( int )sizeof( short );
+	}
+
 	bool			IsCompressed() const
 	{
 		return ( format.basic.formatTag != idWaveFile::FORMAT_PCM );
@@ -157,6 +172,7 @@ protected:
 	~idSoundSample_OpenAL();
 
 	bool			LoadWav( const idStr& name );
+	bool			LoadOgg( const idStr& name );
 	bool			LoadAmplitude( const idStr& name );
 	void			WriteAllSamples( const idStr& sampleName );
 	bool			LoadGeneratedSample( const idStr& name );
@@ -200,6 +216,9 @@ protected:
 	// OpenAL buffer that contains all buffers
 	ALuint			openalBuffer;
 
+	// the whole Ogg file for streamed samples, buffers is empty then
+	idList<byte, TAG_AUDIO> compressedData;
+
 	int				playBegin;
 	int				playLength;
 
@@ -54,9 +54,18 @@ idSoundVoice_OpenAL::idSoundVoice_OpenAL()
 	numChannels( 0 ),
 	sampleRate( 0 ),
 	hasVUMeter( false ),
-	paused( true )
+	paused( true ),
+	streaming( false ),
+	streamFinished( false ),
+	streamSample( NULL ),
+	streamOffset( 0 ),
+	streamDecoder( NULL ),
+	streamDecodeIndex( 0 ),
+	streamQueueIndex( 0 )
 {
-
+	memset( openalStreamingBuffer, 0, sizeof( openalStreamingBuffer ) );
+	memset( lastopenalStreamingBuffer, 0, sizeof( lastopenalStreamingBuffer ) );
+	memset( streamContexts, 0, sizeof( streamContexts ) );
 }
 
 /*
@@ -199,6 +208,8 @@ idSoundVoice_OpenAL::DestroyInternal
 */
 void idSoundVoice_OpenAL::DestroyInternal()
 {
+	StopStream();
+
 	if( alIsSource( openalSource ) )
 	{
 		if( s_debugHardware.GetBool() )
@@ -311,7 +322,17 @@ void idSoundVoice_OpenAL::Start( int offsetMS, int ssFlags )
 		return;
 	}
 
-	RestartAt( offsetSamples );
+	if( leadinSample->IsStreamed() || ( loopingSample != NULL && loopingSample->IsStreamed() ) )
+	{
+		if( !StartStream( offsetSamples ) )
+		{
+			return;
+		}
+	}
+	else
+	{
+		RestartAt( offsetSamples );
+	}
 	Update();
 	UnPause();
 }
@@ -633,6 +654,9 @@ void idSoundVoice_OpenAL::Stop()
 		return;
 	}
 
+	// also when paused, the stream contexts go back to the pool right away
+	StopStream();
+
 	if( !paused )
 	{
 		if( s_debugHardware.GetBool() )
@@ -773,3 +797,305 @@ void idSoundVoice_OpenAL::OnBufferStart( idSoundSample_OpenAL* sample, int buffe
 
 	SubmitBuffer( nextSample, nextBuffer, 0 );
 }
+
+/*
+========================
+idSoundVoice_OpenAL::StartStream
+
+Queues the first decoded buffer, the stream thread keeps the rest of the
+ring filled while the source plays.
+========================
+*/
+bool idSoundVoice_OpenAL::StartStream( int offsetSamples )
+{
+	// the stream thread must not see this voice half set up
+	soundSystemLocal.hardware.WaitForStreams();
+	StopStream();
+
+	if( openalStreamingBuffer[0] == 0 || openalStreamingBuffer[1] == 0 || openalStreamingBuffer[2] == 0 )
+	{
+		CheckALErrors();
+
+		alGenBuffers( 3, &openalStreamingBuffer[0] );
+		if( CheckALErrors() != AL_NO_ERROR )
+		{
+			openalStreamingBuffer[0] = openalStreamingBuffer[1] = openalStreamingBuffer[2] = 0;
+			return false;
+		}
+	}
+
+	alSourceStop( openalSource );
+	alSourcei( openalSource, AL_BUFFER, 0 );
+	alSourcei( openalSource, AL_LOOPING, AL_FALSE );
+
+	streaming = true;
+
+	for( int i = 0; i < MAX_QUEUED_BUFFERS; i++ )
+	{
+		soundBufferContext_t* bufferContext = soundSystemLocal.ObtainStreamBufferContext();
+		if( bufferContext == NULL )
+		{
+			idLib::Warning( "No free buffer contexts!" );
+			StopStream();
+			return false;
+		}
+
+		if( bufferContext->pcm == NULL )
+		{
+			bufferContext->pcm = ( byte* )Mem_Alloc( STREAM_BUFFER_BYTES, TAG_AUDIO );
+		}
+		bufferContext->voice = this;
+		bufferContext->sample = NULL;
+		bufferContext->bufferNumber = i;
+		bufferContext->pcmBytes = 0;
+		bufferContext->queued = false;
+
+		streamContexts[i] = bufferContext;
+	}
+
+	offsetSamples &= ~127;
+
+	idSoundSample_OpenAL* sample = leadinSample;
+	if( offsetSamples >= leadinSample->playLength )
+	{
+		if( loopingSample == NULL )
+		{
+			StopStream();
+			return false;
+		}
+		offsetSamples %= loopingSample->playLength;
+		sample = loopingSample;
+	}
+
+	if( !OpenStreamSample( sample, offsetSamples ) )
+	{
+		StopStream();
+		return false;
+	}
+
+	// decode the first buffer right away so the source can start playing
+	DecodeStreamBuffers( 1 );
+	QueueStreamBuffers();
+
+	return true;
+}
+
+/*
+========================
+idSoundVoice_OpenAL::StopStream
+========================
+*/
+void idSoundVoice_OpenAL::StopStream()
+{
+	if( !streaming )
+	{
+		return;
+	}
+
+	soundSystemLocal.hardware.WaitForStreams();
+
+	if( alIsSource( openalSource ) )
+	{
+		// detaching the buffer unqueues everything
+		alSourceStop( openalSource );
+		alSourcei( openalSource, AL_BUFFER, 0 );
+	}
+
+	for( int i = 0; i < MAX_QUEUED_BUFFERS; i++ )
+	{
+		soundBufferContext_t* bufferContext = streamContexts[i];
+		if( bufferContext == NULL )
+		{
+			continue;
+		}
+		bufferContext->voice = NULL;
+		bufferContext->sample = NULL;
+		bufferContext->pcmBytes = 0;
+		bufferContext->queued = false;
+		soundSystemLocal.ReleaseStreamBufferContext( bufferContext );
+		streamContexts[i] = NULL;
+	}
+
+	delete streamDecoder;
+	streamDecoder = NULL;
+
+	streamSample = NULL;
+	streamOffset = 0;
+	streamDecodeIndex = 0;
+	streamQueueIndex = 0;
+	streamFinished = false;
+	streaming = false;
+}
+
+/*
+========================
+idSoundVoice_OpenAL::OpenStreamSample
+
+Streamed samples are decoded from their compressed data, regular samples
+that are mixed into a stream as leadin or loop are copied from their PCM.
+========================
+*/
+bool idSoundVoice_OpenAL::OpenStreamSample( idSoundSample_OpenAL* sample, int offsetSamples )
+{
+	// all buffers on a source need the same format
+	if( sample->NumChannels() != leadinSample->NumChannels() || sample->SampleRate() != leadinSample->SampleRate() )
+	{
+		idLib::Warning( "Can't stream %s after %s, format mismatch", sample->GetName(), leadinSample->GetName() );
+		return false;
+	}
+
+	if( sample->IsStreamed() )
+	{
+		if( streamDecoder == NULL || sample != streamSample )
+		{
+			delete streamDecoder;
+			streamDecoder = new( TAG_AUDIO ) idSoundDecoder_Vorbis;
+			if( !streamDecoder->Open( sample->GetName(), sample->compressedData.Ptr(), sample->compressedData.Num() ) )
+			{
+				delete streamDecoder;
+				streamDecoder = NULL;
+				return false;
+			}
+		}
+		streamDecoder->Seek( offsetSamples );
+	}
+	else
+	{
+		delete streamDecoder;
+		streamDecoder = NULL;
+
+		if( sample->format.basic.formatTag != idWaveFile::FORMAT_PCM || sample->buffers.Num() != 1 )
+		{
+			idLib::Warning( "Can't stream %s, only PCM samples can be mixed with streamed ones", sample->GetName() );
+			return false;
+		}
+	}
+
+	streamSample = sample;
+	streamOffset = offsetSamples;
+
+	return true;
+}
+
+/*
+========================
+idSoundVoice_OpenAL::DecodeStreamBuffers
+========================
+*/
+void idSoundVoice_OpenAL::DecodeStreamBuffers( int maxBuffers )
+{
+	for( int n = 0; n < maxBuffers && streaming && !streamFinished; n++ )
+	{
+		soundBufferContext_t* bufferContext = streamContexts[streamDecodeIndex];
+		if( bufferContext->queued || bufferContext->pcmBytes > 0 )
+		{
+			// the source hasn't released this one yet
+			break;
+		}
+
+		if( streamOffset >= streamSample->playLength )
+		{
+			if( loopingSample == NULL || !OpenStreamSample( loopingSample, 0 ) )
+			{
+				streamFinished = true;
+				break;
+			}
+		}
+
+		// never mix two samples in one buffer
+		const int frameBytes = streamSample->NumChannels() * sizeof( short );
+		const int numFrames = Min( STREAM_BUFFER_BYTES / frameBytes, streamSample->playLength - streamOffset );
+
+		int bytes = 0;
+		if( streamDecoder != NULL )
+		{
+			bytes = streamDecoder->Read( bufferContext->pcm, numFrames * frameBytes );
+		}
+		else
+		{
+			bytes = numFrames * frameBytes;
+			memcpy( bufferContext->pcm, ( const byte* )streamSample->buffers[0].buffer + ( streamSample->playBegin + streamOffset ) * frameBytes, bytes );
+		}
+
+		if( bytes <= 0 )
+		{
+			streamFinished = true;
+			break;
+		}
+
+		bufferContext->sample = streamSample;
+		bufferContext->pcmBytes = bytes;
+
+		streamOffset += bytes / frameBytes;
+		streamDecodeIndex = ( streamDecodeIndex + 1 ) % MAX_QUEUED_BUFFERS;
+	}
+}
+
+/*
+========================
+idSoundVoice_OpenAL::QueueStreamBuffers
+========================
+*/
+void idSoundVoice_OpenAL::QueueStreamBuffers()
+{
+	for( int n = 0; n < MAX_QUEUED_BUFFERS; n++ )
+	{
+		soundBufferContext_t* bufferContext = streamContexts[streamQueueIndex];
+		if( bufferContext->queued || bufferContext->pcmBytes == 0 )
+		{
+			break;
+		}
+
+		ALuint buffer = openalStreamingBuffer[bufferContext->bufferNumber];
+		alBufferData( buffer, bufferContext->sample->GetOpenALBufferFormat(), bufferContext->pcm, bufferContext->pcmBytes, bufferContext->sample->SampleRate() );
+		alSourceQueueBuffers( openalSource, 1, &buffer );
+
+		bufferContext->queued = true;
+		bufferContext->pcmBytes = 0;
+
+		streamQueueIndex = ( streamQueueIndex + 1 ) % MAX_QUEUED_BUFFERS;
+	}
+}
+
+/*
+========================
+idSoundVoice_OpenAL::UpdateStream
+========================
+*/
+void idSoundVoice_OpenAL::UpdateStream()
+{
+	if( !alIsSource( openalSource ) )
+	{
+		return;
+	}
+
+	ALint processed = 0;
+	alGetSourcei( openalSource, AL_BUFFERS_PROCESSED, &processed );
+	for( int i = 0; i < processed; i++ )
+	{
+		ALuint buffer = 0;
+		alSourceUnqueueBuffers( openalSource, 1, &buffer );
+		for( int j = 0; j < MAX_QUEUED_BUFFERS; j++ )
+		{
+			if( openalStreamingBuffer[j] == buffer )
+			{
+				streamContexts[j]->queued = false;
+			}
+		}
+	}
+
+	QueueStreamBuffers();
+
+	if( !paused )
+	{
+		ALint state = AL_INITIAL;
+		ALint queued = 0;
+		alGetSourcei( openalSource, AL_SOURCE_STATE, &state );
+		alGetSourcei( openalSource, AL_BUFFERS_QUEUED, &queued );
+		if( state != AL_PLAYING && queued > 0 )
+		{
+			// the stream thread fell behind and the source ran dry
+			alSourcePlay( openalSource );
+		}
+	}
+}
@@ -31,6 +31,12 @@ If you have questions concerning this license or the applicable additional terms
 
 static const int MAX_QUEUED_BUFFERS = 3;
 
+// size of each PCM chunk a streaming voice keeps queued on its source
+static const int STREAM_BUFFER_BYTES = 32 * 1024;
+
+struct soundBufferContext_t;
+class idSoundDecoder_Vorbis;
+
 /*
 ================================================
 idSoundVoice_OpenAL
@@ -115,6 +121,18 @@ private:
 	// Adjust the voice frequency based on the new sample rate for the buffer
 	void					SetSampleRate( uint32 newSampleRate, uint32 operationSet );
 
+	// Streaming playback of samples that are kept Ogg compressed in memory
+	bool					StartStream( int offsetSamples );
+	void					StopStream();
+	bool					OpenStreamSample( idSoundSample_OpenAL* sample, int offsetSamples );
+
+	// Called by the stream thread, fills up to maxBuffers free contexts with PCM
+	void					DecodeStreamBuffers( int maxBuffers );
+
+	// Called by the hardware update, recycles processed buffers and queues decoded ones
+	void					UpdateStream();
+	void					QueueStreamBuffers();
+
 	//IXAudio2SourceVoice* 	pSourceVoice;
 	bool					triggered;
 	ALuint					openalSource;
@@ -134,6 +152,15 @@ private:
 
 	bool					hasVUMeter;
 	bool					paused;
+
+	bool					streaming;
+	bool					streamFinished;			// the decoder reached the end of a non looping sound
+	idSoundSample_OpenAL*	streamSample;			// sample currently being decoded
+	int						streamOffset;			// next sample frame to decode from streamSample
+	idSoundDecoder_Vorbis*	streamDecoder;
+	int						streamDecodeIndex;		// next context the stream thread fills
+	int						streamQueueIndex;		// next context handed to the source
+	soundBufferContext_t*	streamContexts[MAX_QUEUED_BUFFERS];
 };
 
 /*
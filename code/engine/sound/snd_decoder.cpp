@@ -191,9 +191,21 @@ idSoundDecoder_Vorbis::~idSoundDecoder_Vorbis()
 		sample = nullptr;
 	}
 
-	if( vorbisFile )
+	Close();
+}
+
+/*
+====================
+idSoundDecoder_Vorbis::Close
+====================
+*/
+void idSoundDecoder_Vorbis::Close()
+{
+	if( vorbisFile != nullptr )
 	{
+		ov_clear( vorbisFile );
 		delete vorbisFile;
+		vorbisFile = nullptr;
 	}
 
 	if( mhmmio )
@@ -302,30 +314,46 @@ idSoundDecoder_Vorbis::Open
 */
 bool idSoundDecoder_Vorbis::Open( const char* fileName )
 {
-	if( mhmmio )
-	{
-		fileSystem->CloseFile( mhmmio );
-		mhmmio = nullptr;
-	}
-
-	if( vorbisFile != nullptr )
-	{
-		delete vorbisFile;
-		vorbisFile = nullptr;
-	}
+	Close();
 
-	mhmmio = fileSystem->OpenFileRead( fileName );
-	if( !mhmmio )
+	idFile* file = fileSystem->OpenFileRead( fileName );
+	if( !file )
 	{
 		return false;
 	}
 
+	return OpenFile( file );
+}
+
+/*
+====================
+idSoundDecoder_Vorbis::Open
+====================
+*/
+bool idSoundDecoder_Vorbis::Open( const char* fileName, const byte* data, int dataSize )
+{
+	Close();
+
+	return OpenFile( new idFile_Memory( fileName, ( const char* )data, dataSize ) );
+}
+
+/*
+====================
+idSoundDecoder_Vorbis::OpenFile
+====================
+*/
+bool idSoundDecoder_Vorbis::OpenFile( idFile* file )
+{
+	mhmmio = file;
+
 	vorbisFile = new OggVorbis_File;
 
 	if( ov_openFile( mhmmio, vorbisFile ) < 0 )
 	{
 		delete vorbisFile;
+		vorbisFile = nullptr;
 		fileSystem->CloseFile( mhmmio );
+		mhmmio = nullptr;
 		common->FatalError( "ov_openFile failed" );
 		return false;
 	}
@@ -36,6 +36,8 @@ If you have questions concerning this license or the applicable additional terms
 idCVar s_singleEmitter( "s_singleEmitter", "0", CVAR_INTEGER, "mute all sounds but this emitter" );
 idCVar s_showStartSound( "s_showStartSound", "0", CVAR_BOOL, "print a message every time a sound starts/stops" );
 idCVar s_useOcclusion( "s_useOcclusion", "1", CVAR_BOOL, "Attenuate sounds based on walls" );
+idCVar s_cachePortalPaths( "s_cachePortalPaths", "1", CVAR_BOOL, "reuse the occlusion portal path of an emitter until the listener changes area, the emitter moves or a portal changes state" );
+idCVar s_portalPathListenerMove( "s_portalPathListenerMove", "32", CVAR_FLOAT, "retrace a cached portal path when the listener moved this far inside its area" );
 idCVar s_centerFractionVO( "s_centerFractionVO", "0.75", CVAR_FLOAT, "Portion of VO sounds routed to the center channel" );
 
 extern idCVar s_playDefaultSound;
@@ -466,6 +468,8 @@ void idSoundEmitterLocal::Init( int i, idSoundWorldLocal* sw )
 	spatializedDistance = 0.0f;
 	spatializedOrigin.Zero();
 
+	memset( &portalCache, 0, sizeof( portalCache ) );
+
 	memset( &parms, 0, sizeof( parms ) );
 }
 
@@ -567,41 +571,29 @@ bool idSoundEmitterLocal::CheckForCompletion( int currentTime )
 
 /*
 ========================
-idSoundEmitterLocal::Update
+idSoundEmitterLocal::CheckAudible
 ========================
 */
-void idSoundEmitterLocal::Update( int currentTime )
+bool idSoundEmitterLocal::CheckAudible( float& maxDistance, int& soundArea )
 {
-	if( channels.Num() == 0 )
-	{
-		return;
-	}
-
 	directDistance = ( soundWorld->listener.pos - origin ).LengthFast() * DOOM_TO_METERS;
 
-	spatializedDistance = directDistance;
-	spatializedOrigin = origin;
-
-	// Initialize all channels to silence
-	for( int i = 0; i < channels.Num(); i++ )
-	{
-		channels[i]->volumeDB = DB_SILENCE;
-	}
+	maxDistance = 0.0f;
+	soundArea = -1;
 
 	if( s_singleEmitter.GetInteger() > 0 && s_singleEmitter.GetInteger() != index )
 	{
-		return;
+		return false;
 	}
 	if( soundWorld->listener.area == -1 )
 	{
 		// listener is outside the world
-		return;
+		return false;
 	}
 	if( soundSystemLocal.muted || soundWorld != soundSystemLocal.currentSoundWorld )
 	{
-		return;
+		return false;
 	}
-	float maxDistance = 0.0f;
 	bool maxDistanceValid = false;
 	bool useOcclusion = false;
 	if( emitterId != soundWorld->listener.id )
@@ -624,7 +616,7 @@ void idSoundEmitterLocal::Update( int currentTime )
 	if( maxDistanceValid && directDistance >= maxDistance )
 	{
 		// too far away to possibly hear it
-		return;
+		return false;
 	}
 	if( useOcclusion && s_useOcclusion.GetBool() )
 	{
@@ -643,12 +635,151 @@ void idSoundEmitterLocal::Update( int currentTime )
 			}
 			if( soundInArea != -1 && soundInArea != soundWorld->listener.area )
 			{
-				spatializedDistance = maxDistance * METERS_TO_DOOM;
-				soundWorld->ResolveOrigin( 0, NULL, soundInArea, 0.0f, origin, this );
-				spatializedDistance *= DOOM_TO_METERS;
+				soundArea = soundInArea;
 			}
 		}
 	}
+	return true;
+}
+
+/*
+========================
+idSoundEmitterLocal::PortalCacheValid
+========================
+*/
+bool idSoundEmitterLocal::PortalCacheValid( int soundArea, float maxDistance ) const
+{
+	if( !portalCache.valid || !s_cachePortalPaths.GetBool() )
+	{
+		return false;
+	}
+
+	const listener_t& listener = soundWorld->listener;
+	if( portalCache.soundArea != soundArea || portalCache.listenerArea != listener.area || portalCache.maxDistance != maxDistance )
+	{
+		return false;
+	}
+	if( portalCache.portalStateCount != soundWorld->renderWorld->PortalStateChangeCount() )
+	{
+		return false;
+	}
+	if( portalCache.origin != origin )
+	{
+		return false;
+	}
+
+	// the virtual origin is where the line to the listener crosses the last portal,
+	// and paths that were too long may have come into range
+	const float move = s_portalPathListenerMove.GetFloat();
+	return ( portalCache.listenerPos - listener.pos ).LengthSqr() <= move * move;
+}
+
+/*
+========================
+idSoundEmitterLocal::ResolvePortalPath
+
+Traces the portals from soundArea to the listener and caches the result.
+Only writes to this emitter, so different emitters can be resolved in parallel.
+========================
+*/
+void idSoundEmitterLocal::ResolvePortalPath( int soundArea, float maxDistance )
+{
+	const listener_t& listener = soundWorld->listener;
+
+	portalCache.valid = true;
+	portalCache.retraced = true;
+	portalCache.pathFound = false;
+	portalCache.soundArea = soundArea;
+	portalCache.listenerArea = listener.area;
+	portalCache.portalStateCount = soundWorld->renderWorld->PortalStateChangeCount();
+	portalCache.maxDistance = maxDistance;
+	portalCache.origin = origin;
+	portalCache.listenerPos = listener.pos;
+	portalCache.pathDistance = 0.0f;
+
+	spatializedDistance = maxDistance * METERS_TO_DOOM;
+	spatializedOrigin = origin;
+	soundWorld->ResolveOrigin( 0, NULL, soundArea, 0.0f, origin, this );
+
+	portalCache.virtualOrigin = spatializedOrigin;
+}
+
+/*
+========================
+idSoundEmitterLocal::ApplyPortalPath
+
+Sets the spatialized distance and origin from the cached portal path, with the
+last leg measured to where the listener is now.
+========================
+*/
+void idSoundEmitterLocal::ApplyPortalPath( float maxDistance )
+{
+	if( portalCache.pathFound )
+	{
+		const float fullDist = portalCache.pathDistance + ( portalCache.virtualOrigin - soundWorld->listener.pos ).LengthFast();
+		if( fullDist < maxDistance * METERS_TO_DOOM )
+		{
+			spatializedDistance = fullDist * DOOM_TO_METERS;
+			spatializedOrigin = portalCache.virtualOrigin;
+			return;
+		}
+	}
+
+	// no open path to the listener within hearing distance
+	spatializedDistance = maxDistance;
+	spatializedOrigin = origin;
+}
+
+/*
+========================
+idSoundEmitterLocal::Update
+========================
+*/
+void idSoundEmitterLocal::Update( int currentTime )
+{
+	if( channels.Num() == 0 )
+	{
+		return;
+	}
+
+	float maxDistance = 0.0f;
+	int soundInArea = -1;
+	const bool audible = CheckAudible( maxDistance, soundInArea );
+
+	spatializedDistance = directDistance;
+	spatializedOrigin = origin;
+
+	// Initialize all channels to silence
+	for( int i = 0; i < channels.Num(); i++ )
+	{
+		channels[i]->volumeDB = DB_SILENCE;
+	}
+
+	if( !audible )
+	{
+		return;
+	}
+
+	if( soundInArea != -1 )
+	{
+		// usually already traced by idSoundWorldLocal::ResolveEmitterPortals
+		if( !PortalCacheValid( soundInArea, maxDistance ) )
+		{
+			ResolvePortalPath( soundInArea, maxDistance );
+		}
+
+		if( portalCache.retraced )
+		{
+			soundWorld->portalCacheMisses++;
+			portalCache.retraced = false;
+		}
+		else
+		{
+			soundWorld->portalCacheHits++;
+		}
+
+		ApplyPortalPath( maxDistance );
+	}
 
 	for( int j = 0; j < channels.Num(); j++ )
 	{
@@ -191,9 +191,11 @@ class idSoundDecoder_Vorbis
 {
 public:
 	idSoundDecoder_Vorbis();
-	~idSoundDecoder_Vorbis();
+	virtual						~idSoundDecoder_Vorbis();
 
 	virtual bool				Open( const char* fileName );
+	// decodes from a compressed file that is already in memory, data must outlive the decoder
+	virtual bool				Open( const char* fileName, const byte* data, int dataSize );
 	virtual bool				IsEOS( void );
 	virtual void				Seek( int samplePos );
 	virtual int					Read( void* buffer, int bufferSize );
@@ -202,11 +204,51 @@ public:
 	virtual void				GetFormat( idWaveFile::waveFmt_t& format );
 
 private:
+	bool						OpenFile( idFile* file );
+	void						Close();
+
 	idSoundSample* sample;
 	OggVorbis_File* vorbisFile;
 	idFile* mhmmio;
 };
 
+//------------------------
+// Stream buffer contexts
+//------------------------
+struct soundBufferContext_t
+{
+	soundBufferContext_t() :
+		voice( NULL ),
+		sample( NULL ),
+		bufferNumber( 0 ),
+		pcm( NULL ),
+		pcmBytes( 0 ),
+		queued( false )
+	{ }
+
+#if defined(USE_OPENAL)
+	idSoundVoice_OpenAL* 	voice;
+	idSoundSample_OpenAL*	sample;
+#elif defined(_MSC_VER) // XAudio backend
+	// DG: because the inheritance is kinda strange (idSoundVoice is derived
+	// from idSoundVoice_XAudio2), casting the latter to the former isn't possible
+	// so we need this ugly #ifdef ..
+	idSoundVoice_XAudio2* 	voice;
+	idSoundSample_XAudio2* sample;
+#else // not _MSC_VER
+	// from stub or something..
+	idSoundVoice* 	voice;
+	idSoundSample* sample;
+#endif // _MSC_VER ; DG end
+
+	int bufferNumber;
+
+	// PCM decoded by the stream thread for a streaming OpenAL voice
+	byte*	pcm;
+	int		pcmBytes;		// 0 until the stream thread filled it
+	bool	queued;			// handed to the OpenAL source, refilled once processed
+};
+
 //------------------------
 // Listener data
 //------------------------
@@ -357,6 +399,9 @@ public:
 	void			Update();
 	void			OnReloadSound( const idDecl* decl );
 
+	// traces the portal paths of all emitters with a stale cache as one parallel batch
+	void			ResolveEmitterPortals();
+
 	idSoundChannel* 	AllocSoundChannel();
 	void				FreeSoundChannel( idSoundChannel* );
 
@@ -388,6 +433,18 @@ public:
 	float					slowmoSpeed;
 	bool					enviroSuitActive;
 
+	struct portalResolve_t
+	{
+		idSoundEmitterLocal*	emitter;
+		int						soundArea;
+		float					maxDistance;
+	};
+
+	idParallelJobList* 		portalJobList;
+	idList<portalResolve_t, TAG_AUDIO>	portalResolves;
+	int						portalCacheHits;		// emitter portal paths reused this update
+	int						portalCacheMisses;		// emitter portal paths traced this update
+
 public:
 	struct soundPortalTrace_t
 	{
@@ -438,6 +495,14 @@ public:
 	void			Update( int currentTime );
 	void			OnReloadSound( const idDecl* decl );
 
+	// Returns false if nothing on this emitter can be heard. soundArea is the area the portal
+	// search has to start from, or -1 if the sound reaches the listener directly.
+	bool			CheckAudible( float& maxDistance, int& soundArea );
+
+	bool			PortalCacheValid( int soundArea, float maxDistance ) const;
+	void			ResolvePortalPath( int soundArea, float maxDistance );
+	void			ApplyPortalPath( float maxDistance );
+
 	//----------------------------------------------
 
 	idSoundWorldLocal* 		soundWorld;						// the world that holds this emitter
@@ -459,6 +524,23 @@ public:
 	float		spatializedDistance;
 	idVec3		spatializedOrigin;
 
+	//----- portal path from the emitter to the listener area, set by ResolvePortalPath -----
+	struct portalCache_t
+	{
+		bool		valid;
+		bool		retraced;				// traced again since the last Update
+		bool		pathFound;				// false if no open path is shorter than maxDistance
+		int			soundArea;
+		int			listenerArea;
+		int			portalStateCount;		// idRenderWorld::PortalStateChangeCount() when traced
+		float		maxDistance;			// in meters
+		idVec3		origin;					// emitter origin the path was traced from
+		idVec3		listenerPos;			// listener position the path was traced towards
+		idVec3		virtualOrigin;			// point on the last portal into the listener area
+		float		pathDistance;			// from origin to virtualOrigin, including door penalties
+	};
+	portalCache_t	portalCache;
+
 	// sound emitters are only allocated by the soundWorld block allocator
 	idSoundEmitterLocal();
 	virtual			~idSoundEmitterLocal();
@@ -560,31 +642,7 @@ public:
 
 	virtual void			Preload( idPreloadManifest& preload );
 
-	struct bufferContext_t
-	{
-		bufferContext_t() :
-			voice( NULL ),
-			sample( NULL ),
-			bufferNumber( 0 )
-		{ }
-
-#if defined(USE_OPENAL)
-		idSoundVoice_OpenAL* 	voice;
-		idSoundSample_OpenAL*	sample;
-#elif defined(_MSC_VER) // XAudio backend
-		// DG: because the inheritance is kinda strange (idSoundVoice is derived
-		// from idSoundVoice_XAudio2), casting the latter to the former isn't possible
-		// so we need this ugly #ifdef ..
-		idSoundVoice_XAudio2* 	voice;
-		idSoundSample_XAudio2* sample;
-#else // not _MSC_VER
-		// from stub or something..
-		idSoundVoice* 	voice;
-		idSoundSample* sample;
-#endif // _MSC_VER ; DG end
-
-		int bufferNumber;
-	};
+	typedef soundBufferContext_t bufferContext_t;
 
 	// Get a stream buffer from the free pool, returns NULL if none are available
 	bufferContext_t* 			ObtainStreamBufferContext();
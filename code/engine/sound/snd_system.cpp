@@ -95,14 +95,27 @@ ListSamples_f
 void ListSamples_f( const idCmdArgs& args )
 {
 	idLib::Printf( "Sound samples\n-------------\n" );
+	idLib::Printf( "resident decoded type\n" );
 	int totSize = 0;
+	int totDecoded = 0;
+	int numStreamed = 0;
 	for( int i = 0; i < soundSystemLocal.samples.Num(); i++ )
 	{
-		idLib::Printf( "%05dkb\t%s\n", soundSystemLocal.samples[ i ]->BufferSize() / 1024, soundSystemLocal.samples[ i ]->GetName() );
-		totSize += soundSystemLocal.samples[ i ]->BufferSize();
+		const idSoundSample* sample = soundSystemLocal.samples[ i ];
+		const bool streamed = sample->IsStreamed();
+		const int resident = streamed ? sample->CompressedSize() : sample->BufferSize();
+		idLib::Printf( "%05dkb  %05dkb  %s\t%s\n", resident / 1024, sample->DecodedSize() / 1024, streamed ? "stream" : "pcm   ", sample->GetName() );
+		totSize += resident;
+		totDecoded += sample->DecodedSize();
+		if( streamed )
+		{
+			numStreamed++;
+		}
 	}
 	idLib::Printf( "--------------------------\n" );
 	idLib::Printf( "%05dkb total size\n", totSize / 1024 );
+	idLib::Printf( "%05dkb total if fully decoded\n", totDecoded / 1024 );
+	idLib::Printf( "%i of %i samples streamed\n", numStreamed, soundSystemLocal.samples.Num() );
 }
 
 /*
@@ -206,6 +219,13 @@ idSoundSystemLocal::FreeStreamBuffers
 void idSoundSystemLocal::FreeStreamBuffers()
 {
 	streamBufferMutex.Lock();
+	for( int i = 0; i < bufferContexts.Num(); i++ )
+	{
+		Mem_Free( bufferContexts[ i ].pcm );
+		bufferContexts[ i ].pcm = NULL;
+		bufferContexts[ i ].pcmBytes = 0;
+		bufferContexts[ i ].queued = false;
+	}
 	bufferContexts.Clear();
 	freeStreamBufferContexts.Clear();
 	activeStreamBufferContexts.Clear();
@@ -44,6 +44,23 @@ idCVar s_doorDistanceAdd( "s_doorDistanceAdd", "150", CVAR_FLOAT, "reduce sound
 idCVar s_drawSounds( "s_drawSounds", "0", CVAR_INTEGER, "", 0, 2, idCmdSystem::ArgCompletion_Integer<0, 2> );
 idCVar s_showVoices( "s_showVoices", "0", CVAR_BOOL, "show active voices" );
 idCVar s_volume_dB( "s_volume_dB", "0", CVAR_ARCHIVE | CVAR_FLOAT, "volume in dB" );
+idCVar s_useParallelPortals( "s_useParallelPortals", "1", CVAR_BOOL, "trace the occlusion portal paths of all emitters as one parallel batch" );
+
+extern idCVar s_useOcclusion;
+
+static const int MAX_PORTAL_JOBS = 256;
+
+/*
+========================
+ResolvePortalPathJob
+========================
+*/
+static void ResolvePortalPathJob( idSoundWorldLocal::portalResolve_t* resolve )
+{
+	resolve->emitter->ResolvePortalPath( resolve->soundArea, resolve->maxDistance );
+}
+
+REGISTER_PARALLEL_JOB( ResolvePortalPathJob, "ResolvePortalPathJob" );
 
 /*
 ========================
@@ -76,6 +93,10 @@ idSoundWorldLocal::idSoundWorldLocal()
 
 	slowmoSpeed = 1.0f;
 	enviroSuitActive = false;
+
+	portalJobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, MAX_PORTAL_JOBS, 0, NULL );
+	portalCacheHits = 0;
+	portalCacheMisses = 0;
 }
 
 /*
@@ -104,6 +125,9 @@ idSoundWorldLocal::~idSoundWorldLocal()
 	emitterAllocator.Shutdown();
 	channelAllocator.Shutdown();
 
+	parallelJobManager->FreeJobList( portalJobList );
+	portalJobList = NULL;
+
 	renderWorld = NULL;
 	localSound = NULL;
 }
@@ -324,6 +348,10 @@ void idSoundWorldLocal::Update()
 	int	totalHardwareChannels = 0;
 	int	totalEmitterChannels = 0;
 
+	portalCacheHits = 0;
+	portalCacheMisses = 0;
+	ResolveEmitterPortals();
+
 	int currentTime = GetSoundTime();
 	for( int e = emitters.Num() - 1; e >= 0; e-- )
 	{
@@ -482,6 +510,9 @@ void idSoundWorldLocal::Update()
 
 	if( s_drawSounds.GetBool() && renderWorld != NULL )
 	{
+		static idOverlayHandle portalHandle;
+		console->PrintOverlay( portalHandle, JUSTIFY_LEFT, "portal paths: %i cached %i traced\n", portalCacheHits, portalCacheMisses );
+
 		for( int e = 0; e < emitters.Num(); e++ )
 		{
 			idSoundEmitterLocal* emitter = emitters[e];
@@ -708,13 +739,69 @@ int idSoundWorldLocal::GetSoundTime()
 	}
 }
 
+/*
+========================
+idSoundWorldLocal::ResolveEmitterPortals
+
+Every emitter that needs a new portal path gets traced on the job threads before
+the emitters are updated, idSoundEmitterLocal::Update then finds a valid cache.
+Emitters that don't fit in the batch are traced in Update as before.
+========================
+*/
+void idSoundWorldLocal::ResolveEmitterPortals()
+{
+	if( !s_useParallelPortals.GetBool() || !s_useOcclusion.GetBool() || renderWorld == NULL )
+	{
+		return;
+	}
+
+	portalResolves.SetNum( 0 );
+	for( int e = 0; e < emitters.Num() && portalResolves.Num() < MAX_PORTAL_JOBS; e++ )
+	{
+		idSoundEmitterLocal* emitter = emitters[e];
+		if( emitter->channels.Num() == 0 )
+		{
+			continue;
+		}
+
+		float maxDistance = 0.0f;
+		int soundArea = -1;
+		if( !emitter->CheckAudible( maxDistance, soundArea ) || soundArea == -1 )
+		{
+			continue;
+		}
+		if( emitter->PortalCacheValid( soundArea, maxDistance ) )
+		{
+			continue;
+		}
+
+		portalResolve_t& resolve = portalResolves.Alloc();
+		resolve.emitter = emitter;
+		resolve.soundArea = soundArea;
+		resolve.maxDistance = maxDistance;
+	}
+
+	// not worth waking the job threads for a single trace
+	if( portalResolves.Num() < 2 )
+	{
+		return;
+	}
+
+	for( int i = 0; i < portalResolves.Num(); i++ )
+	{
+		portalJobList->AddJob( ( jobRun_t )ResolvePortalPathJob, &portalResolves[i] );
+	}
+	portalJobList->Submit();
+	portalJobList->Wait();
+}
+
 /*
 ===================
 idSoundWorldLocal::ResolveOrigin
 
 Find out of the sound is completely occluded by a closed door portal, or
 the virtual sound origin position at the portal closest to the listener.
-  this is called by the main thread
+  this is called by the main thread, or by the portal jobs with a different def each
 
 dist is the distance from the orignial sound origin to the current portal that enters soundArea
 def->distance is the distance we are trying to reduce.
@@ -741,6 +828,8 @@ void idSoundWorldLocal::ResolveOrigin( const int stackDepth, const soundPortalTr
 		{
 			def->spatializedDistance = fullDist;
 			def->spatializedOrigin = soundOrigin;
+			def->portalCache.pathFound = true;
+			def->portalCache.pathDistance = dist;
 		}
 		return;
 	}
@@ -173,6 +173,20 @@ public:
 		return totalBufferSize;
 	}
 
+	// only the OpenAL backend streams samples
+	bool			IsStreamed() const
+	{
+		return false;
+	}
+	int				CompressedSize() const
+	{
+		return 0;
+	}
+	int				DecodedSize() const
+	{
+		return totalBufferSize;
+	}
+
 	bool			IsCompressed() const
 	{
 		return ( format.basic.formatTag != idWaveFile::FORMAT_PCM );
@@ -655,6 +655,14 @@ void			Sys_ShowConsole( int visLevel, bool quitOnClose );
 
 
 ID_TIME_T		Sys_FileTimeStamp( idFileHandle fp );
+
+// maps a whole file into memory, pages are read on first access
+// the mapping is copy on write so the data may be patched in place without changing the file
+// returns NULL if the file can't be mapped
+const byte* 	Sys_MapFile( const char* osPath, size_t& length );
+void			Sys_UnmapFile( const byte* data, size_t length );
+// starts reading a range of a mapped file into the page cache without waiting for it
+void			Sys_PrefetchMappedFile( const byte* data, size_t length );
 // NOTE: do we need to guarantee the same output on all platforms?
 const char* 	Sys_TimeStampToStr( ID_TIME_T timeStamp );
 const char* 	Sys_SecToStr( int sec );
@@ -389,6 +389,7 @@ void idGameLocal::Init()
 	botFuzzyWeightManager.Init();
 	botWeaponInfoManager.Init();
 	botGoalManager.BotSetupGoalAI();
+	botScheduler.Init();
 
 	rvRandom::Init();
 // jmarshall end
@@ -436,6 +437,8 @@ void idGameLocal::Shutdown()
 	delete smokeParticles;
 	smokeParticles = NULL;
 
+	botScheduler.Shutdown();
+
 	idClass::Shutdown();
 
 	// clear list with forces
@@ -983,11 +986,22 @@ void idGameLocal::LoadMap( const char* mapName, int randseed )
 			delete mapFile;
 		}
 		mapFile = new( TAG_GAME ) idMapFile;
-		if( !mapFile->Parse( idStr( mapName ) + ".map" ) )
+
+		// the binary entity cache skips parsing the brushes and patches, which only
+		// the collision model manager needs when the .cm file is out of date
+		if( !g_mapEntityCache.GetBool() || !mapFile->LoadEntityCache( idStr( mapName ) + ".map" ) )
 		{
-			delete mapFile;
-			mapFile = NULL;
-			Error( "Couldn't load %s", mapName );
+			if( !mapFile->Parse( idStr( mapName ) + ".map" ) )
+			{
+				delete mapFile;
+				mapFile = NULL;
+				Error( "Couldn't load %s", mapName );
+			}
+
+			if( g_mapEntityCache.GetBool() )
+			{
+				mapFile->WriteEntityCache();
+			}
 		}
 	}
 	mapFileName = mapFile->GetName();
@@ -1773,6 +1787,8 @@ void idGameLocal::MapShutdown()
 		smokeParticles->Shutdown();
 	}
 
+	botScheduler.Clear();
+
 	pvs.Shutdown();
 
 	common->UpdateLevelLoadPacifier();
@@ -1566,6 +1566,9 @@ idGameLocal::RunBotFrame
 */
 void idGameLocal::RunBotFrame( idUserCmdMgr& cmdMgr )
 {
+	// score the goal and weapon weights on the job threads while the entities think
+	botScheduler.BeginFrame();
+
 	for( int i = 0; i < registeredBots.Num(); i++ )
 	{
 		registeredBots[i]->BotInputFrame( cmdMgr );
@@ -38,6 +38,7 @@ idCVar bot_debugnav( "bot_debugnav", "0", CVAR_BOOL | CVAR_CHEAT, "draws navmesh
 idCVar bot_showstate( "bot_showstate", "0", CVAR_BOOL | CVAR_CHEAT, "draws the bot state above the bot" );
 idCVar bot_debug( "bot_debug", "0", CVAR_BOOL, "shows debug info for the bot" );
 idCVar bot_skill( "bot_skill", "3", CVAR_INTEGER, "" );
+idCVar bot_timeThink( "bot_timeThink", "0", CVAR_FLOAT, "when non-zero, shows bots whose think exceeded the # of milliseconds specified" );
 
 CLASS_DECLARATION( idPlayer, iceBot )
 END_CLASS
@@ -61,6 +62,10 @@ iceBot::~iceBot
 */
 iceBot::~iceBot()
 {
+	if( hasSpawned )
+	{
+		botScheduler.UnRegisterBot( entityNumber );
+	}
 	gameLocal.UnRegisterBot( this );
 }
 
@@ -195,6 +200,8 @@ void iceBot::Spawn()
 		bs.setupcount = 4;
 		bs.entergame_time = Bot_Time();
 
+		botScheduler.RegisterBot( entityNumber, bs.gs, bs.ws, bs.inventory );
+
 		hasSpawned = true;
 
 		bs.botinput.respawn = true;
@@ -421,8 +428,17 @@ void iceBot::Think()
 
 	if( common->IsServer() )
 	{
+		const uint64 thinkStart = Sys_Microseconds();
+
 		ServerThink();
 
+		const int thinkMicroSeconds = ( int )( Sys_Microseconds() - thinkStart );
+		botScheduler.AddThinkTime( entityNumber, thinkMicroSeconds );
+		if( bot_timeThink.GetFloat() > 0.0f && thinkMicroSeconds * 0.001f >= bot_timeThink.GetFloat() )
+		{
+			gameLocal.Printf( "%d: bot '%s': %.1f ms\n", gameLocal.time, name.c_str(), thinkMicroSeconds * 0.001f );
+		}
+
 		if( bot_debug.GetBool() )
 		{
 			idVec4 color;
@@ -756,6 +756,7 @@ public:
 #include "Bot_weights.h"
 #include "Bot_weapons.h"
 #include "Bot_goal.h"
+#include "Bot_scheduler.h"
 
 struct bot_state_t
 {
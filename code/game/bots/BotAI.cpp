@@ -105,7 +105,17 @@ void iceBot::BotChooseWeapon( bot_state_t* bs )
 	//	bs->input.weapon = bs->weaponnum;
 	//}
 	//else {
-	newweaponnum = botWeaponInfoManager.BotChooseBestFightWeapon( bs->ws, bs->inventory );
+	if( !botScheduler.AllowDecision( bs->client, BOT_DECISION_WEAPON ) )
+	{
+		return;
+	}
+	// use the weapon scored on the job threads this frame if there is one
+	newweaponnum = botScheduler.GetBestWeapon( bs->client );
+	if( newweaponnum < 0 )
+	{
+		newweaponnum = botWeaponInfoManager.BotChooseBestFightWeapon( bs->ws, bs->inventory );
+	}
+	botScheduler.FinishDecision( bs->client, BOT_DECISION_WEAPON );
 	if( bs->weaponnum != newweaponnum )
 	{
 		bs->weaponchange_time = Bot_Time();
@@ -160,12 +170,17 @@ int iceBot::BotGetItemLongTermGoal( bot_state_t* bs, int tfl, bot_goal_t* goal )
 	//if it is time to find a new long term goal
 	if( bs->ltg_time == 0 )
 	{
+		//keep going for the current goal until the scheduler has time for a new one
+		if( !botScheduler.AllowDecision( bs->client, BOT_DECISION_GOAL ) )
+		{
+			return botGoalManager.BotGetTopGoal( bs->gs, goal );
+		}
 		//pop the current goal from the stack
 		botGoalManager.BotPopGoal( bs->gs );
 		//BotAI_Print(PRT_MESSAGE, "%s: choosing new ltg\n", ClientName(bs->client, netname, sizeof(netname)));
 		//choose a new goal
 		//BotAI_Print(PRT_MESSAGE, "%6.1f client %d: BotChooseLTGItem\n", Bot_Time(), bs->client);
-		if( botGoalManager.BotChooseLTGItem( bs->gs, bs->origin, bs->inventory, tfl ) )
+		if( botGoalManager.BotChooseLTGItem( bs->gs, bs->origin, bs->inventory, tfl, botScheduler.GetItemScores( bs->client ) ) )
 		{
 			char buf[128];
 			//get the goal at the top of the stack
@@ -184,6 +199,7 @@ int iceBot::BotGetItemLongTermGoal( bot_state_t* bs, int tfl, bot_goal_t* goal )
 			botGoalManager.BotResetAvoidGoals( bs->gs );
 			//BotResetAvoidReach(bs->ms);
 		}
+		botScheduler.FinishDecision( bs->client, BOT_DECISION_GOAL );
 		//get the goal at the top of the stack
 		if( !botGoalManager.BotGetTopGoal( bs->gs, goal ) )
 		{
@@ -555,6 +571,12 @@ int iceBot::BotFindEnemy( bot_state_t* bs, int curenemy )
 	//check if the health decreased
 	healthdecrease = bs->lasthealth > bs->inventory[INVENTORY_HEALTH];
 
+	//a bot that gets hurt always looks around, otherwise the sweeps are staggered
+	if( !healthdecrease && !botScheduler.AllowDecision( bs->client, BOT_DECISION_ENEMY ) )
+	{
+		return false;
+	}
+
 	//remember the current health value
 	bs->lasthealth = bs->inventory[INVENTORY_HEALTH];
 	//
@@ -708,8 +730,10 @@ int iceBot::BotFindEnemy( bot_state_t* bs, int curenemy )
 		bs->enemysuicide = false;
 		bs->enemydeath_time = 0;
 		bs->enemyvisible_time = Bot_Time();
+		botScheduler.FinishDecision( bs->client, BOT_DECISION_ENEMY );
 		return true;
 	}
+	botScheduler.FinishDecision( bs->client, BOT_DECISION_ENEMY );
 	return false;
 }
 
@@ -1153,7 +1177,7 @@ int iceBot::BotNearbyGoal( bot_state_t* bs, int tfl, bot_goal_t* ltg, float rang
 	// jmarshall end
 
 	//
-	ret = botGoalManager.BotChooseNBGItem( bs->gs, bs->origin, bs->inventory, tfl, ltg, range );
+	ret = botGoalManager.BotChooseNBGItem( bs->gs, bs->origin, bs->inventory, tfl, ltg, range, botScheduler.GetItemScores( bs->client ) );
 
 	return ret;
 }
@@ -1372,14 +1372,126 @@ int idBotGoalManager::BotGetSecondGoal( int goalstate, bot_goal_t* goal )
 	return true;
 }
 
+/*
+====================
+idBotGoalManager::BotLevelItemWeight
+
+Returns the fuzzy weight of a level item for the goal state before the travel
+time is taken into account, zero if the bot should not go for the item.
+====================
+*/
+float idBotGoalManager::BotLevelItemWeight( bot_goalstate_t* gs, levelitem_t* li, int* inventory, const botItemScores_t* scores )
+{
+	int weightnum;
+	float weight;
+	iteminfo_t* iteminfo;
+
+	//use the weight scored for this frame if there is one
+	const int index = li - levelitemheap;
+	if( scores && scores->framenum == gameLocal.framenum && scores->numbers[index] == li->number )
+	{
+		return scores->weights[index];
+	}
+
+	if( gameLocal.gameType == GAME_SP )
+	{
+		if( li->flags & IFL_NOTSINGLE )
+		{
+			return 0;
+		}
+	}
+	else if( gameLocal.gameType >= GAME_TDM )
+	{
+		if( li->flags & IFL_NOTTEAM )
+		{
+			return 0;
+		}
+	}
+	else
+	{
+		if( li->flags & IFL_NOTFREE )
+		{
+			return 0;
+		}
+	}
+	if( li->flags & IFL_NOTBOT )
+	{
+		return 0;
+	}
+	//FIXME: is this a good thing? added this for items that never spawned into the game (f.i. CTF flags in obelisk)
+	if( !li->item && !( li->flags & IFL_ROAM ) )
+	{
+		return 0;
+	}
+	//get the fuzzy weight function for this item
+	iteminfo = &itemconfig->iteminfo[li->iteminfo];
+	weightnum = gs->itemweightindex[iteminfo->number];
+	if( weightnum < 0 )
+	{
+		return 0;
+	}
+
+#ifdef UNDECIDEDFUZZY
+	weight = FuzzyWeightUndecided( inventory, gs->itemweightconfig, weightnum );
+#else
+	weight = botFuzzyWeightManager.FuzzyWeight( inventory, gs->itemweightconfig, weightnum );
+#endif //UNDECIDEDFUZZY
+#ifdef DROPPEDWEIGHT
+	//HACK: to make dropped items more attractive
+	if( li->timeout )
+	{
+		weight += bot_droppedweight.GetFloat();
+	}
+#endif //DROPPEDWEIGHT
+	//use weight scale for item_botroam
+	if( li->flags & IFL_ROAM )
+	{
+		weight *= li->weight;
+	}
+	return weight;
+}
+
+/*
+====================
+idBotGoalManager::BotScoreLevelItems
+====================
+*/
+void idBotGoalManager::BotScoreLevelItems( int goalstate, int* inventory, botItemScores_t* scores )
+{
+	bot_goalstate_t* gs;
+	levelitem_t* li;
+
+	scores->framenum = -1;
+
+	gs = BotGoalStateFromHandle( goalstate );
+	if( !gs || !gs->itemweightconfig || !itemconfig )
+	{
+		return;
+	}
+
+	for( int i = 0; i < MAX_BOT_LEVEL_ITEMS; i++ )
+	{
+		scores->numbers[i] = -1;
+	}
+
+	for( li = levelitems; li; li = li->next )
+	{
+		const int index = li - levelitemheap;
+		scores->weights[index] = BotLevelItemWeight( gs, li, inventory, NULL );
+		scores->numbers[index] = li->number;
+	}
+
+	scores->framenum = gameLocal.framenum;
+}
+
 /*
 ====================
 idBotGoalManager::BotChooseLTGItem
 ====================
 */
-int idBotGoalManager::BotChooseLTGItem( int goalstate, idVec3 origin, int* inventory, int travelflags )
+int idBotGoalManager::BotChooseLTGItem( int goalstate, idVec3 origin, int* inventory, int travelflags, const botItemScores_t* scores )
 {
-	int t, weightnum;
+	int t;
 	float weight, bestweight, avoidtime;
 	iteminfo_t* iteminfo;
 	itemconfig_t* ic;
@@ -1423,64 +1535,7 @@ int idBotGoalManager::BotChooseLTGItem( int goalstate, idVec3 origin, int* inven
 	//go through the items in the level
 	for( li = levelitems; li; li = li->next )
 	{
-		if( gameLocal.gameType == GAME_SP )
-		{
-			if( li->flags & IFL_NOTSINGLE )
-			{
-				continue;
-			}
-		}
-		else if( gameLocal.gameType >= GAME_TDM )
-		{
-			if( li->flags & IFL_NOTTEAM )
-			{
-				continue;
-			}
-		}
-		else
-		{
-			if( li->flags & IFL_NOTFREE )
-			{
-				continue;
-			}
-		}
-		if( li->flags & IFL_NOTBOT )
-		{
-			continue;
-		}
-		//if the item is not in a possible goal area
-		//if (!li->goalareanum)
-		//	continue;
-		//FIXME: is this a good thing? added this for items that never spawned into the game (f.i. CTF flags in obelisk)
-		if( !li->item && !( li->flags & IFL_ROAM ) )
-		{
-			continue;
-		}
-		//get the fuzzy weight function for this item
-		iteminfo = &ic->iteminfo[li->iteminfo];
-		weightnum = gs->itemweightindex[iteminfo->number];
-		if( weightnum < 0 )
-		{
-			continue;
-		}
-
-#ifdef UNDECIDEDFUZZY
-		weight = FuzzyWeightUndecided( inventory, gs->itemweightconfig, weightnum );
-#else
-		weight = botFuzzyWeightManager.FuzzyWeight( inventory, gs->itemweightconfig, weightnum );
-#endif //UNDECIDEDFUZZY
-#ifdef DROPPEDWEIGHT
-		//HACK: to make dropped items more attractive
-		if( li->timeout )
-		{
-			weight += bot_droppedweight.GetFloat();    //GetValueFromLibVar(droppedweight);
-		}
-#endif //DROPPEDWEIGHT
-		//use weight scale for item_botroam
-		if( li->flags & IFL_ROAM )
-		{
-			weight *= li->weight;
-		}
+		weight = BotLevelItemWeight( gs, li, inventory, scores );
 		//
 		if( weight > 0 )
 		{
@@ -1589,9 +1644,9 @@ int idBotGoalManager::BotChooseLTGItem( int goalstate, idVec3 origin, int* inven
 idBotGoalManager::BotChooseNBGItem
 ====================
 */
-int idBotGoalManager::BotChooseNBGItem( int goalstate, idVec3 origin, int* inventory, int travelflags, bot_goal_t* ltg, float maxtime )
+int idBotGoalManager::BotChooseNBGItem( int goalstate, idVec3 origin, int* inventory, int travelflags, bot_goal_t* ltg, float maxtime, const botItemScores_t* scores )
 {
-	int areanum, t, weightnum, ltg_time;
+	int areanum, t, ltg_time;
 	float weight, bestweight, avoidtime;
 	iteminfo_t* iteminfo;
 	itemconfig_t* ic;
@@ -1649,64 +1704,7 @@ int idBotGoalManager::BotChooseNBGItem( int goalstate, idVec3 origin, int* inven
 	//go through the items in the level
 	for( li = levelitems; li; li = li->next )
 	{
-		if( gameLocal.gameType == GAME_SP )
-		{
-			if( li->flags & IFL_NOTSINGLE )
-			{
-				continue;
-			}
-		}
-		else if( gameLocal.gameType >= GAME_TDM )
-		{
-			if( li->flags & IFL_NOTTEAM )
-			{
-				continue;
-			}
-		}
-		else
-		{
-			if( li->flags & IFL_NOTFREE )
-			{
-				continue;
-			}
-		}
-		if( li->flags & IFL_NOTBOT )
-		{
-			continue;
-		}
-		//if the item is in a possible goal area
-//		if (!li->goalareanum)
-//			continue;
-		//FIXME: is this a good thing? added this for items that never spawned into the game (f.i. CTF flags in obelisk)
-		if( !li->item && !( li->flags & IFL_ROAM ) )
-		{
-			continue;
-		}
-		//get the fuzzy weight function for this item
-		iteminfo = &ic->iteminfo[li->iteminfo];
-		weightnum = gs->itemweightindex[iteminfo->number];
-		if( weightnum < 0 )
-		{
-			continue;
-		}
-		//
-#ifdef UNDECIDEDFUZZY
-		weight = FuzzyWeightUndecided( inventory, gs->itemweightconfig, weightnum );
-#else
-		weight = botFuzzyWeightManager.FuzzyWeight( inventory, gs->itemweightconfig, weightnum );
-#endif //UNDECIDEDFUZZY
-#ifdef DROPPEDWEIGHT
-		//HACK: to make dropped items more attractive
-		if( li->timeout )
-		{
-			weight += bot_droppedweight.GetFloat();
-		}
-#endif //DROPPEDWEIGHT
-		//use weight scale for item_botroam
-		if( li->flags & IFL_ROAM )
-		{
-			weight *= li->weight;
-		}
+		weight = BotLevelItemWeight( gs, li, inventory, scores );
 		//
 		if( weight > 0 )
 		{
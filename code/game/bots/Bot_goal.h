@@ -278,6 +278,14 @@ struct bot_goalstate_t
 	float avoidgoaltimes[MAX_AVOIDGOALS];		//times to avoid the goals
 };
 
+//fuzzy item weights of one bot, scored ahead of the goal choice
+struct botItemScores_t
+{
+	int framenum;								//game frame the weights were scored in, -1 if none
+	int numbers[MAX_BOT_LEVEL_ITEMS];			//level item number of each weight, indexed like the level item heap
+	float weights[MAX_BOT_LEVEL_ITEMS];			//fuzzy weight without the travel time
+};
+
 class idBotGoalManager
 {
 public:
@@ -297,8 +305,12 @@ public:
 
 	int BotItemGoalInVisButNotVisible( int viewer, idVec3 eye, idAngles viewangles, bot_goal_t* goal );
 
-	int BotChooseLTGItem( int goalstate, idVec3 origin, int* inventory, int travelflags );
-	int BotChooseNBGItem( int goalstate, idVec3 origin, int* inventory, int travelflags, bot_goal_t* ltg, float maxtime );
+	// scores is optional, weights scored for this frame are used instead of evaluating the fuzzy logic again
+	int BotChooseLTGItem( int goalstate, idVec3 origin, int* inventory, int travelflags, const botItemScores_t* scores = NULL );
+	int BotChooseNBGItem( int goalstate, idVec3 origin, int* inventory, int travelflags, bot_goal_t* ltg, float maxtime, const botItemScores_t* scores = NULL );
+
+	// evaluates the item weights of a goal state without touching the AAS, safe to call from a job
+	void BotScoreLevelItems( int goalstate, int* inventory, botItemScores_t* scores );
 
 	int BotTouchingGoal( idVec3 origin, bot_goal_t* goal );
 
@@ -345,6 +357,7 @@ private:
 	void BotMutateGoalFuzzyLogic( int goalstate, float range );
 	bot_goalstate_t* BotGoalStateFromHandle( int handle );
 	void BotInterbreedGoalFuzzyLogic( int parent1, int parent2, int child );
+	float BotLevelItemWeight( bot_goalstate_t* gs, levelitem_t* li, int* inventory, const botItemScores_t* scores );
 private:
 	void ParseItemInfo( idParser& parser, iteminfo_t* itemInfo );
 private:
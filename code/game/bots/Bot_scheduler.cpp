@@ -0,0 +1,370 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+Copyright (C) 2021 Justin Marshall
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "precompiled.h"
+#pragma hdrstop
+
+#include "../Game_local.h"
+
+idCVar bot_thinkBudget( "bot_thinkBudget", "2", CVAR_GAME | CVAR_FLOAT, "milliseconds per game frame all bots together may spend on goal, weapon and enemy decisions" );
+idCVar bot_goalInterval( "bot_goalInterval", "200", CVAR_GAME | CVAR_INTEGER, "minimum milliseconds between two long term goal choices of a bot" );
+idCVar bot_weaponInterval( "bot_weaponInterval", "250", CVAR_GAME | CVAR_INTEGER, "minimum milliseconds between two weapon choices of a bot" );
+idCVar bot_enemyInterval( "bot_enemyInterval", "100", CVAR_GAME | CVAR_INTEGER, "minimum milliseconds between two enemy searches of a bot" );
+idCVar bot_maxDecisionDelay( "bot_maxDecisionDelay", "500", CVAR_GAME | CVAR_INTEGER, "milliseconds a decision may be deferred by the budget before it is made anyway" );
+idCVar bot_parallelScoring( "bot_parallelScoring", "1", CVAR_GAME | CVAR_BOOL, "score the bot item and weapon weights on job threads" );
+idCVar bot_schedulerStats( "bot_schedulerStats", "0", CVAR_GAME | CVAR_BOOL, "prints bot scheduler statistics for each game frame" );
+
+idBotScheduler botScheduler;
+
+/*
+============
+BotScoreJob
+============
+*/
+static void BotScoreJob( botSchedule_t* schedule )
+{
+	if( schedule->scoreItems )
+	{
+		botGoalManager.BotScoreLevelItems( schedule->gs, schedule->inventory, &schedule->itemScores );
+	}
+	if( schedule->scoreWeapon )
+	{
+		schedule->bestWeapon = botWeaponInfoManager.BotChooseBestFightWeapon( schedule->ws, schedule->inventory );
+	}
+}
+
+REGISTER_PARALLEL_JOB( BotScoreJob, "BotScoreJob" );
+
+/*
+============
+idBotScheduler::idBotScheduler
+============
+*/
+idBotScheduler::idBotScheduler()
+{
+	jobList = NULL;
+	jobsSubmitted = false;
+	Clear();
+}
+
+/*
+============
+idBotScheduler::Init
+============
+*/
+void idBotScheduler::Init()
+{
+	jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, MAX_CLIENTS, 0, NULL );
+	jobsSubmitted = false;
+}
+
+/*
+============
+idBotScheduler::Shutdown
+============
+*/
+void idBotScheduler::Shutdown()
+{
+	WaitForScores();
+	if( jobList != NULL )
+	{
+		parallelJobManager->FreeJobList( jobList );
+		jobList = NULL;
+	}
+}
+
+/*
+============
+idBotScheduler::Clear
+============
+*/
+void idBotScheduler::Clear()
+{
+	WaitForScores();
+
+	for( int i = 0; i < MAX_CLIENTS; i++ )
+	{
+		UnRegisterBot( i );
+	}
+	frameDecisionMicroSeconds = 0;
+	frameThinkMicroSeconds = 0;
+	numBots = 0;
+	numScored = 0;
+	numDecisions = 0;
+	numDeferred = 0;
+}
+
+/*
+============
+idBotScheduler::RegisterBot
+============
+*/
+void idBotScheduler::RegisterBot( int client, int gs, int ws, const int* inventory )
+{
+	WaitForScores();
+
+	botSchedule_t& schedule = schedules[client];
+	schedule.gs = gs;
+	schedule.ws = ws;
+	schedule.botInventory = inventory;
+	for( int i = 0; i < BOT_DECISION_MAX; i++ )
+	{
+		schedule.nextDecisionTime[i] = 0;
+		schedule.deferredTime[i] = -1;
+	}
+	schedule.decisionStart = 0;
+	schedule.scoreItems = false;
+	schedule.scoreWeapon = false;
+	schedule.itemScores.framenum = -1;
+	schedule.bestWeapon = 0;
+	schedule.weaponFrame = -1;
+	schedule.thinkMicroSeconds = 0;
+	schedule.numDecisions = 0;
+	schedule.numDeferred = 0;
+}
+
+/*
+============
+idBotScheduler::UnRegisterBot
+============
+*/
+void idBotScheduler::UnRegisterBot( int client )
+{
+	RegisterBot( client, 0, 0, NULL );
+}
+
+/*
+============
+idBotScheduler::WaitForScores
+============
+*/
+void idBotScheduler::WaitForScores()
+{
+	if( jobsSubmitted )
+	{
+		jobList->Wait();
+		jobsSubmitted = false;
+	}
+}
+
+/*
+============
+idBotScheduler::BeginFrame
+============
+*/
+void idBotScheduler::BeginFrame()
+{
+	WaitForScores();
+
+	if( bot_schedulerStats.GetBool() )
+	{
+		PrintStats();
+	}
+
+	frameDecisionMicroSeconds = 0;
+	frameThinkMicroSeconds = 0;
+	numBots = 0;
+	numScored = 0;
+	numDecisions = 0;
+	numDeferred = 0;
+
+	for( int i = 0; i < MAX_CLIENTS; i++ )
+	{
+		botSchedule_t& schedule = schedules[i];
+		if( schedule.gs == 0 )
+		{
+			continue;
+		}
+
+		schedule.thinkMicroSeconds = 0;
+		schedule.numDecisions = 0;
+		schedule.numDeferred = 0;
+		numBots++;
+
+		if( !bot_parallelScoring.GetBool() )
+		{
+			continue;
+		}
+
+		// score ahead for the decisions the bot is waiting on or that become due this frame
+		schedule.scoreItems = ( schedule.deferredTime[BOT_DECISION_GOAL] != -1 || schedule.nextDecisionTime[BOT_DECISION_GOAL] <= gameLocal.time );
+		schedule.scoreWeapon = ( schedule.nextDecisionTime[BOT_DECISION_WEAPON] <= gameLocal.time );
+		if( !schedule.scoreItems && !schedule.scoreWeapon )
+		{
+			continue;
+		}
+
+		// the bot updates its inventory while thinking, the jobs work on a copy taken
+		// before that, so an item picked up in this frame is only weighed in the next
+		memcpy( schedule.inventory, schedule.botInventory, sizeof( schedule.inventory ) );
+		schedule.weaponFrame = schedule.scoreWeapon ? gameLocal.framenum : -1;
+
+		jobList->AddJob( ( jobRun_t )BotScoreJob, &schedule );
+		numScored++;
+	}
+
+	if( numScored > 0 )
+	{
+		jobList->Submit();
+		jobsSubmitted = true;
+	}
+}
+
+/*
+============
+idBotScheduler::AllowDecision
+============
+*/
+bool idBotScheduler::AllowDecision( int client, botDecision_t decision )
+{
+	botSchedule_t& schedule = schedules[client];
+
+	if( schedule.gs == 0 )
+	{
+		return true;
+	}
+
+	if( gameLocal.time < schedule.nextDecisionTime[decision] )
+	{
+		return false;
+	}
+
+	// over the budget, wait for a later frame unless the bot has been waiting too long already
+	const bool overBudget = frameDecisionMicroSeconds >= bot_thinkBudget.GetFloat() * 1000.0f;
+	const bool waitedTooLong = schedule.deferredTime[decision] != -1 && gameLocal.time - schedule.deferredTime[decision] >= bot_maxDecisionDelay.GetInteger();
+	if( overBudget && !waitedTooLong )
+	{
+		if( schedule.deferredTime[decision] == -1 )
+		{
+			schedule.deferredTime[decision] = gameLocal.time;
+		}
+		schedule.numDeferred++;
+		numDeferred++;
+		return false;
+	}
+
+	int interval;
+	switch( decision )
+	{
+		case BOT_DECISION_GOAL:
+			interval = bot_goalInterval.GetInteger();
+			break;
+		case BOT_DECISION_WEAPON:
+			interval = bot_weaponInterval.GetInteger();
+			break;
+		default:
+			interval = bot_enemyInterval.GetInteger();
+			break;
+	}
+
+	schedule.nextDecisionTime[decision] = gameLocal.time + interval;
+	schedule.deferredTime[decision] = -1;
+	schedule.decisionStart = Sys_Microseconds();
+	schedule.numDecisions++;
+	numDecisions++;
+	return true;
+}
+
+/*
+============
+idBotScheduler::FinishDecision
+============
+*/
+void idBotScheduler::FinishDecision( int client, botDecision_t decision )
+{
+	botSchedule_t& schedule = schedules[client];
+
+	// decisions made without asking the scheduler don't count against the budget
+	if( schedule.gs == 0 || schedule.decisionStart == 0 )
+	{
+		return;
+	}
+	frameDecisionMicroSeconds += ( int )( Sys_Microseconds() - schedule.decisionStart );
+	schedule.decisionStart = 0;
+}
+
+/*
+============
+idBotScheduler::GetItemScores
+============
+*/
+const botItemScores_t* idBotScheduler::GetItemScores( int client )
+{
+	WaitForScores();
+
+	const botSchedule_t& schedule = schedules[client];
+	if( schedule.gs == 0 || schedule.itemScores.framenum != gameLocal.framenum )
+	{
+		return NULL;
+	}
+	return &schedule.itemScores;
+}
+
+/*
+============
+idBotScheduler::GetBestWeapon
+============
+*/
+int idBotScheduler::GetBestWeapon( int client )
+{
+	WaitForScores();
+
+	const botSchedule_t& schedule = schedules[client];
+	if( schedule.gs == 0 || schedule.weaponFrame != gameLocal.framenum )
+	{
+		return -1;
+	}
+	return schedule.bestWeapon;
+}
+
+/*
+============
+idBotScheduler::AddThinkTime
+============
+*/
+void idBotScheduler::AddThinkTime( int client, int microSeconds )
+{
+	schedules[client].thinkMicroSeconds += microSeconds;
+	frameThinkMicroSeconds += microSeconds;
+}
+
+/*
+============
+idBotScheduler::PrintStats
+============
+*/
+void idBotScheduler::PrintStats()
+{
+	if( numBots == 0 )
+	{
+		return;
+	}
+	gameLocal.Printf( "botScheduler %d: %d bots, %.2f ms think, %.2f ms decisions, %d decisions, %d deferred, %d scored\n",
+					  gameLocal.time, numBots, frameThinkMicroSeconds * 0.001f, frameDecisionMicroSeconds * 0.001f, numDecisions, numDeferred, numScored );
+}
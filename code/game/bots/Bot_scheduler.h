@@ -0,0 +1,129 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+Copyright (C) 2021 Justin Marshall
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#pragma once
+
+/*
+===============================================================================
+
+	Bot scheduler
+
+	Spreads the expensive bot decisions over several game frames. Every
+	decision type has a minimum interval per bot and all bots share a per
+	frame time budget; a decision that doesn't fit is deferred and the bot
+	keeps acting on its previous one. A decision that was deferred for too
+	long is granted regardless of the budget so no bot starves.
+
+	The fuzzy item and weapon weights a bot needs for its next goal or weapon
+	choice only depend on its inventory, they are scored on job threads
+	while the other entities think. The travel times and avoid goals still
+	use the AAS and are evaluated by the bot itself.
+
+	The jobs score the inventory as it was at the start of the frame, before
+	the bot thinks, so the weights can be one frame behind a pickup.
+
+===============================================================================
+*/
+
+enum botDecision_t
+{
+	BOT_DECISION_GOAL,			// long term goal item choice
+	BOT_DECISION_WEAPON,		// fight weapon choice
+	BOT_DECISION_ENEMY,			// visibility sweep over the other clients
+	BOT_DECISION_MAX
+};
+
+struct botSchedule_t
+{
+	int					gs;									// goal state handle of the bot, 0 if the slot is free
+	int					ws;									// weapon state handle of the bot
+	const int* 			botInventory;						// inventory the bot updates while thinking
+	int					nextDecisionTime[BOT_DECISION_MAX];	// earliest game time of the next decision
+	int					deferredTime[BOT_DECISION_MAX];		// game time the decision was first deferred, -1 if not waiting
+	uint64				decisionStart;						// Sys_Microseconds when the granted decision started
+
+	// job input and output
+	bool				scoreItems;
+	bool				scoreWeapon;
+	int					inventory[MAX_BOT_INVENTORY];		// inventory snapshot the jobs score with
+	botItemScores_t		itemScores;
+	int					bestWeapon;
+	int					weaponFrame;						// game frame bestWeapon was scored in, -1 if none
+
+	// stats for the current frame
+	int					thinkMicroSeconds;
+	int					numDecisions;
+	int					numDeferred;
+};
+
+class idBotScheduler
+{
+public:
+	idBotScheduler();
+
+	void				Init();
+	void				Shutdown();
+
+	// forgets all bots and pending jobs, called on map shutdown
+	void				Clear();
+
+	// snapshots the bots that need scores and kicks off the scoring jobs, called before the entities think
+	void				BeginFrame();
+
+	// returns true if the bot may make the decision this frame, the caller calls FinishDecision when done
+	bool				AllowDecision( int client, botDecision_t decision );
+	void				FinishDecision( int client, botDecision_t decision );
+
+	// item weights scored for this frame or NULL, waits for the scoring jobs
+	const botItemScores_t* GetItemScores( int client );
+
+	// weapon scored for this frame or -1, waits for the scoring jobs
+	int					GetBestWeapon( int client );
+
+	void				RegisterBot( int client, int gs, int ws, const int* inventory );
+	void				UnRegisterBot( int client );
+	void				AddThinkTime( int client, int microSeconds );
+
+private:
+	botSchedule_t		schedules[MAX_CLIENTS];
+	idParallelJobList* 	jobList;
+	bool				jobsSubmitted;
+
+	int					frameDecisionMicroSeconds;			// time spent in granted decisions this frame
+	int					frameThinkMicroSeconds;
+	int					numBots;
+	int					numScored;
+	int					numDecisions;
+	int					numDeferred;
+
+	void				WaitForScores();
+	void				PrintStats();
+};
+
+extern idBotScheduler botScheduler;
@@ -659,11 +659,10 @@ void idClass::CancelEvents( const idEventDef* ev )
 idClass::PostEventArgs
 ================
 */
-bool idClass::PostEventArgs( const idEventDef* ev, int time, int numargs, ... )
+bool idClass::PostEventArgs( const idEventDef* ev, int time, int numargs, const idEventArg* const* args )
 {
 	idTypeInfo*	c;
 	idEvent*		event;
-	va_list		args;
 
 	assert( ev );
 
@@ -698,9 +697,7 @@ bool idClass::PostEventArgs( const idEventDef* ev, int time, int numargs, ... )
 		return true;
 	}
 
-	va_start( args, numargs );
 	event = idEvent::Alloc( ev, numargs, args );
-	va_end( args );
 
 	event->Schedule( this, c, time );
 
@@ -714,7 +711,7 @@ idClass::PostEventMS
 */
 bool idClass::PostEventMS( const idEventDef* ev, int time )
 {
-	return PostEventArgs( ev, time, 0 );
+	return PostEventArgs( ev, time, 0, NULL );
 }
 
 /*
@@ -724,7 +721,8 @@ idClass::PostEventMS
 */
 bool idClass::PostEventMS( const idEventDef* ev, int time, idEventArg arg1 )
 {
-	return PostEventArgs( ev, time, 1, &arg1 );
+	const idEventArg* args[ 1 ] = { &arg1 };
+	return PostEventArgs( ev, time, 1, args );
 }
 
 /*
@@ -734,7 +732,8 @@ idClass::PostEventMS
 */
 bool idClass::PostEventMS( const idEventDef* ev, int time, idEventArg arg1, idEventArg arg2 )
 {
-	return PostEventArgs( ev, time, 2, &arg1, &arg2 );
+	const idEventArg* args[ 2 ] = { &arg1, &arg2 };
+	return PostEventArgs( ev, time, 2, args );
 }
 
 /*
@@ -744,7 +743,8 @@ idClass::PostEventMS
 */
 bool idClass::PostEventMS( const idEventDef* ev, int time, idEventArg arg1, idEventArg arg2, idEventArg arg3 )
 {
-	return PostEventArgs( ev, time, 3, &arg1, &arg2, &arg3 );
+	const idEventArg* args[ 3 ] = { &arg1, &arg2, &arg3 };
+	return PostEventArgs( ev, time, 3, args );
 }
 
 /*
@@ -754,7 +754,8 @@ idClass::PostEventMS
 */
 bool idClass::PostEventMS( const idEventDef* ev, int time, idEventArg arg1, idEventArg arg2, idEventArg arg3, idEventArg arg4 )
 {
-	return PostEventArgs( ev, time, 4, &arg1, &arg2, &arg3, &arg4 );
+	const idEventArg* args[ 4 ] = { &arg1, &arg2, &arg3, &arg4 };
+	return PostEventArgs( ev, time, 4, args );
 }
 
 /*
@@ -764,7 +765,8 @@ idClass::PostEventMS
 */
 bool idClass::PostEventMS( const idEventDef* ev, int time, idEventArg arg1, idEventArg arg2, idEventArg arg3, idEventArg arg4, idEventArg arg5 )
 {
-	return PostEventArgs( ev, time, 5, &arg1, &arg2, &arg3, &arg4, &arg5 );
+	const idEventArg* args[ 5 ] = { &arg1, &arg2, &arg3, &arg4, &arg5 };
+	return PostEventArgs( ev, time, 5, args );
 }
 
 /*
@@ -774,7 +776,8 @@ idClass::PostEventMS
 */
 bool idClass::PostEventMS( const idEventDef* ev, int time, idEventArg arg1, idEventArg arg2, idEventArg arg3, idEventArg arg4, idEventArg arg5, idEventArg arg6 )
 {
-	return PostEventArgs( ev, time, 6, &arg1, &arg2, &arg3, &arg4, &arg5, &arg6 );
+	const idEventArg* args[ 6 ] = { &arg1, &arg2, &arg3, &arg4, &arg5, &arg6 };
+	return PostEventArgs( ev, time, 6, args );
 }
 
 /*
@@ -784,7 +787,8 @@ idClass::PostEventMS
 */
 bool idClass::PostEventMS( const idEventDef* ev, int time, idEventArg arg1, idEventArg arg2, idEventArg arg3, idEventArg arg4, idEventArg arg5, idEventArg arg6, idEventArg arg7 )
 {
-	return PostEventArgs( ev, time, 7, &arg1, &arg2, &arg3, &arg4, &arg5, &arg6, &arg7 );
+	const idEventArg* args[ 7 ] = { &arg1, &arg2, &arg3, &arg4, &arg5, &arg6, &arg7 };
+	return PostEventArgs( ev, time, 7, args );
 }
 
 /*
@@ -794,7 +798,8 @@ idClass::PostEventMS
 */
 bool idClass::PostEventMS( const idEventDef* ev, int time, idEventArg arg1, idEventArg arg2, idEventArg arg3, idEventArg arg4, idEventArg arg5, idEventArg arg6, idEventArg arg7, idEventArg arg8 )
 {
-	return PostEventArgs( ev, time, 8, &arg1, &arg2, &arg3, &arg4, &arg5, &arg6, &arg7, &arg8 );
+	const idEventArg* args[ 8 ] = { &arg1, &arg2, &arg3, &arg4, &arg5, &arg6, &arg7, &arg8 };
+	return PostEventArgs( ev, time, 8, args );
 }
 
 /*
@@ -804,7 +809,7 @@ idClass::PostEventSec
 */
 bool idClass::PostEventSec( const idEventDef* ev, float time )
 {
-	return PostEventArgs( ev, SEC2MS( time ), 0 );
+	return PostEventArgs( ev, SEC2MS( time ), 0, NULL );
 }
 
 /*
@@ -814,7 +819,8 @@ idClass::PostEventSec
 */
 bool idClass::PostEventSec( const idEventDef* ev, float time, idEventArg arg1 )
 {
-	return PostEventArgs( ev, SEC2MS( time ), 1, &arg1 );
+	const idEventArg* args[ 1 ] = { &arg1 };
+	return PostEventArgs( ev, SEC2MS( time ), 1, args );
 }
 
 /*
@@ -824,7 +830,8 @@ idClass::PostEventSec
 */
 bool idClass::PostEventSec( const idEventDef* ev, float time, idEventArg arg1, idEventArg arg2 )
 {
-	return PostEventArgs( ev, SEC2MS( time ), 2, &arg1, &arg2 );
+	const idEventArg* args[ 2 ] = { &arg1, &arg2 };
+	return PostEventArgs( ev, SEC2MS( time ), 2, args );
 }
 
 /*
@@ -834,7 +841,8 @@ idClass::PostEventSec
 */
 bool idClass::PostEventSec( const idEventDef* ev, float time, idEventArg arg1, idEventArg arg2, idEventArg arg3 )
 {
-	return PostEventArgs( ev, SEC2MS( time ), 3, &arg1, &arg2, &arg3 );
+	const idEventArg* args[ 3 ] = { &arg1, &arg2, &arg3 };
+	return PostEventArgs( ev, SEC2MS( time ), 3, args );
 }
 
 /*
@@ -844,7 +852,8 @@ idClass::PostEventSec
 */
 bool idClass::PostEventSec( const idEventDef* ev, float time, idEventArg arg1, idEventArg arg2, idEventArg arg3, idEventArg arg4 )
 {
-	return PostEventArgs( ev, SEC2MS( time ), 4, &arg1, &arg2, &arg3, &arg4 );
+	const idEventArg* args[ 4 ] = { &arg1, &arg2, &arg3, &arg4 };
+	return PostEventArgs( ev, SEC2MS( time ), 4, args );
 }
 
 /*
@@ -854,7 +863,8 @@ idClass::PostEventSec
 */
 bool idClass::PostEventSec( const idEventDef* ev, float time, idEventArg arg1, idEventArg arg2, idEventArg arg3, idEventArg arg4, idEventArg arg5 )
 {
-	return PostEventArgs( ev, SEC2MS( time ), 5, &arg1, &arg2, &arg3, &arg4, &arg5 );
+	const idEventArg* args[ 5 ] = { &arg1, &arg2, &arg3, &arg4, &arg5 };
+	return PostEventArgs( ev, SEC2MS( time ), 5, args );
 }
 
 /*
@@ -864,7 +874,8 @@ idClass::PostEventSec
 */
 bool idClass::PostEventSec( const idEventDef* ev, float time, idEventArg arg1, idEventArg arg2, idEventArg arg3, idEventArg arg4, idEventArg arg5, idEventArg arg6 )
 {
-	return PostEventArgs( ev, SEC2MS( time ), 6, &arg1, &arg2, &arg3, &arg4, &arg5, &arg6 );
+	const idEventArg* args[ 6 ] = { &arg1, &arg2, &arg3, &arg4, &arg5, &arg6 };
+	return PostEventArgs( ev, SEC2MS( time ), 6, args );
 }
 
 /*
@@ -874,7 +885,8 @@ idClass::PostEventSec
 */
 bool idClass::PostEventSec( const idEventDef* ev, float time, idEventArg arg1, idEventArg arg2, idEventArg arg3, idEventArg arg4, idEventArg arg5, idEventArg arg6, idEventArg arg7 )
 {
-	return PostEventArgs( ev, SEC2MS( time ), 7, &arg1, &arg2, &arg3, &arg4, &arg5, &arg6, &arg7 );
+	const idEventArg* args[ 7 ] = { &arg1, &arg2, &arg3, &arg4, &arg5, &arg6, &arg7 };
+	return PostEventArgs( ev, SEC2MS( time ), 7, args );
 }
 
 /*
@@ -884,7 +896,8 @@ idClass::PostEventSec
 */
 bool idClass::PostEventSec( const idEventDef* ev, float time, idEventArg arg1, idEventArg arg2, idEventArg arg3, idEventArg arg4, idEventArg arg5, idEventArg arg6, idEventArg arg7, idEventArg arg8 )
 {
-	return PostEventArgs( ev, SEC2MS( time ), 8, &arg1, &arg2, &arg3, &arg4, &arg5, &arg6, &arg7, &arg8 );
+	const idEventArg* args[ 8 ] = { &arg1, &arg2, &arg3, &arg4, &arg5, &arg6, &arg7, &arg8 };
+	return PostEventArgs( ev, SEC2MS( time ), 8, args );
 }
 
 /*
@@ -892,14 +905,13 @@ bool idClass::PostEventSec( const idEventDef* ev, float time, idEventArg arg1, i
 idClass::ProcessEventArgs
 ================
 */
-bool idClass::ProcessEventArgs( const idEventDef* ev, int numargs, ... )
+bool idClass::ProcessEventArgs( const idEventDef* ev, int numargs, const idEventArg* const* args )
 {
 	idTypeInfo*	c;
 	int			num;
 	// RB: 64 bit fix, changed int to intptr_t
 	intptr_t	data[ D_EVENT_MAXARGS ];
 	// RB end
-	va_list		args;
 
 	assert( ev );
 	assert( idEvent::initialized );
@@ -912,9 +924,7 @@ bool idClass::ProcessEventArgs( const idEventDef* ev, int numargs, ... )
 		return false;
 	}
 
-	va_start( args, numargs );
 	idEvent::CopyArgs( ev, numargs, args, data );
-	va_end( args );
 
 	ProcessEventArgPtr( ev, data );
 
@@ -928,7 +938,7 @@ idClass::ProcessEvent
 */
 bool idClass::ProcessEvent( const idEventDef* ev )
 {
-	return ProcessEventArgs( ev, 0 );
+	return ProcessEventArgs( ev, 0, NULL );
 }
 
 /*
@@ -938,7 +948,8 @@ idClass::ProcessEvent
 */
 bool idClass::ProcessEvent( const idEventDef* ev, idEventArg arg1 )
 {
-	return ProcessEventArgs( ev, 1, &arg1 );
+	const idEventArg* args[ 1 ] = { &arg1 };
+	return ProcessEventArgs( ev, 1, args );
 }
 
 /*
@@ -948,7 +959,8 @@ idClass::ProcessEvent
 */
 bool idClass::ProcessEvent( const idEventDef* ev, idEventArg arg1, idEventArg arg2 )
 {
-	return ProcessEventArgs( ev, 2, &arg1, &arg2 );
+	const idEventArg* args[ 2 ] = { &arg1, &arg2 };
+	return ProcessEventArgs( ev, 2, args );
 }
 
 /*
@@ -958,7 +970,8 @@ idClass::ProcessEvent
 */
 bool idClass::ProcessEvent( const idEventDef* ev, idEventArg arg1, idEventArg arg2, idEventArg arg3 )
 {
-	return ProcessEventArgs( ev, 3, &arg1, &arg2, &arg3 );
+	const idEventArg* args[ 3 ] = { &arg1, &arg2, &arg3 };
+	return ProcessEventArgs( ev, 3, args );
 }
 
 /*
@@ -968,7 +981,8 @@ idClass::ProcessEvent
 */
 bool idClass::ProcessEvent( const idEventDef* ev, idEventArg arg1, idEventArg arg2, idEventArg arg3, idEventArg arg4 )
 {
-	return ProcessEventArgs( ev, 4, &arg1, &arg2, &arg3, &arg4 );
+	const idEventArg* args[ 4 ] = { &arg1, &arg2, &arg3, &arg4 };
+	return ProcessEventArgs( ev, 4, args );
 }
 
 /*
@@ -978,7 +992,8 @@ idClass::ProcessEvent
 */
 bool idClass::ProcessEvent( const idEventDef* ev, idEventArg arg1, idEventArg arg2, idEventArg arg3, idEventArg arg4, idEventArg arg5 )
 {
-	return ProcessEventArgs( ev, 5, &arg1, &arg2, &arg3, &arg4, &arg5 );
+	const idEventArg* args[ 5 ] = { &arg1, &arg2, &arg3, &arg4, &arg5 };
+	return ProcessEventArgs( ev, 5, args );
 }
 
 /*
@@ -988,7 +1003,8 @@ idClass::ProcessEvent
 */
 bool idClass::ProcessEvent( const idEventDef* ev, idEventArg arg1, idEventArg arg2, idEventArg arg3, idEventArg arg4, idEventArg arg5, idEventArg arg6 )
 {
-	return ProcessEventArgs( ev, 6, &arg1, &arg2, &arg3, &arg4, &arg5, &arg6 );
+	const idEventArg* args[ 6 ] = { &arg1, &arg2, &arg3, &arg4, &arg5, &arg6 };
+	return ProcessEventArgs( ev, 6, args );
 }
 
 /*
@@ -998,7 +1014,8 @@ idClass::ProcessEvent
 */
 bool idClass::ProcessEvent( const idEventDef* ev, idEventArg arg1, idEventArg arg2, idEventArg arg3, idEventArg arg4, idEventArg arg5, idEventArg arg6, idEventArg arg7 )
 {
-	return ProcessEventArgs( ev, 7, &arg1, &arg2, &arg3, &arg4, &arg5, &arg6, &arg7 );
+	const idEventArg* args[ 7 ] = { &arg1, &arg2, &arg3, &arg4, &arg5, &arg6, &arg7 };
+	return ProcessEventArgs( ev, 7, args );
 }
 
 /*
@@ -1008,7 +1025,8 @@ idClass::ProcessEvent
 */
 bool idClass::ProcessEvent( const idEventDef* ev, idEventArg arg1, idEventArg arg2, idEventArg arg3, idEventArg arg4, idEventArg arg5, idEventArg arg6, idEventArg arg7, idEventArg arg8 )
 {
-	return ProcessEventArgs( ev, 8, &arg1, &arg2, &arg3, &arg4, &arg5, &arg6, &arg7, &arg8 );
+	const idEventArg* args[ 8 ] = { &arg1, &arg2, &arg3, &arg4, &arg5, &arg6, &arg7, &arg8 };
+	return ProcessEventArgs( ev, 8, args );
 }
 
 /*
@@ -340,8 +340,11 @@ public:
 private:
 	classSpawnFunc_t			CallSpawnFunc( idTypeInfo* cls );
 
-	bool						PostEventArgs( const idEventDef* ev, int time, int numargs, ... );
-	bool						ProcessEventArgs( const idEventDef* ev, int numargs, ... );
+	bool						PostEventArgs( const idEventDef* ev, int time, int numargs, const idEventArg* const* args );
+	bool						ProcessEventArgs( const idEventDef* ev, int numargs, const idEventArg* const* args );
+
+	friend class idEvent;
+	idLinkList<idEvent>			scheduledEvents;		// events posted to this object, so cancelling them does not search the event queues
 
 	static bool					initialized;
 	static idList<idTypeInfo*, TAG_IDCLASS>	types;
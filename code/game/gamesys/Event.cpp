@@ -49,6 +49,7 @@ Event are used for scheduling tasks and for linking script commands.
 ***********************************************************************/
 
 idEventDef* idEventDef::eventDefList[MAX_EVENTS];
+idEventDef* idEventDef::eventDefHash[EVENT_HASH_SIZE];
 int idEventDef::numEventDefs = 0;
 
 static bool eventError = false;
@@ -76,6 +77,7 @@ idEventDef::idEventDef( const char* command, const char* formatspec, char return
 	}
 
 	this->name = command;
+	this->nameId = idName( command );
 	this->formatspec = formatspec;
 	this->returnType = returnType;
 
@@ -147,33 +149,29 @@ idEventDef::idEventDef( const char* command, const char* formatspec, char return
 	// calculate the formatspecindex
 	formatspecIndex = ( 1 << ( numargs + D_EVENT_MAXARGS ) ) | bits;
 
-	// go through the list of defined events and check for duplicates
-	// and mismatched format strings
+	// check for duplicates and mismatched format strings
 	eventnum = numEventDefs;
-	for( i = 0; i < eventnum; i++ )
+	ev = FindEventDef( nameId, command );
+	if( ev != NULL )
 	{
-		ev = eventDefList[ i ];
-		if( strcmp( command, ev->name ) == 0 )
+		if( strcmp( formatspec, ev->formatspec ) != 0 )
 		{
-			if( strcmp( formatspec, ev->formatspec ) != 0 )
-			{
-				eventError = true;
-				idStr::snPrintf( eventErrorMsg, sizeof( eventErrorMsg ), "idEvent '%s' defined twice with same name but differing format strings ('%s'!='%s').",
-								 command, formatspec, ev->formatspec );
-				return;
-			}
+			eventError = true;
+			idStr::snPrintf( eventErrorMsg, sizeof( eventErrorMsg ), "idEvent '%s' defined twice with same name but differing format strings ('%s'!='%s').",
+							 command, formatspec, ev->formatspec );
+			return;
+		}
 
-			if( ev->returnType != returnType )
-			{
-				eventError = true;
-				idStr::snPrintf( eventErrorMsg, sizeof( eventErrorMsg ), "idEvent '%s' defined twice with same name but differing return types ('%c'!='%c').",
-								 command, returnType, ev->returnType );
-				return;
-			}
-			// Don't bother putting the duplicate event in list.
-			eventnum = ev->eventnum;
+		if( ev->returnType != returnType )
+		{
+			eventError = true;
+			idStr::snPrintf( eventErrorMsg, sizeof( eventErrorMsg ), "idEvent '%s' defined twice with same name but differing return types ('%c'!='%c').",
+							 command, returnType, ev->returnType );
 			return;
 		}
+		// Don't bother putting the duplicate event in list.
+		eventnum = ev->eventnum;
+		return;
 	}
 
 	ev = this;
@@ -186,6 +184,10 @@ idEventDef::idEventDef( const char* command, const char* formatspec, char return
 	}
 	eventDefList[numEventDefs] = ev;
 	numEventDefs++;
+
+	const int hash = nameId.GetHash() & ( EVENT_HASH_SIZE - 1 );
+	hashNext = eventDefHash[hash];
+	eventDefHash[hash] = this;
 }
 
 /*
@@ -215,17 +217,29 @@ idEventDef::FindEvent
 */
 const idEventDef* idEventDef::FindEvent( const char* name )
 {
-	idEventDef*	ev;
-	int			num;
-	int			i;
-
 	assert( name );
 
-	num = numEventDefs;
-	for( i = 0; i < num; i++ )
+	const idName nameId = idName::Find( name );
+	if( nameId.IsEmpty() )
 	{
-		ev = eventDefList[ i ];
-		if( strcmp( name, ev->name ) == 0 )
+		return NULL;
+	}
+
+	return FindEventDef( nameId, name );
+}
+
+/*
+================
+idEventDef::FindEventDef
+
+Interned names ignore case but event names don't, so the chain is also checked with strcmp.
+================
+*/
+idEventDef* idEventDef::FindEventDef( const idName& nameId, const char* name )
+{
+	for( idEventDef* ev = eventDefHash[nameId.GetHash() & ( EVENT_HASH_SIZE - 1 )]; ev != NULL; ev = ev->hashNext )
+	{
+		if( ev->nameId == nameId && strcmp( name, ev->name ) == 0 )
 		{
 			return ev;
 		}
@@ -234,21 +248,331 @@ const idEventDef* idEventDef::FindEvent( const char* name )
 	return NULL;
 }
 
+/***********************************************************************
+
+  idEventWheel
+
+  Hierarchical timing wheel keyed by game time. The first level has a slot
+  for every msec of the EVENT_WHEEL_SIZE msec block the queue is currently
+  in, the second level a slot for each of the following blocks. Events
+  further in the future wait in an overflow list. Whenever the queue enters
+  a new block its events move down to the msec slots, so scheduling is O(1)
+  and servicing only visits the slots of the msecs that passed.
+
+  Every slot keeps its events sorted by time and then by schedule order,
+  which is the order the old sorted list serviced them in.
+
+***********************************************************************/
+
+#define EVENT_WHEEL_BITS			10
+#define EVENT_WHEEL_SIZE			( 1 << EVENT_WHEEL_BITS )
+#define EVENT_WHEEL_MASK			( EVENT_WHEEL_SIZE - 1 )
+#define EVENT_WHEEL_BLOCKS			64
+
+enum
+{
+	EVENT_LEVEL_NONE = -1,
+	EVENT_LEVEL_MSEC,
+	EVENT_LEVEL_BLOCK,
+	EVENT_LEVEL_OVERFLOW
+};
+
+class idEventWheel
+{
+public:
+	void					Clear();
+	void					Add( idEvent* event );
+	void					Remove( idEvent* event );
+	idEvent*				NextEvent( int time );							// first event due at or before time, NULL when there is none
+	void					GetEvents( idList<idEvent*>& list ) const;		// all events in the order they will be serviced
+	int						Num() const
+	{
+		return num;
+	}
+
+private:
+	idLinkList<idEvent>		msecSlots[ EVENT_WHEEL_SIZE ];
+	idLinkList<idEvent>		blockSlots[ EVENT_WHEEL_BLOCKS ];
+	idLinkList<idEvent>		overflow;
+
+	int						current;		// msec the wheel is at, events due before it wait in its slot
+	int						num;
+	int						numMsec;
+	int						numBlock;
+
+	void					AddToSlot( idLinkList<idEvent>& slot, idEvent* event, int level );
+	void					Advance( int time );
+
+	class idSort_EventsByTime : public idSort_Quick< idEvent*, idSort_EventsByTime >
+	{
+	public:
+		int Compare( idEvent* const& a, idEvent* const& b ) const
+		{
+			if( a->time != b->time )
+			{
+				return ( a->time < b->time ) ? -1 : 1;
+			}
+			return ( a->sequence < b->sequence ) ? -1 : ( a->sequence > b->sequence );
+		}
+	};
+};
+
+/*
+================
+idEventWheel::Clear
+================
+*/
+void idEventWheel::Clear()
+{
+	for( int i = 0; i < EVENT_WHEEL_SIZE; i++ )
+	{
+		msecSlots[ i ].Clear();
+	}
+	for( int i = 0; i < EVENT_WHEEL_BLOCKS; i++ )
+	{
+		blockSlots[ i ].Clear();
+	}
+	overflow.Clear();
+
+	current = 0;
+	num = 0;
+	numMsec = 0;
+	numBlock = 0;
+}
+
+/*
+================
+idEventWheel::AddToSlot
+
+Searches from the end since events are almost always added after all others in the slot.
+================
+*/
+void idEventWheel::AddToSlot( idLinkList<idEvent>& slot, idEvent* event, int level )
+{
+	idEvent* prev = slot.Prev();
+	while( ( prev != NULL ) && ( prev->time > event->time ) )
+	{
+		prev = prev->eventNode.Prev();
+	}
+
+	if( prev != NULL )
+	{
+		event->eventNode.InsertAfter( prev->eventNode );
+	}
+	else
+	{
+		event->eventNode.AddToFront( slot );
+	}
+
+	event->queue = this;
+	event->queueLevel = level;
+}
+
+/*
+================
+idEventWheel::Add
+================
+*/
+void idEventWheel::Add( idEvent* event )
+{
+	// the wheel can jump anywhere when nothing is scheduled
+	if( num == 0 )
+	{
+		current = event->time;
+	}
+	num++;
+
+	int block = event->time >> EVENT_WHEEL_BITS;
+	int currentBlock = current >> EVENT_WHEEL_BITS;
+
+	if( event->time <= current )
+	{
+		AddToSlot( msecSlots[ current & EVENT_WHEEL_MASK ], event, EVENT_LEVEL_MSEC );
+		numMsec++;
+	}
+	else if( block == currentBlock )
+	{
+		AddToSlot( msecSlots[ event->time & EVENT_WHEEL_MASK ], event, EVENT_LEVEL_MSEC );
+		numMsec++;
+	}
+	else if( block - currentBlock < EVENT_WHEEL_BLOCKS )
+	{
+		event->eventNode.AddToEnd( blockSlots[ block & ( EVENT_WHEEL_BLOCKS - 1 ) ] );
+		event->queue = this;
+		event->queueLevel = EVENT_LEVEL_BLOCK;
+		numBlock++;
+	}
+	else
+	{
+		event->eventNode.AddToEnd( overflow );
+		event->queue = this;
+		event->queueLevel = EVENT_LEVEL_OVERFLOW;
+	}
+}
+
+/*
+================
+idEventWheel::Remove
+================
+*/
+void idEventWheel::Remove( idEvent* event )
+{
+	assert( event->queue == this );
+
+	if( event->queueLevel == EVENT_LEVEL_MSEC )
+	{
+		numMsec--;
+	}
+	else if( event->queueLevel == EVENT_LEVEL_BLOCK )
+	{
+		numBlock--;
+	}
+	num--;
+
+	event->eventNode.Remove();
+	event->queue = NULL;
+	event->queueLevel = EVENT_LEVEL_NONE;
+}
+
+/*
+================
+idEventWheel::Advance
+
+Moves the wheel forward within the current block or to the start of the next one.
+================
+*/
+void idEventWheel::Advance( int time )
+{
+	int block = time >> EVENT_WHEEL_BITS;
+
+	if( block == ( current >> EVENT_WHEEL_BITS ) )
+	{
+		current = time;
+		return;
+	}
+
+	assert( ( block == ( current >> EVENT_WHEEL_BITS ) + 1 ) && ( numMsec == 0 ) );
+	current = time;
+
+	// the events of the new block move down to the msec slots
+	idLinkList<idEvent>& slot = blockSlots[ block & ( EVENT_WHEEL_BLOCKS - 1 ) ];
+	for( idEvent* event = slot.Next(); event != NULL; event = slot.Next() )
+	{
+		event->eventNode.Remove();
+		numBlock--;
+		AddToSlot( msecSlots[ event->time & EVENT_WHEEL_MASK ], event, EVENT_LEVEL_MSEC );
+		numMsec++;
+	}
+
+	// and the block slot that became free takes the overflow events of the last block in reach
+	int lastBlock = block + EVENT_WHEEL_BLOCKS - 1;
+	idEvent* next;
+	for( idEvent* event = overflow.Next(); event != NULL; event = next )
+	{
+		next = event->eventNode.Next();
+		if( ( event->time >> EVENT_WHEEL_BITS ) == lastBlock )
+		{
+			event->eventNode.AddToEnd( blockSlots[ lastBlock & ( EVENT_WHEEL_BLOCKS - 1 ) ] );
+			event->queueLevel = EVENT_LEVEL_BLOCK;
+			numBlock++;
+		}
+	}
+}
+
+/*
+================
+idEventWheel::NextEvent
+================
+*/
+idEvent* idEventWheel::NextEvent( int time )
+{
+	while( true )
+	{
+		idEvent* event = msecSlots[ current & EVENT_WHEEL_MASK ].Next();
+		if( ( event != NULL ) && ( event->time <= time ) )
+		{
+			return event;
+		}
+
+		if( current >= time )
+		{
+			return NULL;
+		}
+
+		// everything in the current slot was due, so it is empty now
+		assert( event == NULL );
+
+		if( numMsec > 0 )
+		{
+			Advance( current + 1 );
+			continue;
+		}
+
+		if( ( numBlock == 0 ) && overflow.IsListEmpty() )
+		{
+			current = time;
+			continue;
+		}
+
+		// skip the rest of the empty block
+		int nextBlock = ( current | EVENT_WHEEL_MASK ) + 1;
+		Advance( ( nextBlock > time ) ? time : nextBlock );
+	}
+}
+
+/*
+================
+idEventWheel::GetEvents
+================
+*/
+void idEventWheel::GetEvents( idList<idEvent*>& list ) const
+{
+	list.SetNum( 0 );
+	list.SetGranularity( 256 );
+
+	for( int i = 0; i < EVENT_WHEEL_SIZE; i++ )
+	{
+		for( idEvent* event = msecSlots[ i ].Next(); event != NULL; event = event->eventNode.Next() )
+		{
+			list.Append( event );
+		}
+	}
+	for( int i = 0; i < EVENT_WHEEL_BLOCKS; i++ )
+	{
+		for( idEvent* event = blockSlots[ i ].Next(); event != NULL; event = event->eventNode.Next() )
+		{
+			list.Append( event );
+		}
+	}
+	for( idEvent* event = overflow.Next(); event != NULL; event = event->eventNode.Next() )
+	{
+		list.Append( event );
+	}
+
+	list.SortWithTemplate( idSort_EventsByTime() );
+}
+
 /***********************************************************************
 
   idEvent
 
 ***********************************************************************/
 
+// fixed size storage for arguments that do not fit into idEvent::inlineData
+struct eventArgSlab_t
+{
+	intptr_t				data[ D_EVENT_SLAB_ARGSIZE / sizeof( intptr_t ) ];
+};
+
+static idBlockAlloc<eventArgSlab_t, 64, TAG_EVENTS> eventDataAllocator;
 static idLinkList<idEvent> FreeEvents;
-static idLinkList<idEvent> EventQueue;
-static idLinkList<idEvent> FastEventQueue;
+static idEventWheel EventQueue;
+static idEventWheel FastEventQueue;
 static idEvent EventPool[ MAX_EVENTS ];
+static int eventSequence = 0;
 
 bool idEvent::initialized = false;
 
-idDynamicBlockAlloc<byte, 16 * 1024, 256>	idEvent::eventDataAllocator;
-
 /*
 ================
 idEvent::~idEvent()
@@ -264,12 +588,12 @@ idEvent::~idEvent()
 idEvent::Alloc
 ================
 */
-idEvent* idEvent::Alloc( const idEventDef* evdef, int numargs, va_list args )
+idEvent* idEvent::Alloc( const idEventDef* evdef, int numargs, const idEventArg* const* args )
 {
 	idEvent*		ev;
 	size_t		size;
 	const char*	format;
-	idEventArg*	arg;
+	const idEventArg*	arg;
 	byte*		dataPtr;
 	int			i;
 	const char*	materialName;
@@ -292,7 +616,7 @@ idEvent* idEvent::Alloc( const idEventDef* evdef, int numargs, va_list args )
 	size = evdef->GetArgSize();
 	if( size )
 	{
-		ev->data = eventDataAllocator.Alloc( size );
+		ev->AllocData( size );
 		memset( ev->data, 0, size );
 	}
 	else
@@ -304,7 +628,7 @@ idEvent* idEvent::Alloc( const idEventDef* evdef, int numargs, va_list args )
 	format = evdef->GetArgFormat();
 	for( i = 0; i < numargs; i++ )
 	{
-		arg = va_arg( args, idEventArg* );
+		arg = args[ i ];
 		if( format[ i ] != arg->type )
 		{
 			// when NULL is passed in for an entity, it gets cast as an integer 0, so don't give an error when it happens
@@ -378,12 +702,12 @@ idEvent::CopyArgs
 ================
 */
 // RB: 64 bit fixes, changed int to intptr_t
-void idEvent::CopyArgs( const idEventDef* evdef, int numargs, va_list args, intptr_t data[ D_EVENT_MAXARGS ] )
+void idEvent::CopyArgs( const idEventDef* evdef, int numargs, const idEventArg* const* args, intptr_t data[ D_EVENT_MAXARGS ] )
 {
 // RB end
 	int			i;
 	const char*	format;
-	idEventArg*	arg;
+	const idEventArg*	arg;
 
 	format = evdef->GetArgFormat();
 	if( numargs != evdef->GetNumArgs() )
@@ -393,7 +717,7 @@ void idEvent::CopyArgs( const idEventDef* evdef, int numargs, va_list args, intp
 
 	for( i = 0; i < numargs; i++ )
 	{
-		arg = va_arg( args, idEventArg* );
+		arg = args[ i ];
 		if( format[ i ] != arg->type )
 		{
 			// when NULL is passed in for an entity, it gets cast as an integer 0, so don't give an error when it happens
@@ -414,21 +738,77 @@ idEvent::Free
 */
 void idEvent::Free()
 {
-	if( data )
-	{
-		eventDataAllocator.Free( data );
-		data = NULL;
-	}
+	FreeData();
+	Unlink();
 
 	eventdef	= NULL;
 	time		= 0;
 	object		= NULL;
 	typeinfo	= NULL;
 
+	objectNode.SetOwner( this );
 	eventNode.SetOwner( this );
 	eventNode.AddToEnd( FreeEvents );
 }
 
+/*
+================
+idEvent::AllocData
+================
+*/
+void idEvent::AllocData( size_t size )
+{
+	if( size <= sizeof( inlineData ) )
+	{
+		data = reinterpret_cast<byte*>( inlineData );
+	}
+	else if( size <= D_EVENT_SLAB_ARGSIZE )
+	{
+		data = reinterpret_cast<byte*>( eventDataAllocator.Alloc() );
+	}
+	else
+	{
+		data = reinterpret_cast<byte*>( Mem_Alloc( size, TAG_EVENTS ) );
+	}
+}
+
+/*
+================
+idEvent::FreeData
+================
+*/
+void idEvent::FreeData()
+{
+	if( ( data != NULL ) && ( data != reinterpret_cast<byte*>( inlineData ) ) )
+	{
+		if( eventdef->GetArgSize() <= D_EVENT_SLAB_ARGSIZE )
+		{
+			eventDataAllocator.Free( reinterpret_cast<eventArgSlab_t*>( data ) );
+		}
+		else
+		{
+			Mem_Free( data );
+		}
+	}
+	data = NULL;
+}
+
+/*
+================
+idEvent::Unlink
+
+Takes the event out of its queue and the event list of its object.
+================
+*/
+void idEvent::Unlink()
+{
+	if( queue != NULL )
+	{
+		queue->Remove( this );
+	}
+	objectNode.Remove();
+}
+
 /*
 ================
 idEvent::Schedule
@@ -436,60 +816,32 @@ idEvent::Schedule
 */
 void idEvent::Schedule( idClass* obj, const idTypeInfo* type, int time )
 {
-	idEvent* event;
-
 	assert( initialized );
 	if( !initialized )
 	{
 		return;
 	}
 
+	Unlink();
+
 	object = obj;
 	typeinfo = type;
+	sequence = eventSequence++;
 
 	// wraps after 24 days...like I care. ;)
 	this->time = gameLocal.time + time;
 
-	eventNode.Remove();
-
 	if( obj->IsType( idEntity::Type ) && ( ( ( idEntity* )( obj ) )->timeGroup == TIME_GROUP2 ) )
 	{
-		event = FastEventQueue.Next();
-		while( ( event != NULL ) && ( this->time >= event->time ) )
-		{
-			event = event->eventNode.Next();
-		}
-
-		if( event )
-		{
-			eventNode.InsertBefore( event->eventNode );
-		}
-		else
-		{
-			eventNode.AddToEnd( FastEventQueue );
-		}
-
-		return;
+		FastEventQueue.Add( this );
 	}
 	else
 	{
 		this->time = gameLocal.slow.time + time;
+		EventQueue.Add( this );
 	}
 
-	event = EventQueue.Next();
-	while( ( event != NULL ) && ( this->time >= event->time ) )
-	{
-		event = event->eventNode.Next();
-	}
-
-	if( event )
-	{
-		eventNode.InsertBefore( event->eventNode );
-	}
-	else
-	{
-		eventNode.AddToEnd( EventQueue );
-	}
+	objectNode.AddToEnd( obj->scheduledEvents );
 }
 
 /*
@@ -507,27 +859,12 @@ void idEvent::CancelEvents( const idClass* obj, const idEventDef* evdef )
 		return;
 	}
 
-	for( event = EventQueue.Next(); event != NULL; event = next )
+	for( event = obj->scheduledEvents.Next(); event != NULL; event = next )
 	{
-		next = event->eventNode.Next();
-		if( event->object == obj )
+		next = event->objectNode.Next();
+		if( !evdef || ( evdef == event->eventdef ) )
 		{
-			if( !evdef || ( evdef == event->eventdef ) )
-			{
-				event->Free();
-			}
-		}
-	}
-
-	for( event = FastEventQueue.Next(); event != NULL; event = next )
-	{
-		next = event->eventNode.Next();
-		if( event->object == obj )
-		{
-			if( !evdef || ( evdef == event->eventdef ) )
-			{
-				event->Free();
-			}
+			event->Free();
 		}
 	}
 }
@@ -545,7 +882,6 @@ void idEvent::ClearEventList()
 	// initialize lists
 	//
 	FreeEvents.Clear();
-	EventQueue.Clear();
 
 	//
 	// add the events to the free list
@@ -554,6 +890,10 @@ void idEvent::ClearEventList()
 	{
 		EventPool[ i ].Free();
 	}
+
+	EventQueue.Clear();
+	FastEventQueue.Clear();
+	eventSequence = 0;
 }
 
 /*
@@ -578,16 +918,8 @@ void idEvent::ServiceEvents()
 	const char*  materialName;
 
 	num = 0;
-	while( !EventQueue.IsListEmpty() )
+	while( ( event = EventQueue.NextEvent( gameLocal.time ) ) != NULL )
 	{
-		event = EventQueue.Next();
-		assert( event );
-
-		if( event->time > gameLocal.time )
-		{
-			break;
-		}
-
 		common->UpdateLevelLoadPacifier();
 
 		// copy the data into the local args array and set up pointers
@@ -642,9 +974,9 @@ void idEvent::ServiceEvents()
 			}
 		}
 
-		// the event is removed from its list so that if then object
+		// the event is removed from its lists so that if then object
 		// is deleted, the event won't be freed twice
-		event->eventNode.Remove();
+		event->Unlink();
 		assert( event->object );
 		event->object->ProcessEventArgPtr( ev, args );
 
@@ -692,16 +1024,8 @@ void idEvent::ServiceFastEvents()
 	const char*  materialName;
 
 	num = 0;
-	while( !FastEventQueue.IsListEmpty() )
+	while( ( event = FastEventQueue.NextEvent( gameLocal.fast.time ) ) != NULL )
 	{
-		event = FastEventQueue.Next();
-		assert( event );
-
-		if( event->time > gameLocal.fast.time )
-		{
-			break;
-		}
-
 		// copy the data into the local args array and set up pointers
 		ev = event->eventdef;
 		formatspec = ev->GetArgFormat();
@@ -754,9 +1078,9 @@ void idEvent::ServiceFastEvents()
 			}
 		}
 
-		// the event is removed from its list so that if then object
+		// the event is removed from its lists so that if then object
 		// is deleted, the event won't be freed twice
-		event->eventNode.Remove();
+		event->Unlink();
 		assert( event->object );
 		event->object->ProcessEventArgPtr( ev, args );
 
@@ -811,8 +1135,6 @@ void idEvent::Init()
 
 	ClearEventList();
 
-	eventDataAllocator.Init();
-
 	gameLocal.Printf( "...%i event definitions\n", idEventDef::NumEventCommands() );
 
 	// the event system has started
@@ -859,11 +1181,14 @@ void idEvent::Save( idSaveGame* savefile )
 	idStr s;
 	// RB end
 
-	savefile->WriteInt( EventQueue.Num() );
+	idList<idEvent*> events;
 
-	event = EventQueue.Next();
-	while( event != NULL )
+	EventQueue.GetEvents( events );
+	savefile->WriteInt( events.Num() );
+
+	for( int n = 0; n < events.Num(); n++ )
 	{
+		event = events[ n ];
 		savefile->WriteInt( event->time );
 		savefile->WriteString( event->eventdef->GetName() );
 		savefile->WriteString( event->typeinfo->classname );
@@ -933,23 +1258,21 @@ void idEvent::Save( idSaveGame* savefile )
 			}
 		}
 		assert( size == ( int )event->eventdef->GetArgSize() );
-		event = event->eventNode.Next();
 	}
 
 	// Save the Fast EventQueue
-	savefile->WriteInt( FastEventQueue.Num() );
+	FastEventQueue.GetEvents( events );
+	savefile->WriteInt( events.Num() );
 
-	event = FastEventQueue.Next();
-	while( event != NULL )
+	for( int n = 0; n < events.Num(); n++ )
 	{
+		event = events[ n ];
 		savefile->WriteInt( event->time );
 		savefile->WriteString( event->eventdef->GetName() );
 		savefile->WriteString( event->typeinfo->classname );
 		savefile->WriteObject( event->object );
 		savefile->WriteInt( event->eventdef->GetArgSize() );
 		savefile->Write( event->data, event->eventdef->GetArgSize() );
-
-		event = event->eventNode.Next();
 	}
 }
 
@@ -981,7 +1304,6 @@ void idEvent::Restore( idRestoreGame* savefile )
 
 		event = FreeEvents.Next();
 		event->eventNode.Remove();
-		event->eventNode.AddToEnd( EventQueue );
 
 		savefile->ReadInt( event->time );
 
@@ -1005,6 +1327,14 @@ void idEvent::Restore( idRestoreGame* savefile )
 
 		savefile->ReadObject( event->object );
 
+		// the events were saved in the order they are serviced in, so they can just be added again
+		event->sequence = eventSequence++;
+		EventQueue.Add( event );
+		if( event->object != NULL )
+		{
+			event->objectNode.AddToEnd( event->object->scheduledEvents );
+		}
+
 		// read the args
 		savefile->ReadInt( argsize );
 		if( argsize != ( int )event->eventdef->GetArgSize() )
@@ -1015,7 +1345,7 @@ void idEvent::Restore( idRestoreGame* savefile )
 		}
 		if( argsize )
 		{
-			event->data = eventDataAllocator.Alloc( argsize );
+			event->AllocData( argsize );
 			format = event->eventdef->GetArgFormat();
 			assert( format );
 			for( j = 0, size = 0; j < event->eventdef->GetNumArgs(); ++j )
@@ -1099,7 +1429,6 @@ void idEvent::Restore( idRestoreGame* savefile )
 
 		event = FreeEvents.Next();
 		event->eventNode.Remove();
-		event->eventNode.AddToEnd( FastEventQueue );
 
 		savefile->ReadInt( event->time );
 
@@ -1123,6 +1452,13 @@ void idEvent::Restore( idRestoreGame* savefile )
 
 		savefile->ReadObject( event->object );
 
+		event->sequence = eventSequence++;
+		FastEventQueue.Add( event );
+		if( event->object != NULL )
+		{
+			event->objectNode.AddToEnd( event->object->scheduledEvents );
+		}
+
 		// read the args
 		savefile->ReadInt( argsize );
 		if( argsize != ( int )event->eventdef->GetArgSize() )
@@ -1131,7 +1467,7 @@ void idEvent::Restore( idRestoreGame* savefile )
 		}
 		if( argsize )
 		{
-			event->data = eventDataAllocator.Alloc( argsize );
+			event->AllocData( argsize );
 			savefile->Read( event->data, argsize );
 		}
 		else
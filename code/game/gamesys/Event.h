@@ -52,6 +52,10 @@ Event are used for scheduling tasks and for linking script commands.
 #define D_EVENT_TRACE				't'
 
 #define MAX_EVENTS					4096
+#define EVENT_HASH_SIZE				1024
+
+#define D_EVENT_INLINE_ARGSIZE		64			// arguments up to this size are stored inside the idEvent
+#define D_EVENT_SLAB_ARGSIZE		1024		// larger arguments up to this size come from fixed size slabs
 
 class idClass;
 class idTypeInfo;
@@ -60,6 +64,7 @@ class idEventDef
 {
 private:
 	const char*					name;
+	idName						nameId;
 	const char*					formatspec;
 	unsigned int				formatspecIndex;
 	int							returnType;
@@ -68,10 +73,14 @@ private:
 	int							argOffset[ D_EVENT_MAXARGS ];
 	int							eventnum;
 	const idEventDef* 			next;
+	idEventDef* 				hashNext;
 
 	static idEventDef* 			eventDefList[MAX_EVENTS];
+	static idEventDef* 			eventDefHash[EVENT_HASH_SIZE];
 	static int					numEventDefs;
 
+	static idEventDef* 			FindEventDef( const idName& nameId, const char* name );
+
 public:
 	idEventDef( const char* command, const char* formatspec = NULL, char returnType = 0 );
 
@@ -91,29 +100,41 @@ public:
 
 class idSaveGame;
 class idRestoreGame;
+class idEventWheel;
+class idEventArg;
 
 class idEvent
 {
+	friend class idEventWheel;
+
 private:
 	const idEventDef*			eventdef;
 	byte*						data;
 	int							time;
+	int							sequence;				// keeps events with the same time in the order they were scheduled
 	idClass*						object;
 	const idTypeInfo*			typeinfo;
 
-	idLinkList<idEvent>			eventNode;
+	idEventWheel*				queue;					// queue and wheel level the event is scheduled in
+	int							queueLevel;
+
+	idLinkList<idEvent>			eventNode;				// wheel slot or free list
+	idLinkList<idEvent>			objectNode;				// all events scheduled on the object
 
-	static idDynamicBlockAlloc<byte, 16 * 1024, 256> eventDataAllocator;
+	intptr_t					inlineData[ D_EVENT_INLINE_ARGSIZE / sizeof( intptr_t ) ];
 
+	void						AllocData( size_t size );
+	void						FreeData();
+	void						Unlink();
 
 public:
 	static bool					initialized;
 
 	~idEvent();
 
-	static idEvent*				Alloc( const idEventDef* evdef, int numargs, va_list args );
+	static idEvent*				Alloc( const idEventDef* evdef, int numargs, const idEventArg* const* args );
 	// RB: 64 bit fix, changed int to intptr_t
-	static void					CopyArgs( const idEventDef* evdef, int numargs, va_list args, intptr_t data[ D_EVENT_MAXARGS ] );
+	static void					CopyArgs( const idEventDef* evdef, int numargs, const idEventArg* const* args, intptr_t data[ D_EVENT_MAXARGS ] );
 	// RB end
 
 	void						Free();
@@ -247,6 +247,65 @@ void Cmd_Script_f( const idCmdArgs& args )
 	}
 }
 
+/*
+===================
+Cmd_ScriptBench_f
+
+Runs a small script loop through the interpreter and reports the statement rate.
+===================
+*/
+void Cmd_ScriptBench_f( const idCmdArgs& args )
+{
+	idStr			text;
+	idStr			funcname;
+	static int		funccount = 0;
+	const function_t* func;
+
+	if( !gameLocal.CheatsOk() )
+	{
+		return;
+	}
+
+	// stay well below the runaway loop limit of the interpreter
+	int iterations = ( args.Argc() > 1 ) ? atoi( args.Argv( 1 ) ) : 100000;
+	iterations = idMath::ClampInt( 1, 250000, iterations );
+
+	sprintf( funcname, "ScriptBench_%d", funccount++ );
+	sprintf( text,
+			 "void %s() {\n"
+			 "	float i;\n"
+			 "	float sum;\n"
+			 "	for( i = 0; i < %d; i++ ) {\n"
+			 "		sum = sum + i * 0.5;\n"
+			 "		if( sum > 1000 ) {\n"
+			 "			sum = sys.sin( sum );\n"
+			 "		}\n"
+			 "	}\n"
+			 "}\n", funcname.c_str(), iterations );
+
+	if( !gameLocal.program.CompileText( "scriptBench", text, true ) )
+	{
+		return;
+	}
+
+	func = gameLocal.program.FindFunction( funcname );
+	if( func == NULL )
+	{
+		return;
+	}
+
+	int64 statements = idInterpreter::statementsExecuted;
+	uint64 start = Sys_Microseconds();
+
+	idThread* thread = new idThread( func );
+	thread->Start();
+
+	uint64 usec = Max<uint64>( Sys_Microseconds() - start, 1 );
+	statements = idInterpreter::statementsExecuted - statements;
+
+	gameLocal.Printf( "%d iterations, %lld statements in %.2f msec, %.2f million statements/sec\n", iterations, statements, usec * 0.001f, ( double )statements / usec );
+}
+
 /*
 ==================
 KillEntities
@@ -2848,6 +2907,7 @@ void idGameLocal::InitConsoleCommands()
 	cmdSystem->AddCommand( "testBlend",				idTestModel::TestBlend_f,			CMD_FL_GAME | CMD_FL_CHEAT,	"tests animation blending" );
 	cmdSystem->AddCommand( "reloadScript",			Cmd_ReloadScript_f,			CMD_FL_GAME | CMD_FL_CHEAT,	"reloads scripts" );
 	cmdSystem->AddCommand( "script",				Cmd_Script_f,				CMD_FL_GAME | CMD_FL_CHEAT,	"executes a line of script" );
+	cmdSystem->AddCommand( "scriptBench",			Cmd_ScriptBench_f,			CMD_FL_GAME | CMD_FL_CHEAT,	"measures script interpreter speed" );
 	cmdSystem->AddCommand( "listCollisionModels",	Cmd_ListCollisionModels_f,	CMD_FL_GAME,				"lists collision models" );
 	cmdSystem->AddCommand( "collisionModelInfo",	Cmd_CollisionModelInfo_f,	CMD_FL_GAME,				"shows collision model info" );
 	cmdSystem->AddCommand( "reloadanims",			Cmd_ReloadAnims_f,			CMD_FL_GAME | CMD_FL_CHEAT,	"reloads animations" );
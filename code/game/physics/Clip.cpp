@@ -1408,6 +1408,102 @@ bool idClip::Translation( trace_t& results, const idVec3& start, const idVec3& e
 	return ( results.fraction < 1.0f );
 }
 
+/*
+============
+idClip::TracePoints
+============
+*/
+int idClip::TracePoints( trace_t* results, const idVec3* starts, const idVec3* ends, const int numPoints,
+						 int contentMask, const idEntity* passEntity )
+{
+	int i, n, num, numHits;
+	idClipModel* touch, *clipModelList[MAX_GENTITIES];
+	idBounds traceBounds;
+	trace_t trace;
+
+	if( numPoints <= 0 )
+	{
+		return 0;
+	}
+
+	if( !passEntity || passEntity->entityNumber != ENTITYNUM_WORLD )
+	{
+		// test world, the rays are traced together in packets
+		idClip::numTranslations += numPoints;
+		collisionModelManager->TracePoints( results, starts, ends, numPoints, contentMask, 0, vec3_origin, mat3_default );
+		for( n = 0; n < numPoints; n++ )
+		{
+			results[n].c.entityNum = results[n].fraction != 1.0f ? ENTITYNUM_WORLD : ENTITYNUM_NONE;
+		}
+	}
+	else
+	{
+		memset( results, 0, numPoints * sizeof( results[0] ) );
+		for( n = 0; n < numPoints; n++ )
+		{
+			results[n].fraction = 1.0f;
+			results[n].endpos = ends[n];
+			results[n].endAxis = mat3_identity;
+		}
+	}
+
+	numHits = 0;
+	for( n = 0; n < numPoints; n++ )
+	{
+		trace_t& result = results[n];
+
+		if( result.fraction == 0.0f )
+		{
+			numHits++;
+			continue;		// blocked immediately by the world
+		}
+
+		traceBounds.FromPointTranslation( starts[n], result.endpos - starts[n] );
+
+		num = GetTraceClipModels( traceBounds, contentMask, passEntity, clipModelList );
+
+		for( i = 0; i < num; i++ )
+		{
+			touch = clipModelList[i];
+
+			if( !touch )
+			{
+				continue;
+			}
+
+			if( touch->renderModelHandle != -1 )
+			{
+				idClip::numRenderModelTraces++;
+				TraceRenderModel( trace, starts[n], ends[n], 0.0f, mat3_identity, touch );
+			}
+			else
+			{
+				idClip::numTranslations++;
+				collisionModelManager->Translation( &trace, starts[n], ends[n], NULL, mat3_identity, contentMask,
+													touch->Handle(), touch->origin, touch->axis );
+			}
+
+			if( trace.fraction < result.fraction )
+			{
+				result = trace;
+				result.c.entityNum = touch->entity->entityNumber;
+				result.c.id = touch->id;
+				if( result.fraction == 0.0f )
+				{
+					break;
+				}
+			}
+		}
+
+		if( result.fraction < 1.0f )
+		{
+			numHits++;
+		}
+	}
+
+	return numHits;
+}
+
 /*
 ============
 idClip::Rotation
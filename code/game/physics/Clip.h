@@ -302,6 +302,9 @@ public:
 										int contentMask, const idEntity* passEntity );
 	bool					TraceBounds( trace_t& results, const idVec3& start, const idVec3& end, const idBounds& bounds,
 										 int contentMask, const idEntity* passEntity );
+	// traces a batch of points, returns the number of traces that hit something
+	int						TracePoints( trace_t* results, const idVec3* starts, const idVec3* ends, const int numPoints,
+										 int contentMask, const idEntity* passEntity );
 
 	// clip versus a specific model
 	void					TranslationModel( trace_t& results, const idVec3& start, const idVec3& end,
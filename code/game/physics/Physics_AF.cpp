@@ -5747,68 +5747,83 @@ void idPhysics_AF::AuxiliaryForces( float timeStep )
 		}
 	}
 
-	// NOTE: the rows are 16 byte padded
-	jmk.SetData( numAuxConstraints, ( ( numAuxConstraints + 3 ) & ~3 ), MATX_ALLOCA( numAuxConstraints * ( ( numAuxConstraints + 3 ) & ~3 ) ) );
+	const int sparseMode = af_useSparseLCP.GetInteger();
+	const bool useSparse = ( sparseMode == 2 || ( sparseMode == 1 && sparseLCP ) );
+	const bool testSparse = af_testSparseLCP.GetBool();
+	const bool buildDense = !useSparse || testSparse;
+	const bool buildSparse = useSparse || testSparse;
+
 	tmp.SetData( 6, VECX_ALLOCA( 6 ) );
 
-	// create constraint matrix for auxiliary constraints using a mass matrix adjusted for the primary constraints
-	for( k = 0, i = 0; i < auxiliaryConstraints.Num(); i++ )
+	if( buildDense )
 	{
-		constraint = auxiliaryConstraints[i];
+		// NOTE: the rows are 16 byte padded
+		jmk.SetData( numAuxConstraints, ( ( numAuxConstraints + 3 ) & ~3 ), MATX_ALLOCA( numAuxConstraints * ( ( numAuxConstraints + 3 ) & ~3 ) ) );
 
-		for( j = 0; j < constraint->J1.GetNumRows(); j++, k++ )
+		// create constraint matrix for auxiliary constraints using a mass matrix adjusted for the primary constraints
+		for( k = 0, i = 0; i < auxiliaryConstraints.Num(); i++ )
 		{
-			constraint->body1->InverseWorldSpatialInertiaMultiply( tmp, constraint->J1[j] );
-			j1 = tmp.ToFloatPtr();
-			ptr = constraint->body1->response;
-			index = constraint->body1->responseIndex;
-			dstPtr = jmk[k];
-			s = af_useSymmetry.GetBool() ? k + 1 : numAuxConstraints;
-			for( l = n = 0, m = index[n]; n < constraint->body1->numResponses && m < s; n++, m = index[n] )
+			constraint = auxiliaryConstraints[i];
+
+			for( j = 0; j < constraint->J1.GetNumRows(); j++, k++ )
 			{
-				while( l < m )
+				constraint->body1->InverseWorldSpatialInertiaMultiply( tmp, constraint->J1[j] );
+				j1 = tmp.ToFloatPtr();
+				ptr = constraint->body1->response;
+				index = constraint->body1->responseIndex;
+				dstPtr = jmk[k];
+				s = af_useSymmetry.GetBool() ? k + 1 : numAuxConstraints;
+				for( l = n = 0, m = index[n]; n < constraint->body1->numResponses && m < s; n++, m = index[n] )
+				{
+					while( l < m )
+					{
+						dstPtr[l++] = 0.0f;
+					}
+					dstPtr[l++] = j1[0] * ptr[0] + j1[1] * ptr[1] + j1[2] * ptr[2] +
+								  j1[3] * ptr[3] + j1[4] * ptr[4] + j1[5] * ptr[5];
+					ptr += 8;
+				}
+
+				while( l < s )
 				{
 					dstPtr[l++] = 0.0f;
 				}
-				dstPtr[l++] = j1[0] * ptr[0] + j1[1] * ptr[1] + j1[2] * ptr[2] +
-							  j1[3] * ptr[3] + j1[4] * ptr[4] + j1[5] * ptr[5];
-				ptr += 8;
-			}
 
-			while( l < s )
-			{
-				dstPtr[l++] = 0.0f;
+				if( constraint->body2 )
+				{
+					constraint->body2->InverseWorldSpatialInertiaMultiply( tmp, constraint->J2[j] );
+					j2 = tmp.ToFloatPtr();
+					ptr = constraint->body2->response;
+					index = constraint->body2->responseIndex;
+					for( n = 0, m = index[n]; n < constraint->body2->numResponses && m < s; n++, m = index[n] )
+					{
+						dstPtr[m] += j2[0] * ptr[0] + j2[1] * ptr[1] + j2[2] * ptr[2] +
+									 j2[3] * ptr[3] + j2[4] * ptr[4] + j2[5] * ptr[5];
+						ptr += 8;
+					}
+				}
 			}
+		}
 
-			if( constraint->body2 )
+		if( af_useSymmetry.GetBool() )
+		{
+			n = jmk.GetNumColumns();
+			for( i = 0; i < numAuxConstraints; i++ )
 			{
-				constraint->body2->InverseWorldSpatialInertiaMultiply( tmp, constraint->J2[j] );
-				j2 = tmp.ToFloatPtr();
-				ptr = constraint->body2->response;
-				index = constraint->body2->responseIndex;
-				for( n = 0, m = index[n]; n < constraint->body2->numResponses && m < s; n++, m = index[n] )
+				ptr = jmk.ToFloatPtr() + ( i + 1 ) * n + i;
+				dstPtr = jmk.ToFloatPtr() + i * n + i + 1;
+				for( j = i + 1; j < numAuxConstraints; j++ )
 				{
-					dstPtr[m] += j2[0] * ptr[0] + j2[1] * ptr[1] + j2[2] * ptr[2] +
-								 j2[3] * ptr[3] + j2[4] * ptr[4] + j2[5] * ptr[5];
-					ptr += 8;
+					*dstPtr++ = *ptr;
+					ptr += n;
 				}
 			}
 		}
 	}
 
-	if( af_useSymmetry.GetBool() )
+	if( buildSparse )
 	{
-		n = jmk.GetNumColumns();
-		for( i = 0; i < numAuxConstraints; i++ )
-		{
-			ptr = jmk.ToFloatPtr() + ( i + 1 ) * n + i;
-			dstPtr = jmk.ToFloatPtr() + i * n + i + 1;
-			for( j = i + 1; j < numAuxConstraints; j++ )
-			{
-				*dstPtr++ = *ptr;
-				ptr += n;
-			}
-		}
+		BuildSparseConstraintMatrix( numAuxConstraints );
 	}
 
 	invStep = 1.0f / timeStep;
@@ -5872,7 +5887,16 @@ void idPhysics_AF::AuxiliaryForces( float timeStep )
 			{
 				boxIndex[k] = -1;
 			}
-			jmk[k][k] += constraint->e[j] * invStep;
+			if( buildDense )
+			{
+				jmk[k][k] += constraint->e[j] * invStep;
+			}
+			if( buildSparse )
+			{
+				sparseMatrix.AddToDiagonal( k, constraint->e[j] * invStep );
+				// the iterative solver starts from the forces of the previous frame
+				lm[k] = constraint->lm[j];
+			}
 		}
 	}
 
@@ -5881,7 +5905,22 @@ void idPhysics_AF::AuxiliaryForces( float timeStep )
 #endif
 
 	// calculate lagrange multipliers for auxiliary constraints
-	if( !lcp->Solve( jmk, lm, rhs, lo, hi, boxIndex ) )
+	if( testSparse )
+	{
+		// solves with both solvers and keeps the dense solution
+		if( !TestSparseLCP( jmk, lm, rhs, lo, hi, boxIndex ) )
+		{
+			return;
+		}
+	}
+	else if( useSparse )
+	{
+		if( !sparseLcp->SolveSparse( sparseMatrix, lm, rhs, lo, hi, boxIndex ) )
+		{
+			return;
+		}
+	}
+	else if( !lcp->Solve( jmk, lm, rhs, lo, hi, boxIndex ) )
 	{
 		return;		// bad monkey!
 	}
@@ -5934,6 +5973,139 @@ void idPhysics_AF::AuxiliaryForces( float timeStep )
 	}
 }
 
+/*
+================
+idPhysics_AF::BuildSparseConstraintMatrix
+
+  same as the dense constraint matrix for auxiliary constraints but only stores the
+  entries for which the constrained bodies have a response
+================
+*/
+void idPhysics_AF::BuildSparseConstraintMatrix( int numAuxConstraints )
+{
+	int i, j, k, m, m1, m2, n1, n2, s, num1, num2;
+	const int* index1, *index2;
+	const float* ptr1, *ptr2, *j1, *j2;
+	float value;
+	idAFConstraint* constraint;
+	idVecX tmp1, tmp2;
+
+	const bool useSymmetry = af_useSymmetry.GetBool();
+	idLCPSparseMatrix& matrix = useSymmetry ? sparseLower : sparseMatrix;
+
+	tmp1.SetData( 6, VECX_ALLOCA( 6 ) );
+	tmp2.SetData( 6, VECX_ALLOCA( 6 ) );
+
+	matrix.Clear();
+	for( k = 0, i = 0; i < auxiliaryConstraints.Num(); i++ )
+	{
+		constraint = auxiliaryConstraints[i];
+
+		for( j = 0; j < constraint->J1.GetNumRows(); j++, k++ )
+		{
+			s = useSymmetry ? k + 1 : numAuxConstraints;
+
+			constraint->body1->InverseWorldSpatialInertiaMultiply( tmp1, constraint->J1[j] );
+			j1 = tmp1.ToFloatPtr();
+			ptr1 = constraint->body1->response;
+			index1 = constraint->body1->responseIndex;
+			num1 = constraint->body1->numResponses;
+
+			if( constraint->body2 )
+			{
+				constraint->body2->InverseWorldSpatialInertiaMultiply( tmp2, constraint->J2[j] );
+				j2 = tmp2.ToFloatPtr();
+				ptr2 = constraint->body2->response;
+				index2 = constraint->body2->responseIndex;
+				num2 = constraint->body2->numResponses;
+			}
+			else
+			{
+				j2 = ptr2 = NULL;
+				index2 = NULL;
+				num2 = 0;
+			}
+
+			// merge the responses of both bodies, the response indices are in increasing order
+			matrix.BeginRow();
+			for( n1 = n2 = 0; ; )
+			{
+				m1 = ( n1 < num1 ) ? index1[n1] : s;
+				m2 = ( n2 < num2 ) ? index2[n2] : s;
+				m = Min( m1, m2 );
+				if( m >= s )
+				{
+					break;
+				}
+				value = 0.0f;
+				if( m1 == m )
+				{
+					value += j1[0] * ptr1[0] + j1[1] * ptr1[1] + j1[2] * ptr1[2] +
+							 j1[3] * ptr1[3] + j1[4] * ptr1[4] + j1[5] * ptr1[5];
+					ptr1 += 8;
+					n1++;
+				}
+				if( m2 == m )
+				{
+					value += j2[0] * ptr2[0] + j2[1] * ptr2[1] + j2[2] * ptr2[2] +
+							 j2[3] * ptr2[3] + j2[4] * ptr2[4] + j2[5] * ptr2[5];
+					ptr2 += 8;
+					n2++;
+				}
+				matrix.AddEntry( m, value );
+			}
+			matrix.EndRow();
+		}
+	}
+
+	if( useSymmetry )
+	{
+		sparseMatrix.SymmetricFromLower( sparseLower );
+	}
+}
+
+/*
+================
+idPhysics_AF::TestSparseLCP
+
+  solves the auxiliary constraints with both solvers, keeps the dense solution and
+  prints how the sparse solver compares
+================
+*/
+bool idPhysics_AF::TestSparseLCP( const idMatX& jmk, idVecX& lm, const idVecX& rhs, const idVecX& lo, const idVecX& hi, const int* boxIndex )
+{
+	int i, n;
+	bool denseSolved, sparseSolved;
+	float maxError, maxForce;
+	idVecX sparseLm;
+	idTimer timerDense, timerSparse;
+
+	n = lm.GetSize();
+	sparseLm.SetData( n, VECX_ALLOCA( n ) );
+	memcpy( sparseLm.ToFloatPtr(), lm.ToFloatPtr(), n * sizeof( float ) );
+
+	timerSparse.Start();
+	sparseSolved = sparseLcp->SolveSparse( sparseMatrix, sparseLm, rhs, lo, hi, boxIndex );
+	timerSparse.Stop();
+
+	timerDense.Start();
+	denseSolved = lcp->Solve( jmk, lm, rhs, lo, hi, boxIndex );
+	timerDense.Stop();
+
+	maxError = maxForce = 0.0f;
+	for( i = 0; i < n; i++ )
+	{
+		maxError = Max( maxError, idMath::Fabs( lm[i] - sparseLm[i] ) );
+		maxForce = Max( maxForce, idMath::Fabs( lm[i] ) );
+	}
+
+	gameLocal.Printf( "%12s: lcp %1.4f sparse lcp %1.4f entries %d of %d error %1.4f of %1.4f%s\n",
+					  self->name.c_str(), timerDense.Milliseconds(), timerSparse.Milliseconds(),
+					  sparseMatrix.GetNumEntries(), n * n, maxError, maxForce, sparseSolved ? "" : " failed" );
+
+	return denseSolved;
+}
+
 /*
 ================
 idPhysics_AF::VerifyContactConstraints
@@ -7478,6 +7650,7 @@ idPhysics_AF::idPhysics_AF()
 	masterBody = NULL;
 
 	lcp = idLCP::AllocSymmetric();
+	sparseLcp = idLCP::AllocGaussSeidel();
 
 	memset( &current, 0, sizeof( current ) );
 	current.atRest = -1;
@@ -7520,6 +7693,7 @@ idPhysics_AF::idPhysics_AF()
 	selfCollision = true;
 	comeToRest = true;
 	linearTime = true;
+	sparseLCP = false;
 	noImpact = false;
 	worldConstraintsLocked = false;
 	forcePushable = false;
@@ -7557,6 +7731,7 @@ idPhysics_AF::~idPhysics_AF()
 	}
 
 	delete lcp;
+	delete sparseLcp;
 
 	if( masterBody )
 	{
@@ -1067,6 +1067,11 @@ public:
 	{
 		comeToRest = enable;
 	}
+	// enable or disable the sparse iterative lcp solver for the auxiliary constraints
+	void					SetSparseLCP( bool enable )
+	{
+		sparseLCP = enable;
+	}
 	// call when structure of articulated figure changes
 	void					SetChanged()
 	{
@@ -1204,6 +1209,7 @@ private:
 	bool					selfCollision;					// if true the self collision is allowed
 	bool					comeToRest;						// if true the figure can come to rest
 	bool					linearTime;						// if true use the linear time algorithm
+	bool					sparseLCP;						// if true use the sparse lcp solver when af_useSparseLCP is 1
 	bool					noImpact;						// if true do not activate when another object collides
 	bool					worldConstraintsLocked;			// if true world constraints cannot be moved
 	bool					forcePushable;					// if true can be pushed even when bound to a master
@@ -1214,6 +1220,9 @@ private:
 
 	idAFBody* 				masterBody;						// master body
 	idLCP* 					lcp;							// linear complementarity problem solver
+	idLCP* 					sparseLcp;						// iterative solver for the sparse constraint matrix
+	idLCPSparseMatrix		sparseLower;					// lower triangle of the sparse constraint matrix when using symmetry
+	idLCPSparseMatrix		sparseMatrix;					// sparse constraint matrix for auxiliary constraints
 
 private:
 	void					BuildTrees();
@@ -1226,6 +1235,8 @@ private:
 	void					ApplyFriction( float timeStep, float endTimeMSec );
 	void					PrimaryForces( float timeStep );
 	void					AuxiliaryForces( float timeStep );
+	void					BuildSparseConstraintMatrix( int numAuxConstraints );
+	bool					TestSparseLCP( const idMatX& jmk, idVecX& lm, const idVecX& rhs, const idVecX& lo, const idVecX& hi, const int* boxIndex );
 	void					VerifyContactConstraints();
 	void					SetupContactConstraints();
 	void					ApplyContactForces();
@@ -33,6 +33,8 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "../Game_local.h"
 
+int64 idInterpreter::statementsExecuted = 0;
+
 /*
 ================
 idInterpreter::idInterpreter()
@@ -1120,6 +1122,60 @@ void idInterpreter::CallSysEvent( const function_t* func, int argsize )
 	popParms = 0;
 }
 
+/*
+================================================================================================
+
+	Statement dispatch
+
+	With GCC and Clang the interpreter is direct threaded: every opcode handler fetches the
+	next statement and jumps straight to its handler through a table of label addresses
+	instead of going back to the top of the switch. This removes the bounds check and the
+	shared, badly predicted indirect branch of the switch. Other compilers use the switch.
+
+================================================================================================
+*/
+
+#if defined( __GNUC__ ) || defined( __clang__ )
+	#define SCRIPT_THREADED_DISPATCH
+#endif
+
+#ifdef SCRIPT_THREADED_DISPATCH
+#define SCRIPT_LABEL( op )	L_##op:
+
+#define NEXT_STATEMENT											\
+		if( doneProcessing || threadDying )							\
+		{															\
+			goto finished;											\
+		}															\
+		instructionPointer++;										\
+		if( !--runaway )											\
+		{															\
+			Error( "runaway loop error" );							\
+		}															\
+		st = &statements[ instructionPointer ];						\
+		goto *dispatchTable[ st->op ]
+#else
+#define SCRIPT_LABEL( op )
+#define NEXT_STATEMENT		break
+#endif
+
+// field reads flagged by idProgram::FuseStatements also run the OP_IF / OP_IFNOT that tests the result,
+// which counts against runaway and statementsExecuted like any other statement
+#define FUSED_BRANCH( result )												\
+	if( st->flags & statement_t::FLAG_FUSED_BRANCH )						\
+	{																		\
+		instructionPointer++;												\
+		if( !--runaway )													\
+		{																	\
+			Error( "runaway loop error" );									\
+		}																	\
+		st = &statements[ instructionPointer ];								\
+		if( ( *( result ).intPtr != 0 ) == ( st->op == OP_IF ) )			\
+		{																	\
+			NextInstruction( instructionPointer + st->b->value.jumpOffset );	\
+		}																	\
+	}
+
 /*
 ====================
 idInterpreter::Execute
@@ -1137,6 +1193,46 @@ bool idInterpreter::Execute()
 	float		floatVal;
 	idScriptObject* obj;
 	const function_t* func;
+	statement_t*	statements;
+
+#ifdef SCRIPT_THREADED_DISPATCH
+	// handler addresses in opcode order, see the opcode enum in Script_Compiler.h
+	static const void* const dispatchTable[] =
+	{
+		&&L_OP_RETURN, &&L_OP_UINC_F, &&L_OP_UINCP_F, &&L_OP_UDEC_F,
+		&&L_OP_UDECP_F, &&L_OP_COMP_F, &&L_OP_MUL_F, &&L_OP_MUL_V,
+		&&L_OP_MUL_FV, &&L_OP_MUL_VF, &&L_OP_DIV_F, &&L_OP_MOD_F,
+		&&L_OP_ADD_F, &&L_OP_ADD_V, &&L_OP_ADD_S, &&L_OP_ADD_FS,
+		&&L_OP_ADD_SF, &&L_OP_ADD_VS, &&L_OP_ADD_SV, &&L_OP_SUB_F,
+		&&L_OP_SUB_V, &&L_OP_EQ_F, &&L_OP_EQ_V, &&L_OP_EQ_S,
+		&&L_OP_EQ_E, &&L_OP_EQ_EO, &&L_OP_EQ_OE, &&L_OP_EQ_OO,
+		&&L_OP_NE_F, &&L_OP_NE_V, &&L_OP_NE_S, &&L_OP_NE_E,
+		&&L_OP_NE_EO, &&L_OP_NE_OE, &&L_OP_NE_OO, &&L_OP_LE,
+		&&L_OP_GE, &&L_OP_LT, &&L_OP_GT, &&L_OP_INDIRECT_F,
+		&&L_OP_INDIRECT_V, &&L_OP_INDIRECT_S, &&L_OP_INDIRECT_ENT, &&L_OP_INDIRECT_BOOL,
+		&&L_OP_INDIRECT_OBJ, &&L_OP_ADDRESS, &&L_OP_EVENTCALL, &&L_OP_OBJECTCALL,
+		&&L_OP_SYSCALL, &&L_OP_STORE_F, &&L_OP_STORE_V, &&L_OP_STORE_S,
+		&&L_OP_STORE_ENT, &&L_OP_STORE_BOOL, &&L_OP_STORE_OBJENT, &&L_OP_STORE_OBJ,
+		&&L_OP_STORE_ENTOBJ, &&L_OP_STORE_FTOS, &&L_OP_STORE_BTOS, &&L_OP_STORE_VTOS,
+		&&L_OP_STORE_FTOBOOL, &&L_OP_STORE_BOOLTOF, &&L_OP_STOREP_F, &&L_OP_STOREP_V,
+		&&L_OP_STOREP_S, &&L_OP_STOREP_ENT, &&L_OP_STOREP_FLD, &&L_OP_STOREP_BOOL,
+		&&L_OP_STOREP_OBJ, &&L_OP_STOREP_OBJENT, &&L_OP_STOREP_FTOS, &&L_OP_STOREP_BTOS,
+		&&L_OP_STOREP_VTOS, &&L_OP_STOREP_FTOBOOL, &&L_OP_STOREP_BOOLTOF, &&L_OP_UMUL_F,
+		&&L_OP_UMUL_V, &&L_OP_UDIV_F, &&L_OP_UDIV_V, &&L_OP_UMOD_F,
+		&&L_OP_UADD_F, &&L_OP_UADD_V, &&L_OP_USUB_F, &&L_OP_USUB_V,
+		&&L_OP_UAND_F, &&L_OP_UOR_F, &&L_OP_NOT_BOOL, &&L_OP_NOT_F,
+		&&L_OP_NOT_V, &&L_OP_NOT_S, &&L_OP_NOT_ENT, &&L_OP_NEG_F,
+		&&L_OP_NEG_V, &&L_OP_INT_F, &&L_OP_IF, &&L_OP_IFNOT,
+		&&L_OP_CALL, &&L_OP_THREAD, &&L_OP_OBJTHREAD, &&L_OP_PUSH_F,
+		&&L_OP_PUSH_V, &&L_OP_PUSH_S, &&L_OP_PUSH_ENT, &&L_OP_PUSH_OBJ,
+		&&L_OP_PUSH_OBJENT, &&L_OP_PUSH_FTOS, &&L_OP_PUSH_BTOF, &&L_OP_PUSH_FTOB,
+		&&L_OP_PUSH_VTOS, &&L_OP_PUSH_BTOS, &&L_OP_GOTO, &&L_OP_AND,
+		&&L_OP_AND_BOOLF, &&L_OP_AND_FBOOL, &&L_OP_AND_BOOLBOOL, &&L_OP_OR,
+		&&L_OP_OR_BOOLF, &&L_OP_OR_FBOOL, &&L_OP_OR_BOOLBOOL, &&L_OP_BITAND,
+		&&L_OP_BITOR, &&L_OP_BREAK, &&L_OP_CONTINUE,
+	};
+	compile_time_assert( sizeof( dispatchTable ) / sizeof( dispatchTable[0] ) == NUM_OPCODES );
+#endif
 
 	if( threadDying || !currentFunction )
 	{
@@ -1150,6 +1246,7 @@ bool idInterpreter::Execute()
 	}
 
 	runaway = 5000000;
+	statements = &gameLocal.program.GetStatement( 0 );
 
 	doneProcessing = false;
 	while( !doneProcessing && !threadDying )
@@ -1162,24 +1259,27 @@ bool idInterpreter::Execute()
 		}
 
 		// next statement
-		st = &gameLocal.program.GetStatement( instructionPointer );
+		st = &statements[ instructionPointer ];
 
 		switch( st->op )
 		{
 			case OP_RETURN:
+				SCRIPT_LABEL( OP_RETURN );
 				LeaveFunction( st->a );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_THREAD:
+				SCRIPT_LABEL( OP_THREAD );
 				newThread = new idThread( this, st->a->value.functionPtr, st->b->value.argSize );
 				newThread->Start();
 
 				// return the thread number to the script
 				gameLocal.program.ReturnFloat( newThread->GetThreadNum() );
 				PopParms( st->b->value.argSize );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_OBJTHREAD:
+				SCRIPT_LABEL( OP_OBJTHREAD );
 				var_a = GetVariable( st->a );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
 				if( obj )
@@ -1198,17 +1298,20 @@ bool idInterpreter::Execute()
 					gameLocal.program.ReturnFloat( 0.0f );
 				}
 				PopParms( st->c->value.argSize );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_CALL:
+				SCRIPT_LABEL( OP_CALL );
 				EnterFunction( st->a->value.functionPtr, false );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_EVENTCALL:
+				SCRIPT_LABEL( OP_EVENTCALL );
 				CallEvent( st->a->value.functionPtr, st->b->value.argSize );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_OBJECTCALL:
+				SCRIPT_LABEL( OP_OBJECTCALL );
 				var_a = GetVariable( st->a );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
 				if( obj )
@@ -1223,118 +1326,136 @@ bool idInterpreter::Execute()
 					gameLocal.program.ReturnString( "" );
 					PopParms( st->c->value.argSize );
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_SYSCALL:
+				SCRIPT_LABEL( OP_SYSCALL );
 				CallSysEvent( st->a->value.functionPtr, st->b->value.argSize );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_IFNOT:
+				SCRIPT_LABEL( OP_IFNOT );
 				var_a = GetVariable( st->a );
 				if( *var_a.intPtr == 0 )
 				{
 					NextInstruction( instructionPointer + st->b->value.jumpOffset );
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_IF:
+				SCRIPT_LABEL( OP_IF );
 				var_a = GetVariable( st->a );
 				if( *var_a.intPtr != 0 )
 				{
 					NextInstruction( instructionPointer + st->b->value.jumpOffset );
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_GOTO:
+				SCRIPT_LABEL( OP_GOTO );
 				NextInstruction( instructionPointer + st->a->value.jumpOffset );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_ADD_F:
+				SCRIPT_LABEL( OP_ADD_F );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = *var_a.floatPtr + *var_b.floatPtr;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_ADD_V:
+				SCRIPT_LABEL( OP_ADD_V );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.vectorPtr = *var_a.vectorPtr + *var_b.vectorPtr;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_ADD_S:
+				SCRIPT_LABEL( OP_ADD_S );
 				SetString( st->c, GetString( st->a ) );
 				AppendString( st->c, GetString( st->b ) );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_ADD_FS:
+				SCRIPT_LABEL( OP_ADD_FS );
 				var_a = GetVariable( st->a );
 				SetString( st->c, FloatToString( *var_a.floatPtr ) );
 				AppendString( st->c, GetString( st->b ) );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_ADD_SF:
+				SCRIPT_LABEL( OP_ADD_SF );
 				var_b = GetVariable( st->b );
 				SetString( st->c, GetString( st->a ) );
 				AppendString( st->c, FloatToString( *var_b.floatPtr ) );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_ADD_VS:
+				SCRIPT_LABEL( OP_ADD_VS );
 				var_a = GetVariable( st->a );
 				SetString( st->c, var_a.vectorPtr->ToString() );
 				AppendString( st->c, GetString( st->b ) );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_ADD_SV:
+				SCRIPT_LABEL( OP_ADD_SV );
 				var_b = GetVariable( st->b );
 				SetString( st->c, GetString( st->a ) );
 				AppendString( st->c, var_b.vectorPtr->ToString() );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_SUB_F:
+				SCRIPT_LABEL( OP_SUB_F );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = *var_a.floatPtr - *var_b.floatPtr;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_SUB_V:
+				SCRIPT_LABEL( OP_SUB_V );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.vectorPtr = *var_a.vectorPtr - *var_b.vectorPtr;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_MUL_F:
+				SCRIPT_LABEL( OP_MUL_F );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = *var_a.floatPtr** var_b.floatPtr;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_MUL_V:
+				SCRIPT_LABEL( OP_MUL_V );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = *var_a.vectorPtr** var_b.vectorPtr;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_MUL_FV:
+				SCRIPT_LABEL( OP_MUL_FV );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.vectorPtr = *var_a.floatPtr** var_b.vectorPtr;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_MUL_VF:
+				SCRIPT_LABEL( OP_MUL_VF );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.vectorPtr = *var_a.vectorPtr** var_b.floatPtr;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_DIV_F:
+				SCRIPT_LABEL( OP_DIV_F );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
@@ -1348,9 +1469,10 @@ bool idInterpreter::Execute()
 				{
 					*var_c.floatPtr = *var_a.floatPtr / *var_b.floatPtr;
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_MOD_F:
+				SCRIPT_LABEL( OP_MOD_F );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
@@ -1364,250 +1486,293 @@ bool idInterpreter::Execute()
 				{
 					*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) % static_cast<int>( *var_b.floatPtr );
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_BITAND:
+				SCRIPT_LABEL( OP_BITAND );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) & static_cast<int>( *var_b.floatPtr );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_BITOR:
+				SCRIPT_LABEL( OP_BITOR );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) | static_cast<int>( *var_b.floatPtr );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_GE:
+				SCRIPT_LABEL( OP_GE );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr >= *var_b.floatPtr );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_LE:
+				SCRIPT_LABEL( OP_LE );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr <= *var_b.floatPtr );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_GT:
+				SCRIPT_LABEL( OP_GT );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr > *var_b.floatPtr );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_LT:
+				SCRIPT_LABEL( OP_LT );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr < *var_b.floatPtr );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_AND:
+				SCRIPT_LABEL( OP_AND );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.floatPtr != 0.0f );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_AND_BOOLF:
+				SCRIPT_LABEL( OP_AND_BOOLF );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.floatPtr != 0.0f );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_AND_FBOOL:
+				SCRIPT_LABEL( OP_AND_FBOOL );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.intPtr != 0 );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_AND_BOOLBOOL:
+				SCRIPT_LABEL( OP_AND_BOOLBOOL );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.intPtr != 0 );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_OR:
+				SCRIPT_LABEL( OP_OR );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.floatPtr != 0.0f );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_OR_BOOLF:
+				SCRIPT_LABEL( OP_OR_BOOLF );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.floatPtr != 0.0f );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_OR_FBOOL:
+				SCRIPT_LABEL( OP_OR_FBOOL );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.intPtr != 0 );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_OR_BOOLBOOL:
+				SCRIPT_LABEL( OP_OR_BOOLBOOL );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.intPtr != 0 );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_NOT_BOOL:
+				SCRIPT_LABEL( OP_NOT_BOOL );
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.intPtr == 0 );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_NOT_F:
+				SCRIPT_LABEL( OP_NOT_F );
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr == 0.0f );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_NOT_V:
+				SCRIPT_LABEL( OP_NOT_V );
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.vectorPtr == vec3_zero );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_NOT_S:
+				SCRIPT_LABEL( OP_NOT_S );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( strlen( GetString( st->a ) ) == 0 );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_NOT_ENT:
+				SCRIPT_LABEL( OP_NOT_ENT );
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( GetEntity( *var_a.entityNumberPtr ) == NULL );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_NEG_F:
+				SCRIPT_LABEL( OP_NEG_F );
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = -*var_a.floatPtr;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_NEG_V:
+				SCRIPT_LABEL( OP_NEG_V );
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				*var_c.vectorPtr = -*var_a.vectorPtr;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_INT_F:
+				SCRIPT_LABEL( OP_INT_F );
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = static_cast<int>( *var_a.floatPtr );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_EQ_F:
+				SCRIPT_LABEL( OP_EQ_F );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr == *var_b.floatPtr );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_EQ_V:
+				SCRIPT_LABEL( OP_EQ_V );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.vectorPtr == *var_b.vectorPtr );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_EQ_S:
+				SCRIPT_LABEL( OP_EQ_S );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( idStr::Cmp( GetString( st->a ), GetString( st->b ) ) == 0 );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_EQ_E:
+				SCRIPT_LABEL( OP_EQ_E );
 			case OP_EQ_EO:
+				SCRIPT_LABEL( OP_EQ_EO );
 			case OP_EQ_OE:
+				SCRIPT_LABEL( OP_EQ_OE );
 			case OP_EQ_OO:
+				SCRIPT_LABEL( OP_EQ_OO );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.entityNumberPtr == *var_b.entityNumberPtr );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_NE_F:
+				SCRIPT_LABEL( OP_NE_F );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr != *var_b.floatPtr );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_NE_V:
+				SCRIPT_LABEL( OP_NE_V );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.vectorPtr != *var_b.vectorPtr );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_NE_S:
+				SCRIPT_LABEL( OP_NE_S );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( idStr::Cmp( GetString( st->a ), GetString( st->b ) ) != 0 );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_NE_E:
+				SCRIPT_LABEL( OP_NE_E );
 			case OP_NE_EO:
+				SCRIPT_LABEL( OP_NE_EO );
 			case OP_NE_OE:
+				SCRIPT_LABEL( OP_NE_OE );
 			case OP_NE_OO:
+				SCRIPT_LABEL( OP_NE_OO );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.entityNumberPtr != *var_b.entityNumberPtr );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_UADD_F:
+				SCRIPT_LABEL( OP_UADD_F );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.floatPtr += *var_a.floatPtr;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_UADD_V:
+				SCRIPT_LABEL( OP_UADD_V );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.vectorPtr += *var_a.vectorPtr;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_USUB_F:
+				SCRIPT_LABEL( OP_USUB_F );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.floatPtr -= *var_a.floatPtr;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_USUB_V:
+				SCRIPT_LABEL( OP_USUB_V );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.vectorPtr -= *var_a.vectorPtr;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_UMUL_F:
+				SCRIPT_LABEL( OP_UMUL_F );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.floatPtr *= *var_a.floatPtr;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_UMUL_V:
+				SCRIPT_LABEL( OP_UMUL_V );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.vectorPtr *= *var_a.floatPtr;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_UDIV_F:
+				SCRIPT_LABEL( OP_UDIV_F );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 
@@ -1620,9 +1785,10 @@ bool idInterpreter::Execute()
 				{
 					*var_b.floatPtr = *var_b.floatPtr / *var_a.floatPtr;
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_UDIV_V:
+				SCRIPT_LABEL( OP_UDIV_V );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 
@@ -1635,9 +1801,10 @@ bool idInterpreter::Execute()
 				{
 					*var_b.vectorPtr = *var_b.vectorPtr / *var_a.floatPtr;
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_UMOD_F:
+				SCRIPT_LABEL( OP_UMOD_F );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 
@@ -1650,26 +1817,30 @@ bool idInterpreter::Execute()
 				{
 					*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) % static_cast<int>( *var_a.floatPtr );
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_UOR_F:
+				SCRIPT_LABEL( OP_UOR_F );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) | static_cast<int>( *var_a.floatPtr );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_UAND_F:
+				SCRIPT_LABEL( OP_UAND_F );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) & static_cast<int>( *var_a.floatPtr );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_UINC_F:
+				SCRIPT_LABEL( OP_UINC_F );
 				var_a = GetVariable( st->a );
 				( *var_a.floatPtr )++;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_UINCP_F:
+				SCRIPT_LABEL( OP_UINCP_F );
 				var_a = GetVariable( st->a );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
 				if( obj )
@@ -1677,14 +1848,16 @@ bool idInterpreter::Execute()
 					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
 					( *var.floatPtr )++;
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_UDEC_F:
+				SCRIPT_LABEL( OP_UDEC_F );
 				var_a = GetVariable( st->a );
 				( *var_a.floatPtr )--;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_UDECP_F:
+				SCRIPT_LABEL( OP_UDECP_F );
 				var_a = GetVariable( st->a );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
 				if( obj )
@@ -1692,33 +1865,38 @@ bool idInterpreter::Execute()
 					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
 					( *var.floatPtr )--;
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_COMP_F:
+				SCRIPT_LABEL( OP_COMP_F );
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ~static_cast<int>( *var_a.floatPtr );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STORE_F:
+				SCRIPT_LABEL( OP_STORE_F );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.floatPtr = *var_a.floatPtr;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STORE_ENT:
+				SCRIPT_LABEL( OP_STORE_ENT );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.entityNumberPtr = *var_a.entityNumberPtr;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STORE_BOOL:
+				SCRIPT_LABEL( OP_STORE_BOOL );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.intPtr = *var_a.intPtr;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STORE_OBJENT:
+				SCRIPT_LABEL( OP_STORE_OBJENT );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
@@ -1735,41 +1913,49 @@ bool idInterpreter::Execute()
 				{
 					*var_b.entityNumberPtr = *var_a.entityNumberPtr;
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STORE_OBJ:
+				SCRIPT_LABEL( OP_STORE_OBJ );
 			case OP_STORE_ENTOBJ:
+				SCRIPT_LABEL( OP_STORE_ENTOBJ );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.entityNumberPtr = *var_a.entityNumberPtr;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STORE_S:
+				SCRIPT_LABEL( OP_STORE_S );
 				SetString( st->b, GetString( st->a ) );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STORE_V:
+				SCRIPT_LABEL( OP_STORE_V );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.vectorPtr = *var_a.vectorPtr;
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STORE_FTOS:
+				SCRIPT_LABEL( OP_STORE_FTOS );
 				var_a = GetVariable( st->a );
 				SetString( st->b, FloatToString( *var_a.floatPtr ) );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STORE_BTOS:
+				SCRIPT_LABEL( OP_STORE_BTOS );
 				var_a = GetVariable( st->a );
 				SetString( st->b, *var_a.intPtr ? "true" : "false" );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STORE_VTOS:
+				SCRIPT_LABEL( OP_STORE_VTOS );
 				var_a = GetVariable( st->a );
 				SetString( st->b, var_a.vectorPtr->ToString() );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STORE_FTOBOOL:
+				SCRIPT_LABEL( OP_STORE_FTOBOOL );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				if( *var_a.floatPtr != 0.0f )
@@ -1780,77 +1966,86 @@ bool idInterpreter::Execute()
 				{
 					*var_b.intPtr = 0;
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STORE_BOOLTOF:
+				SCRIPT_LABEL( OP_STORE_BOOLTOF );
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.floatPtr = static_cast<float>( *var_a.intPtr );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STOREP_F:
+				SCRIPT_LABEL( OP_STOREP_F );
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->floatPtr )
 				{
 					var_a = GetVariable( st->a );
 					*var_b.evalPtr->floatPtr = *var_a.floatPtr;
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STOREP_ENT:
+				SCRIPT_LABEL( OP_STOREP_ENT );
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->entityNumberPtr )
 				{
 					var_a = GetVariable( st->a );
 					*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STOREP_FLD:
+				SCRIPT_LABEL( OP_STOREP_FLD );
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->intPtr )
 				{
 					var_a = GetVariable( st->a );
 					*var_b.evalPtr->intPtr = *var_a.intPtr;
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STOREP_BOOL:
+				SCRIPT_LABEL( OP_STOREP_BOOL );
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->intPtr )
 				{
 					var_a = GetVariable( st->a );
 					*var_b.evalPtr->intPtr = *var_a.intPtr;
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STOREP_S:
+				SCRIPT_LABEL( OP_STOREP_S );
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->stringPtr )
 				{
 					idStr::Copynz( var_b.evalPtr->stringPtr, GetString( st->a ), MAX_STRING_LEN );
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STOREP_V:
+				SCRIPT_LABEL( OP_STOREP_V );
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->vectorPtr )
 				{
 					var_a = GetVariable( st->a );
 					*var_b.evalPtr->vectorPtr = *var_a.vectorPtr;
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STOREP_FTOS:
+				SCRIPT_LABEL( OP_STOREP_FTOS );
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->stringPtr )
 				{
 					var_a = GetVariable( st->a );
 					idStr::Copynz( var_b.evalPtr->stringPtr, FloatToString( *var_a.floatPtr ), MAX_STRING_LEN );
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STOREP_BTOS:
+				SCRIPT_LABEL( OP_STOREP_BTOS );
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->stringPtr )
 				{
@@ -1864,18 +2059,20 @@ bool idInterpreter::Execute()
 						idStr::Copynz( var_b.evalPtr->stringPtr, "false", MAX_STRING_LEN );
 					}
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STOREP_VTOS:
+				SCRIPT_LABEL( OP_STOREP_VTOS );
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->stringPtr )
 				{
 					var_a = GetVariable( st->a );
 					idStr::Copynz( var_b.evalPtr->stringPtr, var_a.vectorPtr->ToString(), MAX_STRING_LEN );
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STOREP_FTOBOOL:
+				SCRIPT_LABEL( OP_STOREP_FTOBOOL );
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->intPtr )
 				{
@@ -1889,27 +2086,30 @@ bool idInterpreter::Execute()
 						*var_b.evalPtr->intPtr = 0;
 					}
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STOREP_BOOLTOF:
+				SCRIPT_LABEL( OP_STOREP_BOOLTOF );
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->floatPtr )
 				{
 					var_a = GetVariable( st->a );
 					*var_b.evalPtr->floatPtr = static_cast<float>( *var_a.intPtr );
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STOREP_OBJ:
+				SCRIPT_LABEL( OP_STOREP_OBJ );
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->entityNumberPtr )
 				{
 					var_a = GetVariable( st->a );
 					*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_STOREP_OBJENT:
+				SCRIPT_LABEL( OP_STOREP_OBJENT );
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->entityNumberPtr )
 				{
@@ -1933,9 +2133,10 @@ bool idInterpreter::Execute()
 						*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
 					}
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_ADDRESS:
+				SCRIPT_LABEL( OP_ADDRESS );
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
@@ -1947,9 +2148,10 @@ bool idInterpreter::Execute()
 				{
 					var_c.evalPtr->bytePtr = NULL;
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_INDIRECT_F:
+				SCRIPT_LABEL( OP_INDIRECT_F );
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
@@ -1962,9 +2164,11 @@ bool idInterpreter::Execute()
 				{
 					*var_c.floatPtr = 0.0f;
 				}
-				break;
+				FUSED_BRANCH( var_c );
+				NEXT_STATEMENT;
 
 			case OP_INDIRECT_ENT:
+				SCRIPT_LABEL( OP_INDIRECT_ENT );
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
@@ -1977,9 +2181,11 @@ bool idInterpreter::Execute()
 				{
 					*var_c.entityNumberPtr = 0;
 				}
-				break;
+				FUSED_BRANCH( var_c );
+				NEXT_STATEMENT;
 
 			case OP_INDIRECT_BOOL:
+				SCRIPT_LABEL( OP_INDIRECT_BOOL );
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
@@ -1992,9 +2198,11 @@ bool idInterpreter::Execute()
 				{
 					*var_c.intPtr = 0;
 				}
-				break;
+				FUSED_BRANCH( var_c );
+				NEXT_STATEMENT;
 
 			case OP_INDIRECT_S:
+				SCRIPT_LABEL( OP_INDIRECT_S );
 				var_a = GetVariable( st->a );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
 				if( obj )
@@ -2006,9 +2214,10 @@ bool idInterpreter::Execute()
 				{
 					SetString( st->c, "" );
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_INDIRECT_V:
+				SCRIPT_LABEL( OP_INDIRECT_V );
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
@@ -2021,9 +2230,10 @@ bool idInterpreter::Execute()
 				{
 					var_c.vectorPtr->Zero();
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_INDIRECT_OBJ:
+				SCRIPT_LABEL( OP_INDIRECT_OBJ );
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
@@ -2036,25 +2246,49 @@ bool idInterpreter::Execute()
 					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
 					*var_c.entityNumberPtr = *var.entityNumberPtr;
 				}
-				break;
+				FUSED_BRANCH( var_c );
+				NEXT_STATEMENT;
 
 			case OP_PUSH_F:
+				SCRIPT_LABEL( OP_PUSH_F );
+			case OP_PUSH_ENT:
+				SCRIPT_LABEL( OP_PUSH_ENT );
+			case OP_PUSH_OBJ:
+				SCRIPT_LABEL( OP_PUSH_OBJ );
+			case OP_PUSH_OBJENT:
+				SCRIPT_LABEL( OP_PUSH_OBJENT );
 				var_a = GetVariable( st->a );
 				Push( *var_a.intPtr );
-				break;
+
+				// push the rest of the event or function arguments without dispatching each one
+				while( st->flags & statement_t::FLAG_FUSED_PUSH )
+				{
+					instructionPointer++;
+					if( !--runaway )
+					{
+						Error( "runaway loop error" );
+					}
+					st = &statements[ instructionPointer ];
+					var_a = GetVariable( st->a );
+					Push( *var_a.intPtr );
+				}
+				NEXT_STATEMENT;
 
 			case OP_PUSH_FTOS:
+				SCRIPT_LABEL( OP_PUSH_FTOS );
 				var_a = GetVariable( st->a );
 				PushString( FloatToString( *var_a.floatPtr ) );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_PUSH_BTOF:
+				SCRIPT_LABEL( OP_PUSH_BTOF );
 				var_a = GetVariable( st->a );
 				floatVal = *var_a.intPtr;
 				Push( *reinterpret_cast<int*>( &floatVal ) );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_PUSH_FTOB:
+				SCRIPT_LABEL( OP_PUSH_FTOB );
 				var_a = GetVariable( st->a );
 				if( *var_a.floatPtr != 0.0f )
 				{
@@ -2064,28 +2298,27 @@ bool idInterpreter::Execute()
 				{
 					Push( 0 );
 				}
-				break;
+				NEXT_STATEMENT;
 
 			case OP_PUSH_VTOS:
+				SCRIPT_LABEL( OP_PUSH_VTOS );
 				var_a = GetVariable( st->a );
 				PushString( var_a.vectorPtr->ToString() );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_PUSH_BTOS:
+				SCRIPT_LABEL( OP_PUSH_BTOS );
 				var_a = GetVariable( st->a );
 				PushString( *var_a.intPtr ? "true" : "false" );
-				break;
-
-			case OP_PUSH_ENT:
-				var_a = GetVariable( st->a );
-				Push( *var_a.entityNumberPtr );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_PUSH_S:
+				SCRIPT_LABEL( OP_PUSH_S );
 				PushString( GetString( st->a ) );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_PUSH_V:
+				SCRIPT_LABEL( OP_PUSH_V );
 				var_a = GetVariable( st->a );
 				// RB: 64 bit fix, changed individual pushes with PushVector
 				/*
@@ -2095,26 +2328,23 @@ bool idInterpreter::Execute()
 				*/
 				PushVector( *var_a.vectorPtr );
 				// RB end
-				break;
-
-			case OP_PUSH_OBJ:
-				var_a = GetVariable( st->a );
-				Push( *var_a.entityNumberPtr );
-				break;
-
-			case OP_PUSH_OBJENT:
-				var_a = GetVariable( st->a );
-				Push( *var_a.entityNumberPtr );
-				break;
+				NEXT_STATEMENT;
 
 			case OP_BREAK:
+				SCRIPT_LABEL( OP_BREAK );
 			case OP_CONTINUE:
+				SCRIPT_LABEL( OP_CONTINUE );
 			default:
 				Error( "Bad opcode %i", st->op );
-				break;
+				NEXT_STATEMENT;
 		}
 	}
 
+#ifdef SCRIPT_THREADED_DISPATCH
+finished:
+#endif
+	statementsExecuted += 5000000 - runaway;
+
 	return threadDying;
 }
 
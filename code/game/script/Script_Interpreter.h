@@ -94,6 +94,8 @@ public:
 	bool				terminateOnExit;
 	bool				debug;
 
+	static int64		statementsExecuted;		// total over all threads, used by scriptBench
+
 	idInterpreter();
 
 	// save games
@@ -69,6 +69,33 @@ idVarDef	def_jumpoffset( &type_jumpoffset );		// only used for jump opcodes
 idVarDef	def_argsize( &type_argsize );
 idVarDef	def_boolean( &type_boolean );
 
+// the statically allocated types and defs are referenced by negative numbers in binary program dumps
+static idTypeDef* const builtinTypes[] =
+{
+	&type_void, &type_scriptevent, &type_namespace, &type_string, &type_float, &type_vector, &type_entity, &type_field,
+	&type_function, &type_virtualfunction, &type_pointer, &type_object, &type_jumpoffset, &type_argsize, &type_boolean
+};
+
+static idVarDef* const builtinDefs[] =
+{
+	&def_void, &def_scriptevent, &def_namespace, &def_string, &def_float, &def_vector, &def_entity, &def_field,
+	&def_function, &def_virtualfunction, &def_pointer, &def_object, &def_jumpoffset, &def_argsize, &def_boolean
+};
+
+static const int NUM_BUILTIN_TYPES = sizeof( builtinTypes ) / sizeof( builtinTypes[0] );
+static const int NUM_BUILTIN_DEFS = sizeof( builtinDefs ) / sizeof( builtinDefs[0] );
+
+static const byte BSCRIPT_VERSION = 1;
+static const unsigned int BSCRIPT_MAGIC = ( 'B' << 24 ) | ( 'S' << 16 ) | ( 'C' << 8 ) | BSCRIPT_VERSION;
+
+// how the value of a def is stored in a binary program dump
+enum
+{
+	BSCRIPT_VALUE_INT,			// stack offset, object field offset, jump offset, arg size or virtual function number
+	BSCRIPT_VALUE_FUNCTION,		// function number
+	BSCRIPT_VALUE_GLOBAL		// offset in global variable memory
+};
+
 /***********************************************************************
 
   function_t
@@ -2064,6 +2091,49 @@ void idProgram::FinishCompilation()
 	}
 }
 
+/*
+==============
+idProgram::FuseStatements
+
+Flags statement pairs the interpreter executes as one superinstruction.
+Only flags are changed, so jumps into the second statement of a pair
+still work and savegame checksums are not affected.
+==============
+*/
+void idProgram::FuseStatements( int firstStatement )
+{
+	for( int i = firstStatement; i < statements.Num() - 1; i++ )
+	{
+		statement_t& st = statements[ i ];
+		const statement_t& next = statements[ i + 1 ];
+
+		switch( st.op )
+		{
+			case OP_INDIRECT_F:
+			case OP_INDIRECT_ENT:
+			case OP_INDIRECT_BOOL:
+			case OP_INDIRECT_OBJ:
+				// reading an object field and branching on it
+				if( ( next.op == OP_IF || next.op == OP_IFNOT ) && ( next.a == st.c ) )
+				{
+					st.flags |= statement_t::FLAG_FUSED_BRANCH;
+				}
+				break;
+
+			case OP_PUSH_F:
+			case OP_PUSH_ENT:
+			case OP_PUSH_OBJ:
+			case OP_PUSH_OBJENT:
+				// setting up the arguments of an event or function call
+				if( next.op == OP_PUSH_F || next.op == OP_PUSH_ENT || next.op == OP_PUSH_OBJ || next.op == OP_PUSH_OBJENT )
+				{
+					st.flags |= statement_t::FLAG_FUSED_PUSH;
+				}
+				break;
+		}
+	}
+}
+
 /*
 ==============
 idProgram::CompileStats
@@ -2136,6 +2206,8 @@ bool idProgram::CompileText( const char* source, const char* text, bool console
 	idVarDef*	def;
 	idStr		ospath;
 
+	int			firstStatement = statements.Num();
+
 	// use a full os path for GetFilenum since it calls OSPathToRelativePath to convert filenames from the parser
 	ospath = fileSystem->RelativePathToOSPath( source );
 	filenum = GetFilenum( ospath );
@@ -2178,6 +2250,8 @@ bool idProgram::CompileText( const char* source, const char* text, bool console
 	};
 #endif
 
+	FuseStatements( firstStatement );
+
 	if( !console )
 	{
 		CompileStats();
@@ -2299,6 +2373,15 @@ void idProgram::Startup( const char* defaultScript )
 	// make sure all data is freed up
 	idThread::Restart();
 
+	bool useCache = g_scriptCache.GetBool() && ( defaultScript != NULL ) && ( *defaultScript != '\0' );
+
+	// skip compiling when the sources did not change since the last dump
+	if( useCache && LoadBinary( defaultScript ) )
+	{
+		FinishCompilation();
+		return;
+	}
+
 	// get ready for loading scripts
 	BeginCompilation();
 
@@ -2309,6 +2392,722 @@ void idProgram::Startup( const char* defaultScript )
 	}
 
 	FinishCompilation();
+
+	if( useCache )
+	{
+		WriteBinary( defaultScript );
+	}
+}
+
+/*
+================
+idProgram::TypeNum
+================
+*/
+int idProgram::TypeNum( const idTypeDef* type ) const
+{
+	if( type == NULL )
+	{
+		return -1;
+	}
+
+	for( int i = 0; i < NUM_BUILTIN_TYPES; i++ )
+	{
+		if( builtinTypes[ i ] == type )
+		{
+			return -2 - i;
+		}
+	}
+
+	for( int i = typesHash.First( idStr::Hash( type->Name() ) ); i != -1; i = typesHash.Next( i ) )
+	{
+		if( types[ i ] == type )
+		{
+			return i;
+		}
+	}
+
+	// not owned by the program
+	return INT_MIN;
+}
+
+/*
+================
+idProgram::TypeForNum
+================
+*/
+idTypeDef* idProgram::TypeForNum( int num ) const
+{
+	if( num == -1 )
+	{
+		return NULL;
+	}
+	if( num < -1 )
+	{
+		return builtinTypes[ -2 - num ];
+	}
+	return types[ num ];
+}
+
+/*
+================
+idProgram::DefNum
+================
+*/
+int idProgram::DefNum( const idVarDef* def ) const
+{
+	if( def == NULL )
+	{
+		return -1;
+	}
+
+	for( int i = 0; i < NUM_BUILTIN_DEFS; i++ )
+	{
+		if( builtinDefs[ i ] == def )
+		{
+			return -2 - i;
+		}
+	}
+
+	if( def->num >= 0 && def->num < varDefs.Num() && varDefs[ def->num ] == def )
+	{
+		return def->num;
+	}
+
+	// not owned by the program
+	return INT_MIN;
+}
+
+/*
+================
+idProgram::DefForNum
+================
+*/
+idVarDef* idProgram::DefForNum( int num ) const
+{
+	if( num == -1 )
+	{
+		return NULL;
+	}
+	if( num < -1 )
+	{
+		return builtinDefs[ -2 - num ];
+	}
+	return varDefs[ num ];
+}
+
+/*
+================
+idProgram::WriteBinary
+
+Dumps the compiled program so the next startup can skip compiling.
+Nothing is written if the program references data it does not own.
+================
+*/
+bool idProgram::WriteBinary( const char* defaultScript ) const
+{
+	idStrStatic< MAX_OSPATH > generatedFileName = "generated/";
+	generatedFileName.Append( defaultScript );
+	generatedFileName.SetFileExtension( "bscript" );
+
+	idFile_Memory file( generatedFileName );
+	bool valid = true;
+
+	file.WriteBig( BSCRIPT_MAGIC );
+	file.WriteBig( ( int )sizeof( intptr_t ) );
+	file.WriteBig( ( int )NUM_OPCODES );
+	file.WriteBig( idEventDef::NumEventCommands() );
+
+	// the source files with their time stamps, the dump is invalid if any of them changed
+	file.WriteBig( fileList.Num() );
+	for( int i = 0; i < fileList.Num(); i++ )
+	{
+		file.WriteString( fileList[ i ] );
+		file.WriteBig( fileSystem->GetTimestamp( fileList[ i ] ) );
+	}
+
+	file.WriteBig( types.Num() );
+	file.WriteBig( varDefs.Num() );
+	file.WriteBig( functions.Num() );
+	file.WriteBig( statements.Num() );
+
+	file.WriteBig( numVariables );
+	file.Write( variables, numVariables );
+
+	for( int i = 0; i < types.Num(); i++ )
+	{
+		const idTypeDef* type = types[ i ];
+
+		file.WriteBig( ( int )type->type );
+		file.WriteString( type->name );
+		file.WriteBig( type->size );
+		file.WriteBig( TypeNum( type->auxType ) );
+		file.WriteBig( DefNum( type->def ) );
+
+		file.WriteBig( type->parmTypes.Num() );
+		for( int j = 0; j < type->parmTypes.Num(); j++ )
+		{
+			file.WriteBig( TypeNum( type->parmTypes[ j ] ) );
+			file.WriteString( type->parmNames[ j ] );
+		}
+
+		file.WriteBig( type->functions.Num() );
+		for( int j = 0; j < type->functions.Num(); j++ )
+		{
+			file.WriteBig( ( int )( type->functions[ j ] - &functions[ 0 ] ) );
+		}
+
+		valid &= ( TypeNum( type->auxType ) != INT_MIN ) && ( DefNum( type->def ) != INT_MIN );
+	}
+
+	for( int i = 0; i < varDefs.Num(); i++ )
+	{
+		const idVarDef* def = varDefs[ i ];
+
+		file.WriteBig( TypeNum( def->TypeDef() ) );
+		file.WriteString( def->Name() );
+		file.WriteBig( DefNum( def->scope ) );
+		file.WriteBig( def->numUsers );
+		file.WriteBig( ( int )def->initialized );
+
+		valid &= ( TypeNum( def->TypeDef() ) != INT_MIN ) && ( DefNum( def->scope ) != INT_MIN );
+
+		switch( def->Type() )
+		{
+			case ev_function:
+				file.WriteBig( ( int )BSCRIPT_VALUE_FUNCTION );
+				file.WriteBig( def->value.functionPtr ? ( int )( def->value.functionPtr - &functions[ 0 ] ) : -1 );
+				continue;
+
+			case ev_virtualfunction:
+			case ev_jumpoffset:
+			case ev_argsize:
+				file.WriteBig( ( int )BSCRIPT_VALUE_INT );
+				file.WriteBig( def->value.argSize );
+				continue;
+		}
+
+		if( ( def->initialized == idVarDef::stackVariable ) || ( def->scope && def->scope->TypeDef() && def->scope->TypeDef()->Inherits( &type_object ) ) )
+		{
+			file.WriteBig( ( int )BSCRIPT_VALUE_INT );
+			file.WriteBig( def->value.stackOffset );
+		}
+		else
+		{
+			int offset = def->value.bytePtr ? ( int )( def->value.bytePtr - variables ) : -1;
+			valid &= ( offset >= -1 ) && ( offset <= numVariables );
+
+			file.WriteBig( ( int )BSCRIPT_VALUE_GLOBAL );
+			file.WriteBig( offset );
+		}
+	}
+
+	for( int i = 0; i < functions.Num(); i++ )
+	{
+		const function_t& func = functions[ i ];
+
+		file.WriteString( func.Name() );
+		file.WriteString( func.eventdef ? func.eventdef->GetName() : "" );
+		file.WriteBig( DefNum( func.def ) );
+		file.WriteBig( TypeNum( func.type ) );
+		file.WriteBig( func.firstStatement );
+		file.WriteBig( func.numStatements );
+		file.WriteBig( func.parmTotal );
+		file.WriteBig( func.locals );
+		file.WriteBig( func.filenum );
+		file.WriteBig( func.parmSize.Num() );
+		file.WriteBigArray( func.parmSize.Ptr(), func.parmSize.Num() );
+
+		valid &= ( DefNum( func.def ) != INT_MIN ) && ( TypeNum( func.type ) != INT_MIN );
+	}
+
+	for( int i = 0; i < statements.Num(); i++ )
+	{
+		const statement_t& st = statements[ i ];
+
+		file.WriteBig( st.op );
+		file.WriteBig( st.flags );
+		file.WriteBig( st.linenumber );
+		file.WriteBig( st.file );
+		file.WriteBig( DefNum( st.a ) );
+		file.WriteBig( DefNum( st.b ) );
+		file.WriteBig( DefNum( st.c ) );
+
+		valid &= ( DefNum( st.a ) != INT_MIN ) && ( DefNum( st.b ) != INT_MIN ) && ( DefNum( st.c ) != INT_MIN );
+	}
+
+	file.WriteBig( DefNum( returnDef ) );
+	file.WriteBig( DefNum( returnStringDef ) );
+	file.WriteBig( DefNum( sysDef ) );
+	file.WriteBig( filenum );
+
+	if( !valid )
+	{
+		gameLocal.Warning( "idProgram::WriteBinary: program references data it does not own, not writing %s", generatedFileName.c_str() );
+		return false;
+	}
+
+	fileSystem->WriteFile( generatedFileName, file.GetDataPtr(), file.Length(), "fs_basepath" );
+	return true;
+}
+
+/*
+================
+idBinaryScriptReader
+
+Reads a binary program dump without trusting it. Every count is checked
+against the bytes left in the file before anything is allocated for it,
+and once a read goes past the end all further reads fail.
+================
+*/
+class idBinaryScriptReader
+{
+public:
+	idBinaryScriptReader( idFile* file_ ) : file( file_ ), ok( true ) {}
+
+	bool		IsOk() const
+	{
+		return ok;
+	}
+
+	void		Fail()
+	{
+		ok = false;
+	}
+
+	int			ReadInt()
+	{
+		int value = 0;
+		if( ok && file->ReadBig( value ) != sizeof( value ) )
+		{
+			ok = false;
+		}
+		return ok ? value : 0;
+	}
+
+	ID_TIME_T	ReadTimeStamp()
+	{
+		ID_TIME_T value = 0;
+		if( ok && file->ReadBig( value ) != sizeof( value ) )
+		{
+			ok = false;
+		}
+		return value;
+	}
+
+	int			ReadShort()
+	{
+		unsigned short value = 0;
+		if( ok && file->ReadBig( value ) != sizeof( value ) )
+		{
+			ok = false;
+		}
+		return value;
+	}
+
+	// written by idFile::WriteString
+	void		ReadString( idStr& string )
+	{
+		int length = 0;
+		if( ok && ( file->ReadInt( length ) != sizeof( length ) || length < 0 || length > file->Length() - file->Tell() ) )
+		{
+			ok = false;
+		}
+		if( ok )
+		{
+			string.Fill( ' ', length );
+			ok = ( file->Read( &string[ 0 ], length ) == length );
+		}
+	}
+
+	void		ReadBytes( void* data, int length )
+	{
+		ok = ok && ( file->Read( data, length ) == length );
+	}
+
+	// a count of records that take at least recordSize bytes each
+	int			ReadCount( int recordSize )
+	{
+		const int count = ReadInt();
+		if( count < 0 || count > ( file->Length() - file->Tell() ) / recordSize )
+		{
+			ok = false;
+		}
+		return ok ? count : 0;
+	}
+
+	// an index in [first, last]
+	int			ReadIndex( int first, int last )
+	{
+		const int num = ReadInt();
+		if( num < first || num > last )
+		{
+			ok = false;
+		}
+		return ok ? num : first;
+	}
+
+	// a type or def number as written by TypeNum and DefNum
+	int			ReadNum( int numBuiltins, int num )
+	{
+		return ReadIndex( -1 - numBuiltins, num - 1 );
+	}
+
+private:
+	idFile* 	file;
+	bool		ok;
+};
+
+struct bscriptType_t
+{
+	int							type;
+	idStr						name;
+	int							size;
+	int							auxType;
+	int							def;
+	idList<int>					parmTypes;
+	idStrList					parmNames;
+	idList<int>					functions;
+};
+
+struct bscriptDef_t
+{
+	int							type;
+	idStr						name;
+	int							scope;
+	int							numUsers;
+	int							initialized;
+	int							valueType;
+	int							value;
+};
+
+struct bscriptFunction_t
+{
+	idStr						name;
+	const idEventDef* 			eventdef;
+	int							def;
+	int							type;
+	int							firstStatement;
+	int							numStatements;
+	int							parmTotal;
+	int							locals;
+	int							filenum;
+	idList<int, TAG_SCRIPT>		parmSize;
+};
+
+struct bscriptStatement_t
+{
+	unsigned short				op;
+	unsigned short				flags;
+	int							linenumber;
+	int							file;
+	int							a;
+	int							b;
+	int							c;
+};
+
+/*
+================
+idProgram::LoadBinary
+
+Restores the state compiling the default script would produce. Fails
+if the dump is missing, from another version, broken or any source
+changed. The whole dump is read and checked before the current program
+is replaced, so a failure leaves it untouched.
+================
+*/
+bool idProgram::LoadBinary( const char* defaultScript )
+{
+	idStrStatic< MAX_OSPATH > generatedFileName = "generated/";
+	generatedFileName.Append( defaultScript );
+	generatedFileName.SetFileExtension( "bscript" );
+
+	idFileLocal file( fileSystem->OpenFileReadMemory( generatedFileName ) );
+	if( file == NULL )
+	{
+		return false;
+	}
+
+	idBinaryScriptReader reader( file );
+
+	const unsigned int magic = ( unsigned int )reader.ReadInt();
+	const int pointerSize = reader.ReadInt();
+	const int numOpcodes = reader.ReadInt();
+	const int numEvents = reader.ReadInt();
+	if( !reader.IsOk() || magic != BSCRIPT_MAGIC || pointerSize != sizeof( intptr_t ) || numOpcodes != NUM_OPCODES || numEvents != idEventDef::NumEventCommands() )
+	{
+		return false;
+	}
+
+	idStrList sourceFiles;
+	sourceFiles.SetNum( reader.ReadCount( sizeof( int ) + sizeof( ID_TIME_T ) ) );
+	for( int i = 0; i < sourceFiles.Num(); i++ )
+	{
+		reader.ReadString( sourceFiles[ i ] );
+		const ID_TIME_T timeStamp = reader.ReadTimeStamp();
+		if( !reader.IsOk() || fileSystem->GetTimestamp( sourceFiles[ i ] ) != timeStamp )
+		{
+			return false;
+		}
+	}
+
+	// the smallest number of bytes each record takes in the file
+	const int numTypes = reader.ReadCount( 7 * sizeof( int ) );
+	const int numDefs = reader.ReadCount( 7 * sizeof( int ) );
+	const int numFunctions = reader.ReadCount( 10 * sizeof( int ) );
+	const int numStatements = reader.ReadCount( 5 * sizeof( int ) + 2 * sizeof( unsigned short ) );
+	if( !reader.IsOk() || numFunctions > functions.Max() || numStatements > statements.Max() )
+	{
+		return false;
+	}
+
+	const int newNumVariables = reader.ReadIndex( 0, MAX_GLOBALS );
+	idList<byte> newVariables;
+	newVariables.SetNum( reader.IsOk() ? newNumVariables : 0 );
+	reader.ReadBytes( newVariables.Ptr(), newVariables.Num() );
+
+	// statements reference files by number, the "NULL" function statement uses file 0 even without files
+	const int lastFile = Max( sourceFiles.Num() - 1, 0 );
+
+	idList<bscriptType_t> newTypes;
+	newTypes.SetNum( numTypes );
+	for( int i = 0; i < numTypes && reader.IsOk(); i++ )
+	{
+		bscriptType_t& type = newTypes[ i ];
+
+		type.type = reader.ReadIndex( ev_void, ev_boolean );
+		reader.ReadString( type.name );
+		type.size = reader.ReadInt();
+		type.auxType = reader.ReadNum( NUM_BUILTIN_TYPES, numTypes );
+		type.def = reader.ReadNum( NUM_BUILTIN_DEFS, numDefs );
+
+		type.parmTypes.SetNum( reader.ReadCount( 2 * sizeof( int ) ) );
+		type.parmNames.SetNum( type.parmTypes.Num() );
+		for( int j = 0; j < type.parmTypes.Num(); j++ )
+		{
+			type.parmTypes[ j ] = reader.ReadNum( NUM_BUILTIN_TYPES, numTypes );
+			reader.ReadString( type.parmNames[ j ] );
+		}
+
+		type.functions.SetNum( reader.ReadCount( sizeof( int ) ) );
+		for( int j = 0; j < type.functions.Num(); j++ )
+		{
+			type.functions[ j ] = reader.ReadIndex( 0, numFunctions - 1 );
+		}
+	}
+
+	idList<bscriptDef_t> newDefs;
+	newDefs.SetNum( reader.IsOk() ? numDefs : 0 );
+	for( int i = 0; i < newDefs.Num() && reader.IsOk(); i++ )
+	{
+		bscriptDef_t& def = newDefs[ i ];
+
+		def.type = reader.ReadNum( NUM_BUILTIN_TYPES, numTypes );
+		reader.ReadString( def.name );
+		def.scope = reader.ReadNum( NUM_BUILTIN_DEFS, numDefs );
+		def.numUsers = reader.ReadInt();
+		def.initialized = reader.ReadIndex( idVarDef::uninitialized, idVarDef::stackVariable );
+		def.valueType = reader.ReadIndex( BSCRIPT_VALUE_INT, BSCRIPT_VALUE_GLOBAL );
+		switch( def.valueType )
+		{
+			case BSCRIPT_VALUE_FUNCTION:
+				def.value = reader.ReadIndex( -1, numFunctions - 1 );
+				break;
+
+			case BSCRIPT_VALUE_GLOBAL:
+				def.value = reader.ReadIndex( -1, newNumVariables );
+				break;
+
+			default:
+				def.value = reader.ReadInt();
+				break;
+		}
+	}
+
+	idList<bscriptFunction_t> newFunctions;
+	newFunctions.SetNum( reader.IsOk() ? numFunctions : 0 );
+	for( int i = 0; i < newFunctions.Num() && reader.IsOk(); i++ )
+	{
+		bscriptFunction_t& func = newFunctions[ i ];
+		idStr eventName;
+
+		reader.ReadString( func.name );
+		reader.ReadString( eventName );
+		func.eventdef = NULL;
+		if( eventName.Length() )
+		{
+			func.eventdef = idEventDef::FindEvent( eventName );
+			if( func.eventdef == NULL )
+			{
+				return false;
+			}
+		}
+		func.def = reader.ReadNum( NUM_BUILTIN_DEFS, numDefs );
+		func.type = reader.ReadNum( NUM_BUILTIN_TYPES, numTypes );
+		func.firstStatement = reader.ReadIndex( 0, numStatements );
+		func.numStatements = reader.ReadIndex( 0, numStatements - func.firstStatement );
+		func.parmTotal = reader.ReadInt();
+		func.locals = reader.ReadInt();
+		func.filenum = reader.ReadIndex( 0, lastFile );
+		func.parmSize.SetNum( reader.ReadCount( sizeof( int ) ) );
+		for( int j = 0; j < func.parmSize.Num(); j++ )
+		{
+			func.parmSize[ j ] = reader.ReadInt();
+		}
+	}
+
+	idList<bscriptStatement_t> newStatements;
+	newStatements.SetNum( reader.IsOk() ? numStatements : 0 );
+	for( int i = 0; i < newStatements.Num() && reader.IsOk(); i++ )
+	{
+		bscriptStatement_t& st = newStatements[ i ];
+
+		st.op = ( unsigned short )reader.ReadShort();
+		st.flags = ( unsigned short )reader.ReadShort();
+		st.linenumber = reader.ReadInt();
+		st.file = reader.ReadIndex( 0, lastFile );
+		st.a = reader.ReadNum( NUM_BUILTIN_DEFS, numDefs );
+		st.b = reader.ReadNum( NUM_BUILTIN_DEFS, numDefs );
+		st.c = reader.ReadNum( NUM_BUILTIN_DEFS, numDefs );
+
+		if( st.op >= NUM_OPCODES )
+		{
+			reader.Fail();
+		}
+	}
+
+	const int newReturnDef = reader.ReadNum( NUM_BUILTIN_DEFS, numDefs );
+	const int newReturnStringDef = reader.ReadNum( NUM_BUILTIN_DEFS, numDefs );
+	const int newSysDef = reader.ReadNum( NUM_BUILTIN_DEFS, numDefs );
+	const int newFilenum = reader.ReadIndex( 0, lastFile );
+
+	if( !reader.IsOk() )
+	{
+		gameLocal.Warning( "idProgram::LoadBinary: %s is broken, compiling the scripts", generatedFileName.c_str() );
+		return false;
+	}
+
+	// everything checked out, replace the program
+	FreeData();
+
+	numVariables = newNumVariables;
+	memcpy( variables, newVariables.Ptr(), numVariables );
+
+	fileList = sourceFiles;
+
+	// allocate everything up front, types and defs reference each other in both directions
+	types.SetNum( numTypes );
+	for( int i = 0; i < numTypes; i++ )
+	{
+		types[ i ] = new( TAG_SCRIPT ) idTypeDef( ev_void, NULL, "", 0, NULL );
+	}
+	varDefs.SetNum( numDefs );
+	for( int i = 0; i < numDefs; i++ )
+	{
+		varDefs[ i ] = new( TAG_SCRIPT ) idVarDef();
+		varDefs[ i ]->num = i;
+	}
+	functions.SetNum( numFunctions );
+	statements.SetNum( numStatements );
+
+	for( int i = 0; i < numTypes; i++ )
+	{
+		const bscriptType_t& src = newTypes[ i ];
+		idTypeDef* type = types[ i ];
+
+		type->type = ( etype_t )src.type;
+		type->name = src.name;
+		type->size = src.size;
+		type->auxType = TypeForNum( src.auxType );
+		type->def = DefForNum( src.def );
+
+		type->parmTypes.SetNum( src.parmTypes.Num() );
+		type->parmNames = src.parmNames;
+		for( int j = 0; j < src.parmTypes.Num(); j++ )
+		{
+			type->parmTypes[ j ] = TypeForNum( src.parmTypes[ j ] );
+		}
+
+		type->functions.SetNum( src.functions.Num() );
+		for( int j = 0; j < src.functions.Num(); j++ )
+		{
+			type->functions[ j ] = &functions[ src.functions[ j ] ];
+		}
+
+		typesHash.Add( idStr::Hash( type->name ), i );
+	}
+
+	for( int i = 0; i < numDefs; i++ )
+	{
+		const bscriptDef_t& src = newDefs[ i ];
+		idVarDef* def = varDefs[ i ];
+
+		def->SetTypeDef( TypeForNum( src.type ) );
+		def->scope = DefForNum( src.scope );
+		def->numUsers = src.numUsers;
+		def->initialized = ( idVarDef::initialized_t )src.initialized;
+
+		switch( src.valueType )
+		{
+			case BSCRIPT_VALUE_FUNCTION:
+				def->value.functionPtr = ( src.value >= 0 ) ? &functions[ src.value ] : NULL;
+				break;
+
+			case BSCRIPT_VALUE_GLOBAL:
+				def->value.bytePtr = ( src.value >= 0 ) ? &variables[ src.value ] : NULL;
+				break;
+
+			default:
+				def->value.stackOffset = src.value;
+				break;
+		}
+
+		AddDefToNameList( def, src.name );
+	}
+
+	for( int i = 0; i < numFunctions; i++ )
+	{
+		const bscriptFunction_t& src = newFunctions[ i ];
+		function_t& func = functions[ i ];
+
+		func.Clear();
+		func.SetName( src.name );
+		func.eventdef = src.eventdef;
+		func.def = DefForNum( src.def );
+		func.type = TypeForNum( src.type );
+		func.firstStatement = src.firstStatement;
+		func.numStatements = src.numStatements;
+		func.parmTotal = src.parmTotal;
+		func.locals = src.locals;
+		func.filenum = src.filenum;
+		func.parmSize = src.parmSize;
+	}
+
+	for( int i = 0; i < numStatements; i++ )
+	{
+		const bscriptStatement_t& src = newStatements[ i ];
+		statement_t& st = statements[ i ];
+
+		st.op = src.op;
+		// the fused pairs are found again below, the file can't choose them
+		st.flags = src.flags & ~( statement_t::FLAG_FUSED_BRANCH | statement_t::FLAG_FUSED_PUSH );
+		st.linenumber = src.linenumber;
+		st.file = src.file;
+		st.a = DefForNum( src.a );
+		st.b = DefForNum( src.b );
+		st.c = DefForNum( src.c );
+	}
+
+	FuseStatements( 0 );
+
+	returnDef = DefForNum( newReturnDef );
+	returnStringDef = DefForNum( newReturnStringDef );
+	sysDef = DefForNum( newSysDef );
+	filenum = newFilenum;
+
+	gameLocal.Printf( "Loaded compiled script %s, %d statements, %d functions\n", generatedFileName.c_str(), statements.Num(), functions.Num() );
+
+	return true;
 }
 
 /*
@@ -94,6 +94,8 @@ Contains type information for variables and functions.
 
 class idTypeDef
 {
+	friend class idProgram;		// binary program dumps
+
 private:
 	etype_t						type;
 	idStr 						name;
@@ -469,6 +471,9 @@ typedef struct statement_s
 		// implementation hasn't been parsed yet (only the declaration/prototype)
 		// see idCompiler::EmitFunctionParms() and idProgram::CalculateChecksum()
 		FLAG_OBJECTCALL_IMPL_NOT_PARSED_YET = 1,
+		// set by idProgram::FuseStatements, the interpreter executes the following statement together with this one
+		FLAG_FUSED_BRANCH = 2,		// OP_INDIRECT_* followed by an OP_IF / OP_IFNOT on its result
+		FLAG_FUSED_PUSH = 4,		// int sized OP_PUSH_* followed by another int sized push
 	};
 	// DG: moved linenumber and file up here to prevent wasting 8 bytes of padding on 64bit
 	unsigned short	linenumber;
@@ -518,6 +523,15 @@ private:
 	void										CompileStats();
 	byte*										ReserveDefMemory( int size );
 	idVarDef*									AllocVarDef( idTypeDef* type, const char* name, idVarDef* scope );
+	void										FuseStatements( int firstStatement );
+
+	// binary dump of the compiled default script in generated/
+	bool										LoadBinary( const char* defaultScript );
+	bool										WriteBinary( const char* defaultScript ) const;
+	int											TypeNum( const idTypeDef* type ) const;
+	idTypeDef*									TypeForNum( int num ) const;
+	int											DefNum( const idVarDef* def ) const;
+	idVarDef*									DefForNum( int num ) const;
 
 public:
 	idVarDef*									returnDef;
@@ -56,7 +56,10 @@ idDict& idDict::operator=( const idDict& other )
 
 	for( i = 0; i < args.Num(); i++ )
 	{
-		args[i].key = globalKeys.CopyString( args[i].key );
+		if( args[i].keyString != NULL )
+		{
+			args[i].keyString = globalKeys.CopyString( args[i].keyString );
+		}
 		args[i].value = globalValues.CopyString( args[i].value );
 	}
 
@@ -88,7 +91,7 @@ void idDict::Copy( const idDict& other )
 		found = ( int* ) _alloca16( other.args.Num() * sizeof( int ) );
 		for( i = 0; i < n; i++ )
 		{
-			found[i] = FindKeyIndex( other.args[i].GetKey() );
+			found[i] = FindKeyIndex( other.args[i].key, other.args[i].GetKey(), other.args[i].KeyHash() );
 		}
 	}
 	else
@@ -107,9 +110,10 @@ void idDict::Copy( const idDict& other )
 		}
 		else
 		{
-			kv.key = globalKeys.CopyString( other.args[i].key );
+			kv.key = other.args[i].key;
+			kv.keyString = ( other.args[i].keyString != NULL ) ? globalKeys.CopyString( other.args[i].keyString ) : NULL;
 			kv.value = globalValues.CopyString( other.args[i].value );
-			argHash.Add( argHash.GenerateKey( kv.GetKey(), false ), args.Append( kv ) );
+			argHash.Add( argHash.GenerateKey( kv.KeyHash() ), args.Append( kv ) );
 		}
 	}
 }
@@ -130,7 +134,7 @@ void idDict::TransferKeyValues( idDict& other )
 		return;
 	}
 
-	if( other.args.Num() && other.args[0].key->GetPool() != &globalKeys )
+	if( other.args.Num() && other.args[0].value->GetPool() != &globalValues )
 	{
 		common->FatalError( "idDict::TransferKeyValues: can't transfer values across a DLL boundary" );
 		return;
@@ -143,6 +147,7 @@ void idDict::TransferKeyValues( idDict& other )
 	for( i = 0; i < n; i++ )
 	{
 		args[i].key = other.args[i].key;
+		args[i].keyString = other.args[i].keyString;
 		args[i].value = other.args[i].value;
 	}
 	argHash = other.argHash;
@@ -202,19 +207,19 @@ idDict::SetDefaults
 void idDict::SetDefaults( const idDict* dict )
 {
 	int i, n;
-	const idKeyValue* kv, *def;
+	const idKeyValue* def;
 	idKeyValue newkv;
 
 	n = dict->args.Num();
 	for( i = 0; i < n; i++ )
 	{
 		def = &dict->args[i];
-		kv = FindKey( def->GetKey() );
-		if( !kv )
+		if( FindKeyIndex( def->key, def->GetKey(), def->KeyHash() ) == -1 )
 		{
-			newkv.key = globalKeys.CopyString( def->key );
+			newkv.key = def->key;
+			newkv.keyString = ( def->keyString != NULL ) ? globalKeys.CopyString( def->keyString ) : NULL;
 			newkv.value = globalValues.CopyString( def->value );
-			argHash.Add( argHash.GenerateKey( newkv.GetKey(), false ), args.Append( newkv ) );
+			argHash.Add( argHash.GenerateKey( newkv.KeyHash() ), args.Append( newkv ) );
 		}
 	}
 }
@@ -230,7 +235,10 @@ void idDict::Clear()
 
 	for( i = 0; i < args.Num(); i++ )
 	{
-		globalKeys.FreeString( args[i].key );
+		if( args[i].keyString != NULL )
+		{
+			globalKeys.FreeString( args[i].keyString );
+		}
 		globalValues.FreeString( args[i].value );
 	}
 
@@ -319,7 +327,11 @@ void idDict::Set( const char* key, const char* value )
 		return;
 	}
 
-	i = FindKeyIndex( key );
+	// keys can come from the network, don't let them fill the name table
+	const idName name = idName::TryIntern( key );
+	const int keyHash = name.IsEmpty() ? idStr::IHash( key ) : name.GetHash();
+
+	i = FindKeyIndex( name, key, keyHash );
 	if( i != -1 )
 	{
 		// first set the new value and then free the old value to allow proper self copying
@@ -329,9 +341,10 @@ void idDict::Set( const char* key, const char* value )
 	}
 	else
 	{
-		kv.key = globalKeys.AllocString( key );
+		kv.key = name;
+		kv.keyString = name.IsEmpty() ? globalKeys.AllocString( key ) : NULL;
 		kv.value = globalValues.AllocString( value );
-		argHash.Add( argHash.GenerateKey( kv.GetKey(), false ), args.Append( kv ) );
+		argHash.Add( argHash.GenerateKey( keyHash ), args.Append( kv ) );
 	}
 }
 
@@ -567,24 +580,32 @@ idDict::FindKey
 */
 const idKeyValue* idDict::FindKey( const char* key ) const
 {
-	int i, hash;
-
 	if( key == NULL || key[0] == '\0' )
 	{
 		idLib::common->DWarning( "idDict::FindKey: empty key" );
 		return NULL;
 	}
 
-	hash = argHash.GenerateKey( key, false );
-	for( i = argHash.First( hash ); i != -1; i = argHash.Next( i ) )
+	// a key that was never interned can only be in a dictionary once the name table is full
+	const idName name = idName::Find( key );
+	if( name.IsEmpty() && !idName::IsFull() )
 	{
-		if( args[i].GetKey().Icmp( key ) == 0 )
-		{
-			return &args[i];
-		}
+		return NULL;
 	}
 
-	return NULL;
+	int i = FindKeyIndex( name, key, name.IsEmpty() ? idStr::IHash( key ) : name.GetHash() );
+	return ( i != -1 ) ? &args[i] : NULL;
+}
+
+/*
+================
+idDict::FindKey
+================
+*/
+const idKeyValue* idDict::FindKey( const idName& key ) const
+{
+	int i = FindKeyIndex( key, key.c_str(), key.GetHash() );
+	return ( i != -1 ) ? &args[i] : NULL;
 }
 
 /*
@@ -601,10 +622,39 @@ int idDict::FindKeyIndex( const char* key ) const
 		return 0;
 	}
 
-	int hash = argHash.GenerateKey( key, false );
+	const idName name = idName::Find( key );
+	if( name.IsEmpty() && !idName::IsFull() )
+	{
+		return -1;
+	}
+
+	return FindKeyIndex( name, key, name.IsEmpty() ? idStr::IHash( key ) : name.GetHash() );
+}
+
+/*
+================
+idDict::FindKeyIndex
+================
+*/
+int idDict::FindKeyIndex( const idName& key ) const
+{
+	return FindKeyIndex( key, key.c_str(), key.GetHash() );
+}
+
+/*
+================
+idDict::FindKeyIndex
+
+  interned keys compare by name, the ones that could not be interned by string
+================
+*/
+int idDict::FindKeyIndex( const idName& name, const char* key, int keyHash ) const
+{
+	int hash = argHash.GenerateKey( keyHash );
 	for( int i = argHash.First( hash ); i != -1; i = argHash.Next( i ) )
 	{
-		if( args[i].GetKey().Icmp( key ) == 0 )
+		const idKeyValue& kv = args[i];
+		if( ( kv.keyString == NULL ) ? ( kv.key == name ) : ( kv.keyString->Icmp( key ) == 0 ) )
 		{
 			return i;
 		}
@@ -622,17 +672,29 @@ void idDict::Delete( const char* key )
 {
 	int hash, i;
 
-	hash = argHash.GenerateKey( key, false );
-	for( i = argHash.First( hash ); i != -1; i = argHash.Next( i ) )
+	if( key == NULL || key[0] == '\0' )
+	{
+		return;
+	}
+
+	const idName name = idName::Find( key );
+	if( name.IsEmpty() && !idName::IsFull() )
+	{
+		return;
+	}
+
+	const int keyHash = name.IsEmpty() ? idStr::IHash( key ) : name.GetHash();
+	i = FindKeyIndex( name, key, keyHash );
+	if( i != -1 )
 	{
-		if( args[i].GetKey().Icmp( key ) == 0 )
+		hash = argHash.GenerateKey( keyHash );
+		if( args[i].keyString != NULL )
 		{
-			globalKeys.FreeString( args[i].key );
-			globalValues.FreeString( args[i].value );
-			args.RemoveIndex( i );
-			argHash.RemoveIndex( hash, i );
-			break;
+			globalKeys.FreeString( args[i].keyString );
 		}
+		globalValues.FreeString( args[i].value );
+		args.RemoveIndex( i );
+		argHash.RemoveIndex( hash, i );
 	}
 
 #if 0
@@ -1069,7 +1131,8 @@ idDict::ShowMemoryUsage_f
 */
 void idDict::ShowMemoryUsage_f( const idCmdArgs& args )
 {
-	idLib::common->Printf( "%5d KB in %d keys\n", globalKeys.Size() >> 10, globalKeys.Num() );
+	idLib::common->Printf( "%5d KB in %d interned names\n", ( int )( idName::Allocated() >> 10 ), idName::NumNames() );
+	idLib::common->Printf( "%5d KB in %d keys that could not be interned\n", globalKeys.Size() >> 10, globalKeys.Num() );
 	idLib::common->Printf( "%5d KB in %d values\n", globalValues.Size() >> 10, globalValues.Num() );
 }
 
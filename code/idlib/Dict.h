@@ -41,7 +41,8 @@ This is a dictionary class that tracks an arbitrary number of key / value
 pair combinations. It is used for map entity spawning, GUI state management,
 and other things.
 
-Keys are compared case-insensitive.
+Keys are interned as idName and compared case-insensitive. Once the name
+table is full, new keys are kept as pooled strings instead.
 
 Does not allocate memory until the first key/value pair is added.
 
@@ -55,30 +56,42 @@ class idKeyValue
 public:
 	const idStr& 		GetKey() const
 	{
-		return *key;
+		return ( keyString != NULL ) ? *keyString : key.GetString();
+	}
+	// empty if the key could not be interned
+	const idName& 		GetKeyName() const
+	{
+		return key;
 	}
 	const idStr& 		GetValue() const
 	{
 		return *value;
 	}
 
+	// the interned keys are shared by all dictionaries and not counted here
 	size_t				Allocated() const
 	{
-		return key->Allocated() + value->Allocated();
+		return ( ( keyString != NULL ) ? keyString->Allocated() : 0 ) + value->Allocated();
 	}
 	size_t				Size() const
 	{
-		return sizeof( *this ) + key->Size() + value->Size();
+		return sizeof( *this ) + ( ( keyString != NULL ) ? keyString->Size() : 0 ) + value->Size();
 	}
 
 	bool				operator==( const idKeyValue& kv ) const
 	{
-		return ( key == kv.key && value == kv.value );
+		return ( key == kv.key && keyString == kv.keyString && value == kv.value );
 	}
 
 private:
-	const idPoolStr* 	key;
+	idName				key;
+	const idPoolStr* 	keyString;		// only set when the key could not be interned
 	const idPoolStr* 	value;
+
+	int					KeyHash() const
+	{
+		return ( keyString != NULL ) ? idStr::IHash( keyString->c_str() ) : key.GetHash();
+	}
 };
 
 /*
@@ -179,10 +192,12 @@ public:
 	// returns the key/value pair with the given key
 	// returns NULL if the key/value pair does not exist
 	const idKeyValue* 	FindKey( const char* key ) const;
+	const idKeyValue* 	FindKey( const idName& key ) const;
 
 	// returns the index to the key/value pair with the given key
 	// returns -1 if the key/value pair does not exist
 	int					FindKeyIndex( const char* key ) const;
+	int					FindKeyIndex( const idName& key ) const;
 
 	// delete the key/value pair with the given key
 	void				Delete( const char* key );
@@ -223,8 +238,10 @@ private:
 	idList<idKeyValue>	args;
 	idHashIndex			argHash;
 
-	static idStrPool	globalKeys;
+	static idStrPool	globalKeys;		// keys that could not be interned
 	static idStrPool	globalValues;
+
+	int					FindKeyIndex( const idName& name, const char* key, int keyHash ) const;
 };
 
 
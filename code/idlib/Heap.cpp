@@ -37,29 +37,132 @@ If you have questions concerning this license or the applicable additional terms
 //
 //===============================================================
 #include <stdlib.h>
+#include <atomic>
+#include <new>
 #undef new
 
+/*
+Every block starts with a 16 byte header that remembers the requested size and
+the memory tag, so Mem_Free16 can keep the per tag statistics up to date.
+
+Blocks up to MEM_SMALL_BLOCK_SIZE bytes (header included) are rounded up to a
+size class and served from a free list of the calling thread. The thread
+caches exchange batches of blocks with one shared pool per size class, which
+carves its blocks out of MEM_CHUNK_SIZE chunks and never gives them back to
+the system. Larger blocks come straight from the system heap.
+
+Every pointer passed to Mem_Free16 must come from Mem_Alloc16, there is no
+way to tell engine blocks from foreign ones without reading in front of them.
+
+A thread hands its cached blocks back to the pools when it exits, whether it
+is an idSysThread or was started by a library.
+
+Define ID_SYSTEM_ALLOCATOR (SYSTEM_ALLOCATOR in CMake) to allocate every block
+from the system heap without a header, so ASan or Valgrind see each allocation
+exactly as it was requested. That build keeps no per tag statistics.
+*/
+#if !defined( ID_SYSTEM_ALLOCATOR ) && defined( __SANITIZE_ADDRESS__ )
+	#define ID_SYSTEM_ALLOCATOR
+#endif
+
+#if !defined( ID_SYSTEM_ALLOCATOR ) && defined( __has_feature )
+	#if __has_feature( address_sanitizer )
+		#define ID_SYSTEM_ALLOCATOR
+	#endif
+#endif
+
+static const uint32 MEM_HEADER_MAGIC		= 0x314d454d;	// "MEM1"
+static const uint32 MEM_FREED_MAGIC			= 0x464d454d;	// "MEMF"
+
+static const int MEM_NUM_SIZE_CLASSES		= 20;
+static const int MEM_LARGE_BLOCK			= 0xff;			// sizeClass of blocks from the system heap
+static const int MEM_SMALL_BLOCK_SIZE		= 1024;
+static const int MEM_CHUNK_SIZE				= 64 * 1024;
+static const int MEM_CACHE_BATCH_SIZE		= 8 * 1024;		// bytes moved between a thread cache and a pool at once
+
+struct memHeader_t
+{
+	uint64				size;
+	byte				tag;
+	byte				sizeClass;
+	uint16				pad;
+	uint32				magic;
+};
+
+compile_time_assert( sizeof( memHeader_t ) == 16 );
+compile_time_assert( TAG_NUM_TAGS <= MAX_TAGS );
+
+struct memFreeBlock_t
+{
+	memFreeBlock_t* 	next;
+};
+
+// size class blocks, header included
+static const int memClassSizes[MEM_NUM_SIZE_CLASSES] =
+{
+	16, 32, 48, 64, 80, 96, 112, 128,
+	160, 192, 224, 256,
+	320, 384, 448, 512,
+	640, 768, 896, 1024
+};
+
+struct memClassPool_t
+{
+	interlockedInt_t	lock;
+	memFreeBlock_t* 	freeList;
+	byte* 				chunk;				// unused part of the last chunk
+	int					chunkSize;
+};
+
+// plain old data so the caches are zero initialized before any constructor runs
+struct memThreadCache_t
+{
+	memFreeBlock_t* 	freeList[MEM_NUM_SIZE_CLASSES];
+	int					numFree[MEM_NUM_SIZE_CLASSES];
+	bool				exited;				// destructors of other thread locals may still free blocks
+};
+
+// flushes the cache when the thread exits, its destructor is only
+// registered once the thread first takes blocks from a pool
+struct memThreadCacheOwner_t
+{
+	bool				active;
+
+	~memThreadCacheOwner_t();
+};
+
+static memClassPool_t			memPools[MEM_NUM_SIZE_CLASSES];
+static thread_local memThreadCache_t memThreadCache;
+static thread_local memThreadCacheOwner_t memThreadCacheOwner;
+
+static std::atomic<int64>		memTagBytes[TAG_NUM_TAGS];
+static std::atomic<int>			memTagAllocs[TAG_NUM_TAGS];
+static std::atomic<int64>		memAllocsTotal;
+static std::atomic<int64>		memReservedBytes;
+
+static const char* memTagNames[] =
+{
+#define MEM_TAG( x )	#x,
+#include "sys/sys_alloc_tags.h"
+};
+
 /*
 ==================
-Mem_Alloc16
+Mem_SystemAlloc
 ==================
 */
-// RB: 64 bit fixes, changed int to size_t
-void* Mem_Alloc16( const size_t size, const memTag_t tag )
-// RB end
+static void* Mem_SystemAlloc( const size_t size, const size_t alignment = 16 )
 {
-	if( !size )
-	{
-		return NULL;
-	}
-	const size_t paddedSize = ( size + 15 ) & ~15;
 #ifdef _WIN32
 	// this should work with MSVC and mingw, as long as __MSVCRT_VERSION__ >= 0x0700
-	return _aligned_malloc( paddedSize, 16 );
+	return _aligned_malloc( size, alignment );
 #else // not _WIN32
 	// DG: the POSIX solution for linux etc
 	void* ret;
-	posix_memalign( &ret, 16, paddedSize );
+	if( posix_memalign( &ret, alignment, size ) != 0 )
+	{
+		return NULL;
+	}
 	return ret;
 	// DG end
 #endif // _WIN32
@@ -67,15 +170,11 @@ void* Mem_Alloc16( const size_t size, const memTag_t tag )
 
 /*
 ==================
-Mem_Free16
+Mem_SystemFree
 ==================
 */
-void Mem_Free16( void* ptr )
+static void Mem_SystemFree( void* ptr )
 {
-	if( ptr == NULL )
-	{
-		return;
-	}
 #ifdef _WIN32
 	_aligned_free( ptr );
 #else // not _WIN32
@@ -86,6 +185,341 @@ void Mem_Free16( void* ptr )
 #endif // _WIN32
 }
 
+/*
+==================
+Mem_SizeClass
+==================
+*/
+static ID_INLINE int Mem_SizeClass( const size_t blockSize )
+{
+	assert( blockSize <= MEM_SMALL_BLOCK_SIZE );
+
+	const int size = ( int )blockSize;
+	if( size <= 128 )
+	{
+		return ( size - 1 ) >> 4;
+	}
+	if( size <= 256 )
+	{
+		return 8 + ( ( size - 129 ) >> 5 );
+	}
+	if( size <= 512 )
+	{
+		return 12 + ( ( size - 257 ) >> 6 );
+	}
+	return 16 + ( ( size - 513 ) >> 7 );
+}
+
+/*
+==================
+Mem_LockPool
+==================
+*/
+static ID_INLINE void Mem_LockPool( memClassPool_t& pool )
+{
+	while( Sys_InterlockedCompareExchange( pool.lock, 0, 1 ) != 0 )
+	{
+		Sys_Yield();
+	}
+}
+
+/*
+==================
+Mem_UnlockPool
+==================
+*/
+static ID_INLINE void Mem_UnlockPool( memClassPool_t& pool )
+{
+	Sys_InterlockedExchange( pool.lock, 0 );
+}
+
+/*
+==================
+Mem_RefillThreadCache
+
+Moves a batch of blocks from the shared pool into the thread cache.
+==================
+*/
+static bool Mem_RefillThreadCache( memThreadCache_t& cache, const int sizeClass )
+{
+	memClassPool_t& pool = memPools[sizeClass];
+	const int blockSize = memClassSizes[sizeClass];
+	const int batchSize = MEM_CACHE_BATCH_SIZE / blockSize;
+
+	memFreeBlock_t* list = NULL;
+	int numBlocks = 0;
+
+	Mem_LockPool( pool );
+
+	while( pool.freeList != NULL && numBlocks < batchSize )
+	{
+		memFreeBlock_t* block = pool.freeList;
+		pool.freeList = block->next;
+		block->next = list;
+		list = block;
+		numBlocks++;
+	}
+
+	while( numBlocks < batchSize )
+	{
+		if( pool.chunkSize < blockSize )
+		{
+			byte* chunk = ( byte* )Mem_SystemAlloc( MEM_CHUNK_SIZE );
+			if( chunk == NULL )
+			{
+				break;
+			}
+			// the tail of the previous chunk is smaller than a block and stays unused
+			pool.chunk = chunk;
+			pool.chunkSize = MEM_CHUNK_SIZE;
+			memReservedBytes.fetch_add( MEM_CHUNK_SIZE, std::memory_order_relaxed );
+		}
+
+		memFreeBlock_t* block = ( memFreeBlock_t* )pool.chunk;
+		pool.chunk += blockSize;
+		pool.chunkSize -= blockSize;
+		block->next = list;
+		list = block;
+		numBlocks++;
+	}
+
+	Mem_UnlockPool( pool );
+
+	cache.freeList[sizeClass] = list;
+	cache.numFree[sizeClass] = numBlocks;
+
+	memThreadCacheOwner.active = true;
+
+	return ( numBlocks != 0 );
+}
+
+/*
+==================
+Mem_SpillThreadCache
+
+Hands the first numBlocks blocks of the thread cache back to the shared pool.
+==================
+*/
+static void Mem_SpillThreadCache( memThreadCache_t& cache, const int sizeClass, const int numBlocks )
+{
+	if( numBlocks <= 0 )
+	{
+		return;
+	}
+
+	memFreeBlock_t* first = cache.freeList[sizeClass];
+	memFreeBlock_t* last = first;
+	for( int i = 1; i < numBlocks; i++ )
+	{
+		last = last->next;
+	}
+
+	cache.freeList[sizeClass] = last->next;
+	cache.numFree[sizeClass] -= numBlocks;
+
+	memClassPool_t& pool = memPools[sizeClass];
+
+	Mem_LockPool( pool );
+	last->next = pool.freeList;
+	pool.freeList = first;
+	Mem_UnlockPool( pool );
+}
+
+/*
+==================
+Mem_FlushThreadCache
+==================
+*/
+void Mem_FlushThreadCache()
+{
+#if !defined( ID_SYSTEM_ALLOCATOR )
+	memThreadCache_t& cache = memThreadCache;
+	for( int i = 0; i < MEM_NUM_SIZE_CLASSES; i++ )
+	{
+		Mem_SpillThreadCache( cache, i, cache.numFree[i] );
+	}
+#endif
+}
+
+/*
+==================
+memThreadCacheOwner_t::~memThreadCacheOwner_t
+==================
+*/
+memThreadCacheOwner_t::~memThreadCacheOwner_t()
+{
+	Mem_FlushThreadCache();
+	memThreadCache.exited = true;
+}
+
+/*
+==================
+Mem_Alloc16
+==================
+*/
+// RB: 64 bit fixes, changed int to size_t
+void* Mem_Alloc16( const size_t size, const memTag_t tag )
+// RB end
+{
+	if( !size )
+	{
+		return NULL;
+	}
+
+#if defined( ID_SYSTEM_ALLOCATOR )
+	memAllocsTotal.fetch_add( 1, std::memory_order_relaxed );
+	return Mem_SystemAlloc( size );
+#else
+	const size_t blockSize = ( size + sizeof( memHeader_t ) + 15 ) & ~15;
+
+	memHeader_t* header;
+	int sizeClass = MEM_LARGE_BLOCK;
+
+	if( blockSize <= MEM_SMALL_BLOCK_SIZE )
+	{
+		sizeClass = Mem_SizeClass( blockSize );
+
+		memThreadCache_t& cache = memThreadCache;
+		if( cache.freeList[sizeClass] == NULL && !Mem_RefillThreadCache( cache, sizeClass ) )
+		{
+			return NULL;
+		}
+
+		memFreeBlock_t* block = cache.freeList[sizeClass];
+		cache.freeList[sizeClass] = block->next;
+		cache.numFree[sizeClass]--;
+
+		header = ( memHeader_t* )block;
+	}
+	else
+	{
+		header = ( memHeader_t* )Mem_SystemAlloc( blockSize );
+		if( header == NULL )
+		{
+			return NULL;
+		}
+		memReservedBytes.fetch_add( blockSize, std::memory_order_relaxed );
+	}
+
+	header->size = size;
+	header->tag = ( byte )tag;
+	header->sizeClass = ( byte )sizeClass;
+	header->pad = 0;
+	header->magic = MEM_HEADER_MAGIC;
+
+	memTagBytes[tag].fetch_add( size, std::memory_order_relaxed );
+	memTagAllocs[tag].fetch_add( 1, std::memory_order_relaxed );
+	memAllocsTotal.fetch_add( 1, std::memory_order_relaxed );
+
+	return header + 1;
+#endif
+}
+
+/*
+==================
+Mem_Free16
+==================
+*/
+void Mem_Free16( void* ptr )
+{
+	if( ptr == NULL )
+	{
+		return;
+	}
+
+#if defined( ID_SYSTEM_ALLOCATOR )
+	Mem_SystemFree( ptr );
+#else
+	memHeader_t* header = ( memHeader_t* )ptr - 1;
+
+	assert( header->magic != MEM_FREED_MAGIC );		// freed twice
+	assert( header->magic == MEM_HEADER_MAGIC );	// not from Mem_Alloc16
+
+	// release builds leak a block they can't trust instead of corrupting the pools
+	if( header->magic != MEM_HEADER_MAGIC || header->tag >= TAG_NUM_TAGS )
+	{
+		return;
+	}
+
+	const size_t size = ( size_t )header->size;
+	const int tag = header->tag;
+	const int sizeClass = header->sizeClass;
+
+	header->magic = MEM_FREED_MAGIC;
+
+	memTagBytes[tag].fetch_sub( size, std::memory_order_relaxed );
+	memTagAllocs[tag].fetch_sub( 1, std::memory_order_relaxed );
+
+	if( sizeClass == MEM_LARGE_BLOCK )
+	{
+		memReservedBytes.fetch_sub( ( size + sizeof( memHeader_t ) + 15 ) & ~15, std::memory_order_relaxed );
+		Mem_SystemFree( header );
+		return;
+	}
+
+	// blocks freed by another thread than the one that allocated them simply
+	// move over to the cache of the freeing thread
+	memThreadCache_t& cache = memThreadCache;
+	memFreeBlock_t* block = ( memFreeBlock_t* )header;
+	block->next = cache.freeList[sizeClass];
+	cache.freeList[sizeClass] = block;
+	cache.numFree[sizeClass]++;
+
+	const int batchSize = MEM_CACHE_BATCH_SIZE / memClassSizes[sizeClass];
+	if( cache.exited )
+	{
+		Mem_SpillThreadCache( cache, sizeClass, cache.numFree[sizeClass] );
+	}
+	else if( cache.numFree[sizeClass] > batchSize * 2 )
+	{
+		Mem_SpillThreadCache( cache, sizeClass, batchSize );
+	}
+#endif
+}
+
+/*
+==================
+Mem_GetTagStats
+==================
+*/
+void Mem_GetTagStats( const memTag_t tag, memTagStats_t& stats )
+{
+	stats.numBytes = memTagBytes[tag].load( std::memory_order_relaxed );
+	stats.numAllocs = memTagAllocs[tag].load( std::memory_order_relaxed );
+}
+
+/*
+==================
+Mem_GetHeapStats
+==================
+*/
+void Mem_GetHeapStats( memHeapStats_t& stats )
+{
+	stats.numBytes = 0;
+	stats.numAllocs = 0;
+	for( int i = 0; i < TAG_NUM_TAGS; i++ )
+	{
+		stats.numBytes += memTagBytes[i].load( std::memory_order_relaxed );
+		stats.numAllocs += memTagAllocs[i].load( std::memory_order_relaxed );
+	}
+	stats.numAllocsTotal = memAllocsTotal.load( std::memory_order_relaxed );
+	stats.reservedBytes = memReservedBytes.load( std::memory_order_relaxed );
+}
+
+/*
+==================
+Mem_GetTagName
+==================
+*/
+const char* Mem_GetTagName( const memTag_t tag )
+{
+	if( tag < 0 || tag >= TAG_NUM_TAGS )
+	{
+		return "?";
+	}
+	return memTagNames[tag];
+}
+
 /*
 ==================
 Mem_ClearedAlloc
@@ -110,3 +544,168 @@ char* Mem_CopyString( const char* in )
 	return out;
 }
 
+/*
+==================
+operator new / operator delete
+
+All replaceable forms are defined here, out of line as the standard requires.
+The unsized, sized and nothrow forms go through Mem_Alloc with TAG_NEW.
+
+The aligned forms are only used for types aligned beyond the 16 bytes
+Mem_Alloc guarantees, they take their blocks straight from the system heap
+without a header and always come back through an aligned delete.
+==================
+*/
+void* operator new( size_t s )
+{
+	// a zero sized new must still return a unique pointer
+	return Mem_Alloc( s ? s : 1, TAG_NEW );
+}
+
+void* operator new[]( size_t s )
+{
+	return Mem_Alloc( s ? s : 1, TAG_NEW );
+}
+
+void* operator new( size_t s, const std::nothrow_t& ) noexcept
+{
+	return Mem_Alloc( s ? s : 1, TAG_NEW );
+}
+
+void* operator new[]( size_t s, const std::nothrow_t& ) noexcept
+{
+	return Mem_Alloc( s ? s : 1, TAG_NEW );
+}
+
+// SRS - Added noexcept to silence build-time warning
+void operator delete( void* p ) noexcept
+{
+	Mem_Free( p );
+}
+
+void operator delete[]( void* p ) noexcept
+{
+	Mem_Free( p );
+}
+
+void operator delete( void* p, size_t ) noexcept
+{
+	Mem_Free( p );
+}
+
+void operator delete[]( void* p, size_t ) noexcept
+{
+	Mem_Free( p );
+}
+
+void operator delete( void* p, const std::nothrow_t& ) noexcept
+{
+	Mem_Free( p );
+}
+
+void operator delete[]( void* p, const std::nothrow_t& ) noexcept
+{
+	Mem_Free( p );
+}
+
+#if defined( __cpp_aligned_new )
+void* operator new( size_t s, std::align_val_t alignment )
+{
+	return Mem_SystemAlloc( s ? s : 1, Max( ( size_t )alignment, sizeof( void* ) ) );
+}
+
+void* operator new[]( size_t s, std::align_val_t alignment )
+{
+	return Mem_SystemAlloc( s ? s : 1, Max( ( size_t )alignment, sizeof( void* ) ) );
+}
+
+void* operator new( size_t s, std::align_val_t alignment, const std::nothrow_t& ) noexcept
+{
+	return Mem_SystemAlloc( s ? s : 1, Max( ( size_t )alignment, sizeof( void* ) ) );
+}
+
+void* operator new[]( size_t s, std::align_val_t alignment, const std::nothrow_t& ) noexcept
+{
+	return Mem_SystemAlloc( s ? s : 1, Max( ( size_t )alignment, sizeof( void* ) ) );
+}
+
+void operator delete( void* p, std::align_val_t ) noexcept
+{
+	Mem_SystemFree( p );
+}
+
+void operator delete[]( void* p, std::align_val_t ) noexcept
+{
+	Mem_SystemFree( p );
+}
+
+void operator delete( void* p, size_t, std::align_val_t ) noexcept
+{
+	Mem_SystemFree( p );
+}
+
+void operator delete[]( void* p, size_t, std::align_val_t ) noexcept
+{
+	Mem_SystemFree( p );
+}
+
+void operator delete( void* p, std::align_val_t, const std::nothrow_t& ) noexcept
+{
+	Mem_SystemFree( p );
+}
+
+void operator delete[]( void* p, std::align_val_t, const std::nothrow_t& ) noexcept
+{
+	Mem_SystemFree( p );
+}
+#endif
+
+/*
+==================
+memStats
+==================
+*/
+struct memTagStatsSort_t
+{
+	int					tag;
+	memTagStats_t		stats;
+};
+
+static int MemStatsSortByBytes( const void* a, const void* b )
+{
+	const int64 bytesA = ( ( const memTagStatsSort_t* )a )->stats.numBytes;
+	const int64 bytesB = ( ( const memTagStatsSort_t* )b )->stats.numBytes;
+	return ( bytesA < bytesB ) - ( bytesA > bytesB );
+}
+
+CONSOLE_COMMAND( memStats, "prints the live allocations of every memory tag", 0 )
+{
+	memTagStatsSort_t tags[TAG_NUM_TAGS];
+	for( int i = 0; i < TAG_NUM_TAGS; i++ )
+	{
+		tags[i].tag = i;
+		Mem_GetTagStats( ( memTag_t )i, tags[i].stats );
+	}
+	qsort( tags, TAG_NUM_TAGS, sizeof( tags[0] ), MemStatsSortByBytes );
+
+	idLib::Printf( "%-24s %10s %10s\n", "tag", "kB", "blocks" );
+	idLib::Printf( "-----------------------------------------------\n" );
+	for( int i = 0; i < TAG_NUM_TAGS; i++ )
+	{
+		if( tags[i].stats.numAllocs == 0 )
+		{
+			continue;
+		}
+		idLib::Printf( "%-24s %10lld %10i\n", Mem_GetTagName( ( memTag_t )tags[i].tag ), ( long long )( tags[i].stats.numBytes >> 10 ), tags[i].stats.numAllocs );
+	}
+
+	memHeapStats_t heap;
+	Mem_GetHeapStats( heap );
+
+	idLib::Printf( "-----------------------------------------------\n" );
+	idLib::Printf( "%-24s %10lld %10i\n", "total", ( long long )( heap.numBytes >> 10 ), heap.numAllocs );
+	idLib::Printf( "%lld kB reserved from the system, %lld allocations since startup\n", ( long long )( heap.reservedBytes >> 10 ), ( long long )heap.numAllocsTotal );
+#if defined( ID_SYSTEM_ALLOCATOR )
+	idLib::Printf( "system allocator, no thread caches and no per tag statistics\n" );
+#endif
+}
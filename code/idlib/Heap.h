@@ -67,33 +67,32 @@ void* 		Mem_ClearedAlloc( const size_t size, const memTag_t tag );
 char* 		Mem_CopyString( const char* in );
 // RB end
 
-#ifdef _MSC_VER						// SRS: #pragma warning is MSVC specific
-	#pragma warning( push )
-	#pragma warning( disable : 4595 )	// C4595: non-member operator new or delete functions may not be declared inline
-#endif
-ID_INLINE void* operator new( size_t s )
+// live allocations of a single memory tag
+struct memTagStats_t
 {
-	return Mem_Alloc( s, TAG_NEW );
-}
+	int64		numBytes;			// requested bytes, allocator overhead excluded
+	int			numAllocs;
+};
 
-// SRS - Added noexcept to silence build-time warning
-ID_INLINE void operator delete( void* p ) noexcept
+struct memHeapStats_t
 {
-	Mem_Free( p );
-}
-ID_INLINE void* operator new[]( size_t s )
-{
-	return Mem_Alloc( s, TAG_NEW );
-}
+	int64		numBytes;			// requested bytes of all live blocks
+	int			numAllocs;			// live blocks
+	int64		numAllocsTotal;		// Mem_Alloc calls since startup
+	int64		reservedBytes;		// taken from the system, cached and chunked blocks included
+};
 
-// SRS - Added noexcept to silence build-time warning
-ID_INLINE void operator delete[]( void* p ) noexcept
-{
-	Mem_Free( p );
-}
-#ifdef _MSC_VER
-	#pragma warning( pop )
-#endif
+void		Mem_GetTagStats( const memTag_t tag, memTagStats_t& stats );
+void		Mem_GetHeapStats( memHeapStats_t& stats );
+const char* Mem_GetTagName( const memTag_t tag );
+
+// returns the small blocks cached by the calling thread to the shared pools,
+// every thread that took blocks from the pools also does this when it exits
+void		Mem_FlushThreadCache();
+
+// The global operator new and delete are replaced in Heap.cpp. Every form of
+// them is replaced, the library's sized and nothrow forms would otherwise hand
+// blocks with a memory header to free().
 
 ID_INLINE void* operator new( size_t s, memTag_t tag )
 {
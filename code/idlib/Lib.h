@@ -318,6 +318,7 @@ public:
 // text manipulation
 #include "Str.h"
 #include "StrStatic.h"
+#include "Name.h"
 #include "Token.h"
 #include "Lexer.h"
 #include "Parser.h"
@@ -37,6 +37,10 @@ If you have questions concerning this license or the applicable additional terms
 
 idCVar gltf_MapSceneName( "gltf_MapSceneName", "Scene", CVAR_SYSTEM , "Scene to use when d-mapping a gltf/glb" );
 
+#define MAP_ENTITYCACHE_EXT		"bentities"
+#define MAP_ENTITYCACHE_ID		"MapEntities"
+#define MAP_ENTITYCACHE_VERSION	"1"
+
 /*
 ===============
 FloatCRC
@@ -2326,6 +2330,255 @@ bool idMapFile::NeedsReload()
 	return true;
 }
 
+/*
+===============
+FindMapSourceFile
+
+finds the file idMapFile::Parse would load for the given name, in the same order
+===============
+*/
+static bool FindMapSourceFile( const idStr& mapName, idStr& sourceName, ID_TIME_T& sourceTime )
+{
+	static const char* sourceExtensions[] = { "json", "glb", "gltf", "map" };
+	static const int numSourceExtensions = sizeof( sourceExtensions ) / sizeof( sourceExtensions[0] );
+
+	for( int i = 0; i < numSourceExtensions; i++ )
+	{
+		sourceName = mapName;
+		sourceName.SetFileExtension( sourceExtensions[i] );
+		sourceTime = idLib::fileSystem->GetTimestamp( sourceName );
+		if( sourceTime != FILE_NOT_FOUND_TIMESTAMP )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+===============
+FindEntityCacheKey
+===============
+*/
+static int FindEntityCacheKey( const idStrList& keys, const idHashIndex& keyHash, const char* key )
+{
+	for( int index = keyHash.First( keyHash.GenerateKey( key, true ) ); index != -1; index = keyHash.Next( index ) )
+	{
+		if( keys[index].Cmp( key ) == 0 )
+		{
+			return index;
+		}
+	}
+	return -1;
+}
+
+/*
+===============
+idMapFile::LoadEntityCache
+
+loads only the entity key/value pairs from generated/<map>.bentities
+if the cache is still up to date with the map source and its _extra_ents.map.
+The map has no primitive data afterwards.
+===============
+*/
+bool idMapFile::LoadEntityCache( const char* filename )
+{
+	idStr mapName = filename;
+	mapName.StripFileExtension();
+	mapName.StripFileExtension(); // RB: there might be .map.map
+
+	idStr sourceName;
+	ID_TIME_T sourceTime;
+	if( !FindMapSourceFile( mapName, sourceName, sourceTime ) )
+	{
+		return false;
+	}
+	ID_TIME_T extraEntsTime = idLib::fileSystem->GetTimestamp( mapName + "_extra_ents.map" );
+
+	idStr cacheName = mapName;
+	cacheName.Insert( "generated/", 0 );
+	cacheName.SetFileExtension( MAP_ENTITYCACHE_EXT );
+
+	idFile* file = idLib::fileSystem->OpenFileReadMemory( cacheName );
+	if( file == NULL )
+	{
+		return false;
+	}
+
+	idStrStatic< 32 > fileID;
+	idStrStatic< 32 > fileVersion;
+	idStr cachedSourceName;
+	int64 cachedSourceTime = 0;
+	int64 cachedExtraEntsTime = 0;
+	file->ReadString( fileID );
+	file->ReadString( fileVersion );
+	file->ReadString( cachedSourceName );
+	file->ReadBig( cachedSourceTime );
+	file->ReadBig( cachedExtraEntsTime );
+
+	if( fileID != MAP_ENTITYCACHE_ID || fileVersion != MAP_ENTITYCACHE_VERSION ||
+			cachedSourceName.Icmp( sourceName ) != 0 || cachedSourceTime != ( int64 )sourceTime || cachedExtraEntsTime != ( int64 )extraEntsTime )
+	{
+		idLib::fileSystem->CloseFile( file );
+		return false;
+	}
+
+	int cachedVersion = 0;
+	unsigned int cachedCRC = 0;
+	byte cachedFormat = 0;
+	file->ReadBig( cachedVersion );
+	file->ReadBig( cachedCRC );
+	file->ReadBig( cachedFormat );
+
+	// keys are stored once and referenced by index
+	int numKeys = 0;
+	file->ReadBig( numKeys );
+	if( numKeys < 0 || numKeys > 0xFFFF )
+	{
+		idLib::fileSystem->CloseFile( file );
+		return false;
+	}
+
+	idStrList keys;
+	keys.SetNum( numKeys );
+	for( int i = 0; i < numKeys; i++ )
+	{
+		file->ReadString( keys[i] );
+	}
+
+	int numEntities = 0;
+	file->ReadBig( numEntities );
+	if( numEntities < 0 )
+	{
+		idLib::fileSystem->CloseFile( file );
+		return false;
+	}
+
+	entities.DeleteContents( true );
+	entities.Resize( Max( numEntities, 1 ) );
+
+	idStr value;
+	for( int i = 0; i < numEntities; i++ )
+	{
+		idMapEntity* mapEnt = new( TAG_SYSTEM ) idMapEntity();
+		entities.Append( mapEnt );
+
+		unsigned short numPairs = 0;
+		file->ReadBig( numPairs );
+		for( int j = 0; j < numPairs; j++ )
+		{
+			unsigned short key = 0;
+			file->ReadBig( key );
+			file->ReadString( value );
+			if( key >= numKeys )
+			{
+				idLib::Warning( "%s is corrupt", cacheName.c_str() );
+				entities.DeleteContents( true );
+				idLib::fileSystem->CloseFile( file );
+				return false;
+			}
+			mapEnt->epairs.Set( keys[key], value );
+		}
+	}
+
+	idLib::fileSystem->CloseFile( file );
+
+	name = mapName;
+	version = cachedVersion;
+	fileTime = sourceTime;
+	geometryCRC = cachedCRC;
+	valve220Format = ( cachedFormat & 1 ) != 0;
+	gltfFormat = ( cachedFormat & 2 ) != 0;
+	hasPrimitiveData = false;
+
+	return true;
+}
+
+/*
+===============
+idMapFile::WriteEntityCache
+
+writes the entity key/value pairs of a parsed map to generated/<map>.bentities,
+keyed by the timestamps of the map source and its _extra_ents.map
+===============
+*/
+bool idMapFile::WriteEntityCache() const
+{
+	idStr sourceName;
+	ID_TIME_T sourceTime;
+	if( !FindMapSourceFile( name, sourceName, sourceTime ) )
+	{
+		return false;
+	}
+	ID_TIME_T extraEntsTime = idLib::fileSystem->GetTimestamp( name + "_extra_ents.map" );
+
+	// gather the unique keys
+	idStrList keys;
+	idHashIndex keyHash;
+	for( int i = 0; i < entities.Num(); i++ )
+	{
+		const idDict& epairs = entities[i]->epairs;
+		for( int j = 0; j < epairs.GetNumKeyVals(); j++ )
+		{
+			const idStr& key = epairs.GetKeyVal( j )->GetKey();
+			if( FindEntityCacheKey( keys, keyHash, key ) == -1 )
+			{
+				keyHash.Add( keyHash.GenerateKey( key, true ), keys.Append( key ) );
+			}
+		}
+		if( epairs.GetNumKeyVals() > 0xFFFF )
+		{
+			return false;
+		}
+	}
+
+	if( keys.Num() > 0xFFFF )
+	{
+		return false;
+	}
+
+	idStr cacheName = name;
+	cacheName.Insert( "generated/", 0 );
+	cacheName.SetFileExtension( MAP_ENTITYCACHE_EXT );
+
+	idFile* file = idLib::fileSystem->OpenFileWrite( cacheName, "fs_basepath" );
+	if( file == NULL )
+	{
+		return false;
+	}
+
+	file->WriteString( MAP_ENTITYCACHE_ID );
+	file->WriteString( MAP_ENTITYCACHE_VERSION );
+	file->WriteString( sourceName );
+	file->WriteBig( ( int64 )sourceTime );
+	file->WriteBig( ( int64 )extraEntsTime );
+	file->WriteBig( version );
+	file->WriteBig( geometryCRC );
+	file->WriteBig( ( byte )( ( valve220Format ? 1 : 0 ) | ( gltfFormat ? 2 : 0 ) ) );
+
+	file->WriteBig( keys.Num() );
+	for( int i = 0; i < keys.Num(); i++ )
+	{
+		file->WriteString( keys[i] );
+	}
+
+	file->WriteBig( entities.Num() );
+	for( int i = 0; i < entities.Num(); i++ )
+	{
+		const idDict& epairs = entities[i]->epairs;
+		file->WriteBig( ( unsigned short )epairs.GetNumKeyVals() );
+		for( int j = 0; j < epairs.GetNumKeyVals(); j++ )
+		{
+			const idKeyValue* kv = epairs.GetKeyVal( j );
+			file->WriteBig( ( unsigned short )FindEntityCacheKey( keys, keyHash, kv->GetKey() ) );
+			file->WriteString( kv->GetValue() );
+		}
+	}
+
+	idLib::fileSystem->CloseFile( file );
+	return true;
+}
+
 
 // RB begin
 MapPolygonMesh::MapPolygonMesh()
@@ -543,6 +543,11 @@ public:
 	// returns true if the file on disk changed
 	bool					NeedsReload();
 
+	// the binary entity cache keeps only the entity key/value pairs under generated/,
+	// so the game can skip parsing brushes and patches that are already compiled into .proc and .cm
+	bool					LoadEntityCache( const char* filename );
+	bool					WriteEntityCache() const;
+
 	int						AddEntity( idMapEntity* mapentity );
 	idMapEntity* 			FindEntity( const char* name ) const;
 	idMapEntity*			FindEntityAtOrigin( const idVec3& org ) const; // RB
@@ -550,7 +555,7 @@ public:
 	void					RemoveEntities( const char* classname );
 	void					RemoveAllEntities();
 	void					RemovePrimitiveData();
-	bool					HasPrimitiveData()
+	bool					HasPrimitiveData() const
 	{
 		return hasPrimitiveData;
 	}
@@ -0,0 +1,243 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "precompiled.h"
+#pragma hdrstop
+
+#include <atomic>
+
+/*
+The table is a fixed array of buckets so it can be read without taking a
+lock. A new entry is fully built before it is published at the head of its
+bucket and entries are never removed. Writers serialize on a spin lock, which
+unlike idSysMutex needs no constructor, so names can already be interned by
+static initializers such as the idEventDef constructors.
+*/
+
+static const int NAME_HASH_BITS		= 15;
+static const int NAME_HASH_SIZE		= 1 << NAME_HASH_BITS;
+
+static std::atomic<idNameEntry*>	nameHash[NAME_HASH_SIZE];
+static interlockedInt_t				nameLock;
+static int							numNames;
+static size_t						namesAllocated;
+static bool							namesFull;
+
+/*
+================
+Name_Bucket
+================
+*/
+static ID_INLINE int Name_Bucket( const int hash )
+{
+	// idStr::IHash is a plain sum of the characters, spread it over the table
+	return ( int )( ( ( unsigned int )hash * 2654435761u ) >> ( 32 - NAME_HASH_BITS ) );
+}
+
+/*
+================
+Name_FindEntry
+================
+*/
+static const idNameEntry* Name_FindEntry( const char* string, const int hash, const int bucket )
+{
+	for( const idNameEntry* entry = nameHash[bucket].load( std::memory_order_acquire ); entry != NULL; entry = entry->next )
+	{
+		if( entry->hash == hash && entry->string.Icmp( string ) == 0 )
+		{
+			return entry;
+		}
+	}
+	return NULL;
+}
+
+/*
+================
+Name_Intern
+================
+*/
+static const idNameEntry* Name_Intern( const char* string, const bool limited )
+{
+	if( string == NULL || string[0] == '\0' )
+	{
+		return NULL;
+	}
+
+	const int hash = idStr::IHash( string );
+	const int bucket = Name_Bucket( hash );
+
+	const idNameEntry* entry = Name_FindEntry( string, hash, bucket );
+	if( entry != NULL )
+	{
+		return entry;
+	}
+
+	while( Sys_InterlockedCompareExchange( nameLock, 0, 1 ) != 0 )
+	{
+		Sys_Yield();
+	}
+
+	// another thread may have added the name in the meantime
+	entry = Name_FindEntry( string, hash, bucket );
+	if( entry == NULL )
+	{
+		if( limited && numNames >= idName::MAX_NAMES )
+		{
+			namesFull = true;
+		}
+		else
+		{
+			idNameEntry* newEntry = new( TAG_IDLIB_STRING ) idNameEntry;
+			newEntry->string = string;
+			newEntry->hash = hash;
+			newEntry->next = nameHash[bucket].load( std::memory_order_relaxed );
+			nameHash[bucket].store( newEntry, std::memory_order_release );
+
+			numNames++;
+			namesAllocated += sizeof( idNameEntry ) + newEntry->string.Allocated();
+
+			entry = newEntry;
+		}
+	}
+
+	Sys_InterlockedExchange( nameLock, 0 );
+
+	return entry;
+}
+
+/*
+================
+idName::idName
+================
+*/
+idName::idName( const char* string )
+{
+	entry = Name_Intern( string, false );
+}
+
+/*
+================
+idName::TryIntern
+================
+*/
+idName idName::TryIntern( const char* string )
+{
+	idName name;
+	name.entry = Name_Intern( string, true );
+	return name;
+}
+
+/*
+================
+idName::IsFull
+================
+*/
+bool idName::IsFull()
+{
+	return namesFull;
+}
+
+/*
+================
+idName::Find
+================
+*/
+idName idName::Find( const char* string )
+{
+	idName name;
+
+	if( string == NULL || string[0] == '\0' )
+	{
+		return name;
+	}
+
+	const int hash = idStr::IHash( string );
+	name.entry = Name_FindEntry( string, hash, Name_Bucket( hash ) );
+	return name;
+}
+
+/*
+================
+idName::NumNames
+================
+*/
+int idName::NumNames()
+{
+	return numNames;
+}
+
+/*
+================
+idName::Allocated
+================
+*/
+size_t idName::Allocated()
+{
+	return namesAllocated + sizeof( nameHash );
+}
+
+/*
+================
+idName::EmptyString
+================
+*/
+const idStr& idName::EmptyString()
+{
+	static const idStr empty;
+	return empty;
+}
+
+/*
+================
+listNames
+================
+*/
+CONSOLE_COMMAND( listNames, "lists the interned names, optionally only those starting with [prefix]", 0 )
+{
+	const char* prefix = ( args.Argc() > 1 ) ? args.Argv( 1 ) : "";
+	const int prefixLength = idStr::Length( prefix );
+
+	idStrList names;
+	for( int i = 0; i < NAME_HASH_SIZE; i++ )
+	{
+		for( const idNameEntry* entry = nameHash[i].load( std::memory_order_acquire ); entry != NULL; entry = entry->next )
+		{
+			if( entry->string.Icmpn( prefix, prefixLength ) == 0 )
+			{
+				names.Append( entry->string );
+			}
+		}
+	}
+	names.SortWithTemplate( idSort_Str() );
+
+	for( int i = 0; i < names.Num(); i++ )
+	{
+		idLib::Printf( "%s\n", names[i].c_str() );
+	}
+	idLib::Printf( "%d of %d names, %d KB\n", names.Num(), idName::NumNames(), ( int )( idName::Allocated() >> 10 ) );
+}
@@ -0,0 +1,134 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#ifndef __NAME_H__
+#define __NAME_H__
+
+/*
+===============================================================================
+
+	idName
+
+	Interned, case-insensitive name. Every distinct name is stored once in a
+	global table and kept until the program exits, so names carry their hash
+	with them and compare by pointer. Looking up and interning names is safe
+	from any thread; only adding a new name to the table takes a lock.
+
+	The hash is idStr::IHash of the string, which means idHashIndex keys
+	generated from a name match the ones generated from the plain string.
+
+	Names from data that may come from the network, such as dictionary keys,
+	go through TryIntern, which stops adding names once the table is full
+	so a client can't grow it without bound.
+
+===============================================================================
+*/
+
+struct idNameEntry
+{
+	idStr				string;
+	int					hash;
+	idNameEntry* 		next;
+};
+
+class idName
+{
+public:
+	idName();
+	explicit idName( const char* string );
+
+	// returns the name if it was interned before, an empty name otherwise
+	static idName		Find( const char* string );
+	// same as the constructor, but returns an empty name instead of adding
+	// a new one once the table holds MAX_NAMES names
+	static idName		TryIntern( const char* string );
+	// true once TryIntern refused to add a name
+	static bool			IsFull();
+
+	static const int	MAX_NAMES = 1 << 16;
+
+	const char* 		c_str() const;
+	const idStr& 		GetString() const;
+	int					Length() const;
+	int					GetHash() const;
+	bool				IsEmpty() const;
+
+	bool				operator==( const idName& other ) const;
+	bool				operator!=( const idName& other ) const;
+
+	// number of interned names and the memory they use
+	static int			NumNames();
+	static size_t		Allocated();
+
+private:
+	const idNameEntry* 	entry;
+
+	static const idStr&	EmptyString();
+};
+
+ID_INLINE idName::idName()
+{
+	entry = NULL;
+}
+
+ID_INLINE const char* idName::c_str() const
+{
+	return ( entry != NULL ) ? entry->string.c_str() : "";
+}
+
+ID_INLINE const idStr& idName::GetString() const
+{
+	return ( entry != NULL ) ? entry->string : EmptyString();
+}
+
+ID_INLINE int idName::Length() const
+{
+	return ( entry != NULL ) ? entry->string.Length() : 0;
+}
+
+ID_INLINE int idName::GetHash() const
+{
+	return ( entry != NULL ) ? entry->hash : 0;
+}
+
+ID_INLINE bool idName::IsEmpty() const
+{
+	return ( entry == NULL );
+}
+
+ID_INLINE bool idName::operator==( const idName& other ) const
+{
+	return ( entry == other.entry );
+}
+
+ID_INLINE bool idName::operator!=( const idName& other ) const
+{
+	return ( entry != other.entry );
+}
+
+#endif /* !__NAME_H__ */
@@ -270,6 +270,9 @@ int idSysThread::ThreadProc( idSysThread* thread )
 		}
 	}
 
+	// give the small blocks this thread kept around back to the heap
+	Mem_FlushThreadCache();
+
 	thread->isRunning = false;
 
 	return retVal;
@@ -2294,6 +2294,166 @@ bool idRenderMatrix::CullExtrudedBoundsToMVPbits( const idRenderMatrix& mvp, con
 #endif
 }
 
+/*
+========================
+idRenderMatrix::CullBoundsSoAToMVP
+
+Same test as CullBoundsToMVP but for many bounds at once. The six clip planes are
+transformed to the space of the bounds once, after which each bounds only needs the
+distance of its center plus its projected extents for every plane. A bounds is culled
+when it is completely behind one of the planes.
+
+Eight bounds are tested per iteration. The bounds are gathered through the index list,
+so callers can test any subset of a structure of arrays without copying it.
+
+Inverted bounds ( min > max ) are used to mark unused entries and are always culled.
+========================
+*/
+int idRenderMatrix::CullBoundsSoAToMVP( const idRenderMatrix& mvp, const boundsSoA_t& bounds, const int* indices, int numIndices, int* outIndices, bool zeroToOne )
+{
+	const float minMul = zeroToOne ? 0.0f : -1.0f;
+
+	// inside( p ) = p * plane > 0
+	ALIGN16( float planes[6][4] );
+	for( int i = 0; i < 4; i++ )
+	{
+		planes[0][i] = mvp[0][i] - minMul * mvp[3][i];
+		planes[1][i] = mvp[3][i] - mvp[0][i];
+		planes[2][i] = mvp[1][i] - minMul * mvp[3][i];
+		planes[3][i] = mvp[3][i] - mvp[1][i];
+#if defined( CLIP_SPACE_D3D )	// the D3D clip space Z is in the range [0,1] so always compare Z vs zero whether 'zeroToOne' is true or false
+		planes[4][i] = mvp[2][i];
+#else
+		planes[4][i] = mvp[2][i] - minMul * mvp[3][i];
+#endif
+		planes[5][i] = mvp[3][i] - mvp[2][i];
+	}
+
+	int numVisible = 0;
+	int i = 0;
+
+#if defined(USE_INTRINSICS_SSE)
+
+	const __m128 half = _mm_set1_ps( 0.5f );
+	const __m128 zero = _mm_setzero_ps();
+
+	for( ; i + 8 <= numIndices; i += 8 )
+	{
+		__m128 center[2][3];
+		__m128 extents[2][3];
+		__m128 inverted[2];
+
+		for( int g = 0; g < 2; g++ )
+		{
+			for( int a = 0; a < 3; a++ )
+			{
+				const float* mins = bounds.min[a];
+				const float* maxs = bounds.max[a];
+				__m128 bmin, bmax;
+				if( indices != NULL )
+				{
+					const int* index = indices + i + g * 4;
+					bmin = _mm_setr_ps( mins[index[0]], mins[index[1]], mins[index[2]], mins[index[3]] );
+					bmax = _mm_setr_ps( maxs[index[0]], maxs[index[1]], maxs[index[2]], maxs[index[3]] );
+				}
+				else
+				{
+					bmin = _mm_loadu_ps( mins + i + g * 4 );
+					bmax = _mm_loadu_ps( maxs + i + g * 4 );
+				}
+				if( a == 0 )
+				{
+					inverted[g] = _mm_cmplt_ps( bmax, bmin );
+				}
+				center[g][a] = _mm_mul_ps( _mm_add_ps( bmin, bmax ), half );
+				extents[g][a] = _mm_mul_ps( _mm_sub_ps( bmax, bmin ), half );
+			}
+		}
+
+		__m128 culled0 = inverted[0];
+		__m128 culled1 = inverted[1];
+		for( int p = 0; p < 6; p++ )
+		{
+			const __m128 nx = _mm_set1_ps( planes[p][0] );
+			const __m128 ny = _mm_set1_ps( planes[p][1] );
+			const __m128 nz = _mm_set1_ps( planes[p][2] );
+			const __m128 nd = _mm_set1_ps( planes[p][3] );
+			const __m128 ax = _mm_set1_ps( idMath::Fabs( planes[p][0] ) );
+			const __m128 ay = _mm_set1_ps( idMath::Fabs( planes[p][1] ) );
+			const __m128 az = _mm_set1_ps( idMath::Fabs( planes[p][2] ) );
+
+			// distance of the corner furthest along the plane normal
+			__m128 d0 = _mm_madd_ps( center[0][0], nx, nd );
+			__m128 d1 = _mm_madd_ps( center[1][0], nx, nd );
+			d0 = _mm_madd_ps( center[0][1], ny, d0 );
+			d1 = _mm_madd_ps( center[1][1], ny, d1 );
+			d0 = _mm_madd_ps( center[0][2], nz, d0 );
+			d1 = _mm_madd_ps( center[1][2], nz, d1 );
+			d0 = _mm_madd_ps( extents[0][0], ax, d0 );
+			d1 = _mm_madd_ps( extents[1][0], ax, d1 );
+			d0 = _mm_madd_ps( extents[0][1], ay, d0 );
+			d1 = _mm_madd_ps( extents[1][1], ay, d1 );
+			d0 = _mm_madd_ps( extents[0][2], az, d0 );
+			d1 = _mm_madd_ps( extents[1][2], az, d1 );
+
+			culled0 = _mm_or_ps( culled0, _mm_cmple_ps( d0, zero ) );
+			culled1 = _mm_or_ps( culled1, _mm_cmple_ps( d1, zero ) );
+		}
+
+		const int mask = _mm_movemask_ps( culled0 ) | ( _mm_movemask_ps( culled1 ) << 4 );
+		if( mask == 0xFF )
+		{
+			continue;
+		}
+		for( int j = 0; j < 8; j++ )
+		{
+			if( ( mask & ( 1 << j ) ) == 0 )
+			{
+				outIndices[numVisible++] = ( indices != NULL ) ? indices[i + j] : i + j;
+			}
+		}
+	}
+
+#endif
+
+	for( ; i < numIndices; i++ )
+	{
+		const int index = ( indices != NULL ) ? indices[i] : i;
+
+		if( bounds.max[0][index] < bounds.min[0][index] )
+		{
+			continue;
+		}
+
+		float center[3];
+		float extents[3];
+		for( int a = 0; a < 3; a++ )
+		{
+			center[a] = ( bounds.min[a][index] + bounds.max[a][index] ) * 0.5f;
+			extents[a] = ( bounds.max[a][index] - bounds.min[a][index] ) * 0.5f;
+		}
+
+		bool culled = false;
+		for( int p = 0; p < 6; p++ )
+		{
+			const float d = center[0] * planes[p][0] + center[1] * planes[p][1] + center[2] * planes[p][2] + planes[p][3] +
+							extents[0] * idMath::Fabs( planes[p][0] ) + extents[1] * idMath::Fabs( planes[p][1] ) + extents[2] * idMath::Fabs( planes[p][2] );
+			if( d <= 0.0f )
+			{
+				culled = true;
+				break;
+			}
+		}
+
+		if( !culled )
+		{
+			outIndices[numVisible++] = index;
+		}
+	}
+
+	return numVisible;
+}
+
 /*
 ========================
 idRenderMatrix::ProjectedBounds
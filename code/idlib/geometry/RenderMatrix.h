@@ -45,6 +45,13 @@ enum frustumCull_t
 	FRUSTUM_CULL_CROSS		= 3
 };
 
+// axis aligned bounds stored as structure of arrays for batched culling
+struct boundsSoA_t
+{
+	const float* 	min[3];
+	const float* 	max[3];
+};
+
 /*
 ================================================================================================
 
@@ -147,6 +154,9 @@ public:
 	static bool				CullBoundsToMVPbits( const idRenderMatrix& mvp, const idBounds& bounds, byte* outBits, bool zeroToOne = false );
 	static bool				CullExtrudedBoundsToMVP( const idRenderMatrix& mvp, const idBounds& bounds, const idVec3& extrudeDirection, const idPlane& clipPlane, bool zeroToOne = false );
 	static bool				CullExtrudedBoundsToMVPbits( const idRenderMatrix& mvp, const idBounds& bounds, const idVec3& extrudeDirection, const idPlane& clipPlane, byte* outBits, bool zeroToOne = false );
+	// culls the bounds with the given indices, or the first numIndices bounds if indices is NULL, and
+	// writes the indices of the bounds that are not culled to outIndices, returns the number written
+	static int				CullBoundsSoAToMVP( const idRenderMatrix& mvp, const boundsSoA_t& bounds, const int* indices, int numIndices, int* outIndices, bool zeroToOne = false );
 
 	// Calculate the projected bounds.
 	static void				ProjectedBounds( idBounds& projected, const idRenderMatrix& mvp, const idBounds& bounds, bool windowSpace = true );
@@ -29,6 +29,11 @@ If you have questions concerning this license or the applicable additional terms
 #include "precompiled.h"
 #pragma hdrstop
 
+#include "rapidjson/document.h"
+#include "rapidjson/writer.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/error/en.h"
+
 /// <TODO>
 ///	Clean up registerd gltfItem_Extra's
 /// Clean up loaded gltfData;
@@ -39,6 +44,7 @@ static const unsigned int gltfChunk_Type_BIN =  0x004E4942; //5130562
 
 idCVar gltf_parseVerbose( "gltf_parseVerbose", "0", CVAR_RENDERER | CVAR_ARCHIVE | CVAR_BOOL | CVAR_NEW, "print gltf json data while parsing" );
 idCVar gltfParser_PrefixNodeWithID( "gltfParser_PrefixNodeWithID", "0", CVAR_SYSTEM | CVAR_BOOL, "The node's id is prefixed to the node's name during load" );
+idCVar gltf_parseInsitu( "gltf_parseInsitu", "1", CVAR_SYSTEM | CVAR_BOOL, "parse gltf json in-situ with rapidjson instead of the idLexer based parser" );
 //
 //gltf_sampler_wrap_type_map s_samplerWrapTypeMap[] = {
 //	//33071 CLAMP_TO_EDGE
@@ -386,22 +392,43 @@ int gltfItemArray::Parse( idLexer* lexer, bool forwardLexer/* = false*/ )
 }
 
 byte* gltfData::AddData( int size, int* bufferID/*=nullptr*/ )
+{
+	int id = totalChunks;
+	byte* chunk = AddChunk( ( byte* ) Mem_ClearedAlloc( size, TAG_IDLIB_GLTF ), size, bufferID );
+
+	if( id == -1 )
+	{
+		ownsJson = true;
+	}
+	else
+	{
+		ownedChunks |= BIT( id );
+	}
+
+	return chunk;
+}
+
+byte* gltfData::AddChunk( byte* chunk, int size, int* bufferID/*=nullptr*/ )
 {
 	if( totalChunks == -1 )
 	{
-		json  = ( byte* ) Mem_ClearedAlloc( size, TAG_IDLIB_GLTF );
+		json = chunk;
 		totalChunks++;
 		jsonDataLength = size;
 		return json;
 	}
 
 	int id = totalChunks;
+	if( id >= GLTF_MAX_CHUNKS )
+	{
+		common->FatalError( "%s uses more than %i buffers", fileName.c_str(), GLTF_MAX_CHUNKS );
+	}
 
 	if( data == nullptr )
 	{
 		data = ( byte** ) Mem_ClearedAlloc( GLTF_MAX_CHUNKS * sizeof( byte* ), TAG_IDLIB_GLTF );
 	}
-	data[totalChunks++] = ( byte* ) Mem_ClearedAlloc( size, TAG_IDLIB_GLTF );
+	data[totalChunks++] = chunk;
 
 	if( bufferID )
 	{
@@ -1928,68 +1955,69 @@ gltfProperty GLTF_Parser::ResolveProp( idToken& token )
 
 bool GLTF_Parser::loadGLB( idStr filename )
 {
-	if( fileSystem->GetFileLength( filename ) <= 0 )
+	// the whole file is read with a single allocation, the binary chunks are
+	// referenced in place instead of being copied into their own buffers.
+	byte* fileData = nullptr;
+	int fileLength = fileSystem->ReadFile( filename, ( void** )&fileData );
+	if( fileLength <= 0 || fileData == nullptr )
 	{
 		common->Warning( " %s does not exist!", filename.c_str() );
 		return false;
 	}
 
-	idFile* file = fileSystem->OpenFileRead( filename );
-
-	if( file->Length() < 20 )
+	if( fileLength < 20 )
 	{
+		fileSystem->FreeFile( fileData );
 		common->FatalError( "Too short data size for glTF Binary." );
 		return false;
 	}
-	idStr gltfMagic( "glTF" );
-	unsigned char fileMagic[5];
 
-	file->Read( ( void* )&fileMagic, 4 );
-	fileMagic[4] = 0;
-	if( gltfMagic.Icmp( ( const char* )&fileMagic ) == 0 )
+	if( idStr::Icmpn( ( const char* )fileData, "glTF", 4 ) == 0 )
 	{
 		common->Printf( "reading %s...\n", filename.c_str() );
 	}
 	else
 	{
+		fileSystem->FreeFile( fileData );
 		common->Error( "invalid magic" );
 		return false;
 	}
 
-	unsigned int version = 0;	// 4 bytes
-	unsigned int length = 0;	// 4 bytes
+	unsigned int version = LittleLong( *( unsigned int* )( fileData + 4 ) );
+	unsigned int length = LittleLong( *( unsigned int* )( fileData + 8 ) );
+	if( length > ( unsigned int )fileLength )
+	{
+		common->Warning( "%s: header length %u exceeds file size %i", filename.c_str(), length, fileLength );
+		length = fileLength;
+	}
 
-	//HVG_TODO
-	//handle 0 bin chunk -> size is chunk[0].size  + 20;
-	file->ReadUnsignedInt( version );
-	file->ReadUnsignedInt( length );
-	length -= 12; // header size
-
-	unsigned int chunk_type = 0;	// 4 bytes
-	unsigned int chunk_length = 0;	// 4 bytes
-	byte* data = nullptr;
 	gltfData* dataCache = gltfData::Data( filename, true );
+	dataCache->SetFileData( fileData );
 	currentAsset = dataCache;
+	currentFile = filename;
 
+	char* json = nullptr;
+	int jsonLength = 0;
 	int chunkCount = 0;
-	while( length )
+	unsigned int offset = 12; // header size
+	while( offset + 8 <= length )
 	{
-		unsigned int prev_length = chunk_length;
-		length -= file->ReadUnsignedInt( chunk_length );
-		length -= file->ReadUnsignedInt( chunk_type );
+		unsigned int chunk_length = LittleLong( *( unsigned int* )( fileData + offset ) );
+		unsigned int chunk_type = LittleLong( *( unsigned int* )( fileData + offset + 4 ) );
+		offset += 8;
 
-		data = dataCache->AddData( chunk_length );
-
-		int read = file->Read( ( void* )data, chunk_length );
-		if( read != chunk_length )
+		if( chunk_length > length - offset )
 		{
 			common->FatalError( "Could not read full chunk (%i bytes) in file %s", chunk_length, filename.c_str() );
 		}
-		length -= read;
+
+		byte* data = dataCache->AddChunk( fileData + offset, chunk_length );
+		offset += chunk_length;
+
 		if( chunk_type == gltfChunk_Type_JSON )
 		{
-			currentFile = filename ;
-			parser.LoadMemory( ( const char* )data, chunk_length, "gltfJson", 0 );
+			json = ( char* )data;
+			jsonLength = chunk_length;
 		}
 		else if( !chunkCount )
 		{
@@ -1999,15 +2027,19 @@ bool GLTF_Parser::loadGLB( idStr filename )
 		{
 			common->Printf( "BINCHUNK %i %i bytes\n", chunkCount, chunk_length );
 		}
-		if( chunkCount++ && length )
+		if( chunkCount++ && offset < length )
 		{
 			common->FatalError( "corrupt glb file." );
 		}
 	}
 
-	Parse();
-	delete file;
-	return true;
+	if( json == nullptr )
+	{
+		common->Warning( "%s has no json chunk", filename.c_str() );
+		return false;
+	}
+
+	return ParseJson( json, jsonLength, gltf_parseInsitu.GetBool() );
 }
 
 bool GLTF_Parser::Parse()
@@ -2097,6 +2129,944 @@ bool GLTF_Parser::Parse()
 	return true;
 }
 
+#pragma region rapidjson in-situ parsing
+// The in-situ backend fills the same gltfData object model as the idLexer based one,
+// but walks a rapidjson DOM that was built directly on top of the json chunk,
+// without re-tokenizing every array entry through a new idLexer.
+
+// json target field, analogous to GLTFARRAYITEMREF
+#define GLTFJSONITEM(value,target,name) JsonRead( value, #name, target->name )
+
+static const rapidjson::Value* JsonMember( const rapidjson::Value& object, const char* name )
+{
+	rapidjson::Value::ConstMemberIterator it = object.FindMember( name );
+	if( it == object.MemberEnd() )
+	{
+		return nullptr;
+	}
+	return &it->value;
+}
+
+static const rapidjson::Value& JsonObject( const rapidjson::Value& value, const char* name )
+{
+	if( !value.IsObject() )
+	{
+		common->FatalError( "Malformed gltf object %s", name );
+	}
+	return value;
+}
+
+static const rapidjson::Value& JsonArray( const rapidjson::Value& value, const char* name )
+{
+	if( !value.IsArray() )
+	{
+		common->FatalError( "Malformed gltf array %s", name );
+	}
+	return value;
+}
+
+static int JsonInt( const rapidjson::Value& value )
+{
+	if( value.IsInt() )
+	{
+		return value.GetInt();
+	}
+	if( !value.IsNumber() )
+	{
+		common->FatalError( "parse error, expected an integer" );
+	}
+	return ( int )value.GetDouble();
+}
+
+static double JsonNumber( const rapidjson::Value& value )
+{
+	if( !value.IsNumber() )
+	{
+		common->FatalError( "parse error, expected a number" );
+	}
+	return value.GetDouble();
+}
+
+// strings are copied as is, everything else is written back as json text
+static void JsonToString( const rapidjson::Value& value, idStr& out )
+{
+	if( value.IsString() )
+	{
+		out = value.GetString();
+		return;
+	}
+
+	rapidjson::StringBuffer buffer;
+	rapidjson::Writer<rapidjson::StringBuffer> writer( buffer );
+	value.Accept( writer );
+	out = buffer.GetString();
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, int& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( value )
+	{
+		out = JsonInt( *value );
+	}
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, float& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( value )
+	{
+		out = JsonNumber( *value );
+	}
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, bool& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( value )
+	{
+		if( !value->IsBool() )
+		{
+			idLib::FatalError( "parse error" );
+		}
+		out = value->GetBool();
+	}
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, idStr& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( value )
+	{
+		JsonToString( *value, out );
+	}
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, idList<int>& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( value )
+	{
+		const rapidjson::Value& array = JsonArray( *value, name );
+		out.Resize( out.Num() + array.Size() );
+		for( rapidjson::Value::ConstValueIterator it = array.Begin(); it != array.End(); ++it )
+		{
+			out.Append( JsonInt( *it ) );
+		}
+	}
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, idList<double>& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( value )
+	{
+		const rapidjson::Value& array = JsonArray( *value, name );
+		out.Resize( out.Num() + array.Size() );
+		for( rapidjson::Value::ConstValueIterator it = array.Begin(); it != array.End(); ++it )
+		{
+			out.Append( JsonNumber( *it ) );
+		}
+	}
+}
+
+static bool JsonReadNumbers( const rapidjson::Value& object, const char* name, float* out, int count )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( !value )
+	{
+		return false;
+	}
+
+	const rapidjson::Value& array = JsonArray( *value, name );
+	if( array.Size() != ( rapidjson::SizeType )count )
+	{
+		common->FatalError( "%s : missing arguments, expected %i, got %i", name, count, array.Size() );
+	}
+
+	for( int i = 0; i < count; i++ )
+	{
+		out[i] = JsonNumber( array[i] );
+	}
+	return true;
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, idVec2& out )
+{
+	JsonReadNumbers( object, name, out.ToFloatPtr(), 2 );
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, idVec3& out )
+{
+	JsonReadNumbers( object, name, out.ToFloatPtr(), 3 );
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, idVec4& out )
+{
+	JsonReadNumbers( object, name, out.ToFloatPtr(), 4 );
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, idQuat& out )
+{
+	JsonReadNumbers( object, name, out.ToFloatPtr(), 4 );
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, idMat4& out )
+{
+	float m[16];
+	if( JsonReadNumbers( object, name, m, 16 ) )
+	{
+		out = idMat4(
+				  m[0], m[1], m[2], m[3],
+				  m[4], m[5], m[6], m[7],
+				  m[8], m[9], m[10], m[11],
+				  m[12], m[13], m[14], m[15]
+			  );
+	}
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, gltfExtra& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( !value )
+	{
+		return;
+	}
+
+	JsonToString( *value, out.json );
+	if( value->IsObject() )
+	{
+		for( rapidjson::Value::ConstMemberIterator it = value->MemberBegin(); it != value->MemberEnd(); ++it )
+		{
+			idStr pair;
+			JsonToString( it->value, pair );
+			out.strPairs.Set( it->name.GetString(), pair );
+		}
+	}
+
+	if( gltf_parseVerbose.GetBool() )
+	{
+		common->Printf( "%s", out.json.c_str() );
+	}
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, gltfTexture_Info_Extensions& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( !value )
+	{
+		return;
+	}
+
+	const rapidjson::Value* transform = JsonMember( JsonObject( *value, name ), "KHR_texture_transform" );
+	if( transform )
+	{
+		JsonObject( *transform, "KHR_texture_transform" );
+		out.KHR_texture_transform = new gltfExt_KHR_texture_transform();
+		GLTFJSONITEM( *transform, out.KHR_texture_transform, offset );
+		GLTFJSONITEM( *transform, out.KHR_texture_transform, rotation );
+		GLTFJSONITEM( *transform, out.KHR_texture_transform, scale );
+		GLTFJSONITEM( *transform, out.KHR_texture_transform, texCoord );
+	}
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, gltfTexture_Info& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( value )
+	{
+		const rapidjson::Value& info = JsonObject( *value, name );
+		GLTFJSONITEM( info, ( &out ), index );
+		GLTFJSONITEM( info, ( &out ), texCoord );
+		GLTFJSONITEM( info, ( &out ), extensions );
+		GLTFJSONITEM( info, ( &out ), extras );
+	}
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, gltfNormalTexture_Info& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( value )
+	{
+		const rapidjson::Value& info = JsonObject( *value, name );
+		GLTFJSONITEM( info, ( &out ), index );
+		GLTFJSONITEM( info, ( &out ), texCoord );
+		GLTFJSONITEM( info, ( &out ), scale );
+		GLTFJSONITEM( info, ( &out ), extensions );
+		GLTFJSONITEM( info, ( &out ), extras );
+	}
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, gltfOcclusionTexture_Info& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( value )
+	{
+		const rapidjson::Value& info = JsonObject( *value, name );
+		GLTFJSONITEM( info, ( &out ), index );
+		GLTFJSONITEM( info, ( &out ), texCoord );
+		GLTFJSONITEM( info, ( &out ), strength );
+		GLTFJSONITEM( info, ( &out ), extensions );
+		GLTFJSONITEM( info, ( &out ), extras );
+	}
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, gltfMaterial_pbrMetallicRoughness& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( value )
+	{
+		const rapidjson::Value& pbr = JsonObject( *value, name );
+		GLTFJSONITEM( pbr, ( &out ), baseColorFactor );
+		GLTFJSONITEM( pbr, ( &out ), baseColorTexture );
+		GLTFJSONITEM( pbr, ( &out ), metallicFactor );
+		GLTFJSONITEM( pbr, ( &out ), roughnessFactor );
+		GLTFJSONITEM( pbr, ( &out ), metallicRoughnessTexture );
+		GLTFJSONITEM( pbr, ( &out ), extensions );
+		GLTFJSONITEM( pbr, ( &out ), extras );
+	}
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, gltfMaterial_Extensions& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( !value )
+	{
+		return;
+	}
+
+	const rapidjson::Value* specGloss = JsonMember( JsonObject( *value, name ), "KHR_materials_pbrSpecularGlossiness" );
+	if( specGloss )
+	{
+		JsonObject( *specGloss, "KHR_materials_pbrSpecularGlossiness" );
+		gltfExt_KHR_materials_pbrSpecularGlossiness* ext = new gltfExt_KHR_materials_pbrSpecularGlossiness();
+		out.KHR_materials_pbrSpecularGlossiness = ext;
+		GLTFJSONITEM( *specGloss, ext, diffuseFactor );
+		GLTFJSONITEM( *specGloss, ext, diffuseTexture );
+		GLTFJSONITEM( *specGloss, ext, specularFactor );
+		GLTFJSONITEM( *specGloss, ext, glossinessFactor );
+		GLTFJSONITEM( *specGloss, ext, specularGlossinessTexture );
+		GLTFJSONITEM( *specGloss, ext, extensions );
+		GLTFJSONITEM( *specGloss, ext, extras );
+	}
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, gltfNode_Extensions& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( !value )
+	{
+		return;
+	}
+
+	const rapidjson::Value* light = JsonMember( JsonObject( *value, name ), "KHR_lights_punctual" );
+	if( light )
+	{
+		JsonObject( *light, "KHR_lights_punctual" );
+		out.KHR_lights_punctual = new gltfNode_KHR_lights_punctual();
+		GLTFJSONITEM( *light, out.KHR_lights_punctual, light );
+	}
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, gltfCamera_Perspective& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( value )
+	{
+		const rapidjson::Value& camera = JsonObject( *value, name );
+		GLTFJSONITEM( camera, ( &out ), aspectRatio );
+		GLTFJSONITEM( camera, ( &out ), yfov );
+		GLTFJSONITEM( camera, ( &out ), zfar );
+		GLTFJSONITEM( camera, ( &out ), znear );
+		GLTFJSONITEM( camera, ( &out ), extensions );
+		GLTFJSONITEM( camera, ( &out ), extras );
+	}
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, gltfCamera_Orthographic& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( value )
+	{
+		const rapidjson::Value& camera = JsonObject( *value, name );
+		GLTFJSONITEM( camera, ( &out ), xmag );
+		GLTFJSONITEM( camera, ( &out ), ymag );
+		GLTFJSONITEM( camera, ( &out ), zfar );
+		GLTFJSONITEM( camera, ( &out ), znear );
+		GLTFJSONITEM( camera, ( &out ), extensions );
+		GLTFJSONITEM( camera, ( &out ), extras );
+	}
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, gltfAccessor_Sparse& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( !value )
+	{
+		return;
+	}
+
+	const rapidjson::Value& sparse = JsonObject( *value, name );
+	GLTFJSONITEM( sparse, ( &out ), count );
+	GLTFJSONITEM( sparse, ( &out ), extensions );
+	GLTFJSONITEM( sparse, ( &out ), extras );
+
+	const rapidjson::Value* indices = JsonMember( sparse, "indices" );
+	if( indices )
+	{
+		JsonObject( *indices, "indices" );
+		GLTFJSONITEM( *indices, ( &out.indices ), bufferView );
+		GLTFJSONITEM( *indices, ( &out.indices ), byteOffset );
+		GLTFJSONITEM( *indices, ( &out.indices ), componentType );
+		GLTFJSONITEM( *indices, ( &out.indices ), extensions );
+		GLTFJSONITEM( *indices, ( &out.indices ), extras );
+	}
+
+	const rapidjson::Value* values = JsonMember( sparse, "values" );
+	if( values )
+	{
+		JsonObject( *values, "values" );
+		GLTFJSONITEM( *values, ( &out.values ), bufferView );
+		GLTFJSONITEM( *values, ( &out.values ), byteOffset );
+		GLTFJSONITEM( *values, ( &out.values ), extensions );
+		GLTFJSONITEM( *values, ( &out.values ), extras );
+	}
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, gltfAnimation_Channel_Target& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( value )
+	{
+		const rapidjson::Value& target = JsonObject( *value, name );
+		GLTFJSONITEM( target, ( &out ), node );
+		GLTFJSONITEM( target, ( &out ), path );
+		GLTFJSONITEM( target, ( &out ), extensions );
+		GLTFJSONITEM( target, ( &out ), extras );
+		out.TRS = gltfAnimation_Channel_Target::resolveType( out.path );
+	}
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, idList<gltfMesh_Primitive_Attribute*>& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( !value )
+	{
+		return;
+	}
+
+	const rapidjson::Value& attributes = JsonObject( *value, name );
+	for( rapidjson::Value::ConstMemberIterator it = attributes.MemberBegin(); it != attributes.MemberEnd(); ++it )
+	{
+		out.AssureSizeAlloc( out.Num() + 1, idListNewElement<gltfMesh_Primitive_Attribute> );
+		gltfMesh_Primitive_Attribute* attr = out[out.Num() - 1];
+		attr->attributeSemantic = it->name.GetString();
+		attr->type = GetAttributeEnum( attr->attributeSemantic.c_str(), &attr->elementSize );
+		attr->accessorIndex = JsonInt( it->value );
+	}
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, idList<gltfMesh_Primitive*>& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( !value )
+	{
+		return;
+	}
+
+	const rapidjson::Value& array = JsonArray( *value, name );
+	for( rapidjson::Value::ConstValueIterator it = array.Begin(); it != array.End(); ++it )
+	{
+		const rapidjson::Value& prim = JsonObject( *it, name );
+		out.AssureSizeAlloc( out.Num() + 1, idListNewElement<gltfMesh_Primitive> );
+		gltfMesh_Primitive* gltfMeshPrim = out[out.Num() - 1];
+
+		GLTFJSONITEM( prim, gltfMeshPrim, attributes );
+		GLTFJSONITEM( prim, gltfMeshPrim, indices );
+		GLTFJSONITEM( prim, gltfMeshPrim, material );
+		GLTFJSONITEM( prim, gltfMeshPrim, mode );
+		GLTFJSONITEM( prim, gltfMeshPrim, target );
+		GLTFJSONITEM( prim, gltfMeshPrim, extensions );
+		GLTFJSONITEM( prim, gltfMeshPrim, extras );
+	}
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, idList<gltfAnimation_Channel*>& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( !value )
+	{
+		return;
+	}
+
+	const rapidjson::Value& array = JsonArray( *value, name );
+	for( rapidjson::Value::ConstValueIterator it = array.Begin(); it != array.End(); ++it )
+	{
+		const rapidjson::Value& channel = JsonObject( *it, name );
+		out.AssureSizeAlloc( out.Num() + 1, idListNewElement<gltfAnimation_Channel> );
+		gltfAnimation_Channel* gltfAnimationChannel = out[out.Num() - 1];
+
+		GLTFJSONITEM( channel, gltfAnimationChannel, sampler );
+		GLTFJSONITEM( channel, gltfAnimationChannel, target );
+		GLTFJSONITEM( channel, gltfAnimationChannel, extensions );
+		GLTFJSONITEM( channel, gltfAnimationChannel, extras );
+	}
+}
+
+static void JsonRead( const rapidjson::Value& object, const char* name, idList<gltfAnimation_Sampler*>& out )
+{
+	const rapidjson::Value* value = JsonMember( object, name );
+	if( !value )
+	{
+		return;
+	}
+
+	const rapidjson::Value& array = JsonArray( *value, name );
+	for( rapidjson::Value::ConstValueIterator it = array.Begin(); it != array.End(); ++it )
+	{
+		const rapidjson::Value& sampler = JsonObject( *it, name );
+		out.AssureSizeAlloc( out.Num() + 1, idListNewElement<gltfAnimation_Sampler> );
+		gltfAnimation_Sampler* gltfAnimSampler = out[out.Num() - 1];
+
+		GLTFJSONITEM( sampler, gltfAnimSampler, input );
+		GLTFJSONITEM( sampler, gltfAnimSampler, interpolation );
+		GLTFJSONITEM( sampler, gltfAnimSampler, output );
+		GLTFJSONITEM( sampler, gltfAnimSampler, extensions );
+		GLTFJSONITEM( sampler, gltfAnimSampler, extras );
+
+		gltfAnimSampler->intType = gltfAnimation_Sampler::resolveType( gltfAnimSampler->interpolation );
+	}
+}
+
+static void JsonParse_SCENES( gltfData* asset, const rapidjson::Value& array )
+{
+	for( rapidjson::Value::ConstValueIterator it = array.Begin(); it != array.End(); ++it )
+	{
+		const rapidjson::Value& scene = JsonObject( *it, "scenes" );
+		gltfScene* gltfscene = asset->Scene();
+		GLTFJSONITEM( scene, gltfscene, nodes );
+		GLTFJSONITEM( scene, gltfscene, name );
+		GLTFJSONITEM( scene, gltfscene, extensions );
+		GLTFJSONITEM( scene, gltfscene, extras );
+	}
+}
+
+static void JsonParse_CAMERAS( gltfData* asset, const rapidjson::Value& array )
+{
+	for( rapidjson::Value::ConstValueIterator it = array.Begin(); it != array.End(); ++it )
+	{
+		const rapidjson::Value& camera = JsonObject( *it, "cameras" );
+		gltfCamera* item = asset->Camera();
+		GLTFJSONITEM( camera, item, orthographic );
+		GLTFJSONITEM( camera, item, perspective );
+		GLTFJSONITEM( camera, item, type );
+		GLTFJSONITEM( camera, item, name );
+		GLTFJSONITEM( camera, item, extensions );
+		GLTFJSONITEM( camera, item, extras );
+	}
+}
+
+static void JsonParse_NODES( gltfData* asset, const rapidjson::Value& array )
+{
+	for( rapidjson::Value::ConstValueIterator it = array.Begin(); it != array.End(); ++it )
+	{
+		const rapidjson::Value& node = JsonObject( *it, "nodes" );
+		gltfNode* gltfnode = asset->Node();
+		GLTFJSONITEM( node, gltfnode, camera );
+		GLTFJSONITEM( node, gltfnode, children );
+		GLTFJSONITEM( node, gltfnode, skin );
+		GLTFJSONITEM( node, gltfnode, matrix );
+		GLTFJSONITEM( node, gltfnode, mesh );
+		GLTFJSONITEM( node, gltfnode, rotation );
+		GLTFJSONITEM( node, gltfnode, scale );
+		GLTFJSONITEM( node, gltfnode, translation );
+		GLTFJSONITEM( node, gltfnode, weights );
+		GLTFJSONITEM( node, gltfnode, name );
+		GLTFJSONITEM( node, gltfnode, extensions );
+		GLTFJSONITEM( node, gltfnode, extras );
+	}
+}
+
+static void JsonParse_MATERIALS( gltfData* asset, const rapidjson::Value& array )
+{
+	for( rapidjson::Value::ConstValueIterator it = array.Begin(); it != array.End(); ++it )
+	{
+		const rapidjson::Value& material = JsonObject( *it, "materials" );
+		gltfMaterial* gltfmaterial = asset->Material();
+		GLTFJSONITEM( material, gltfmaterial, pbrMetallicRoughness );
+		GLTFJSONITEM( material, gltfmaterial, normalTexture );
+		GLTFJSONITEM( material, gltfmaterial, occlusionTexture );
+		GLTFJSONITEM( material, gltfmaterial, emissiveTexture );
+		GLTFJSONITEM( material, gltfmaterial, emissiveFactor );
+		GLTFJSONITEM( material, gltfmaterial, alphaMode );
+		GLTFJSONITEM( material, gltfmaterial, alphaCutoff );
+		GLTFJSONITEM( material, gltfmaterial, doubleSided );
+		GLTFJSONITEM( material, gltfmaterial, name );
+		GLTFJSONITEM( material, gltfmaterial, extensions );
+		GLTFJSONITEM( material, gltfmaterial, extras );
+
+		gltfmaterial->intType = gltfMaterial::resolveAlphaMode( gltfmaterial->alphaMode );
+	}
+}
+
+static void JsonParse_MESHES( gltfData* asset, const rapidjson::Value& array )
+{
+	for( rapidjson::Value::ConstValueIterator it = array.Begin(); it != array.End(); ++it )
+	{
+		const rapidjson::Value& mesh = JsonObject( *it, "meshes" );
+		gltfMesh* gltfmesh = asset->Mesh();
+		GLTFJSONITEM( mesh, gltfmesh, primitives );
+		GLTFJSONITEM( mesh, gltfmesh, weights );
+		GLTFJSONITEM( mesh, gltfmesh, name );
+		GLTFJSONITEM( mesh, gltfmesh, extensions );
+		GLTFJSONITEM( mesh, gltfmesh, extras );
+	}
+}
+
+static void JsonParse_TEXTURES( gltfData* asset, const rapidjson::Value& array )
+{
+	for( rapidjson::Value::ConstValueIterator it = array.Begin(); it != array.End(); ++it )
+	{
+		const rapidjson::Value& texture = JsonObject( *it, "textures" );
+		gltfTexture* gltftexture = asset->Texture();
+		GLTFJSONITEM( texture, gltftexture, sampler );
+		GLTFJSONITEM( texture, gltftexture, source );
+		GLTFJSONITEM( texture, gltftexture, name );
+		GLTFJSONITEM( texture, gltftexture, extensions );
+		GLTFJSONITEM( texture, gltftexture, extras );
+	}
+}
+
+static void JsonParse_IMAGES( gltfData* asset, const rapidjson::Value& array )
+{
+	for( rapidjson::Value::ConstValueIterator it = array.Begin(); it != array.End(); ++it )
+	{
+		const rapidjson::Value& image = JsonObject( *it, "images" );
+		gltfImage* gltfimage = asset->Image();
+		GLTFJSONITEM( image, gltfimage, mimeType );
+		GLTFJSONITEM( image, gltfimage, bufferView );
+		GLTFJSONITEM( image, gltfimage, name );
+		GLTFJSONITEM( image, gltfimage, extensions );
+		GLTFJSONITEM( image, gltfimage, extras );
+
+		if( JsonMember( image, "uri" ) )
+		{
+			// creates the buffer and bufferview for the image
+			gltfItem_uri uri( "uri" );
+			uri.Set( &gltfimage->uri, &gltfimage->bufferView, asset );
+			GLTFJSONITEM( image, gltfimage, uri );
+			uri.Convert();
+		}
+	}
+}
+
+static void JsonParse_ACCESSORS( gltfData* asset, const rapidjson::Value& array )
+{
+	for( rapidjson::Value::ConstValueIterator it = array.Begin(); it != array.End(); ++it )
+	{
+		const rapidjson::Value& accessor = JsonObject( *it, "accessors" );
+		gltfAccessor* item = asset->Accessor();
+		GLTFJSONITEM( accessor, item, bufferView );
+		GLTFJSONITEM( accessor, item, byteOffset );
+		GLTFJSONITEM( accessor, item, componentType );
+		GLTFJSONITEM( accessor, item, normalized );
+		GLTFJSONITEM( accessor, item, count );
+		GLTFJSONITEM( accessor, item, type );
+		GLTFJSONITEM( accessor, item, max );
+		GLTFJSONITEM( accessor, item, min );
+		GLTFJSONITEM( accessor, item, sparse );
+		GLTFJSONITEM( accessor, item, name );
+		GLTFJSONITEM( accessor, item, extensions );
+		GLTFJSONITEM( accessor, item, extras );
+
+		GetComponentTypeEnum( item->componentType, &item->typeSize );
+	}
+}
+
+static void JsonParse_BUFFERVIEWS( gltfData* asset, const rapidjson::Value& array )
+{
+	for( rapidjson::Value::ConstValueIterator it = array.Begin(); it != array.End(); ++it )
+	{
+		const rapidjson::Value& bufferView = JsonObject( *it, "bufferViews" );
+		gltfBufferView* gltfBV = asset->BufferView();
+		GLTFJSONITEM( bufferView, gltfBV, buffer );
+		GLTFJSONITEM( bufferView, gltfBV, byteLength );
+		GLTFJSONITEM( bufferView, gltfBV, byteStride );
+		GLTFJSONITEM( bufferView, gltfBV, byteOffset );
+		GLTFJSONITEM( bufferView, gltfBV, target );
+		GLTFJSONITEM( bufferView, gltfBV, name );
+		GLTFJSONITEM( bufferView, gltfBV, extensions );
+		GLTFJSONITEM( bufferView, gltfBV, extras );
+		gltfBV->parent = asset;
+	}
+}
+
+static void JsonParse_SAMPLERS( gltfData* asset, const rapidjson::Value& array )
+{
+	for( rapidjson::Value::ConstValueIterator it = array.Begin(); it != array.End(); ++it )
+	{
+		const rapidjson::Value& sampler = JsonObject( *it, "samplers" );
+		gltfSampler* gltfSampl = asset->Sampler();
+		GLTFJSONITEM( sampler, gltfSampl, magFilter );
+		GLTFJSONITEM( sampler, gltfSampl, minFilter );
+		GLTFJSONITEM( sampler, gltfSampl, wrapS );
+		GLTFJSONITEM( sampler, gltfSampl, wrapT );
+		GLTFJSONITEM( sampler, gltfSampl, name );
+		GLTFJSONITEM( sampler, gltfSampl, extensions );
+		GLTFJSONITEM( sampler, gltfSampl, extras );
+	}
+}
+
+static void JsonParse_BUFFERS( gltfData* asset, const rapidjson::Value& array )
+{
+	for( rapidjson::Value::ConstValueIterator it = array.Begin(); it != array.End(); ++it )
+	{
+		const rapidjson::Value& buffer = JsonObject( *it, "buffers" );
+		gltfBuffer* gltfBuf = asset->Buffer();
+		gltfBuf->parent = asset;
+		GLTFJSONITEM( buffer, gltfBuf, byteLength );
+		GLTFJSONITEM( buffer, gltfBuf, name );
+		GLTFJSONITEM( buffer, gltfBuf, extensions );
+		GLTFJSONITEM( buffer, gltfBuf, extras );
+
+		if( JsonMember( buffer, "uri" ) )
+		{
+			gltfItem_uri uri( "uri" );
+			uri.Set( &gltfBuf->uri, nullptr, asset );
+			GLTFJSONITEM( buffer, gltfBuf, uri );
+			uri.Convert();
+		}
+	}
+}
+
+static void JsonParse_ANIMATIONS( gltfData* asset, const rapidjson::Value& array )
+{
+	for( rapidjson::Value::ConstValueIterator it = array.Begin(); it != array.End(); ++it )
+	{
+		const rapidjson::Value& anim = JsonObject( *it, "animations" );
+		gltfAnimation* gltfanim = asset->Animation();
+		GLTFJSONITEM( anim, gltfanim, channels );
+		GLTFJSONITEM( anim, gltfanim, samplers );
+		GLTFJSONITEM( anim, gltfanim, name );
+		GLTFJSONITEM( anim, gltfanim, extensions );
+		GLTFJSONITEM( anim, gltfanim, extras );
+	}
+}
+
+static void JsonParse_SKINS( gltfData* asset, const rapidjson::Value& array )
+{
+	for( rapidjson::Value::ConstValueIterator it = array.Begin(); it != array.End(); ++it )
+	{
+		const rapidjson::Value& skin = JsonObject( *it, "skins" );
+		gltfSkin* gltfSkin = asset->Skin();
+		GLTFJSONITEM( skin, gltfSkin, inverseBindMatrices );
+		GLTFJSONITEM( skin, gltfSkin, skeleton );
+		GLTFJSONITEM( skin, gltfSkin, joints );
+		GLTFJSONITEM( skin, gltfSkin, name );
+		GLTFJSONITEM( skin, gltfSkin, extensions );
+		GLTFJSONITEM( skin, gltfSkin, extras );
+	}
+}
+
+static void JsonParse_EXTENSIONS( gltfData* asset, const rapidjson::Value& extensions )
+{
+	gltfExtensions* gltfextension = asset->Extensions();
+
+	const rapidjson::Value* lightsPunctual = JsonMember( extensions, "KHR_lights_punctual" );
+	if( !lightsPunctual )
+	{
+		return;
+	}
+
+	const rapidjson::Value* lights = JsonMember( JsonObject( *lightsPunctual, "KHR_lights_punctual" ), "lights" );
+	if( !lights )
+	{
+		return;
+	}
+
+	const rapidjson::Value& array = JsonArray( *lights, "lights" );
+	for( rapidjson::Value::ConstValueIterator it = array.Begin(); it != array.End(); ++it )
+	{
+		const rapidjson::Value& light = JsonObject( *it, "lights" );
+
+		gltfextension->KHR_lights_punctual.AssureSizeAlloc(
+			gltfextension->KHR_lights_punctual.Num() + 1,
+			idListNewElement<gltfExt_KHR_lights_punctual> );
+
+		gltfExt_KHR_lights_punctual* gltfLight =
+			gltfextension->KHR_lights_punctual[gltfextension->KHR_lights_punctual.Num() - 1];
+
+		GLTFJSONITEM( light, gltfLight, color );
+		GLTFJSONITEM( light, gltfLight, intensity );
+		GLTFJSONITEM( light, gltfLight, type );
+		GLTFJSONITEM( light, gltfLight, range );
+		GLTFJSONITEM( light, gltfLight, name );
+		GLTFJSONITEM( light, gltfLight, extensions );
+		GLTFJSONITEM( light, gltfLight, extras );
+
+		const rapidjson::Value* spot = JsonMember( light, "spot" );
+		if( spot )
+		{
+			JsonObject( *spot, "spot" );
+			GLTFJSONITEM( *spot, ( &gltfLight->spot ), innerConeAngle );
+			GLTFJSONITEM( *spot, ( &gltfLight->spot ), outerConeAngle );
+		}
+
+		gltfLight->intType = gltfExt_KHR_lights_punctual::resolveType( gltfLight->type );
+	}
+}
+
+bool GLTF_Parser::ParseJson( char* json, int length, bool insitu )
+{
+	if( !insitu )
+	{
+		if( !parser.LoadMemory( json, length, "gltfJson", 0 ) )
+		{
+			return false;
+		}
+
+		bool result = Parse();
+		parser.FreeSource();
+		return result;
+	}
+
+	// the json is decoded in place, strings end up pointing into the chunk itself.
+	// parsing stops after the root object, so GLB padding and chunks behind it are never touched.
+	rapidjson::Document doc;
+	doc.ParseInsitu<rapidjson::kParseStopWhenDoneFlag>( json );
+	if( doc.HasParseError() )
+	{
+		common->Warning( "%s: json parse error at offset %i: %s", currentFile.c_str(), ( int )doc.GetErrorOffset(), rapidjson::GetParseError_En( doc.GetParseError() ) );
+		return false;
+	}
+
+	if( !doc.IsObject() )
+	{
+		common->Warning( "%s: json root is not an object", currentFile.c_str() );
+		return false;
+	}
+
+	// buffers and bufferviews are resolved first, images and buffer uris append to them
+	const rapidjson::Value* buffers = JsonMember( doc, "buffers" );
+	if( buffers )
+	{
+		JsonParse_BUFFERS( currentAsset, JsonArray( *buffers, "buffers" ) );
+	}
+	else
+	{
+		common->Printf( "no %s found", "buffers" );
+	}
+
+	const rapidjson::Value* bufferViews = JsonMember( doc, "bufferViews" );
+	if( bufferViews )
+	{
+		JsonParse_BUFFERVIEWS( currentAsset, JsonArray( *bufferViews, "bufferViews" ) );
+	}
+	else
+	{
+		common->Printf( "no %s found", "bufferviews" );
+	}
+
+	for( rapidjson::Value::ConstMemberIterator it = doc.MemberBegin(); it != doc.MemberEnd(); ++it )
+	{
+		token = it->name.GetString();
+		const rapidjson::Value& value = it->value;
+
+		if( gltf_parseVerbose.GetBool() )
+		{
+			common->Printf( "%s\n", token.c_str() );
+		}
+
+		switch( ResolveProp( token ) )
+		{
+			case ASSET:
+			{
+				idStr section;
+				JsonToString( value, section );
+				common->Printf( "%s\n", section.c_str() );
+				break;
+			}
+			case CAMERAS:
+				JsonParse_CAMERAS( currentAsset, JsonArray( value, "cameras" ) );
+				break;
+			case SCENE:
+				currentAsset->DefaultScene() = JsonInt( value );
+				break;
+			case SCENES:
+				JsonParse_SCENES( currentAsset, JsonArray( value, "scenes" ) );
+				break;
+			case NODES:
+				JsonParse_NODES( currentAsset, JsonArray( value, "nodes" ) );
+				break;
+			case MATERIALS:
+				JsonParse_MATERIALS( currentAsset, JsonArray( value, "materials" ) );
+				break;
+			case MESHES:
+				JsonParse_MESHES( currentAsset, JsonArray( value, "meshes" ) );
+				break;
+			case TEXTURES:
+				JsonParse_TEXTURES( currentAsset, JsonArray( value, "textures" ) );
+				break;
+			case IMAGES:
+				JsonParse_IMAGES( currentAsset, JsonArray( value, "images" ) );
+				break;
+			case ACCESSORS:
+				JsonParse_ACCESSORS( currentAsset, JsonArray( value, "accessors" ) );
+				break;
+			case SAMPLERS:
+				JsonParse_SAMPLERS( currentAsset, JsonArray( value, "samplers" ) );
+				break;
+			case ANIMATIONS:
+				JsonParse_ANIMATIONS( currentAsset, JsonArray( value, "animations" ) );
+				break;
+			case SKINS:
+				JsonParse_SKINS( currentAsset, JsonArray( value, "skins" ) );
+				break;
+			case EXTENSIONS:
+				JsonParse_EXTENSIONS( currentAsset, JsonObject( value, "extensions" ) );
+				break;
+			case EXTENSIONS_USED:
+			{
+				const rapidjson::Value& array = JsonArray( value, "extensionsUsed" );
+				for( rapidjson::Value::ConstValueIterator ext = array.Begin(); ext != array.End(); ++ext )
+				{
+					JsonToString( *ext, currentAsset->ExtensionsUsed()->extension );
+				}
+				break;
+			}
+			case EXTENSIONS_REQUIRED:
+			{
+				const rapidjson::Value& array = JsonArray( value, "extensionsRequired" );
+				for( rapidjson::Value::ConstValueIterator ext = array.Begin(); ext != array.End(); ++ext )
+				{
+					if( !ext->IsString() )
+					{
+						common->FatalError( "malformed extensions_used array" );
+					}
+					common->Printf( "%s", ext->GetString() );
+				}
+				break;
+			}
+			case BUFFERS:
+			case BUFFERVIEWS:
+				// already done
+				break;
+			default:
+				if( gltf_parseVerbose.GetBool() )
+				{
+					common->DPrintf( "Skipping unknown gltf property %s.", token.c_str() );
+				}
+				break;
+		}
+	}
+
+	common->Printf( "%s ^2loaded\n", currentFile.c_str() );
+	return true;
+}
+
+#undef GLTFJSONITEM
+#pragma endregion
+
 bool GLTF_Parser::Load( idStr filename )
 {
 
@@ -2120,39 +3090,29 @@ bool GLTF_Parser::Load( idStr filename )
 	}
 	else if( filename.CheckExtension( ".gltf" ) )
 	{
-		int length = fileSystem->ReadFile( filename, NULL );
-		if( !length )
+		byte* fileData = nullptr;
+		int length = fileSystem->ReadFile( filename, ( void** )&fileData );
+		if( length <= 0 || fileData == nullptr )
 		{
 			common->FatalError( "Failed to read file" );
 		}
 
+		// the file block becomes the json chunk, ReadFile already zero terminated it
 		data = gltfData::Data( filename , true );
-		byte* dataBuff = data->AddData( length );
+		data->SetFileData( fileData );
+		byte* dataBuff = data->AddChunk( fileData, length );
 		currentAsset = data;
 
-		idFile* file = fileSystem->OpenFileRead( filename );
-		if( file->Read( dataBuff, length ) != length )
-		{
-			common->FatalError( "Cannot read file, %s", filename.c_str() );
-		}
-
-		fileSystem->CloseFile( file );
-
-		if( !parser.LoadMemory( ( const char* )dataBuff, length, "GLTF_ASCII_JSON", 0 ) )
+		if( !ParseJson( ( char* )dataBuff, length, gltf_parseInsitu.GetBool() ) )
 		{
 			return false;
 		}
-
-		Parse();
-
 	}
 	else
 	{
 		return false;
 	}
 
-	parser.Reset();
-	parser.FreeSource();
 	common->SetRefreshOnPrint( false );
 
 	//fix up node hierarchy
@@ -2322,20 +3282,28 @@ gltfData::~gltfData()
 
 	if( data )
 	{
-		while( totalChunks )
+		while( totalChunks > 0 )
 		{
-			Mem_Free( data[--totalChunks] );
+			totalChunks--;
+			if( ownedChunks & BIT( totalChunks ) )
+			{
+				Mem_Free( data[totalChunks] );
+			}
 		}
 		Mem_Free( data );
 	}
 
-	if( json )
+	if( json && ownsJson )
 	{
 		Mem_Free( json );
 	}
 
+	// chunks that were not copied point into this block
+	Mem_Free( fileData );
+
 	data = nullptr;
 	json = nullptr;
+	fileData = nullptr;
 	ClearData( fileName );
 
 }
@@ -2372,6 +3340,76 @@ CONSOLE_COMMAND( LoadGLTF, "Loads an .gltf or .glb file", idCmdSystem::ArgComple
 	}
 
 }
+
+CONSOLE_COMMAND( benchGLTF, "Times parsing the json of a .gltf or .glb file with both parser backends", idCmdSystem::ArgCompletion_MapName )
+{
+	if( args.Argc() < 2 )
+	{
+		common->Printf( "usage: benchGLTF <file.gltf|file.glb> [iterations]\n" );
+		return;
+	}
+
+	idStr filename = args.Argv( 1 );
+	int iterations = args.Argc() > 2 ? Max( 1, atoi( args.Argv( 2 ) ) ) : 10;
+
+	byte* fileData = nullptr;
+	int fileLength = fileSystem->ReadFile( filename, ( void** )&fileData );
+	if( fileLength <= 0 || fileData == nullptr )
+	{
+		common->Printf( "couldn't load %s\n", filename.c_str() );
+		return;
+	}
+
+	const char* json = ( const char* )fileData;
+	int jsonLength = fileLength;
+	if( filename.CheckExtension( ".glb" ) )
+	{
+		unsigned int chunkLength = fileLength >= 20 ? LittleLong( *( unsigned int* )( fileData + 12 ) ) : 0;
+		unsigned int chunkType = fileLength >= 20 ? LittleLong( *( unsigned int* )( fileData + 16 ) ) : 0;
+		if( chunkType != gltfChunk_Type_JSON || chunkLength > ( unsigned int )( fileLength - 20 ) )
+		{
+			common->Printf( "%s has no json chunk\n", filename.c_str() );
+			fileSystem->FreeFile( fileData );
+			return;
+		}
+		json = ( const char* )( fileData + 20 );
+		jsonLength = chunkLength;
+	}
+
+	// the in-situ backend destroys its input, so both backends get a fresh copy every run
+	char* scratch = ( char* )Mem_Alloc( jsonLength + 1, TAG_IDLIB_GLTF );
+	idStr benchName = "_benchGLTF";
+	const char* backendNames[2] = { "idLexer", "rapidjson in-situ" };
+	uint64 backendTime[2] = { 0, 0 };
+
+	for( int backend = 0; backend < 2; backend++ )
+	{
+		for( int i = 0; i < iterations; i++ )
+		{
+			memcpy( scratch, json, jsonLength );
+			scratch[jsonLength] = 0;
+
+			GLTF_Parser gltf;
+			gltf.currentAsset = gltfData::Data( benchName, true );
+			gltf.currentFile = filename;
+
+			uint64 start = Sys_Microseconds();
+			gltf.ParseJson( scratch, jsonLength, backend == 1 );
+			backendTime[backend] += Sys_Microseconds() - start;
+		}
+	}
+
+	common->Printf( "%s: %i kB json, %i iterations\n", filename.c_str(), jsonLength >> 10, iterations );
+	for( int backend = 0; backend < 2; backend++ )
+	{
+		float msec = backendTime[backend] / ( 1000.0f * iterations );
+		common->Printf( "%20s : %8.2f msec %8.1f MB/s\n", backendNames[backend], msec, msec > 0.0f ? ( jsonLength / ( 1024.0f * 1024.0f ) ) / ( msec / 1000.0f ) : 0.0f );
+	}
+
+	Mem_Free( scratch );
+	fileSystem->FreeFile( fileData );
+}
+
 //+set r_fullscreen 0 +set com_allowConsole 1 +set developer 1 +set fs_debug 0 +set win_outputDebugString 1 +set fs_basepath "E:\SteamLibrary\steamapps\common\DOOM 3 BFG Edition\"
 
 
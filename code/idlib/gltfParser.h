@@ -303,6 +303,9 @@ public:
 	GLTF_Parser();
 	void Shutdown();
 	bool Parse();
+	// parses a JSON chunk into currentAsset, either with rapidjson in-situ or with idLexer.
+	// the in-situ backend modifies json and requires a terminating zero somewhere after it.
+	bool ParseJson( char* json, int length, bool insitu );
 	bool Load( idStr filename );
 	bool loadGLB( idStr filename );
 
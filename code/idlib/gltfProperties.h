@@ -761,13 +761,22 @@ public:
 // all data should be layed out like an GLB with multiple bin chunks
 // EACH URI will have an unique chunk
 // JSON chunk MUST be the first one to be allocated/added
+// Chunks added with AddChunk are not copied, they point into the
+// file data block that was handed over with SetFileData.
 
 class gltfData
 {
 public:
-	gltfData() : fileName( "" ), fileNameHash( 0 ), json( nullptr ), data( nullptr ), totalChunks( -1 ) { };
+	gltfData() : fileName( "" ), fileNameHash( 0 ), fileData( nullptr ), json( nullptr ), data( nullptr ), totalChunks( -1 ), ownsJson( false ), ownedChunks( 0 ) { };
 	~gltfData();
 	byte* AddData( int size, int* bufferID = nullptr );
+	byte* AddChunk( byte* chunk, int size, int* bufferID = nullptr );
+	// takes ownership of a block returned by idFileSystem::ReadFile
+	void SetFileData( byte* buffer )
+	{
+		assert( fileData == nullptr );
+		fileData = buffer;
+	}
 	byte* GetJsonData( int& size )
 	{
 		size = jsonDataLength;
@@ -1550,10 +1559,13 @@ private:
 	idStr fileName;
 	int	fileNameHash;
 
+	byte* fileData;
 	byte* json;
 	byte** data;
 	int jsonDataLength;
 	int totalChunks;
+	bool ownsJson;
+	uint32 ownedChunks;
 
 	idList<gltfBuffer*>			buffers;
 	idList<gltfImage*>			images;
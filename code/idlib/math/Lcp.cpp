@@ -3356,6 +3356,444 @@ bool idLCP_Symmetric::Solve( const idMatX& o_m, idVecX& o_x, const idVecX& o_b,
 	return true;
 }
 
+/*
+================================================================================================
+
+	idLCPSparseMatrix
+
+================================================================================================
+*/
+
+/*
+========================
+idLCPSparseMatrix::idLCPSparseMatrix
+========================
+*/
+idLCPSparseMatrix::idLCPSparseMatrix()
+{
+	values.SetGranularity( 256 );
+	runs.SetGranularity( 64 );
+	rowRuns.SetGranularity( 64 );
+	diagonal.SetGranularity( 64 );
+	Clear();
+}
+
+/*
+========================
+idLCPSparseMatrix::Clear
+
+Keeps the memory around so a matrix that is rebuilt every frame doesn't allocate.
+========================
+*/
+void idLCPSparseMatrix::Clear()
+{
+	numRows = 0;
+	numEntries = 0;
+	values.SetNum( 0 );
+	runs.SetNum( 0 );
+	rowRuns.SetNum( 0 );
+	rowRuns.Append( 0 );
+	diagonal.SetNum( 0 );
+}
+
+/*
+========================
+idLCPSparseMatrix::BeginRow
+========================
+*/
+void idLCPSparseMatrix::BeginRow()
+{
+	assert( rowRuns.Num() == numRows + 1 );
+	diagonal.Append( -1 );
+}
+
+/*
+========================
+idLCPSparseMatrix::AddEntry
+========================
+*/
+void idLCPSparseMatrix::AddEntry( int column, float value )
+{
+	assert( diagonal.Num() == numRows + 1 );
+
+	if( runs.Num() > rowRuns[numRows] )
+	{
+		run_t& run = runs[runs.Num() - 1];
+		assert( column >= run.column + run.count );
+		if( column == run.column + run.count )
+		{
+			if( column == numRows )
+			{
+				diagonal[numRows] = values.Num();
+			}
+			values.Append( value );
+			run.count++;
+			numEntries++;
+			return;
+		}
+	}
+
+	// start a new run with its values on a 16 byte boundary
+	while( values.Num() & 3 )
+	{
+		values.Append( 0.0f );
+	}
+	if( column == numRows )
+	{
+		diagonal[numRows] = values.Num();
+	}
+
+	run_t& run = runs.Alloc();
+	run.column = column;
+	run.count = 1;
+	run.offset = values.Num();
+	values.Append( value );
+	numEntries++;
+}
+
+/*
+========================
+idLCPSparseMatrix::EndRow
+========================
+*/
+void idLCPSparseMatrix::EndRow()
+{
+	rowRuns.Append( runs.Num() );
+	numRows++;
+}
+
+/*
+========================
+idLCPSparseMatrix::FromDense
+========================
+*/
+void idLCPSparseMatrix::FromDense( const idMatX& m )
+{
+	assert( m.GetNumRows() == m.GetNumColumns() );
+
+	Clear();
+	for( int i = 0; i < m.GetNumRows(); i++ )
+	{
+		const float* row = m[i];
+		BeginRow();
+		for( int j = 0; j < m.GetNumColumns(); j++ )
+		{
+			if( row[j] != 0.0f )
+			{
+				AddEntry( j, row[j] );
+			}
+		}
+		EndRow();
+	}
+}
+
+/*
+========================
+idLCPSparseMatrix::ToDense
+========================
+*/
+void idLCPSparseMatrix::ToDense( idMatX& m ) const
+{
+	m.SetSize( numRows, numRows );
+	m.Zero();
+	for( int i = 0; i < numRows; i++ )
+	{
+		float* row = m[i];
+		for( int r = rowRuns[i]; r < rowRuns[i + 1]; r++ )
+		{
+			const run_t& run = runs[r];
+			for( int j = 0; j < run.count; j++ )
+			{
+				row[run.column + j] = values[run.offset + j];
+			}
+		}
+	}
+}
+
+/*
+========================
+idLCPSparseMatrix::SymmetricFromLower
+========================
+*/
+void idLCPSparseMatrix::SymmetricFromLower( const idLCPSparseMatrix& lower )
+{
+	assert( &lower != this );
+
+	const int n = lower.numRows;
+
+	// bucket the entries below the diagonal by column, the rows of each bucket stay in increasing order
+	int* columnStart = ( int* ) _alloca16( ( n + 1 ) * sizeof( int ) );
+	int* columnFill = ( int* ) _alloca16( n * sizeof( int ) );
+	int* upperRows = ( int* ) _alloca16( ( lower.numEntries + 1 ) * sizeof( int ) );
+	float* upperValues = ( float* ) _alloca16( ( lower.numEntries + 1 ) * sizeof( float ) );
+
+	memset( columnStart, 0, ( n + 1 ) * sizeof( int ) );
+	for( int i = 0; i < n; i++ )
+	{
+		for( int r = lower.rowRuns[i]; r < lower.rowRuns[i + 1]; r++ )
+		{
+			const run_t& run = lower.runs[r];
+			for( int j = 0; j < run.count; j++ )
+			{
+				const int column = run.column + j;
+				assert( column <= i );
+				if( column < i )
+				{
+					columnStart[column + 1]++;
+				}
+			}
+		}
+	}
+	for( int i = 0; i < n; i++ )
+	{
+		columnStart[i + 1] += columnStart[i];
+		columnFill[i] = columnStart[i];
+	}
+	for( int i = 0; i < n; i++ )
+	{
+		for( int r = lower.rowRuns[i]; r < lower.rowRuns[i + 1]; r++ )
+		{
+			const run_t& run = lower.runs[r];
+			for( int j = 0; j < run.count; j++ )
+			{
+				const int column = run.column + j;
+				if( column < i )
+				{
+					upperRows[columnFill[column]] = i;
+					upperValues[columnFill[column]] = lower.values[run.offset + j];
+					columnFill[column]++;
+				}
+			}
+		}
+	}
+
+	// each row is the lower row followed by the mirrored column
+	Clear();
+	for( int i = 0; i < n; i++ )
+	{
+		BeginRow();
+		for( int r = lower.rowRuns[i]; r < lower.rowRuns[i + 1]; r++ )
+		{
+			const run_t& run = lower.runs[r];
+			for( int j = 0; j < run.count; j++ )
+			{
+				AddEntry( run.column + j, lower.values[run.offset + j] );
+			}
+		}
+		for( int j = columnStart[i]; j < columnStart[i + 1]; j++ )
+		{
+			AddEntry( upperRows[j], upperValues[j] );
+		}
+		EndRow();
+	}
+}
+
+/*
+========================
+idLCPSparseMatrix::RowProduct
+========================
+*/
+float idLCPSparseMatrix::RowProduct( int row, const float* x ) const
+{
+	float sum = 0.0f;
+
+#if defined(LCP_SIMD)
+	__m128 sum4 = ( __m128& ) SIMD_SP_zero;
+#endif
+
+	for( int r = rowRuns[row]; r < rowRuns[row + 1]; r++ )
+	{
+		const run_t& run = runs[r];
+		const float* v = values.Ptr() + run.offset;
+		const float* s = x + run.column;
+		int i = 0;
+
+#if defined(LCP_SIMD)
+		assert_16_byte_aligned( v );
+		for( ; i + 4 <= run.count; i += 4 )
+		{
+			sum4 = _mm_add_ps( _mm_mul_ps( _mm_load_ps( v + i ), _mm_loadu_ps( s + i ) ), sum4 );
+		}
+#endif
+
+		for( ; i < run.count; i++ )
+		{
+			sum += v[i] * s[i];
+		}
+	}
+
+#if defined(LCP_SIMD)
+	sum4 = _mm_add_ps( sum4, _mm_shuffle_ps( sum4, sum4, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+	sum4 = _mm_add_ps( sum4, _mm_shuffle_ps( sum4, sum4, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+	float dot;
+	_mm_store_ss( &dot, sum4 );
+	sum += dot;
+#endif
+
+	return sum;
+}
+
+/*
+================================================================================================
+
+	idLCP_GaussSeidel
+
+================================================================================================
+*/
+
+const float LCP_GAUSS_SEIDEL_TOLERANCE		= 1e-4f;
+const float LCP_GAUSS_SEIDEL_MIN_DIAGONAL	= 1e-9f;
+
+/*
+================================================
+idLCP_GaussSeidel
+
+Projected Gauss-Seidel. Every iteration solves each row for its own variable with the
+others fixed and clamps the result to the bounds. The cost of an iteration is linear in
+the number of non-zero matrix entries, there is no factorization. The solution is only as
+accurate as the number of iterations allows, but the previous solution makes a good
+initial guess for a figure that is simulated every frame.
+================================================
+*/
+class idLCP_GaussSeidel : public idLCP
+{
+public:
+	virtual bool	Solve( const idMatX& o_m, idVecX& o_x, const idVecX& o_b, const idVecX& o_lo, const idVecX& o_hi, const int* o_boxIndex );
+	virtual bool	SolveSparse( const idLCPSparseMatrix& o_m, idVecX& o_x, const idVecX& o_b, const idVecX& o_lo, const idVecX& o_hi, const int* o_boxIndex );
+
+private:
+	idLCPSparseMatrix	sparse;			// sparse copy of a dense matrix
+
+	float			Relax( const idLCPSparseMatrix& m, float* x, const float* b, const float* lo, const float* hi, const int* boxIndex, int i ) const;
+};
+
+/*
+========================
+idLCP_GaussSeidel::Relax
+
+Solves row i for x[i] and returns the absolute change.
+========================
+*/
+ID_INLINE float idLCP_GaussSeidel::Relax( const idLCPSparseMatrix& m, float* x, const float* b, const float* lo, const float* hi, const int* boxIndex, int i ) const
+{
+	float l = lo[i];
+	float h = hi[i];
+	if( boxIndex != NULL && boxIndex[i] != -1 )
+	{
+		const float s = x[boxIndex[i]];
+		l = - idMath::Fabs( l * s );
+		h = idMath::Fabs( h * s );
+	}
+
+	const float d = m.GetDiagonal( i );
+	const float old = x[i];
+	// the row product includes the diagonal term for the old value
+	float f = old + ( b[i] - m.RowProduct( i, x ) ) / d;
+	f = idMath::ClampFloat( l, h, f );
+	x[i] = f;
+	return idMath::Fabs( f - old );
+}
+
+/*
+========================
+idLCP_GaussSeidel::Solve
+========================
+*/
+bool idLCP_GaussSeidel::Solve( const idMatX& o_m, idVecX& o_x, const idVecX& o_b, const idVecX& o_lo, const idVecX& o_hi, const int* o_boxIndex )
+{
+	sparse.FromDense( o_m );
+	return SolveSparse( sparse, o_x, o_b, o_lo, o_hi, o_boxIndex );
+}
+
+/*
+========================
+idLCP_GaussSeidel::SolveSparse
+========================
+*/
+bool idLCP_GaussSeidel::SolveSparse( const idLCPSparseMatrix& o_m, idVecX& o_x, const idVecX& o_b, const idVecX& o_lo, const idVecX& o_hi, const int* o_boxIndex )
+{
+	const int n = o_m.GetNumRows();
+
+	assert( o_x.GetSize() == n );
+	assert( o_b.GetSize() == n );
+	assert( o_lo.GetSize() == n );
+	assert( o_hi.GetSize() == n );
+
+	float* x = o_x.ToFloatPtr();
+	const float* b = o_b.ToFloatPtr();
+	const float* lo = o_lo.ToFloatPtr();
+	const float* hi = o_hi.ToFloatPtr();
+
+	// variables without a usable diagonal can't be solved for, leave them at the bound closest to zero
+	int numIgnored = 0;
+	for( int i = 0; i < n; i++ )
+	{
+		if( o_m.GetDiagonal( i ) <= LCP_GAUSS_SEIDEL_MIN_DIAGONAL )
+		{
+			x[i] = idMath::ClampFloat( lo[i], hi[i], 0.0f );
+			numIgnored++;
+		}
+		else if( o_boxIndex == NULL || o_boxIndex[i] == -1 )
+		{
+			x[i] = idMath::ClampFloat( lo[i], hi[i], x[i] );
+		}
+	}
+
+	int iteration;
+	for( iteration = 0; iteration < maxIterations; iteration++ )
+	{
+		float maxDelta = 0.0f;
+		float maxForce = 0.0f;
+
+		// solve for the variables the box constrained variables depend on first
+		for( int pass = 0; pass < 2; pass++ )
+		{
+			for( int i = 0; i < n; i++ )
+			{
+				const bool boxed = ( o_boxIndex != NULL && o_boxIndex[i] != -1 );
+				if( boxed != ( pass == 1 ) || o_m.GetDiagonal( i ) <= LCP_GAUSS_SEIDEL_MIN_DIAGONAL )
+				{
+					continue;
+				}
+				maxDelta = Max( maxDelta, Relax( o_m, x, b, lo, hi, o_boxIndex, i ) );
+				maxForce = Max( maxForce, idMath::Fabs( x[i] ) );
+			}
+		}
+
+		if( maxDelta <= LCP_GAUSS_SEIDEL_TOLERANCE * Max( maxForce, 1.0f ) )
+		{
+			break;
+		}
+	}
+
+	for( int i = 0; i < n; i++ )
+	{
+		if( IEEE_FLT_IS_INF_NAN( x[i] ) )
+		{
+			if( lcp_showFailures.GetBool() )
+			{
+				idLib::Printf( "idLCP_GaussSeidel::Solve: diverged after %d iterations\n", iteration );
+			}
+			o_x.Zero();
+			return false;
+		}
+	}
+
+	if( lcp_showFailures.GetBool() )
+	{
+		if( numIgnored )
+		{
+			idLib::Printf( "idLCP_GaussSeidel::Solve: %d of %d variables ignored\n", numIgnored, n );
+		}
+		if( iteration >= maxIterations )
+		{
+			idLib::Printf( "idLCP_GaussSeidel::Solve: no convergence after %d iterations\n", iteration );
+		}
+	}
+
+	return true;
+}
+
 /*
 ================================================================================================
 
@@ -3388,6 +3826,18 @@ idLCP* idLCP::AllocSymmetric()
 	return lcp;
 }
 
+/*
+========================
+idLCP::AllocGaussSeidel
+========================
+*/
+idLCP* idLCP::AllocGaussSeidel()
+{
+	idLCP* lcp = new idLCP_GaussSeidel;
+	lcp->SetMaxIterations( 64 );
+	return lcp;
+}
+
 /*
 ========================
 idLCP::~idLCP
@@ -3397,6 +3847,18 @@ idLCP::~idLCP()
 {
 }
 
+/*
+========================
+idLCP::SolveSparse
+========================
+*/
+bool idLCP::SolveSparse( const idLCPSparseMatrix& A, idVecX& x, const idVecX& b, const idVecX& lo, const idVecX& hi, const int* boxIndex )
+{
+	idMatX m;
+	A.ToDense( m );
+	return Solve( m, x, b, lo, hi, boxIndex );
+}
+
 /*
 ========================
 idLCP::SetMaxIterations
@@ -57,17 +57,25 @@ Before calculating any of the bounded x[i] with boxIndex[i] != -1, the solver ca
 unbounded x[i] and all x[i] with boxIndex[i] == -1.
 ================================================
 */
+class idLCPSparseMatrix;
+
 class idLCP
 {
 public:
 	static idLCP* 	AllocSquare();		// 'A' must be a square matrix
 	static idLCP* 	AllocSymmetric();	// 'A' must be a symmetric matrix
+	static idLCP* 	AllocGaussSeidel();	// 'A' must be a symmetric positive definite matrix, solved iteratively
 
 	virtual			~idLCP();
 
 	virtual bool	Solve( const idMatX& A, idVecX& x, const idVecX& b, const idVecX& lo,
 						   const idVecX& hi, const int* boxIndex = NULL ) = 0;
 
+	// the direct solvers expand 'A' into a dense matrix, the iterative solver works on the sparse rows
+	// 'x' is used as the initial guess by the iterative solver
+	virtual bool	SolveSparse( const idLCPSparseMatrix& A, idVecX& x, const idVecX& b, const idVecX& lo,
+								 const idVecX& hi, const int* boxIndex = NULL );
+
 	virtual void	SetMaxIterations( int max );
 	virtual int		GetMaxIterations();
 
@@ -77,4 +85,70 @@ protected:
 	int				maxIterations;
 };
 
+/*
+================================================
+idLCPSparseMatrix stores the rows of a square LCP matrix as runs of consecutive non-zero
+columns. Constraints that act on bodies in separate trees of an articulated figure don't
+interact, the zeros between them are never stored or visited.
+
+The values of each run start on a 16 byte boundary so the row products can use SIMD.
+
+	A.BeginRow();
+	A.AddEntry( column, value );	// columns in increasing order
+	A.EndRow();
+================================================
+*/
+class idLCPSparseMatrix
+{
+public:
+	idLCPSparseMatrix();
+
+	void			Clear();
+	void			BeginRow();
+	void			AddEntry( int column, float value );
+	void			EndRow();
+
+	// builds the matrix from the non-zero entries of a dense matrix
+	void			FromDense( const idMatX& m );
+	void			ToDense( idMatX& m ) const;
+	// builds a symmetric matrix from a matrix that only stores the lower triangle and diagonal
+	void			SymmetricFromLower( const idLCPSparseMatrix& lower );
+
+	int				GetNumRows() const
+	{
+		return numRows;
+	}
+	int				GetNumEntries() const
+	{
+		return numEntries;
+	}
+	float			GetDiagonal( int row ) const
+	{
+		return diagonal[row] >= 0 ? values[diagonal[row]] : 0.0f;
+	}
+	void			AddToDiagonal( int row, float value )
+	{
+		assert( diagonal[row] >= 0 );
+		values[diagonal[row]] += value;
+	}
+
+	// dot product of a row with the vector 'x'
+	float			RowProduct( int row, const float* x ) const;
+
+private:
+	struct run_t
+	{
+		int			column;				// first column of the run
+		int			count;				// number of consecutive columns
+		int			offset;				// index of the first value, 16 byte aligned
+	};
+
+	int				numRows;
+	int				numEntries;
+	idList< float, TAG_IDLIB >	values;
+	idList< run_t, TAG_IDLIB >	runs;
+	idList< int, TAG_IDLIB >	rowRuns;		// first run of each row, numRows + 1 entries
+	idList< int, TAG_IDLIB >	diagonal;		// value index of the diagonal of each row, -1 if zero
+};
+
 #endif // !__MATH_LCP_H__
@@ -33,6 +33,8 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "AASBuild_local.h"
 
+idCVar aas_parallelBuild( "aas_parallelBuild", "1", CVAR_TOOL | CVAR_BOOL, "compile the AAS files for the different bounding box sizes of a map in parallel" );
+
 #define BFL_PATCH		0x1000
 
 //===============================================================
@@ -55,6 +57,13 @@ idAASBuild::idAASBuild()
 	numMergedLeafNodes = 0;
 	numLedgeSubdivisions = 0;
 	ledgeMap = NULL;
+	vertexHash = NULL;
+	edgeHash = NULL;
+	mapFile = NULL;
+	leakBSP = NULL;
+	compiled = false;
+	startTime = 0;
+	memset( stageTime, 0, sizeof( stageTime ) );
 }
 
 /*
@@ -90,6 +99,19 @@ void idAASBuild::Shutdown()
 		delete ledgeMap;
 		ledgeMap = NULL;
 	}
+	if( mapFile )
+	{
+		delete mapFile;
+		mapFile = NULL;
+	}
+	if( leakBSP )
+	{
+		delete leakBSP;
+		leakBSP = NULL;
+	}
+	brushList.Free();
+	entityClassNames.Clear();
+	compiled = false;
 }
 
 /*
@@ -811,22 +833,34 @@ idAASBuild::Build
 */
 bool idAASBuild::Build( const idStr& fileName, const idAASSettings* settings )
 {
-	int i, bit, mask, startTime;
-	idMapFile* mapFile;
-	idBrushList brushList;
-	idList<idBrushList*> expandedBrushes;
-	idBrush* b;
-	idBrushBSP bsp;
-	idStr name;
-	idAASReach reach;
-	idAASCluster cluster;
-	idStrList entityClassNames;
+	if( !BeginBuild( fileName, settings ) )
+	{
+		return true;
+	}
 
-	startTime = Sys_Milliseconds();
+	CompileFile( true );
+
+	return EndBuild();
+}
+
+/*
+============
+idAASBuild::BeginBuild
+
+  loads the map brushes, returns false if there is nothing to compile
+============
+*/
+bool idAASBuild::BeginBuild( const idStr& fileName, const idAASSettings* settings )
+{
+	idStr name;
 
 	Shutdown();
 
+	startTime = Sys_Milliseconds();
+	memset( stageTime, 0, sizeof( stageTime ) );
+
 	aasSettings = settings;
+	buildFileName = fileName;
 
 	name = fileName;
 	name.SetFileExtension( "map" );
@@ -835,6 +869,7 @@ bool idAASBuild::Build( const idStr& fileName, const idAASSettings* settings )
 	if( !mapFile->Parse( name ) )
 	{
 		delete mapFile;
+		mapFile = NULL;
 		common->Error( "Couldn't load map file: '%s'", name.c_str() );
 		return false;
 	}
@@ -843,8 +878,9 @@ bool idAASBuild::Build( const idStr& fileName, const idAASSettings* settings )
 	if( !CheckForEntities( mapFile, entityClassNames ) )
 	{
 		delete mapFile;
+		mapFile = NULL;
 		common->Printf( "no entities in map that use %s\n", settings->fileExtension.c_str() );
-		return true;
+		return false;
 	}
 
 	name.SetFileExtension( aasSettings->fileExtension );
@@ -858,6 +894,7 @@ bool idAASBuild::Build( const idStr& fileName, const idAASSettings* settings )
 	if( brushList.Num() == 0 )
 	{
 		delete mapFile;
+		mapFile = NULL;
 		common->Error( "%s is empty", name.c_str() );
 		return false;
 	}
@@ -872,6 +909,32 @@ bool idAASBuild::Build( const idStr& fileName, const idAASSettings* settings )
 		DeleteProcBSP();
 	}
 
+	stageTime[AAS_STAGE_LOAD] = Sys_Milliseconds() - startTime;
+
+	return true;
+}
+
+/*
+============
+idAASBuild::CompileFile
+
+  builds the AAS file from the loaded brushes without touching any shared state,
+  the brush and ledge maps are only written when writeBrushMap is set which is
+  never done for parallel builds
+============
+*/
+bool idAASBuild::CompileFile( bool parallelReachability )
+{
+	int i, bit, mask, time;
+	idList<idBrushList*> expandedBrushes;
+	idBrush* b;
+	idBrushBSP* bsp;
+	idAASReach reach;
+	idAASCluster cluster;
+
+	compiled = false;
+	time = Sys_Milliseconds();
+
 	// make copies of the brush list
 	expandedBrushes.Append( &brushList );
 	for( i = 1; i < aasSettings->numBoundingBoxes; i++ )
@@ -899,77 +962,137 @@ bool idAASBuild::Build( const idStr& fileName, const idAASSettings* settings )
 		delete expandedBrushes[i];
 	}
 
+	bsp = new idBrushBSP;
+
 	if( aasSettings->writeBrushMap )
 	{
-		bsp.WriteBrushMap( fileName, "_" + aasSettings->fileExtension, AREACONTENTS_SOLID );
+		bsp->WriteBrushMap( buildFileName, "_" + aasSettings->fileExtension, AREACONTENTS_SOLID );
 	}
 
-	// build BSP tree from brushes
-	bsp.Build( brushList, AREACONTENTS_SOLID, ExpandedChopAllowed, ExpandedMergeAllowed );
+	// build BSP tree from brushes, the tree owns the brushes from now on
+	bsp->Build( brushList, AREACONTENTS_SOLID, ExpandedChopAllowed, ExpandedMergeAllowed );
+	brushList.Clear();
 
 	// only solid nodes with all bits set for all bounding boxes need to stay solid
-	ChangeMultipleBoundingBoxContents_r( bsp.GetRootNode(), mask );
+	ChangeMultipleBoundingBoxContents_r( bsp->GetRootNode(), mask );
 
 	// portalize the bsp tree
-	bsp.Portalize();
+	bsp->Portalize();
 
 	// remove subspaces not reachable by entities
-	if( !bsp.RemoveOutside( mapFile, AREACONTENTS_SOLID, entityClassNames ) )
+	if( !bsp->RemoveOutside( mapFile, AREACONTENTS_SOLID, entityClassNames ) )
 	{
-		bsp.LeakFile( name );
-		delete mapFile;
-		common->Warning( "%s has no outside", name.c_str() );
+		// the leak file is written by EndBuild
+		leakBSP = bsp;
+		stageTime[AAS_STAGE_BSP] = Sys_Milliseconds() - time;
 		return false;
 	}
 
+	stageTime[AAS_STAGE_BSP] = Sys_Milliseconds() - time;
+	time = Sys_Milliseconds();
+
 	// gravitational subdivision
-	GravitationalSubdivision( bsp );
+	GravitationalSubdivision( *bsp );
 
 	// merge portals where possible
-	bsp.MergePortals( AREACONTENTS_SOLID );
+	bsp->MergePortals( AREACONTENTS_SOLID );
 
 	// melt portal windings
-	bsp.MeltPortals( AREACONTENTS_SOLID );
+	bsp->MeltPortals( AREACONTENTS_SOLID );
 
 	if( aasSettings->writeBrushMap )
 	{
-		WriteLedgeMap( fileName, "_" + aasSettings->fileExtension + "_ledge" );
+		WriteLedgeMap( buildFileName, "_" + aasSettings->fileExtension + "_ledge" );
 	}
 
 	// ledge subdivisions
-	LedgeSubdivision( bsp );
+	LedgeSubdivision( *bsp );
 
 	// merge leaf nodes
-	MergeLeafNodes( bsp );
+	MergeLeafNodes( *bsp );
 
 	// merge portals where possible
-	bsp.MergePortals( AREACONTENTS_SOLID );
+	bsp->MergePortals( AREACONTENTS_SOLID );
 
 	// melt portal windings
-	bsp.MeltPortals( AREACONTENTS_SOLID );
+	bsp->MeltPortals( AREACONTENTS_SOLID );
+
+	stageTime[AAS_STAGE_SUBDIVISION] = Sys_Milliseconds() - time;
+	time = Sys_Milliseconds();
 
 	// store the file from the bsp tree
-	StoreFile( bsp );
+	StoreFile( *bsp );
 	file->settings = *aasSettings;
 
+	delete bsp;
+
+	stageTime[AAS_STAGE_STORE] = Sys_Milliseconds() - time;
+	time = Sys_Milliseconds();
+
 	// calculate reachability
-	reach.Build( mapFile, file );
+	reach.Build( mapFile, file, parallelReachability );
+
+	stageTime[AAS_STAGE_REACHABILITY] = Sys_Milliseconds() - time;
+	time = Sys_Milliseconds();
 
 	// build clusters
 	cluster.Build( file );
 
+	stageTime[AAS_STAGE_CLUSTERS] = Sys_Milliseconds() - time;
+	time = Sys_Milliseconds();
+
 	// optimize the file
 	if( !aasSettings->noOptimize )
 	{
 		file->Optimize();
 	}
 
+	stageTime[AAS_STAGE_OPTIMIZE] = Sys_Milliseconds() - time;
+
+	compiled = true;
+	return true;
+}
+
+/*
+============
+idAASBuild::EndBuild
+
+  writes the compiled file or the leak file
+============
+*/
+bool idAASBuild::EndBuild()
+{
+	idStr name;
+	int time;
+
+	name = buildFileName;
+	name.SetFileExtension( "map" );
+
+	if( !compiled )
+	{
+		if( leakBSP )
+		{
+			leakBSP->LeakFile( name );
+			delete leakBSP;
+			leakBSP = NULL;
+		}
+		delete mapFile;
+		mapFile = NULL;
+		common->Warning( "%s has no outside", name.c_str() );
+		return false;
+	}
+
+	time = Sys_Milliseconds();
+
 	// write the file
 	name.SetFileExtension( aasSettings->fileExtension );
 	file->Write( name, mapFile->GetGeometryCRC() );
 
 	// delete the map file
 	delete mapFile;
+	mapFile = NULL;
+
+	stageTime[AAS_STAGE_WRITE] = Sys_Milliseconds() - time;
 
 	common->Printf( "%6d seconds to create AAS\n", ( Sys_Milliseconds() - startTime ) / 1000 );
 	common->RogmapPacifierInfo( "%6d seconds to create AAS\n", ( Sys_Milliseconds() - startTime ) / 1000 );
@@ -977,6 +1100,23 @@ bool idAASBuild::Build( const idStr& fileName, const idAASSettings* settings )
 	return true;
 }
 
+/*
+============
+idAASBuild::PrintStageTimes
+============
+*/
+void idAASBuild::PrintStageTimes() const
+{
+	static const char* stageNames[AAS_NUM_STAGES] = { "load", "bsp", "subdiv", "store", "reach", "cluster", "optimize", "write" };
+
+	common->Printf( "%-12s", aasSettings ? aasSettings->fileExtension.c_str() : "" );
+	for( int i = 0; i < AAS_NUM_STAGES; i++ )
+	{
+		common->Printf( " %s %5d ms", stageNames[i], stageTime[i] );
+	}
+	common->Printf( "\n" );
+}
+
 /*
 ============
 idAASBuild::BuildReachability
@@ -984,8 +1124,7 @@ idAASBuild::BuildReachability
 */
 bool idAASBuild::BuildReachability( const idStr& fileName, const idAASSettings* settings )
 {
-	int startTime;
-	idMapFile* mapFile;
+	idMapFile* reachMapFile;
 	idStr name;
 	idAASReach reach;
 	idAASCluster cluster;
@@ -997,10 +1136,10 @@ bool idAASBuild::BuildReachability( const idStr& fileName, const idAASSettings*
 	name = fileName;
 	name.SetFileExtension( "map" );
 
-	mapFile = new idMapFile;
-	if( !mapFile->Parse( name ) )
+	reachMapFile = new idMapFile;
+	if( !reachMapFile->Parse( name ) )
 	{
-		delete mapFile;
+		delete reachMapFile;
 		common->Error( "Couldn't load map file: '%s'", name.c_str() );
 		return false;
 	}
@@ -1010,7 +1149,7 @@ bool idAASBuild::BuildReachability( const idStr& fileName, const idAASSettings*
 	name.SetFileExtension( aasSettings->fileExtension );
 	if( !file->Load( name, 0 ) )
 	{
-		delete mapFile;
+		delete reachMapFile;
 		common->Error( "Couldn't load AAS file: '%s'", name.c_str() );
 		return false;
 	}
@@ -1018,16 +1157,16 @@ bool idAASBuild::BuildReachability( const idStr& fileName, const idAASSettings*
 	file->settings = *aasSettings;
 
 	// calculate reachability
-	reach.Build( mapFile, file );
+	reach.Build( reachMapFile, file, true );
 
 	// build clusters
 	cluster.Build( file );
 
 	// write the file
-	file->Write( name, mapFile->GetGeometryCRC() );
+	file->Write( name, reachMapFile->GetGeometryCRC() );
 
 	// delete the map file
-	delete mapFile;
+	delete reachMapFile;
 
 	common->Printf( "%6d seconds to calculate reachability\n", ( Sys_Milliseconds() - startTime ) / 1000 );
 
@@ -1086,6 +1225,97 @@ static const idDict* FindEntityDefDict( const char* name, bool makeDefault )
 }
 // RB end
 
+/*
+============
+AAS_CompileJob
+============
+*/
+static void AAS_CompileJob( idAASBuild* build )
+{
+	// nested job lists are not allowed so the reachabilities are calculated on this thread
+	build->CompileFile( false );
+}
+
+REGISTER_PARALLEL_JOB( AAS_CompileJob, "AAS_CompileJob" );
+
+/*
+============
+BuildAASFiles
+
+  the maps and brushes are loaded and the files are written one after the other on
+  this thread, the compilation of the different sizes runs on the job threads
+============
+*/
+static void BuildAASFiles( const idStr& mapName, const idList<idAASSettings*>& settingsList )
+{
+	int i, startTime;
+	idList<idAASBuild*> builds;
+	bool parallel;
+
+	startTime = Sys_Milliseconds();
+	parallel = aas_parallelBuild.GetBool();
+
+	for( i = 0; i < settingsList.Num(); i++ )
+	{
+		idAASBuild* build = new idAASBuild;
+		if( !build->BeginBuild( mapName, settingsList[i] ) )
+		{
+			delete build;
+			continue;
+		}
+		builds.Append( build );
+
+		// the brush and ledge maps are written while compiling
+		if( settingsList[i]->writeBrushMap )
+		{
+			parallel = false;
+		}
+	}
+
+	if( parallel && builds.Num() > 1 )
+	{
+		idParallelJobList* jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, builds.Num(), 0, NULL );
+
+		for( i = 0; i < builds.Num(); i++ )
+		{
+			jobList->AddJob( ( jobRun_t )AAS_CompileJob, builds[i] );
+		}
+
+		jobList->Submit( NULL, JOBLIST_PARALLELISM_MAX_CORES );
+		jobList->Wait();
+
+		parallelJobManager->FreeJobList( jobList );
+	}
+	else
+	{
+		for( i = 0; i < builds.Num(); i++ )
+		{
+			if( i )
+			{
+				common->Printf( "=======================================================\n" );
+			}
+			builds[i]->CompileFile( true );
+		}
+	}
+
+	for( i = 0; i < builds.Num(); i++ )
+	{
+		builds[i]->EndBuild();
+	}
+
+	if( builds.Num() )
+	{
+		common->Printf( "=======================================================\n" );
+		for( i = 0; i < builds.Num(); i++ )
+		{
+			builds[i]->PrintStageTimes();
+		}
+		common->Printf( "%6d seconds to create %d AAS files%s\n", ( Sys_Milliseconds() - startTime ) / 1000, builds.Num(), ( parallel && builds.Num() > 1 ) ? " in parallel" : "" );
+	}
+
+	builds.DeleteContents( true );
+}
+
 /*
 ============
 RunAAS_f
@@ -1094,8 +1324,7 @@ RunAAS_f
 void RunAAS_f( const idCmdArgs& args )
 {
 	int i;
-	idAASBuild aas;
-	idAASSettings settings;
+	idList<idAASSettings*> settingsList;
 	idStr mapName;
 
 	if( args.Argc() <= 1 )
@@ -1129,23 +1358,24 @@ void RunAAS_f( const idCmdArgs& args )
 		}
 		else
 		{
-			settings.FromDict( kv->GetValue(), settingsDict );
-			i = ParseOptions( args, settings );
+			idAASSettings* settings = new idAASSettings;
+			settings->FromDict( kv->GetValue(), settingsDict );
+			i = ParseOptions( args, *settings );
 			mapName = args.Argv( i );
 			mapName.BackSlashesToSlashes();
 			if( mapName.Icmpn( "maps/", 4 ) != 0 )
 			{
 				mapName = "maps/" + mapName;
 			}
-			aas.Build( mapName, &settings );
+			settingsList.Append( settings );
 		}
 
 		kv = dict->MatchPrefix( "type", kv );
-		if( kv )
-		{
-			common->Printf( "=======================================================\n" );
-		}
 	}
+
+	BuildAASFiles( mapName, settingsList );
+	settingsList.DeleteContents( true );
+
 	common->SetRefreshOnPrint( false );
 	common->PrintWarnings();
 }
@@ -1158,8 +1388,7 @@ RunAASDir_f
 void RunAASDir_f( const idCmdArgs& args )
 {
 	int i;
-	idAASBuild aas;
-	idAASSettings settings;
+	idList<idAASSettings*> settingsList;
 	idFileList* mapFiles;
 
 	if( args.Argc() <= 1 )
@@ -1179,6 +1408,24 @@ void RunAASDir_f( const idCmdArgs& args )
 		common->Error( "Unable to find entityDef for 'aas_types'" );
 	}
 
+	const idKeyValue* kv = dict->MatchPrefix( "type" );
+	while( kv != NULL )
+	{
+		const idDict* settingsDict = FindEntityDefDict( kv->GetValue(), false );
+		if( !settingsDict )
+		{
+			common->Warning( "Unable to find '%s' in def/aas.def", kv->GetValue().c_str() );
+		}
+		else
+		{
+			idAASSettings* settings = new idAASSettings;
+			settings->FromDict( kv->GetValue(), settingsDict );
+			settingsList.Append( settings );
+		}
+
+		kv = dict->MatchPrefix( "type", kv );
+	}
+
 	// scan for .map files
 	mapFiles = fileSystem->ListFiles( idStr( "maps/" ) + args.Argv( 1 ), ".map" );
 
@@ -1190,29 +1437,11 @@ void RunAASDir_f( const idCmdArgs& args )
 			common->Printf( "=======================================================\n" );
 		}
 
-		const idKeyValue* kv = dict->MatchPrefix( "type" );
-		while( kv != NULL )
-		{
-			const idDict* settingsDict = FindEntityDefDict( kv->GetValue(), false );
-			if( !settingsDict )
-			{
-				common->Warning( "Unable to find '%s' in def/aas.def", kv->GetValue().c_str() );
-			}
-			else
-			{
-				settings.FromDict( kv->GetValue(), settingsDict );
-				aas.Build( idStr( "maps/" ) + args.Argv( 1 ) + "/" + mapFiles->GetFile( i ), &settings );
-			}
-
-			kv = dict->MatchPrefix( "type", kv );
-			if( kv )
-			{
-				common->Printf( "=======================================================\n" );
-			}
-		}
+		BuildAASFiles( idStr( "maps/" ) + args.Argv( 1 ) + "/" + mapFiles->GetFile( i ), settingsList );
 	}
 
 	fileSystem->FreeFileList( mapFiles );
+	settingsList.DeleteContents( true );
 
 	common->SetRefreshOnPrint( false );
 	common->PrintWarnings();
@@ -42,11 +42,6 @@ If you have questions concerning this license or the applicable additional terms
 #define AAS_PLANE_DIST_EPSILON			0.01f
 
 
-idHashIndex* aas_vertexHash;
-idHashIndex* aas_edgeHash;
-idBounds aas_vertexBounds;
-int aas_vertexShift;
-
 /*
 ================
 idAASBuild::SetupHash
@@ -54,8 +49,8 @@ idAASBuild::SetupHash
 */
 void idAASBuild::SetupHash()
 {
-	aas_vertexHash = new idHashIndex( VERTEX_HASH_SIZE, 1024 );
-	aas_edgeHash = new idHashIndex( EDGE_HASH_SIZE, 1024 );
+	vertexHash = new idHashIndex( VERTEX_HASH_SIZE, 1024 );
+	edgeHash = new idHashIndex( EDGE_HASH_SIZE, 1024 );
 }
 
 /*
@@ -65,8 +60,10 @@ idAASBuild::ShutdownHash
 */
 void idAASBuild::ShutdownHash()
 {
-	delete aas_vertexHash;
-	delete aas_edgeHash;
+	delete vertexHash;
+	delete edgeHash;
+	vertexHash = NULL;
+	edgeHash = NULL;
 }
 
 /*
@@ -79,9 +76,9 @@ void idAASBuild::ClearHash( const idBounds& bounds )
 	int i;
 	float f, max;
 
-	aas_vertexHash->Clear();
-	aas_edgeHash->Clear();
-	aas_vertexBounds = bounds;
+	vertexHash->Clear();
+	edgeHash->Clear();
+	vertexBounds = bounds;
 
 	max = bounds[1].x - bounds[0].x;
 	f = bounds[1].y - bounds[0].y;
@@ -89,17 +86,17 @@ void idAASBuild::ClearHash( const idBounds& bounds )
 	{
 		max = f;
 	}
-	aas_vertexShift = ( float ) max / VERTEX_HASH_BOXSIZE;
-	for( i = 0; ( 1 << i ) < aas_vertexShift; i++ )
+	vertexShift = ( float ) max / VERTEX_HASH_BOXSIZE;
+	for( i = 0; ( 1 << i ) < vertexShift; i++ )
 	{
 	}
 	if( i == 0 )
 	{
-		aas_vertexShift = 1;
+		vertexShift = 1;
 	}
 	else
 	{
-		aas_vertexShift = i;
+		vertexShift = i;
 	}
 }
 
@@ -112,8 +109,8 @@ ID_INLINE int idAASBuild::HashVec( const idVec3& vec )
 {
 	int x, y;
 
-	x = ( ( ( int )( vec[0] - aas_vertexBounds[0].x + 0.5 ) ) + 2 ) >> 2;
-	y = ( ( ( int )( vec[1] - aas_vertexBounds[0].y + 0.5 ) ) + 2 ) >> 2;
+	x = ( ( ( int )( vec[0] - vertexBounds[0].x + 0.5 ) ) + 2 ) >> 2;
+	y = ( ( ( int )( vec[1] - vertexBounds[0].y + 0.5 ) ) + 2 ) >> 2;
 	return ( x + y * VERTEX_HASH_BOXSIZE ) & ( VERTEX_HASH_SIZE - 1 );
 }
 
@@ -141,7 +138,7 @@ bool idAASBuild::GetVertex( const idVec3& v, int* vertexNum )
 
 	hashKey = idAASBuild::HashVec( vert );
 
-	for( vn = aas_vertexHash->First( hashKey ); vn >= 0; vn = aas_vertexHash->Next( vn ) )
+	for( vn = vertexHash->First( hashKey ); vn >= 0; vn = vertexHash->Next( vn ) )
 	{
 		p = &file->vertices[vn];
 		// first compare z-axis because hash is based on x-y plane
@@ -155,7 +152,7 @@ bool idAASBuild::GetVertex( const idVec3& v, int* vertexNum )
 	}
 
 	*vertexNum = file->vertices.Num();
-	aas_vertexHash->Add( hashKey, file->vertices.Num() );
+	vertexHash->Add( hashKey, file->vertices.Num() );
 	file->vertices.Append( vert );
 
 	return false;
@@ -188,11 +185,11 @@ bool idAASBuild::GetEdge( const idVec3& v1, const idVec3& v2, int* edgeNum, int
 		*edgeNum = 0;
 		return true;
 	}
-	hashKey = aas_edgeHash->GenerateKey( v1num, v2num );
+	hashKey = edgeHash->GenerateKey( v1num, v2num );
 	// if both vertexes where already stored
 	if( found )
 	{
-		for( e = aas_edgeHash->First( hashKey ); e >= 0; e = aas_edgeHash->Next( e ) )
+		for( e = edgeHash->First( hashKey ); e >= 0; e = edgeHash->Next( e ) )
 		{
 
 			vertexNum = file->edges[e].vertexNum;
@@ -222,7 +219,7 @@ bool idAASBuild::GetEdge( const idVec3& v1, const idVec3& v2, int* edgeNum, int
 	}
 
 	*edgeNum = file->edges.Num();
-	aas_edgeHash->Add( hashKey, file->edges.Num() );
+	edgeHash->Add( hashKey, file->edges.Num() );
 
 	edge.vertexNum[0] = v1num;
 	edge.vertexNum[1] = v2num;
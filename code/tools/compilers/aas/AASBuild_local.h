@@ -76,6 +76,20 @@ public:
 };
 
 
+typedef enum
+{
+	AAS_STAGE_LOAD,				// map parsing and brush setup
+	AAS_STAGE_BSP,				// brush expansion, BSP tree and portals
+	AAS_STAGE_SUBDIVISION,		// gravitational and ledge subdivision, leaf merging
+	AAS_STAGE_STORE,			// storing the tree in the AAS file
+	AAS_STAGE_REACHABILITY,
+	AAS_STAGE_CLUSTERS,
+	AAS_STAGE_OPTIMIZE,
+	AAS_STAGE_WRITE,
+	AAS_NUM_STAGES
+} aasBuildStage_t;
+
+
 class idAASBuild
 {
 
@@ -86,9 +100,24 @@ public:
 	bool					BuildReachability( const idStr& fileName, const idAASSettings* settings );
 	void					Shutdown();
 
+	// builds are split up so the compile step of several builds can run in parallel,
+	// loading and writing use the file system and decls and must run on the main thread
+	bool					BeginBuild( const idStr& fileName, const idAASSettings* settings );
+	bool					CompileFile( bool parallelReachability );
+	bool					EndBuild();
+	void					PrintStageTimes() const;
+
 private:
 	const idAASSettings* 	aasSettings;
 	idAASFileLocal* 		file;
+	idStr					buildFileName;
+	idMapFile* 				mapFile;
+	idBrushList				brushList;
+	idStrList				entityClassNames;
+	idBrushBSP* 			leakBSP;			// kept to write the leak file if the map has no outside
+	bool					compiled;
+	int						startTime;
+	int						stageTime[AAS_NUM_STAGES];
 	aasProcNode_t* 			procNodes;
 	int						numProcNodes;
 	int						numGravitationalSubdivisions;
@@ -96,6 +125,10 @@ private:
 	int						numLedgeSubdivisions;
 	idList<idLedge>			ledgeList;
 	idBrushMap* 			ledgeMap;
+	idHashIndex* 			vertexHash;
+	idHashIndex* 			edgeHash;
+	idBounds				vertexBounds;
+	int						vertexShift;
 
 private:	// map loading
 	void					ParseProcNodes( idLexer* src );
@@ -104,7 +104,6 @@ void idAASReach::AddReachabilityToArea( idReachability* reach, int areaNum )
 	area = &file->areas[areaNum];
 	reach->next = area->reach;
 	area->reach = reach;
-	numReachabilities++;
 }
 
 /*
@@ -993,14 +992,81 @@ void idAASReach::FlagReachableAreas( idAASFileLocal* file )
 	common->Printf( "%6d reachable areas\n", numReachableAreas );
 }
 
+/*
+================
+idAASReach::AreaReachabilities
+================
+*/
+void idAASReach::AreaReachabilities( int firstAreaNum, int numAreas )
+{
+	int i, j;
+
+	for( i = firstAreaNum; i < firstAreaNum + numAreas; i++ )
+	{
+
+		if( !( file->areas[i].flags & AREA_REACHABLE_WALK ) )
+		{
+			continue;
+		}
+
+		for( j = 0; j < file->areas.Num(); j++ )
+		{
+			if( i == j )
+			{
+				continue;
+			}
+
+			if( !( file->areas[j].flags & AREA_REACHABLE_WALK ) )
+			{
+				continue;
+			}
+
+			if( ReachabilityExists( i, j ) )
+			{
+				continue;
+			}
+			if( Reachability_Step_Barrier_WaterJump_WalkOffLedge( i, j ) )
+			{
+				continue;
+			}
+		}
+
+		//Reachability_WalkOffLedge( i );
+	}
+}
+
+#define REACH_AREAS_PER_JOB		32
+
+typedef struct aasReachJob_s
+{
+	idAASReach* 			reach;
+	int						firstAreaNum;
+	int						numAreas;
+} aasReachJob_t;
+
+/*
+================
+AAS_ReachabilityJob
+================
+*/
+static void AAS_ReachabilityJob( aasReachJob_t* job )
+{
+	job->reach->AreaReachabilities( job->firstAreaNum, job->numAreas );
+}
+
+REGISTER_PARALLEL_JOB( AAS_ReachabilityJob, "AAS_ReachabilityJob" );
+
 /*
 ================
 idAASReach::Build
+
+  the reachabilities of an area only depend on the areas it starts in so the
+  areas can be handled in parallel, the result is the same as a serial run
 ================
 */
-bool idAASReach::Build( const idMapFile* mapFile, idAASFileLocal* file )
+bool idAASReach::Build( const idMapFile* mapFile, idAASFileLocal* file, bool parallel )
 {
-	int i, j, lastPercent;
+	int i, lastPercent;
 
 	this->mapFile = mapFile;
 	this->file = file;
@@ -1029,47 +1095,45 @@ bool idAASReach::Build( const idMapFile* mapFile, idAASFileLocal* file )
 
 	common->RogmapPacifierCompileProgressTotal( file->areas.Num() - 1 );
 
-	lastPercent = -1;
-	for( i = 1; i < file->areas.Num(); i++, common->RogmapPacifierCompileProgressIncrement( 1 ) )
+	if( parallel )
 	{
+		const int numJobs = ( file->areas.Num() - 1 + REACH_AREAS_PER_JOB - 1 ) / REACH_AREAS_PER_JOB;
+		idList<aasReachJob_t> jobs;
+		jobs.SetNum( numJobs );
 
-		if( !( file->areas[i].flags & AREA_REACHABLE_WALK ) )
-		{
-			continue;
-		}
+		idParallelJobList* jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, numJobs, 0, NULL );
 
-		for( j = 0; j < file->areas.Num(); j++ )
+		for( i = 0; i < numJobs; i++ )
 		{
-			if( i == j )
-			{
-				continue;
-			}
+			jobs[i].reach = this;
+			jobs[i].firstAreaNum = 1 + i * REACH_AREAS_PER_JOB;
+			jobs[i].numAreas = Min( REACH_AREAS_PER_JOB, file->areas.Num() - jobs[i].firstAreaNum );
+			jobList->AddJob( ( jobRun_t )AAS_ReachabilityJob, &jobs[i] );
+		}
 
-			if( !( file->areas[j].flags & AREA_REACHABLE_WALK ) )
-			{
-				continue;
-			}
+		jobList->Submit( NULL, JOBLIST_PARALLELISM_MAX_CORES );
+		jobList->Wait();
 
-			if( ReachabilityExists( i, j ) )
-			{
-				continue;
-			}
-			if( Reachability_Step_Barrier_WaterJump_WalkOffLedge( i, j ) )
-			{
-				continue;
-			}
-		}
+		parallelJobManager->FreeJobList( jobList );
 
-		//Reachability_WalkOffLedge( i );
+		common->RogmapPacifierCompileProgressIncrement( file->areas.Num() - 1 );
+	}
+	else
+	{
+		lastPercent = -1;
+		for( i = 1; i < file->areas.Num(); i++, common->RogmapPacifierCompileProgressIncrement( 1 ) )
+		{
+			AreaReachabilities( i, 1 );
 
 #if !defined( DMAP )
-		int percent = 100 * i / file->areas.Num();
-		if( percent > lastPercent )
-		{
-			common->Printf( "\r%6d%%", percent );
-			lastPercent = percent;
-		}
+			int percent = 100 * i / file->areas.Num();
+			if( percent > lastPercent )
+			{
+				common->Printf( "\r%6d%%", percent );
+				lastPercent = percent;
+			}
 #endif
+		}
 	}
 
 	if( file->GetSettings().allowFlyReachabilities )
@@ -1082,6 +1146,14 @@ bool idAASReach::Build( const idMapFile* mapFile, idAASFileLocal* file )
 
 	file->LinkReversedReachability();
 
+	for( i = 0; i < file->areas.Num(); i++ )
+	{
+		for( idReachability* reach = file->areas[i].reach; reach; reach = reach->next )
+		{
+			numReachabilities++;
+		}
+	}
+
 	common->Printf( "\r%6d reachabilities\n", numReachabilities );
 
 	return true;
@@ -41,7 +41,10 @@ class idAASReach
 {
 
 public:
-	bool					Build( const idMapFile* mapFile, idAASFileLocal* file );
+	bool					Build( const idMapFile* mapFile, idAASFileLocal* file, bool parallel );
+	// creates the walk, jump and ledge reachabilities starting in the given areas,
+	// only the reachability lists of these areas are changed
+	void					AreaReachabilities( int firstAreaNum, int numAreas );
 
 private:
 	const idMapFile* 		mapFile;
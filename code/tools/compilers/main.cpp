@@ -595,6 +595,70 @@ ID_TIME_T Sys_FileTimeStamp( idFileHandle fp )
 	return itime.QuadPart;
 }
 
+/*
+=================
+Sys_MapFile
+=================
+*/
+const byte* Sys_MapFile( const char* osPath, size_t& length )
+{
+	length = 0;
+
+	HANDLE file = CreateFileA( osPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+	if( file == INVALID_HANDLE_VALUE )
+	{
+		return NULL;
+	}
+
+	LARGE_INTEGER size;
+	if( !GetFileSizeEx( file, &size ) || size.QuadPart <= 0 )
+	{
+		CloseHandle( file );
+		return NULL;
+	}
+
+	HANDLE mapping = CreateFileMappingA( file, NULL, PAGE_WRITECOPY, 0, 0, NULL );
+	CloseHandle( file );
+	if( mapping == NULL )
+	{
+		return NULL;
+	}
+
+	// the view keeps the mapping alive
+	void* data = MapViewOfFile( mapping, FILE_MAP_COPY, 0, 0, 0 );
+	CloseHandle( mapping );
+	if( data == NULL )
+	{
+		return NULL;
+	}
+
+	length = ( size_t )size.QuadPart;
+	return ( const byte* )data;
+}
+
+/*
+=================
+Sys_UnmapFile
+=================
+*/
+void Sys_UnmapFile( const byte* data, size_t length )
+{
+	if( data != NULL )
+	{
+		UnmapViewOfFile( data );
+	}
+}
+
+/*
+=================
+Sys_PrefetchMappedFile
+=================
+*/
+void Sys_PrefetchMappedFile( const byte* data, size_t length )
+{
+	// the read ahead of the system file cache is left to do this
+}
+
 /*
 ================
 Sys_GetClockTicks
@@ -35,6 +35,8 @@ If you have questions concerning this license or the applicable additional terms
 
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 #include <stdio.h>
 #include <dirent.h>
 #include <fnmatch.h>
@@ -421,6 +423,67 @@ ID_TIME_T Sys_FileTimeStamp( idFileHandle fp )
 	return st.st_mtime;
 }
 
+/*
+=================
+Sys_MapFile
+=================
+*/
+const byte* Sys_MapFile( const char* osPath, size_t& length )
+{
+	length = 0;
+
+	int fd = open( osPath, O_RDONLY );
+	if( fd == -1 )
+	{
+		return NULL;
+	}
+
+	struct stat st;
+	if( fstat( fd, &st ) == -1 || st.st_size <= 0 )
+	{
+		close( fd );
+		return NULL;
+	}
+
+	void* data = mmap( NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+	close( fd );
+
+	if( data == MAP_FAILED )
+	{
+		return NULL;
+	}
+
+	length = st.st_size;
+	return ( const byte* )data;
+}
+
+/*
+=================
+Sys_UnmapFile
+=================
+*/
+void Sys_UnmapFile( const byte* data, size_t length )
+{
+	if( data != NULL )
+	{
+		munmap( ( void* )data, length );
+	}
+}
+
+/*
+=================
+Sys_PrefetchMappedFile
+=================
+*/
+void Sys_PrefetchMappedFile( const byte* data, size_t length )
+{
+	// madvise wants a page aligned address
+	const uintptr_t pageSize = sysconf( _SC_PAGESIZE );
+	const uintptr_t start = ( uintptr_t )data & ~( pageSize - 1 );
+
+	madvise( ( void* )start, ( uintptr_t )data + length - start, MADV_WILLNEED );
+}
+
 /*
 ===============
 Sys_GetClockticks
@@ -531,6 +531,12 @@ void Rogmap( const idCmdArgs& args )
 			common->RogmapPacifierInfo( "%5.0f seconds to create collision map\n", ( end - start ) * 0.001f );
 		}
 
+		if( !region )
+		{
+			// let the game spawn the entities without parsing the whole map again
+			dmapGlobals.dmapFile->WriteEntityCache();
+		}
+
 		if( !noAAS && !region )
 		{
 			// create AAS files